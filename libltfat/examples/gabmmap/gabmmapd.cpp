@@ -0,0 +1,400 @@
+#include "ltfathelper.h"
+#include "phaseret.h"
+#include "phaseret/types.h"
+#include "ltfat/thirdparty/fftw3.h"
+#include "cxxopts.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+/*
+ * File-backed Gabor analysis, phase retrieval and synthesis of signals
+ * which do not fit into RAM.
+ *
+ * Signal files contain raw single-channel LTFAT_REAL samples, coefficient
+ * files contain raw interleaved LTFAT_COMPLEX values of a M2 x N array.
+ * The coefficients cover all frames overlapping the signal, i.e. column n
+ * is centered at sample n*a - ceil(gl/2/a)*a.
+ * The files are memory-mapped and processed sequentially, the pages
+ * behind the processing position are released so that the resident
+ * memory stays bounded by the block length.
+ */
+
+template<class T>
+using uni_ptrdel = unique_ptr<T, void(*)( T*)>;
+
+class MappedFile
+{
+public:
+    // Map an existing file read-only
+    MappedFile(const string& name)
+    {
+        struct stat st;
+        fd = open(name.c_str(), O_RDONLY);
+        if (fd < 0 || fstat(fd, &st) < 0)
+            throw runtime_error("Cannot open " + name);
+        len = st.st_size;
+        map(PROT_READ, name);
+    }
+
+    // Create a zero-filled file of length len and map it read-write
+    MappedFile(const string& name, size_t len): len(len), writable(true)
+    {
+        fd = open(name.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0 || ftruncate(fd, len) < 0)
+            throw runtime_error("Cannot create " + name);
+        map(PROT_READ | PROT_WRITE, name);
+    }
+
+    ~MappedFile()
+    {
+        if (ptr) munmap(ptr, len);
+        if (fd >= 0) close(fd);
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    template<class T> T* data() { return static_cast<T*>(ptr); }
+    size_t size() const { return len; }
+
+    // Bytes before pos will not be accessed again
+    void release(size_t pos)
+    {
+        size_t upto = pos / pagesize * pagesize;
+        if (upto <= released) return;
+
+        char* start = static_cast<char*>(ptr) + released;
+        if (writable) msync(start, upto - released, MS_ASYNC);
+        madvise(start, upto - released, MADV_DONTNEED);
+        released = upto;
+    }
+
+private:
+    void map(int prot, const string& name)
+    {
+        if (len == 0)
+            throw runtime_error(name + " is empty");
+
+        ptr = mmap(NULL, len, prot, MAP_SHARED, fd, 0);
+        if (ptr == MAP_FAILED)
+        {
+            ptr = nullptr;
+            throw runtime_error("Cannot map " + name);
+        }
+        madvise(ptr, len, MADV_SEQUENTIAL);
+    }
+
+    int fd{-1};
+    void* ptr{nullptr};
+    size_t len{0};
+    size_t released{0};
+    size_t pagesize{static_cast<size_t>(sysconf(_SC_PAGESIZE))};
+    bool writable{false};
+};
+
+static void checkstatus(int status, const string& what)
+{
+    if (status != LTFATERR_SUCCESS)
+        throw runtime_error(what + " failed with status " + to_string(status));
+}
+
+struct GaborParams
+{
+    LTFAT_FIRWIN win;
+    ltfat_int gl, a, M, bl;
+};
+
+// Number of samples the signal is delayed by in the coefficient domain such
+// that the frames overlapping the beginning of the signal are kept
+static ltfat_int frameoffset(const GaborParams& gp)
+{
+    return ltfat_idivceil(gp.gl / 2, gp.a) * gp.a;
+}
+
+static void analysis(const GaborParams& gp, const string& inFile, const string& outFile)
+{
+    ltfat_int M2 = gp.M / 2 + 1;
+    MappedFile in{inFile};
+    ltfat_int L = in.size() / sizeof(LTFAT_REAL);
+    ltfat_int off = frameoffset(gp);
+    ltfat_int N = ltfat_idivceil(L + 2 * off, gp.a);
+    MappedFile out{outFile, N * M2 * sizeof(LTFAT_COMPLEX)};
+
+    const LTFAT_REAL* f = in.data<LTFAT_REAL>();
+    LTFAT_COMPLEX* c = out.data<LTFAT_COMPLEX>();
+    vector<LTFAT_REAL> zeros(off);
+
+    vector<LTFAT_REAL> g(gp.gl);
+    checkstatus(LTFAT_NAME(firwin)(gp.win, gp.gl, g.data()), "firwin");
+
+    LTFAT_NAME(dgtreal_olastream_plan)* p = NULL;
+    checkstatus(LTFAT_NAME(dgtreal_olastream_init)(g.data(), gp.gl, 1, gp.a, gp.M,
+                gp.bl, LTFAT_TIMEINV, FFTW_ESTIMATE, &p), "dgtreal_olastream_init");
+    auto unip = uni_ptrdel<LTFAT_NAME(dgtreal_olastream_plan)>(
+    p, [](auto * p) { LTFAT_NAME(dgtreal_olastream_done)(&p); });
+
+    // The stream is the signal with off zeros on both sides
+    ltfat_int Lpos = 0, nout = 0;
+    while (nout < N)
+    {
+        if (Lpos < L + 2 * off)
+        {
+            const LTFAT_REAL* fchunk;
+            ltfat_int Lchunk, Lused = 0;
+
+            if (Lpos < off)
+            {
+                fchunk = zeros.data();
+                Lchunk = off - Lpos;
+            }
+            else if (Lpos < off + L)
+            {
+                fchunk = f + Lpos - off;
+                Lchunk = std::min(gp.bl, off + L - Lpos);
+            }
+            else
+            {
+                fchunk = zeros.data();
+                Lchunk = 2 * off + L - Lpos;
+            }
+
+            checkstatus(LTFAT_NAME(dgtreal_olastream_push)(p, fchunk, Lchunk, &Lused),
+                        "dgtreal_olastream_push");
+            Lpos += Lused;
+            if (Lpos > off) in.release((Lpos - off) * sizeof * f);
+
+            if (Lpos == L + 2 * off)
+                checkstatus(LTFAT_NAME(dgtreal_olastream_flush)(p), "dgtreal_olastream_flush");
+        }
+
+        // The columns go directly to the mapped output
+        ltfat_int Nout = 0;
+        checkstatus(LTFAT_NAME(dgtreal_olastream_pull)(p, c + nout * M2, N - nout, &Nout),
+                    "dgtreal_olastream_pull");
+        nout += Nout;
+        out.release(nout * M2 * sizeof * c);
+    }
+
+    cout << "Analysis: L=" << L << ", N=" << N << ", M2=" << M2 << endl;
+}
+
+static void pghi(const GaborParams& gp, double tol, const string& inFile, const string& outFile)
+{
+    ltfat_int M2 = gp.M / 2 + 1;
+    MappedFile in{inFile};
+    ltfat_int N = in.size() / (M2 * sizeof(LTFAT_COMPLEX));
+    if (N == 0)
+        throw runtime_error(inFile + " contains less than one coefficient column");
+    MappedFile out{outFile, N * M2 * sizeof(LTFAT_COMPLEX)};
+
+    const LTFAT_COMPLEX* cin = in.data<LTFAT_COMPLEX>();
+    LTFAT_COMPLEX* c = out.data<LTFAT_COMPLEX>();
+
+    double gamma = phaseret_firwin2gamma(gp.win, gp.gl);
+    PHASERET_NAME(rtpghi_state)* p = NULL;
+    checkstatus(PHASERET_NAME(rtpghi_init)(1, gp.a, gp.M, gamma, tol, 0, &p),
+                "rtpghi_init");
+    auto unip = uni_ptrdel<PHASERET_NAME(rtpghi_state)>(
+    p, [](auto * p) { PHASERET_NAME(rtpghi_done)(&p); });
+
+    // The non-causal version outputs the previous column, the first output
+    // is discarded and a zero column is passed after the last one
+    vector<LTFAT_REAL> s(M2);
+    vector<LTFAT_COMPLEX> cdummy(M2);
+    for (ltfat_int n = 0; n <= N; n++)
+    {
+        for (ltfat_int m = 0; m < M2; m++)
+            s[m] = n < N ? ltfat_abs(cin[n * M2 + m]) : 0;
+
+        checkstatus(PHASERET_NAME(rtpghi_execute)(p, s.data(),
+                    n > 0 ? c + (n - 1) * M2 : cdummy.data()), "rtpghi_execute");
+
+        in.release((n + 1) * M2 * sizeof * cin);
+        if (n > 0) out.release(n * M2 * sizeof * c);
+    }
+
+    cout << "PGHI: N=" << N << ", M2=" << M2 << ", gamma=" << gamma << endl;
+}
+
+static void synthesis(const GaborParams& gp, ltfat_int L, const string& inFile,
+                      const string& outFile)
+{
+    ltfat_int M2 = gp.M / 2 + 1;
+    MappedFile in{inFile};
+    ltfat_int N = in.size() / (M2 * sizeof(LTFAT_COMPLEX));
+    ltfat_int off = frameoffset(gp);
+    if (L == 0) L = N * gp.a - 2 * off;
+    if (L <= 0)
+        throw runtime_error(inFile + " is too short");
+    MappedFile out{outFile, L * sizeof(LTFAT_REAL)};
+
+    const LTFAT_COMPLEX* c = in.data<LTFAT_COMPLEX>();
+    LTFAT_REAL* f = out.data<LTFAT_REAL>();
+
+    vector<LTFAT_REAL> g(gp.gl), gd(gp.gl), frame(gp.gl);
+    checkstatus(LTFAT_NAME(firwin)(gp.win, gp.gl, g.data()), "firwin");
+    checkstatus(LTFAT_NAME(gabdual_painless)(g.data(), gp.gl, gp.a, gp.M, gd.data()),
+                "gabdual_painless");
+
+    LTFAT_NAME(rtidgtreal_plan)* p = NULL;
+    checkstatus(LTFAT_NAME(rtidgtreal_init)(gd.data(), gp.gl, gp.M,
+                LTFAT_RTDGTPHASE_ZERO, &p), "rtidgtreal_init");
+    auto unip = uni_ptrdel<LTFAT_NAME(rtidgtreal_plan)>(
+    p, [](auto * p) { LTFAT_NAME(rtidgtreal_done)(&p); });
+
+    // Overlap-add the frames directly in the mapped output
+    for (ltfat_int n = 0; n < N; n++)
+    {
+        checkstatus(LTFAT_NAME(rtidgtreal_execute)(p, c + n * M2, 1, frame.data()),
+                    "rtidgtreal_execute");
+
+        ltfat_int start = n * gp.a - off - gp.gl / 2;
+        ltfat_int jstart = std::max<ltfat_int>(0, -start);
+        ltfat_int jend = std::min<ltfat_int>(gp.gl, L - start);
+        for (ltfat_int j = jstart; j < jend; j++)
+            f[start + j] += frame[j];
+
+        in.release((n + 1) * M2 * sizeof * c);
+        if (start > 0) out.release(start * sizeof * f);
+    }
+
+    cout << "Synthesis: L=" << L << ", N=" << N << ", M2=" << M2 << endl;
+}
+
+int main(int argc, char* argv[])
+{
+    if (!ltfat_int_is_compatible(sizeof(int)))
+    {
+        std::cout << "Incompatible size of int. libltfat was probably"
+                     " compiled with -DLTFAT_LARGEARRAYS" << std::endl;
+        exit(1);
+    }
+
+    string mode, inFile, outFile;
+    string winstr{"hann"};
+    GaborParams gp;
+    ltfat_int L = 0;
+    double tol = 1e-6;
+
+    try
+    {
+        string examplestr{"Usage:\n" +
+            string(argv[0]) + " -a 256 -M 2048 ana input.raw coefs.raw\n" +
+            string(argv[0]) + " -a 256 -M 2048 pghi coefs.raw coefsrec.raw\n" +
+            string(argv[0]) + " -a 256 -M 2048 syn coefsrec.raw output.raw"
+        };
+        cxxopts::Options options(argv[0], "\nFile-backed Gabor analysis, PGHI and synthesis");
+        options
+        .positional_help("mode input output"
+                         "\n\nmode is one of: ana (raw signal -> coefficients),"
+                         " pghi (coefficients -> coefficients with phase"
+                         " reconstructed from the magnitude) or"
+                         " syn (coefficients -> raw signal).")
+        .show_positional_help();
+
+        options.add_options()
+        ("mode", "Processing mode: ana, pghi or syn (REQUIRED)", cxxopts::value<string>())
+        ("i,input", "Input raw file (REQUIRED)", cxxopts::value<string>())
+        ("o,output", "Output raw file (REQUIRED)", cxxopts::value<string>())
+        ("w,win", "Window. Supported windows are: blackman, hann, ...",
+         cxxopts::value<string>()->default_value(winstr))
+        ("a,hop", "Hop size (REQUIRED)", cxxopts::value<int>())
+        ("M,channels", "Number of frequency channels (REQUIRED)", cxxopts::value<int>())
+        ("g,gl", "Window length. Defaults to M", cxxopts::value<int>())
+        ("b,blocklen", "Analysis block length in samples. It is rounded up to a multiple of lcm(a,M)."
+                       " Defaults to 16*max(gl,M)", cxxopts::value<int>())
+        ("L,length", "Length of the synthesized signal. Defaults to the length of the analyzed"
+                     " signal rounded up to a multiple of a", cxxopts::value<int>())
+        ("tol", "PGHI relative tolerance",
+         cxxopts::value<double>()->default_value(to_string(tol)))
+        ("help", "Print help");
+
+        options.parse_positional({"mode", "input", "output"});
+
+        auto result = options.parse(argc, argv);
+
+        if (result.count("help"))
+        {
+            cout << options.help({""}) << endl;
+            exit(0);
+        }
+
+        if (!result.count("mode") || !result.count("input") || !result.count("output")
+            || !result.count("hop") || !result.count("channels"))
+        {
+            cout << "Missing arguments." << endl;
+            cout << examplestr << endl;
+            exit(1);
+        }
+
+        mode = result["mode"].as<string>();
+        inFile = result["input"].as<string>();
+        outFile = result["output"].as<string>();
+        gp.a = result["hop"].as<int>();
+        gp.M = result["channels"].as<int>();
+        gp.gl = result.count("gl") ? result["gl"].as<int>() : gp.M;
+        if (gp.a <= 0 || gp.M <= 0 || gp.gl <= 0)
+        {
+            cout << "a, M and gl must be positive." << endl;
+            exit(1);
+        }
+
+        winstr = result["win"].as<string>();
+        transform(winstr.begin(), winstr.end(), winstr.begin(), ::tolower);
+        int winenum = ltfat_str2firwin(winstr.c_str());
+        if (winenum < 0)
+        {
+            cout << "Window " << winstr << " not recognized." << endl;
+            exit(1);
+        }
+        gp.win = static_cast<LTFAT_FIRWIN>(winenum);
+
+        ltfat_int lcm = ltfat_lcm(gp.a, gp.M);
+        gp.bl = result.count("blocklen") ? result["blocklen"].as<int>() :
+                16 * std::max(gp.gl, gp.M);
+        gp.bl = std::max<ltfat_int>(1, ltfat_idivceil(gp.bl, lcm)) * lcm;
+
+        if (result.count("length"))
+            L = result["length"].as<int>();
+
+        tol = result["tol"].as<double>();
+    }
+    catch (const cxxopts::OptionException& e)
+    {
+        std::cout << "error parsing options: " << e.what() << std::endl;
+        exit(1);
+    }
+
+    try
+    {
+        auto t1 = Clock::now();
+
+        if (mode == "ana")
+            analysis(gp, inFile, outFile);
+        else if (mode == "pghi")
+            pghi(gp, tol, inFile, outFile);
+        else if (mode == "syn")
+            synthesis(gp, L, inFile, outFile);
+        else
+        {
+            cout << "Unrecognized mode " << mode << endl;
+            exit(1);
+        }
+
+        auto t2 = Clock::now();
+        int dur = std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count();
+        cout << "DURATION: " << dur << " ms" << std::endl;
+    }
+    catch (const exception& e)
+    {
+        cout << e.what() << endl;
+        exit(1);
+    }
+
+    return 0;
+}
@@ -0,0 +1,173 @@
+#include "ltfathelper.h"
+#include "cxxopts.hpp"
+#include <random>
+
+// Compares the binary and the blocked maxtree layouts using the access
+// pattern of dgtrealmp: every update modifies a kernel-sized area of the
+// coefficients, the touched columns are refreshed and the maximum over
+// all columns is found.
+
+template<class T>
+using uni_ptrdel = unique_ptr<T, void(*)( T*)>;
+using maxtree_ptr = uni_ptrdel<LTFAT_NAME(maxtree)>;
+
+struct Update
+{
+    ltfat_int n;
+    ltfat_int m;
+    LTFAT_REAL scale;
+};
+
+static maxtree_ptr
+make_maxtree(ltfat_int L, ltfat_int Lstep, bool blocked)
+{
+    LTFAT_NAME(maxtree)* p = NULL;
+    if (blocked)
+        LTFAT_NAME(maxtree_initblocked)(L, Lstep, &p);
+    else
+        LTFAT_NAME(maxtree_init)(L, Lstep,
+                                 ltfat_imax(0, ltfat_pow2base(ltfat_nextpow2(Lstep)) - 4), &p);
+
+    return maxtree_ptr(p, [](auto * pp) { LTFAT_NAME(maxtree_done)(&pp); });
+}
+
+// Returns time in ms, hash collects the positions of the found maxima
+static double
+run(const vector<LTFAT_COMPLEX>& cinit, ltfat_int M, ltfat_int N,
+    ltfat_int kernh, ltfat_int kernw, const vector<Update>& updates,
+    bool blocked, size_t& hash)
+{
+    ltfat_int M2 = M / 2 + 1;
+    vector<LTFAT_COMPLEX> c(cinit);
+    vector<LTFAT_REAL> maxcols(N);
+    vector<ltfat_int> maxcolspos(N);
+    vector<maxtree_ptr> fmaxtree;
+
+    for (ltfat_int n = 0; n < N; n++)
+    {
+        fmaxtree.push_back(make_maxtree(M2, M, blocked));
+        LTFAT_NAME(maxtree_reset_complex)(fmaxtree[n].get(), c.data() + n * M2);
+        LTFAT_NAME(maxtree_findmax)(fmaxtree[n].get(), &maxcols[n], &maxcolspos[n]);
+    }
+
+    maxtree_ptr tmaxtree = make_maxtree(N, N, blocked);
+    LTFAT_NAME(maxtree_reset)(tmaxtree.get(), maxcols.data());
+
+    hash = 0;
+    auto t1 = Clock::now();
+    for (const auto& u : updates)
+    {
+        // Both ranges wrap around as in dgtrealmp
+        ltfat_int mstart = ltfat_positiverem(u.m - kernh / 2, M);
+        ltfat_int nstart = ltfat_positiverem(u.n - kernw / 2, N);
+
+        for (ltfat_int nn = 0, n = nstart; nn < kernw; nn++, n = n + 1 < N ? n + 1 : 0)
+        {
+            for (ltfat_int mm = 0, m = mstart; mm < kernh; mm++, m = m + 1 < M ? m + 1 : 0)
+                if ( m < M2 )
+                    c[n * M2 + m] *= u.scale;
+
+            LTFAT_NAME(maxtree_setdirty)(fmaxtree[n].get(), mstart, mstart + kernh);
+            LTFAT_NAME(maxtree_findmax)(fmaxtree[n].get(), &maxcols[n], &maxcolspos[n]);
+        }
+
+        LTFAT_NAME(maxtree_setdirty)(tmaxtree.get(), nstart, nstart + kernw);
+
+        LTFAT_REAL maxval; ltfat_int maxpos;
+        LTFAT_NAME(maxtree_findmax)(tmaxtree.get(), &maxval, &maxpos);
+        hash = hash * 31 + maxpos * M2 + maxcolspos[maxpos];
+    }
+    auto t2 = Clock::now();
+
+    return std::chrono::duration<double, std::milli>(t2 - t1).count();
+}
+
+int main(int argc, char* argv[])
+{
+    ltfat_int L = 10 * 44100;
+    size_t updatesNo = 20000;
+    ltfat_int kernh = 16;
+    vector<pair<ltfat_int, ltfat_int>> dicts;
+
+    try
+    {
+        cxxopts::Options options(argv[0], "\nBenchmark of the maxtree layouts");
+
+        options.add_options()
+        ("d,dict", "Dictionary sizes. Format: hop1,channels1:hop2,channels2",
+         cxxopts::value<string>()->default_value("128,512:256,1024:512,2048:1024,4096"))
+        ("L,len", "Signal length", cxxopts::value<ltfat_int>()->default_value(to_string(L)))
+        ("u,updates", "Number of updates", cxxopts::value<size_t>()->default_value(to_string(updatesNo)))
+        ("kernh", "Height of the modified area", cxxopts::value<ltfat_int>()->default_value(to_string(kernh)))
+        ("help", "Print help");
+
+        auto result = options.parse(argc, argv);
+
+        if (result.count("help"))
+        {
+            cout << options.help({""}) << endl;
+            exit(0);
+        }
+
+        L = result["len"].as<ltfat_int>();
+        updatesNo = result["updates"].as<size_t>();
+        kernh = result["kernh"].as<ltfat_int>();
+
+        string toparse = result["dict"].as<string>() + ":";
+        size_t pos;
+        while ((pos = toparse.find(":")) != string::npos)
+        {
+            string dictstr = toparse.substr(0, pos);
+            toparse = toparse.substr(pos + 1);
+            if (dictstr.empty()) continue;
+
+            size_t pos2 = dictstr.find(",");
+            if (pos2 == string::npos)
+            {
+                cout << "Parse error: " << dictstr << endl;
+                exit(1);
+            }
+            dicts.push_back(make_pair(stoi(dictstr.substr(0, pos2)),
+                                      stoi(dictstr.substr(pos2 + 1))));
+        }
+    }
+    catch (const cxxopts::OptionException& e)
+    {
+        std::cout << "error parsing options: " << e.what() << std::endl;
+        exit(1);
+    }
+
+    std::mt19937 gen(0);
+    std::normal_distribution<LTFAT_REAL> randn;
+    std::uniform_real_distribution<LTFAT_REAL> randu(0.0, 1.0);
+
+    for (auto dict : dicts)
+    {
+        ltfat_int a = dict.first, M = dict.second;
+        ltfat_int M2 = M / 2 + 1, N = L / a;
+        // Gram kernel of a window of length M spans about 2*M/a columns
+        ltfat_int kernw = ltfat_imin(2 * M / a - 1, N);
+
+        vector<LTFAT_COMPLEX> c(M2 * N);
+        for (auto& cEl : c) cEl = LTFAT_COMPLEX(randn(gen), randn(gen));
+
+        vector<Update> updates(updatesNo);
+        for (auto& u : updates)
+        {
+            u.n = std::uniform_int_distribution<ltfat_int>(0, N - 1)(gen);
+            u.m = std::uniform_int_distribution<ltfat_int>(0, M2 - 1)(gen);
+            u.scale = randu(gen);
+        }
+
+        size_t hashbin, hashblk;
+        double tbin = run(c, M, N, kernh, kernw, updates, false, hashbin);
+        double tblk = run(c, M, N, kernh, kernw, updates, true, hashblk);
+
+        cout << "a=" << a << ", M=" << M << ", N=" << N
+             << ": binary " << tbin << " ms, blocked " << tblk << " ms"
+             << ", speedup " << tbin / tblk
+             << (hashbin == hashblk ? "" : " (RESULTS DIFFER)") << endl;
+    }
+
+    return 0;
+}
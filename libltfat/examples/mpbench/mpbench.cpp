@@ -0,0 +1,415 @@
+#include "ltfathelper.h"
+#include "cxxopts.hpp"
+#include "wavhandler.h"
+#include <algorithm>
+#include <fstream>
+#include <random>
+#include <sstream>
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+// Runs the MP algorithms of dgtrealmp on a synthetic signal or on a wav file
+// and writes the results as JSON, one object per algorithm, so that runs of
+// different library builds can be compared by scripts.
+
+template<class T>
+using uni_ptrdel = unique_ptr<T, void(*)( T*)>;
+
+struct Run
+{
+    string alg;
+    int status;
+    size_t atoms;
+    size_t iters;
+    double tinit;
+    double tdecomp;
+    double tsyn;
+    double tfindmax;
+    double tupdate;
+    double tselect;
+    double snr;
+    long peakrss;
+};
+
+static const vector<pair<string, ltfat_dgtmp_alg>> algs
+{
+    {"mp", ltfat_dgtmp_alg_mp},
+    {"locomp", ltfat_dgtmp_alg_locomp},
+    {"loccyclicmp", ltfat_dgtmp_alg_loccyclicmp},
+    {"locselfprojmp", ltfat_dgtmp_alg_locselfprojmp}
+};
+
+// Peak resident set size of the process in kB, -1 if not available
+static long
+peak_rss_kb()
+{
+#ifndef _WIN32
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0)
+#ifdef __APPLE__
+        return usage.ru_maxrss / 1024;
+#else
+        return usage.ru_maxrss;
+#endif
+#endif
+    return -1;
+}
+
+static double
+seconds(Clock::time_point t1, Clock::time_point t2)
+{
+    return std::chrono::duration<double>(t2 - t1).count();
+}
+
+// Tones, a chirp, clicks and noise. The same seed gives the same signal.
+static vector<LTFAT_REAL>
+synthetic_signal(ltfat_int L, unsigned seed)
+{
+    const double fs = 44100.0, pi = 3.141592653589793;
+    std::mt19937 gen(seed);
+    std::normal_distribution<double> randn;
+    std::uniform_real_distribution<double> randu(0.0, 1.0);
+    vector<double> f(L, 0.0);
+
+    for (int tone = 0; tone < 8; tone++)
+    {
+        double freq = 100.0 + 4000.0 * randu(gen), phase = 2.0 * pi * randu(gen);
+        double amp = 0.1 + 0.4 * randu(gen);
+        for (ltfat_int l = 0; l < L; l++)
+            f[l] += amp * std::sin(2.0 * pi * freq * l / fs + phase);
+    }
+
+    for (ltfat_int l = 0; l < L; l++)
+    {
+        double t = l / fs, T = L / fs;
+        f[l] += 0.3 * std::sin(2.0 * pi * (200.0 * t + 4000.0 * t * t / (2.0 * T)));
+        f[l] += 0.01 * randn(gen);
+    }
+
+    for (int click = 0; click < 16; click++)
+    {
+        ltfat_int pos = std::uniform_int_distribution<ltfat_int>(0, L - 64)(gen);
+        for (ltfat_int l = 0; l < 64; l++)
+            f[pos + l] += std::exp(-l / 8.0) * randn(gen);
+    }
+
+    return vector<LTFAT_REAL>(f.begin(), f.end());
+}
+
+static string
+json_escape(const string& str)
+{
+    string out;
+    for (char ch : str)
+    {
+        if (ch == '"' || ch == '\\') out += '\\';
+        out += ch;
+    }
+    return out;
+}
+
+int main(int argc, char* argv[])
+{
+    if (!ltfat_int_is_compatible(sizeof(int)))
+    {
+        std::cout << "Incompatible size of int. libltfat was probably"
+                     " compiled with -DLTFAT_LARGEARRAYS" << std::endl;
+        exit(1);
+    }
+
+    string inFile, outFile;
+    string dictspec = "blackman,512,2048:blackman,256,1024:blackman,128,512:"
+                      "blackman,64,256:blackman,32,128:blackman,16,64";
+    ltfat_int synthLen = 5 * 44100;
+    double targetsnrdb = 40;
+    double kernthr = 1e-4;
+    size_t maxat = 0;
+    int nthreads = 1;
+    int reps = 1;
+    vector<tuple<string, int, int, int>> dicts;
+    vector<pair<string, ltfat_dgtmp_alg>> runalgs;
+    vector<LTFAT_REAL> f;
+
+    try
+    {
+        cxxopts::Options options(argv[0], "\nBenchmark of the Multi-Gabor MP algorithms");
+
+        options.add_options()
+        ("i,input", "Input *.wav file. Only the first channel is used. "
+                    "A synthetic signal is used if not specified.", cxxopts::value<string>())
+        ("o,output", "Output *.json file. Defaults to the standard output", cxxopts::value<string>())
+        ("L,len", "Length of the synthetic signal in samples",
+         cxxopts::value<ltfat_int>()->default_value(to_string(synthLen)))
+        ("d,dict", "Dictionary specification. Format: win1,hop1,channels1:win2,hop2,channels2. "
+                   "Defaults to blackman windows of lengths 2048, 1024, ..., 64 "
+                   "with hop sizes of a quarter of the window length and as many "
+                   "channels as the window length", cxxopts::value<string>())
+        ("a,alg", "Comma separated list of algorithms. Available: mp,locomp,loccyclicmp,locselfprojmp",
+         cxxopts::value<string>()->default_value("mp,locomp,loccyclicmp,locselfprojmp"))
+        ("s,snr", "Target signal-to-noise ratio in dB",
+         cxxopts::value<double>()->default_value(to_string(targetsnrdb)))
+        ("maxat", "Maximum number of atoms. Defaults to the signal length", cxxopts::value<size_t>())
+        ("kernthr", "Kernel truncation threshold",
+         cxxopts::value<double>()->default_value(to_string(kernthr)))
+        ("t,threads", "Number of threads", cxxopts::value<int>()->default_value(to_string(nthreads)))
+        ("r,reps", "Number of repetitions, the fastest one is reported",
+         cxxopts::value<int>()->default_value(to_string(reps)))
+        ("help", "Print help");
+
+        auto result = options.parse(argc, argv);
+
+        if (result.count("help"))
+        {
+            cout << options.help({""}) << endl;
+            exit(0);
+        }
+
+        if (result.count("output"))
+            outFile = result["output"].as<string>();
+
+        synthLen = result["len"].as<ltfat_int>();
+        targetsnrdb = result["snr"].as<double>();
+        kernthr = result["kernthr"].as<double>();
+        nthreads = result["threads"].as<int>();
+        reps = std::max(1, result["reps"].as<int>());
+
+        if (result.count("input"))
+        {
+            inFile = result["input"].as<string>();
+            try
+            {
+                WavReader<LTFAT_REAL> wr{inFile};
+                vector<vector<LTFAT_REAL>> fch(wr.getNumChannels(),
+                                               vector<LTFAT_REAL>(wr.getNumSamples()));
+                wr.readSamples(fch);
+                f = fch[0];
+            }
+            catch (...)
+            {
+                cout << "Cannot open " << inFile << endl;
+                exit(1);
+            }
+        }
+        else
+        {
+            if (synthLen <= 64)
+            {
+                cout << "The synthetic signal must be longer than 64 samples." << endl;
+                exit(1);
+            }
+            f = synthetic_signal(synthLen, 0);
+        }
+
+        if (f.empty())
+        {
+            cout << "Empty input signal" << endl;
+            exit(1);
+        }
+
+        maxat = result.count("maxat") ? result["maxat"].as<size_t>() : f.size();
+
+        string toparse = result["alg"].as<string>() + ",";
+        size_t pos;
+        while ((pos = toparse.find(",")) != string::npos)
+        {
+            string algstr = toparse.substr(0, pos);
+            toparse = toparse.substr(pos + 1);
+            if (algstr.empty()) continue;
+
+            auto it = std::find_if(algs.begin(), algs.end(),
+                                   [&](const auto & el) { return el.first == algstr; });
+            if (it == algs.end())
+            {
+                cout << "Unrecognized algorithm " << algstr << endl;
+                exit(1);
+            }
+            runalgs.push_back(*it);
+        }
+
+        if (result.count("dict"))
+            dictspec = result["dict"].as<string>();
+
+        toparse = dictspec + ":";
+        while ((pos = toparse.find(":")) != string::npos)
+        {
+            string dictstr = toparse.substr(0, pos);
+            toparse = toparse.substr(pos + 1);
+            if (dictstr.empty()) continue;
+
+            vector<string> dictvec;
+            std::stringstream ss(dictstr);
+            string itemstr;
+            while (std::getline(ss, itemstr, ','))
+                if (!itemstr.empty()) dictvec.push_back(itemstr);
+
+            if (dictvec.size() != 3)
+            {
+                cout << "Parse error: Dictionary should consist of 3 items: win,a,M" << endl;
+                exit(1);
+            }
+            transform(dictvec[0].begin(), dictvec[0].end(), dictvec[0].begin(), ::tolower);
+            int winenum = ltfat_str2firwin(dictvec[0].c_str());
+            if (winenum < 0)
+            {
+                cout << "Parse error: Window " << dictvec[0] << " not recognized." << endl;
+                exit(1);
+            }
+            dicts.push_back(make_tuple(dictvec[0], winenum, stoi(dictvec[1]), stoi(dictvec[2])));
+        }
+    }
+    catch (const cxxopts::OptionException& e)
+    {
+        std::cout << "error parsing options: " << e.what() << std::endl;
+        exit(1);
+    }
+
+    vector<Run> runs;
+    ltfat_int L = 0;
+
+    for (const auto& alg : runalgs)
+    {
+        LTFAT_NAME(dgtrealmp_parbuf)* pbuf = NULL;
+        LTFAT_NAME(dgtrealmp_parbuf_init)(&pbuf);
+        auto unipb = uni_ptrdel<LTFAT_NAME(dgtrealmp_parbuf)>(
+        pbuf, [](auto * p) { LTFAT_NAME(dgtrealmp_parbuf_done)(&p); });
+
+        for (auto dict : dicts)
+        {
+            if ( 0 > LTFAT_NAME(dgtrealmp_parbuf_add_firwin)(
+                     pbuf, (LTFAT_FIRWIN)(get<1>(dict)), get<3>(dict), get<2>(dict), get<3>(dict)))
+            {
+                cout << "Bad dictionary: " << get<0>(dict) << "," << get<2>(dict)
+                     << "," << get<3>(dict) << endl;
+                exit(1);
+            }
+        }
+
+        L = LTFAT_NAME(dgtrealmp_getparbuf_siglen)(pbuf, f.size());
+        vector<LTFAT_REAL> fpad(f), fout(L);
+        fpad.resize(L, 0.0);
+
+        LTFAT_NAME(dgtrealmp_setparbuf_phaseconv)(pbuf, LTFAT_TIMEINV);
+        LTFAT_NAME(dgtrealmp_setparbuf_snrdb)(pbuf, targetsnrdb);
+        LTFAT_NAME(dgtrealmp_setparbuf_kernrelthr)(pbuf, kernthr);
+        LTFAT_NAME(dgtrealmp_setparbuf_maxatoms)(pbuf, maxat);
+        LTFAT_NAME(dgtrealmp_setparbuf_maxit)(pbuf, 2 * maxat);
+        LTFAT_NAME(dgtrealmp_setparbuf_iterstep)(pbuf, L);
+        LTFAT_NAME(dgtrealmp_setparbuf_nthreads)(pbuf, nthreads);
+        LTFAT_NAME(dgtrealmp_setparbuf_profile)(pbuf, 1);
+        LTFAT_NAME(dgtrealmp_setparbuf_alg)(pbuf, alg.second);
+
+        vector<unique_ptr<LTFAT_COMPLEX[]>> coef;
+        for (int pidx = 0; pidx < LTFAT_NAME(dgtrealmp_getparbuf_dictno)(pbuf); pidx++ )
+        {
+            ltfat_int clen = LTFAT_NAME(dgtrealmp_getparbuf_coeflen)(pbuf, L, pidx);
+            coef.push_back( unique_ptr<LTFAT_COMPLEX[]>(new LTFAT_COMPLEX[clen]) );
+        }
+
+        Run run{alg.first, 0, 0, 0, -1.0, -1.0, -1.0, 0.0, 0.0, 0.0, 0.0, 0};
+
+        for (int rep = 0; rep < reps; rep++)
+        {
+            // Cached Gram kernels would hide the initialization cost
+            LTFAT_NAME(dgtrealmp_kernel_cache_clear)();
+
+            LTFAT_NAME(dgtrealmp_state)* plan = NULL;
+            auto t1 = Clock::now();
+            int initstatus = LTFAT_NAME(dgtrealmp_init)( pbuf, L, &plan);
+            auto t2 = Clock::now();
+            if (initstatus != LTFATERR_SUCCESS)
+            {
+                cout << "Initialization failed for " << alg.first << endl;
+                exit(1);
+            }
+            auto uniplan = uni_ptrdel<LTFAT_NAME(dgtrealmp_state)>(
+            plan, [](auto * p) { LTFAT_NAME(dgtrealmp_done)(&p); });
+            double tinit = seconds(t1, t2);
+
+            t1 = Clock::now();
+            int status = LTFAT_NAME(dgtrealmp_execute_decompose)(
+                             plan, fpad.data(), (LTFAT_COMPLEX**) coef.data());
+            t2 = Clock::now();
+            double tdecomp = seconds(t1, t2);
+
+            t1 = Clock::now();
+            LTFAT_NAME(dgtrealmp_execute_synthesize)(
+                plan, (const LTFAT_COMPLEX**) coef.data(), NULL, fout.data());
+            t2 = Clock::now();
+            double tsyn = seconds(t1, t2);
+
+            if (run.tdecomp < 0 || tdecomp < run.tdecomp)
+            {
+                run.status = status;
+                run.tinit = tinit;
+                run.tdecomp = tdecomp;
+                run.tsyn = tsyn;
+                LTFAT_NAME(dgtrealmp_get_numatoms)(plan, &run.atoms);
+                LTFAT_NAME(dgtrealmp_get_numiters)(plan, &run.iters);
+                LTFAT_NAME(dgtrealmp_get_stagetimes)(plan, &run.tfindmax,
+                                                     &run.tupdate, &run.tselect);
+                LTFAT_REAL snr;
+                LTFAT_NAME(snr)(fpad.data(), fout.data(), L, &snr);
+                run.snr = snr;
+            }
+        }
+
+        // The peak is process-wide so it grows with the preceding runs
+        run.peakrss = peak_rss_kb();
+        runs.push_back(run);
+    }
+
+    std::ofstream fileStream;
+    if (!outFile.empty())
+    {
+        fileStream.open(outFile);
+        if (!fileStream)
+        {
+            cout << "Cannot open " << outFile << endl;
+            exit(1);
+        }
+    }
+    std::ostream& os = outFile.empty() ? cout : fileStream;
+    os.precision(9);
+
+    os << "{\n"
+       << "  \"library\": \"" << json_escape(ltfat_get_version()->version) << "\",\n"
+#ifdef LTFAT_DOUBLE
+       << "  \"precision\": \"double\",\n"
+#else
+       << "  \"precision\": \"single\",\n"
+#endif
+       << "  \"input\": " << (inFile.empty() ? string("\"synthetic\"") :
+                              "\"" + json_escape(inFile) + "\"") << ",\n"
+       << "  \"L\": " << L << ",\n"
+       << "  \"dictionaries\": " << dicts.size() << ",\n"
+       << "  \"threads\": " << nthreads << ",\n"
+       << "  \"target_snr_db\": " << targetsnrdb << ",\n"
+       << "  \"runs\": [";
+
+    for (size_t rIdx = 0; rIdx < runs.size(); rIdx++)
+    {
+        const Run& r = runs[rIdx];
+        os << (rIdx ? "," : "") << "\n    {\n"
+           << "      \"algorithm\": \"" << r.alg << "\",\n"
+           << "      \"status\": " << r.status << ",\n"
+           << "      \"atoms\": " << r.atoms << ",\n"
+           << "      \"iterations\": " << r.iters << ",\n"
+           << "      \"init_s\": " << r.tinit << ",\n"
+           << "      \"decompose_s\": " << r.tdecomp << ",\n"
+           << "      \"synthesize_s\": " << r.tsyn << ",\n"
+           << "      \"atoms_per_s\": " << (r.tdecomp > 0 ? r.atoms / r.tdecomp : 0.0) << ",\n"
+           << "      \"iterations_per_s\": " << (r.tdecomp > 0 ? r.iters / r.tdecomp : 0.0) << ",\n"
+           << "      \"stages_s\": { \"findmax\": " << r.tfindmax
+           << ", \"update\": " << r.tupdate << ", \"select\": " << r.tselect << " },\n"
+           << "      \"snr_db\": " << r.snr << ",\n"
+           << "      \"peak_rss_kb\": ";
+        if (r.peakrss < 0) os << "null";
+        else               os << r.peakrss;
+        os << "\n    }";
+    }
+
+    os << "\n  ]\n}" << endl;
+
+    return 0;
+}
@@ -88,6 +88,70 @@ LTFAT_NAME(dgtreal_fb_init)(const LTFAT_REAL g[],
                             ltfat_int M, const ltfat_phaseconvention ptype,
                             unsigned flags, LTFAT_NAME(dgtreal_fb_plan)** plan);
 
+/** Set number of frames transformed by a single FFT call
+ *
+ * Frames are gathered to a contiguous buffer of \a blocksize frames and
+ * a single batched FFT is executed for all of them. This reduces the
+ * per-call overhead for short windows. The default block size is
+ * chosen in dgtreal_fb_init depending on \a M. blocksize = 1 transforms
+ * the frames one by one.
+ *
+ * \note This reallocates internal buffers and recreates the FFT plans.
+ *
+ * \param[in]  plan        DGT plan
+ * \param[in]  blocksize   Number of frames in a block
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtreal_fb_set_blocksize_d(ltfat_dgtreal_fb_plan_d* plan, ltfat_int blocksize);
+ *
+ * ltfat_dgtreal_fb_set_blocksize_s(ltfat_dgtreal_fb_plan_s* plan, ltfat_int blocksize);
+ * </tt>
+ *
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a plan was NULL.
+ * LTFATERR_NOTPOSARG       | \a blocksize was less or equal to 0.
+ * LTFATERR_INITFAILED      | FFTW plan creation failed
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(dgtreal_fb_set_blocksize)(LTFAT_NAME(dgtreal_fb_plan)* plan,
+        ltfat_int blocksize);
+
+/** Set number of threads used by the plan
+ *
+ * The blocks of frames are distributed among \a nthreads threads, each of
+ * them having its own FFT plans and buffers. The coefficients do not depend
+ * on the number of threads.
+ * Without OpenMP support compiled in, the plan always runs in the
+ * calling thread.
+ *
+ * \param[in]  plan      DGT plan
+ * \param[in]  nthreads  Number of threads
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtreal_fb_set_nthreads_d(ltfat_dgtreal_fb_plan_d* plan, int nthreads);
+ *
+ * ltfat_dgtreal_fb_set_nthreads_s(ltfat_dgtreal_fb_plan_s* plan, int nthreads);
+ * </tt>
+ *
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a plan was NULL.
+ * LTFATERR_NOTPOSARG       | \a nthreads was less or equal to 0.
+ * LTFATERR_INITFAILED      | FFTW plan creation failed
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(dgtreal_fb_set_nthreads)(LTFAT_NAME(dgtreal_fb_plan)* plan,
+        int nthreads);
+
 /** Execute plan for Discrete Gabor Transform for real signals using the filter bank algorithm
  *
  * \param[in]  plan   DGT plan
@@ -119,6 +183,42 @@ LTFAT_NAME(dgtreal_fb_execute)(LTFAT_NAME(dgtreal_fb_plan)* plan,
                                const LTFAT_REAL f[], ltfat_int L,
                                ltfat_int W, LTFAT_COMPLEX c[]);
 
+/** Execute plan for DGTREAL using the filter bank algorithm with planar coefficients
+ *
+ * The same as dgtreal_fb_execute() except that the real and the imaginary
+ * parts of the coefficients are written to separate arrays directly from
+ * the FFT output.
+ *
+ * \param[in]  plan   DGT plan
+ * \param[in]     f   Input signal, size L x W
+ * \param[in]     L   Signal length
+ * \param[in]     W   Number of channels of the signal
+ * \param[out]   cr   Real part of the coefficients, size M2 x N x W
+ * \param[out]   ci   Imaginary part of the coefficients, size M2 x N x W
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtreal_fb_execute_planar_d(ltfat_dgtreal_fb_plan_d* plan, const double f[],
+ *                                   ltfat_int L, ltfat_int W, double cr[], double ci[]);
+ *
+ * ltfat_dgtreal_fb_execute_planar_s(ltfat_dgtreal_fb_plan_s* plan, const float f[],
+ *                                   ltfat_int L, ltfat_int W, float cr[], float ci[]);
+ * </tt>
+ *
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the following was NULL: \a f, \a cr, \a ci, \a plan
+ * LTFATERR_BADSIZE         | Length of the signal \a L was less or equal to 0.
+ * LTFATERR_BADTRALEN       | \a L must be bigger of equal to \a gl and must be divisible by \a a
+ * LTFATERR_NOTPOSARG       | \a W was less or equal to 0.
+ */
+LTFAT_API int
+LTFAT_NAME(dgtreal_fb_execute_planar)(LTFAT_NAME(dgtreal_fb_plan)* plan,
+                                      const LTFAT_REAL f[], ltfat_int L,
+                                      ltfat_int W, LTFAT_REAL cr[], LTFAT_REAL ci[]);
+
 /** Destroy the plan
  *
  * \param[in]  plan   DGT plan
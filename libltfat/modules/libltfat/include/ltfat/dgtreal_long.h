@@ -97,6 +97,37 @@ LTFAT_NAME(dgtreal_long_init)(const LTFAT_REAL g[],
                               const ltfat_phaseconvention ptype, unsigned flags,
                               LTFAT_NAME(dgtreal_long_plan)** plan);
 
+/** Set number of threads used by the plan
+ *
+ * The iterations of the outermost loop of the factorization algorithm
+ * are distributed among \a nthreads threads, each of them having its own
+ * buffers. There are gcd(a,M) such iterations.
+ * The coefficients do not depend on the number of threads.
+ * Without OpenMP support compiled in, the plan always runs in the
+ * calling thread.
+ *
+ * \param[in]  plan      DGT plan
+ * \param[in]  nthreads  Number of threads
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtreal_long_set_nthreads_d(ltfat_dgtreal_long_plan_d* plan, int nthreads);
+ *
+ * ltfat_dgtreal_long_set_nthreads_s(ltfat_dgtreal_long_plan_s* plan, int nthreads);
+ * </tt>
+ *
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a plan was NULL.
+ * LTFATERR_NOTPOSARG       | \a nthreads was less or equal to 0.
+ * LTFATERR_INITFAILED      | FFTW plan creation failed
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(dgtreal_long_set_nthreads)(LTFAT_NAME(dgtreal_long_plan)* plan, int nthreads);
+
 /** Execute plan for Discrete Gabor Transform for real signals using the factorization algorithm
  *
  * \param[in]  plan   DGT plan
@@ -0,0 +1,225 @@
+typedef struct LTFAT_NAME(dgtreal_olastream_plan) LTFAT_NAME(dgtreal_olastream_plan);
+
+/**
+ *  \addtogroup dgt
+ * @{
+ */
+
+/** \name Streaming DGTREAL using overlap-add
+ *
+ * The signal is passed in chunks of arbitrary length and the coefficients
+ * are read out as soon as they are final. Internally, the signal is
+ * collected into blocks of length \a bl, each block is transformed by the
+ * factorization algorithm and the window tails of the neighbouring blocks
+ * are overlap-added, so only one block of the signal and one block of
+ * coefficients (plus the window overlap) is kept in memory regardless of
+ * the length of the stream.
+ *
+ * The coefficients are those of the signal extended by zeros on both
+ * sides, i.e. the transform is not periodic. Coefficient column n is
+ * centered at sample n*a of the stream and after ltfat_dgtreal_olastream_flush()
+ * exactly ceil(Ltot/a) columns are produced, where Ltot is the total
+ * number of samples pushed.
+ *
+ * Example:
+ * ~~~~~~~~~~~~~~~{.c}
+ * ltfat_dgtreal_olastream_plan_d* p = NULL;
+ * ltfat_dgtreal_olastream_init_d(g, gl, 1, a, M, bl, LTFAT_FREQINV, FFTW_ESTIMATE, &p);
+ *
+ * // Single channel stream
+ * while( (Lread = read_samples(f, Lchunk)) > 0 )
+ * {
+ *     for(ltfat_int Lpos = 0, Lused = 0; Lpos < Lread; Lpos += Lused)
+ *     {
+ *         ltfat_dgtreal_olastream_push_d(p, f + Lpos, Lread - Lpos, &Lused);
+ *         ltfat_dgtreal_olastream_pull_d(p, c, Ncap, &Nout);
+ *         consume_coefficients(c, Nout);
+ *     }
+ * }
+ *
+ * ltfat_dgtreal_olastream_flush_d(p);
+ * do
+ * {
+ *     ltfat_dgtreal_olastream_pull_d(p, c, Ncap, &Nout);
+ *     consume_coefficients(c, Nout);
+ * }
+ * while(Nout > 0);
+ *
+ * ltfat_dgtreal_olastream_done_d(&p);
+ * ~~~~~~~~~~~~~~~
+ * @{ */
+
+/** Initialize plan for the streaming DGTREAL
+ *
+ * \param[in]     g   Window, size gl x 1
+ * \param[in]    gl   Window length
+ * \param[in]     W   Number of channels of the signal
+ * \param[in]     a   Time hop factor
+ * \param[in]     M   Number of frequency channels
+ * \param[in]    bl   Block length
+ * \param[in] ptype   Phase convention
+ * \param[in] flags   FFTW plan flags
+ * \param[out] plan   Streaming DGT plan
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtreal_olastream_init_d(const double g[], ltfat_int gl, ltfat_int W,
+ *                                ltfat_int a, ltfat_int M, ltfat_int bl,
+ *                                const ltfat_phaseconvention ptype, unsigned flags,
+ *                                ltfat_dgtreal_olastream_plan_d** plan);
+ *
+ * ltfat_dgtreal_olastream_init_s(const float g[], ltfat_int gl, ltfat_int W,
+ *                                ltfat_int a, ltfat_int M, ltfat_int bl,
+ *                                const ltfat_phaseconvention ptype, unsigned flags,
+ *                                ltfat_dgtreal_olastream_plan_s** plan);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a g or \a plan was NULL
+ * LTFATERR_BADSIZE         | \a gl was less or equal to 0.
+ * LTFATERR_NOTPOSARG       | At least one of the following was less or equal to zero: \a W, \a a, \a M, \a bl
+ * LTFATERR_BADTRALEN       | \a bl is not divisible by both \a a and \a M.
+ * LTFATERR_INITFAILED      | FFTW plan creation failed
+ * LTFATERR_CANNOTHAPPEN    | \a ptype does not have a valid value from the ltfat_phaseconvention enum
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(dgtreal_olastream_init)(const LTFAT_REAL g[], ltfat_int gl,
+                                   ltfat_int W, ltfat_int a, ltfat_int M,
+                                   ltfat_int bl, const ltfat_phaseconvention ptype,
+                                   unsigned flags,
+                                   LTFAT_NAME(dgtreal_olastream_plan)** plan);
+
+/** Push a chunk of the signal
+ *
+ * The samples are appended to the internal block. Whenever the block is
+ * full and the coefficients of the previous block were pulled, the block
+ * is transformed. If the coefficients were not pulled, the function
+ * accepts only the samples which fit in the block and reports the number
+ * in \a Lused. The remaining samples must be pushed again after calling
+ * ltfat_dgtreal_olastream_pull().
+ *
+ * \param[in]     p   Streaming DGT plan
+ * \param[in]     f   Signal chunk, size L x W
+ * \param[in]     L   Length of the chunk
+ * \param[out] Lused  Number of samples accepted from each channel or NULL
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtreal_olastream_push_d(ltfat_dgtreal_olastream_plan_d* p,
+ *                                const double f[], ltfat_int L, ltfat_int* Lused);
+ *
+ * ltfat_dgtreal_olastream_push_s(ltfat_dgtreal_olastream_plan_s* p,
+ *                                const float f[], ltfat_int L, ltfat_int* Lused);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p or \a f was NULL
+ * LTFATERR_BADSIZE         | \a L was negative
+ * LTFATERR_BADARG          | The stream was already flushed
+ */
+LTFAT_API int
+LTFAT_NAME(dgtreal_olastream_push)(LTFAT_NAME(dgtreal_olastream_plan)* p,
+                                   const LTFAT_REAL f[], ltfat_int L,
+                                   ltfat_int* Lused);
+
+/** Mark the end of the stream
+ *
+ * The partially filled block is padded with zeros and the remaining
+ * coefficients, including the ones influenced only by the window tail,
+ * become available for pulling. No more samples can be pushed until
+ * ltfat_dgtreal_olastream_reset() is called.
+ *
+ * \param[in]     p   Streaming DGT plan
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtreal_olastream_flush_d(ltfat_dgtreal_olastream_plan_d* p);
+ *
+ * ltfat_dgtreal_olastream_flush_s(ltfat_dgtreal_olastream_plan_s* p);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p was NULL
+ */
+LTFAT_API int
+LTFAT_NAME(dgtreal_olastream_flush)(LTFAT_NAME(dgtreal_olastream_plan)* p);
+
+/** Pull the final coefficients
+ *
+ * Copies at most \a Ncap coefficient columns which are final, in order
+ * of their time positions.
+ * The array \a c is treated as M2 x Ncap x W, i.e. the coefficients
+ * of channel w start at c + w*M2*Ncap.
+ *
+ * \param[in]     p   Streaming DGT plan
+ * \param[out]    c   Coefficients, size M2 x Ncap x W
+ * \param[in]  Ncap   Maximum number of columns to copy
+ * \param[out] Nout   Number of columns copied
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtreal_olastream_pull_d(ltfat_dgtreal_olastream_plan_d* p,
+ *                                ltfat_complex_d c[], ltfat_int Ncap, ltfat_int* Nout);
+ *
+ * ltfat_dgtreal_olastream_pull_s(ltfat_dgtreal_olastream_plan_s* p,
+ *                                ltfat_complex_s c[], ltfat_int Ncap, ltfat_int* Nout);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p, \a c or \a Nout was NULL
+ * LTFATERR_BADSIZE         | \a Ncap was negative
+ */
+LTFAT_API int
+LTFAT_NAME(dgtreal_olastream_pull)(LTFAT_NAME(dgtreal_olastream_plan)* p,
+                                   LTFAT_COMPLEX c[], ltfat_int Ncap,
+                                   ltfat_int* Nout);
+
+/** Discard the state and start a new stream
+ *
+ * \param[in]     p   Streaming DGT plan
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtreal_olastream_reset_d(ltfat_dgtreal_olastream_plan_d* p);
+ *
+ * ltfat_dgtreal_olastream_reset_s(ltfat_dgtreal_olastream_plan_s* p);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p was NULL
+ */
+LTFAT_API int
+LTFAT_NAME(dgtreal_olastream_reset)(LTFAT_NAME(dgtreal_olastream_plan)* p);
+
+/** Destroy the plan
+ *
+ * \param[in]     p   Streaming DGT plan
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtreal_olastream_done_d(ltfat_dgtreal_olastream_plan_d** p);
+ *
+ * ltfat_dgtreal_olastream_done_s(ltfat_dgtreal_olastream_plan_s** p);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | p or *p was NULL.
+ */
+LTFAT_API int
+LTFAT_NAME(dgtreal_olastream_done)(LTFAT_NAME(dgtreal_olastream_plan)** p);
+
+/** @}*/
+/** @}*/
@@ -0,0 +1,505 @@
+typedef struct LTFAT_NAME(dgtreal_shear_plan) LTFAT_NAME(dgtreal_shear_plan);
+
+typedef struct LTFAT_NAME(idgtreal_shear_plan) LTFAT_NAME(idgtreal_shear_plan);
+
+typedef struct LTFAT_NAME(dgtreal_shearola_plan) LTFAT_NAME(dgtreal_shearola_plan);
+
+/**
+ *  \addtogroup dgt
+ * @{
+ */
+
+/** \name DGTREAL on non-separable lattices using the shear algorithm
+ *
+ * Real-input counterparts of dgt_shear and dgt_shearola. The lattice
+ * is described by the same shear parameters \a s0, \a s1 and \a br
+ * as for dgt_shear, and the coefficients follow the same layout
+ * (frequency invariant phase), only the first M2=floor(M/2)+1 channels
+ * are kept.
+ *
+ * This only makes sense when the lattice is symmetric with respect to
+ * the zero frequency, so that the remaining channels are complex
+ * conjugates of the kept ones. That is the case for the rectangular
+ * and the quincunx lattices (lt(2)<=2 in the LTFAT notation),
+ * any other lattice is rejected with LTFATERR_NOTSUPPORTED.
+ *
+ * Pairs of real channels are transformed together as one complex
+ * channel, so for W>1 the transform costs about half of dgt_shear
+ * per channel. Rectangular lattices (\a s0 == \a s1 == 0) are
+ * delegated to dgtreal_long.
+ * @{ */
+
+/** Compute DGT of real signals on a non-separable lattice
+ *
+ * \param[in]     f   Input signal, size L x W
+ * \param[in]     g   Window, size L x 1
+ * \param[in]     L   Signal length
+ * \param[in]     W   Number of channels of the signal
+ * \param[in]     a   Time hop factor
+ * \param[in]     M   Number of frequency channels
+ * \param[in]    s0   Frequency shear parameter
+ * \param[in]    s1   Time shear parameter
+ * \param[in]    br   Frequency hop of the sheared rectangular lattice
+ * \param[out]    c   DGT coefficients, size M2 x N x W
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtreal_shear_d(const double f[], const double g[],
+ *                       ltfat_int L, ltfat_int W, ltfat_int a, ltfat_int M,
+ *                       ltfat_int s0, ltfat_int s1, ltfat_int br,
+ *                       ltfat_complex_d c[]);
+ *
+ * ltfat_dgtreal_shear_s(const float f[], const float g[],
+ *                       ltfat_int L, ltfat_int W, ltfat_int a, ltfat_int M,
+ *                       ltfat_int s0, ltfat_int s1, ltfat_int br,
+ *                       ltfat_complex_s c[]);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the following was NULL: \a f, \a g, \a c
+ * LTFATERR_BADSIZE         | Signal length \a L was less or equal to 0.
+ * LTFATERR_NOTPOSARG       | At least one of the following was less or equal to zero: \a W, \a a, \a M, \a br
+ * LTFATERR_BADTRALEN       | \a L is not divisible by both \a a and \a M.
+ * LTFATERR_BADARG          | The shear parameters do not describe a lattice with the given \a a, \a M.
+ * LTFATERR_NOTSUPPORTED    | The lattice is not symmetric with respect to the zero frequency.
+ * LTFATERR_INITFAILED      | FFTW plan creation failed
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(dgtreal_shear)(const LTFAT_REAL f[], const LTFAT_REAL g[],
+                          ltfat_int L, ltfat_int W, ltfat_int a, ltfat_int M,
+                          ltfat_int s0, ltfat_int s1, ltfat_int br,
+                          LTFAT_COMPLEX c[]);
+
+/** Initialize plan for DGT of real signals on a non-separable lattice
+ *
+ * \note \a f and \a c can be NULL if the plan is intended to be used
+ * with the _newarray execute function.
+ *
+ * \param[in]     g   Window, size L x 1
+ * \param[in]     L   Signal length
+ * \param[in]     W   Number of channels of the signal
+ * \param[in]     a   Time hop factor
+ * \param[in]     M   Number of frequency channels
+ * \param[in]    s0   Frequency shear parameter
+ * \param[in]    s1   Time shear parameter
+ * \param[in]    br   Frequency hop of the sheared rectangular lattice
+ * \param[in]     f   Input signal, size L x W or NULL
+ * \param[in]     c   DGT coefficients, size M2 x N x W or NULL
+ * \param[in] flags   FFTW plan flags
+ * \param[out] plan   DGT plan
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtreal_shear_init_d(const double g[], ltfat_int L, ltfat_int W,
+ *                            ltfat_int a, ltfat_int M,
+ *                            ltfat_int s0, ltfat_int s1, ltfat_int br,
+ *                            const double f[], ltfat_complex_d c[],
+ *                            unsigned flags, ltfat_dgtreal_shear_plan_d** plan);
+ *
+ * ltfat_dgtreal_shear_init_s(const float g[], ltfat_int L, ltfat_int W,
+ *                            ltfat_int a, ltfat_int M,
+ *                            ltfat_int s0, ltfat_int s1, ltfat_int br,
+ *                            const float f[], ltfat_complex_s c[],
+ *                            unsigned flags, ltfat_dgtreal_shear_plan_s** plan);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a g or \a plan was NULL
+ * LTFATERR_BADSIZE         | Signal length \a L was less or equal to 0.
+ * LTFATERR_NOTPOSARG       | At least one of the following was less or equal to zero: \a W, \a a, \a M, \a br
+ * LTFATERR_BADTRALEN       | \a L is not divisible by both \a a and \a M.
+ * LTFATERR_BADARG          | The shear parameters do not describe a lattice with the given \a a, \a M.
+ * LTFATERR_NOTSUPPORTED    | The lattice is not symmetric with respect to the zero frequency.
+ * LTFATERR_INITFAILED      | FFTW plan creation failed
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(dgtreal_shear_init)(const LTFAT_REAL g[], ltfat_int L, ltfat_int W,
+                               ltfat_int a, ltfat_int M,
+                               ltfat_int s0, ltfat_int s1, ltfat_int br,
+                               const LTFAT_REAL f[], LTFAT_COMPLEX c[],
+                               unsigned flags,
+                               LTFAT_NAME(dgtreal_shear_plan)** plan);
+
+/** Execute plan for DGT of real signals on a non-separable lattice
+ *
+ * \param[in]  plan   DGT plan
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtreal_shear_execute_d(ltfat_dgtreal_shear_plan_d* plan);
+ *
+ * ltfat_dgtreal_shear_execute_s(ltfat_dgtreal_shear_plan_s* plan);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | The \a plan was NULL or it was created with \a f == NULL or \a c == NULL
+ */
+LTFAT_API int
+LTFAT_NAME(dgtreal_shear_execute)(LTFAT_NAME(dgtreal_shear_plan)* plan);
+
+/** Execute plan for DGT of real signals on a non-separable lattice
+ *
+ * ... on arrays which might not have been used in init.
+ *
+ * \param[in]  plan   DGT plan
+ * \param[in]     f   Input signal, size L x W
+ * \param[out]    c   DGT coefficients, size M2 x N x W
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtreal_shear_execute_newarray_d(ltfat_dgtreal_shear_plan_d* plan,
+ *                                        const double f[], ltfat_complex_d c[]);
+ *
+ * ltfat_dgtreal_shear_execute_newarray_s(ltfat_dgtreal_shear_plan_s* plan,
+ *                                        const float f[], ltfat_complex_s c[]);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the arguments was NULL.
+ */
+LTFAT_API int
+LTFAT_NAME(dgtreal_shear_execute_newarray)(LTFAT_NAME(dgtreal_shear_plan)* plan,
+        const LTFAT_REAL f[], LTFAT_COMPLEX c[]);
+
+/** Destroy the plan
+ *
+ * \param[in]  plan   DGT plan
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtreal_shear_done_d(ltfat_dgtreal_shear_plan_d** plan);
+ *
+ * ltfat_dgtreal_shear_done_s(ltfat_dgtreal_shear_plan_s** plan);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | plan or *plan was NULL.
+ */
+LTFAT_API int
+LTFAT_NAME(dgtreal_shear_done)(LTFAT_NAME(dgtreal_shear_plan)** plan);
+
+/** Compute inverse DGT of real signals on a non-separable lattice
+ *
+ * Channels M2,...,M-1 are taken as the complex conjugates of their
+ * mirror images. The coefficients are projected onto the conjugate
+ * symmetric ones first, i.e. imaginary parts of channels which are
+ * their own mirror images are ignored.
+ *
+ * \param[in]     c   DGT coefficients, size M2 x N x W
+ * \param[in]     g   Synthesis window, size L x 1
+ * \param[in]     L   Signal length
+ * \param[in]     W   Number of channels of the signal
+ * \param[in]     a   Time hop factor
+ * \param[in]     M   Number of frequency channels
+ * \param[in]    s0   Frequency shear parameter
+ * \param[in]    s1   Time shear parameter
+ * \param[in]    br   Frequency hop of the sheared rectangular lattice
+ * \param[out]    f   Output signal, size L x W
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_idgtreal_shear_d(const ltfat_complex_d c[], const double g[],
+ *                        ltfat_int L, ltfat_int W, ltfat_int a, ltfat_int M,
+ *                        ltfat_int s0, ltfat_int s1, ltfat_int br,
+ *                        double f[]);
+ *
+ * ltfat_idgtreal_shear_s(const ltfat_complex_s c[], const float g[],
+ *                        ltfat_int L, ltfat_int W, ltfat_int a, ltfat_int M,
+ *                        ltfat_int s0, ltfat_int s1, ltfat_int br,
+ *                        float f[]);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the following was NULL: \a c, \a g, \a f
+ * LTFATERR_BADSIZE         | Signal length \a L was less or equal to 0.
+ * LTFATERR_NOTPOSARG       | At least one of the following was less or equal to zero: \a W, \a a, \a M, \a br
+ * LTFATERR_BADTRALEN       | \a L is not divisible by both \a a and \a M.
+ * LTFATERR_BADARG          | The shear parameters do not describe a lattice with the given \a a, \a M.
+ * LTFATERR_NOTSUPPORTED    | The lattice is not symmetric with respect to the zero frequency.
+ * LTFATERR_INITFAILED      | FFTW plan creation failed
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(idgtreal_shear)(const LTFAT_COMPLEX c[], const LTFAT_REAL g[],
+                           ltfat_int L, ltfat_int W, ltfat_int a, ltfat_int M,
+                           ltfat_int s0, ltfat_int s1, ltfat_int br,
+                           LTFAT_REAL f[]);
+
+/** Initialize plan for inverse DGT of real signals on a non-separable lattice
+ *
+ * \note \a c and \a f can be NULL if the plan is intended to be used
+ * with the _newarray execute function.
+ *
+ * \param[in]     g   Synthesis window, size L x 1
+ * \param[in]     L   Signal length
+ * \param[in]     W   Number of channels of the signal
+ * \param[in]     a   Time hop factor
+ * \param[in]     M   Number of frequency channels
+ * \param[in]    s0   Frequency shear parameter
+ * \param[in]    s1   Time shear parameter
+ * \param[in]    br   Frequency hop of the sheared rectangular lattice
+ * \param[in]     c   DGT coefficients, size M2 x N x W or NULL
+ * \param[in]     f   Output signal, size L x W or NULL
+ * \param[in] flags   FFTW plan flags
+ * \param[out] plan   IDGT plan
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_idgtreal_shear_init_d(const double g[], ltfat_int L, ltfat_int W,
+ *                             ltfat_int a, ltfat_int M,
+ *                             ltfat_int s0, ltfat_int s1, ltfat_int br,
+ *                             const ltfat_complex_d c[], double f[],
+ *                             unsigned flags, ltfat_idgtreal_shear_plan_d** plan);
+ *
+ * ltfat_idgtreal_shear_init_s(const float g[], ltfat_int L, ltfat_int W,
+ *                             ltfat_int a, ltfat_int M,
+ *                             ltfat_int s0, ltfat_int s1, ltfat_int br,
+ *                             const ltfat_complex_s c[], float f[],
+ *                             unsigned flags, ltfat_idgtreal_shear_plan_s** plan);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a g or \a plan was NULL
+ * LTFATERR_BADSIZE         | Signal length \a L was less or equal to 0.
+ * LTFATERR_NOTPOSARG       | At least one of the following was less or equal to zero: \a W, \a a, \a M, \a br
+ * LTFATERR_BADTRALEN       | \a L is not divisible by both \a a and \a M.
+ * LTFATERR_BADARG          | The shear parameters do not describe a lattice with the given \a a, \a M.
+ * LTFATERR_NOTSUPPORTED    | The lattice is not symmetric with respect to the zero frequency.
+ * LTFATERR_INITFAILED      | FFTW plan creation failed
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(idgtreal_shear_init)(const LTFAT_REAL g[], ltfat_int L, ltfat_int W,
+                                ltfat_int a, ltfat_int M,
+                                ltfat_int s0, ltfat_int s1, ltfat_int br,
+                                const LTFAT_COMPLEX c[], LTFAT_REAL f[],
+                                unsigned flags,
+                                LTFAT_NAME(idgtreal_shear_plan)** plan);
+
+/** Execute plan for inverse DGT of real signals on a non-separable lattice
+ *
+ * \param[in]  plan   IDGT plan
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_idgtreal_shear_execute_d(ltfat_idgtreal_shear_plan_d* plan);
+ *
+ * ltfat_idgtreal_shear_execute_s(ltfat_idgtreal_shear_plan_s* plan);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | The \a plan was NULL or it was created with \a c == NULL or \a f == NULL
+ */
+LTFAT_API int
+LTFAT_NAME(idgtreal_shear_execute)(LTFAT_NAME(idgtreal_shear_plan)* plan);
+
+/** Execute plan for inverse DGT of real signals on a non-separable lattice
+ *
+ * ... on arrays which might not have been used in init.
+ *
+ * \param[in]  plan   IDGT plan
+ * \param[in]     c   DGT coefficients, size M2 x N x W
+ * \param[out]    f   Output signal, size L x W
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_idgtreal_shear_execute_newarray_d(ltfat_idgtreal_shear_plan_d* plan,
+ *                                         const ltfat_complex_d c[], double f[]);
+ *
+ * ltfat_idgtreal_shear_execute_newarray_s(ltfat_idgtreal_shear_plan_s* plan,
+ *                                         const ltfat_complex_s c[], float f[]);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the arguments was NULL.
+ */
+LTFAT_API int
+LTFAT_NAME(idgtreal_shear_execute_newarray)(LTFAT_NAME(idgtreal_shear_plan)* plan,
+        const LTFAT_COMPLEX c[], LTFAT_REAL f[]);
+
+/** Destroy the plan
+ *
+ * \param[in]  plan   IDGT plan
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_idgtreal_shear_done_d(ltfat_idgtreal_shear_plan_d** plan);
+ *
+ * ltfat_idgtreal_shear_done_s(ltfat_idgtreal_shear_plan_s** plan);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | plan or *plan was NULL.
+ */
+LTFAT_API int
+LTFAT_NAME(idgtreal_shear_done)(LTFAT_NAME(idgtreal_shear_plan)** plan);
+
+/** Compute DGT of real signals on a non-separable lattice using overlap-add
+ *
+ * The signal is processed in blocks of length \a bl, each of them
+ * zero-extended by \a gl samples and transformed by dgtreal_shear.
+ * The shear parameters therefore must be valid for length \a bl + \a gl.
+ *
+ * \param[in]     f   Input signal, size L x W
+ * \param[in]     g   Window, size gl x 1
+ * \param[in]     L   Signal length
+ * \param[in]    gl   Window length
+ * \param[in]     W   Number of channels of the signal
+ * \param[in]     a   Time hop factor
+ * \param[in]     M   Number of frequency channels
+ * \param[in]    s0   Frequency shear parameter
+ * \param[in]    s1   Time shear parameter
+ * \param[in]    br   Frequency hop of the sheared rectangular lattice
+ * \param[in]    bl   Block length
+ * \param[out]    c   DGT coefficients, size M2 x N x W
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtreal_shearola_d(const double f[], const double g[],
+ *                          ltfat_int L, ltfat_int gl, ltfat_int W,
+ *                          ltfat_int a, ltfat_int M,
+ *                          ltfat_int s0, ltfat_int s1, ltfat_int br,
+ *                          ltfat_int bl, ltfat_complex_d c[]);
+ *
+ * ltfat_dgtreal_shearola_s(const float f[], const float g[],
+ *                          ltfat_int L, ltfat_int gl, ltfat_int W,
+ *                          ltfat_int a, ltfat_int M,
+ *                          ltfat_int s0, ltfat_int s1, ltfat_int br,
+ *                          ltfat_int bl, ltfat_complex_s c[]);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the following was NULL: \a f, \a g, \a c
+ * LTFATERR_NOTPOSARG       | At least one of the following was less or equal to zero: \a gl, \a bl
+ * LTFATERR_BADTRALEN       | \a L is not divisible by \a bl or \a bl is not divisible by \a a
+ * LTFATERR_BADARG          | \a gl is not divisible by 2*\a a
+ *
+ * and any of the codes returned by dgtreal_shear_init.
+ */
+LTFAT_API int
+LTFAT_NAME(dgtreal_shearola)(const LTFAT_REAL f[], const LTFAT_REAL g[],
+                             ltfat_int L, ltfat_int gl, ltfat_int W,
+                             ltfat_int a, ltfat_int M,
+                             ltfat_int s0, ltfat_int s1, ltfat_int br,
+                             ltfat_int bl, LTFAT_COMPLEX c[]);
+
+/** Initialize plan for overlap-add DGT of real signals on a non-separable lattice
+ *
+ * \param[in]     g   Window, size gl x 1
+ * \param[in]    gl   Window length
+ * \param[in]     W   Number of channels of the signal
+ * \param[in]     a   Time hop factor
+ * \param[in]     M   Number of frequency channels
+ * \param[in]    s0   Frequency shear parameter
+ * \param[in]    s1   Time shear parameter
+ * \param[in]    br   Frequency hop of the sheared rectangular lattice
+ * \param[in]    bl   Block length
+ * \param[in] flags   FFTW plan flags
+ * \param[out] plan   DGT plan
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtreal_shearola_init_d(const double g[], ltfat_int gl, ltfat_int W,
+ *                               ltfat_int a, ltfat_int M,
+ *                               ltfat_int s0, ltfat_int s1, ltfat_int br,
+ *                               ltfat_int bl, unsigned flags,
+ *                               ltfat_dgtreal_shearola_plan_d** plan);
+ *
+ * ltfat_dgtreal_shearola_init_s(const float g[], ltfat_int gl, ltfat_int W,
+ *                               ltfat_int a, ltfat_int M,
+ *                               ltfat_int s0, ltfat_int s1, ltfat_int br,
+ *                               ltfat_int bl, unsigned flags,
+ *                               ltfat_dgtreal_shearola_plan_s** plan);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a g or \a plan was NULL
+ * LTFATERR_NOTPOSARG       | At least one of the following was less or equal to zero: \a gl, \a bl
+ * LTFATERR_BADTRALEN       | \a bl is not divisible by \a a
+ * LTFATERR_BADARG          | \a gl is not divisible by 2*\a a
+ *
+ * and any of the codes returned by dgtreal_shear_init.
+ */
+LTFAT_API int
+LTFAT_NAME(dgtreal_shearola_init)(const LTFAT_REAL g[], ltfat_int gl,
+                                  ltfat_int W, ltfat_int a, ltfat_int M,
+                                  ltfat_int s0, ltfat_int s1, ltfat_int br,
+                                  ltfat_int bl, unsigned flags,
+                                  LTFAT_NAME(dgtreal_shearola_plan)** plan);
+
+/** Execute plan for overlap-add DGT of real signals on a non-separable lattice
+ *
+ * \param[in]  plan   DGT plan
+ * \param[in]     f   Input signal, size L x W
+ * \param[in]     L   Signal length, must be divisible by the block length
+ * \param[out]    c   DGT coefficients, size M2 x N x W
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtreal_shearola_execute_d(ltfat_dgtreal_shearola_plan_d* plan,
+ *                                  const double f[], ltfat_int L,
+ *                                  ltfat_complex_d c[]);
+ *
+ * ltfat_dgtreal_shearola_execute_s(ltfat_dgtreal_shearola_plan_s* plan,
+ *                                  const float f[], ltfat_int L,
+ *                                  ltfat_complex_s c[]);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the arguments was NULL.
+ * LTFATERR_BADTRALEN       | \a L is not a positive multiple of the block length
+ */
+LTFAT_API int
+LTFAT_NAME(dgtreal_shearola_execute)(LTFAT_NAME(dgtreal_shearola_plan)* plan,
+                                     const LTFAT_REAL f[], ltfat_int L,
+                                     LTFAT_COMPLEX c[]);
+
+/** Destroy the plan
+ *
+ * \param[in]  plan   DGT plan
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtreal_shearola_done_d(ltfat_dgtreal_shearola_plan_d** plan);
+ *
+ * ltfat_dgtreal_shearola_done_s(ltfat_dgtreal_shearola_plan_s** plan);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | plan or *plan was NULL.
+ */
+LTFAT_API int
+LTFAT_NAME(dgtreal_shearola_done)(LTFAT_NAME(dgtreal_shearola_plan)** plan);
+
+/** @}*/
+/** @}*/
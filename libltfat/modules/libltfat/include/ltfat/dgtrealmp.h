@@ -5,6 +5,15 @@
 typedef struct LTFAT_NAME(dgtrealmp_state) LTFAT_NAME(dgtrealmp_state);
 typedef struct LTFAT_NAME(dgtrealmp_parbuf) LTFAT_NAME(dgtrealmp_parbuf);
 
+/** Single atom of a sparse DGTREALMP decomposition */
+typedef struct
+{
+    ltfat_int     w; ///< Dictionary index
+    ltfat_int     m; ///< Frequency index, 0 <= m < M2[w]
+    ltfat_int     n; ///< Time index, 0 <= n < N[w]
+    LTFAT_COMPLEX c; ///< Coefficient
+} LTFAT_NAME(dgtrealmp_atom);
+
 #ifndef _LTFAT_DGTREALMP_H
 #define _LTFAT_DGTREALMP_H
 
@@ -88,6 +97,22 @@ LTFAT_API int
 ltfat_dgtmp_setpar_cycles(
         ltfat_dgtmp_params* params, size_t cycles);
 
+LTFAT_API int
+ltfat_dgtmp_setpar_nthreads(
+        ltfat_dgtmp_params* params, int nthreads);
+
+LTFAT_API int
+ltfat_dgtmp_setpar_batchatoms(
+        ltfat_dgtmp_params* params, size_t batchatoms);
+
+LTFAT_API int
+ltfat_dgtmp_setpar_profile(
+        ltfat_dgtmp_params* params, int do_profile);
+
+LTFAT_API int
+ltfat_dgtmp_setpar_redecompose(
+        ltfat_dgtmp_params* params, int do_redecompose);
+
 // LTFAT_API int
 // ltfat_dgtmp_setpar_checkerreverynit(
 //     ltfat_dgtmp_params* p, ltfat_int itstep, double errtoldb);
@@ -273,6 +298,52 @@ LTFAT_API int
 LTFAT_NAME(dgtrealmp_execute_decompose)(
     LTFAT_NAME(dgtrealmp_state)* p, const LTFAT_REAL f[], LTFAT_COMPLEX* c[]);
 
+/** Update a decomposition after a part of the signal was changed
+ *
+ * Atoms whose support intersects samples [start, start + len) are removed
+ * from \a c, the residual is updated only around the changed samples and
+ * the iterations continue until a stopping criterion is met again.
+ * The cost is proportional to the length of the change rather than to L.
+ * When the change influences all the coefficients, the signal is simply
+ * decomposed again.
+ *
+ * The state must be created with dgtrealmp_setparbuf_redecompose() enabled
+ * and hold the decomposition \a c obtained by the last call to
+ * dgtrealmp_execute_decompose() or dgtrealmp_execute_redecompose().
+ * The number of iterations is counted from the start of this call while
+ * the number of atoms refers to the whole decomposition.
+ *
+ * \param[in,out]    p DGTREALMP state
+ * \param[in]     fnew New samples, length \a len
+ * \param[in]    start Index of the first changed sample
+ * \param[in]      len Number of changed samples
+ * \param[in,out]    c Coefficients of the decomposition
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtrealmp_execute_redecompose_d( ltfat_dgtrealmp_state_d* p,
+ *                                        const double fnew[], ltfat_int start,
+ *                                        ltfat_int len, ltfat_complex_d* c[]);
+ *
+ * ltfat_dgtrealmp_execute_redecompose_s( ltfat_dgtrealmp_state_s* p,
+ *                                        const float fnew[], ltfat_int start,
+ *                                        ltfat_int len, ltfat_complex_s* c[]);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the following was NULL: \a p, \a fnew, \a c
+ * LTFATERR_BADARG          | Redecomposition was not enabled or no decomposition was done yet
+ * LTFATERR_NOTPOSARG       | \a len was less or equal to 0
+ * LTFATERR_NOTINRANGE      | The changed samples are not within [0,L)
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_execute_redecompose)(
+    LTFAT_NAME(dgtrealmp_state)* p, const LTFAT_REAL fnew[],
+    ltfat_int start, ltfat_int len, LTFAT_COMPLEX* c[]);
+
 /** Perform Multi-DGTREAL synthesis
  *
  * \param[in,out]        p DGTREALMP state
@@ -304,6 +375,206 @@ LTFAT_API int
 LTFAT_NAME(dgtrealmp_execute_synthesize)(
     LTFAT_NAME(dgtrealmp_state)* p, const LTFAT_COMPLEX* c[], int dict_mask[], LTFAT_REAL f[]);
 
+/** Perform DGTREAL Matching Pursuit decomposition with sparse output
+ *
+ * \param[in,out]      p DGTREALMP state
+ * \param[in]          f Input signal, length L
+ * \param[out]     atoms Output atom list
+ * \param[in]   atomsLen Length of \a atoms
+ * \param[out]   atomsNo Number of atoms written
+ *
+ * Only the nonzero coefficients are returned, ordered by dictionary, time
+ * and frequency. There can not be more of them than the maximum number of
+ * atoms.
+ *
+ * The decomposition itself still works with dense coefficients. On the first
+ * call, the state allocates arrays of the length given by
+ * dgtrealmp_getparbuf_coeflen() for all dictionaries and a list of the
+ * selected positions. They are shared with
+ * dgtrealmp_execute_synthesize_atoms() and released by dgtrealmp_done().
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtrealmp_execute_decompose_atoms_d( ltfat_dgtrealmp_state_d* p,
+ *                                            const double f[],
+ *                                            ltfat_dgtrealmp_atom_d atoms[],
+ *                                            size_t atomsLen, size_t* atomsNo);
+ *
+ * ltfat_dgtrealmp_execute_decompose_atoms_s( ltfat_dgtrealmp_state_s* p,
+ *                                            const float f[],
+ *                                            ltfat_dgtrealmp_atom_s atoms[],
+ *                                            size_t atomsLen, size_t* atomsNo);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the following was NULL: \a p, \a f, \a atoms, \a atomsNo
+ * LTFATERR_BADREQSIZE      | \a atoms is too short
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_execute_decompose_atoms)(
+    LTFAT_NAME(dgtrealmp_state)* p, const LTFAT_REAL f[],
+    LTFAT_NAME(dgtrealmp_atom) atoms[], size_t atomsLen, size_t* atomsNo);
+
+/** Perform Multi-DGTREAL synthesis from an atom list
+ *
+ * \param[in,out]      p DGTREALMP state
+ * \param[in]      atoms Input atom list
+ * \param[in]    atomsNo Number of atoms
+ * \param[out]         f Output signal, length L
+ *
+ * Repeated atoms are summed. The synthesis goes through dense coefficient
+ * arrays of the length given by dgtrealmp_getparbuf_coeflen() for all
+ * dictionaries. They are allocated on the first call and kept in the state
+ * until dgtrealmp_done().
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtrealmp_execute_synthesize_atoms_d( ltfat_dgtrealmp_state_d* p,
+ *                                             const ltfat_dgtrealmp_atom_d atoms[],
+ *                                             size_t atomsNo, double f[]);
+ *
+ * ltfat_dgtrealmp_execute_synthesize_atoms_s( ltfat_dgtrealmp_state_s* p,
+ *                                             const ltfat_dgtrealmp_atom_s atoms[],
+ *                                             size_t atomsNo, float f[]);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the following was NULL: \a p, \a atoms, \a f
+ * LTFATERR_NOTINRANGE      | An atom lies outside of the dictionaries
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_execute_synthesize_atoms)(
+    LTFAT_NAME(dgtrealmp_state)* p, const LTFAT_NAME(dgtrealmp_atom) atoms[],
+    size_t atomsNo, LTFAT_REAL f[]);
+
+/** Extract the nonzero coefficients as an atom list
+ *
+ * \param[in]          p DGTREALMP state
+ * \param[in]          c Input coefficients, array of length equal to the number of dictionaries
+ * \param[out]     atoms Output atom list
+ * \param[in]   atomsLen Length of \a atoms
+ * \param[out]   atomsNo Number of atoms written
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtrealmp_coefs2atoms_d( const ltfat_dgtrealmp_state_d* p,
+ *                                const ltfat_complex_d* c[],
+ *                                ltfat_dgtrealmp_atom_d atoms[],
+ *                                size_t atomsLen, size_t* atomsNo);
+ *
+ * ltfat_dgtrealmp_coefs2atoms_s( const ltfat_dgtrealmp_state_s* p,
+ *                                const ltfat_complex_s* c[],
+ *                                ltfat_dgtrealmp_atom_s atoms[],
+ *                                size_t atomsLen, size_t* atomsNo);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the following was NULL: \a p, \a c, \a atoms, \a atomsNo
+ * LTFATERR_BADREQSIZE      | \a atoms is too short
+ */
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_coefs2atoms)(
+    const LTFAT_NAME(dgtrealmp_state)* p, const LTFAT_COMPLEX* c[],
+    LTFAT_NAME(dgtrealmp_atom) atoms[], size_t atomsLen, size_t* atomsNo);
+
+/** Number of bytes needed by dgtrealmp_atoms_pack()
+ *
+ * The packed stream is little-endian. It consists of a 16 byte header
+ *
+ * Bytes  | Content
+ * -------|--------
+ * 0-3    | Magic "LTMP"
+ * 4      | Format version, currently 1
+ * 5      | Bytes per real number, 4 or 8
+ * 6-7    | Zero
+ * 8-15   | Number of atoms, 64 bit unsigned
+ *
+ * followed by the atoms, each stored as 16 bit dictionary index, 32 bit
+ * frequency index, 32 bit time index and the real and the imaginary part
+ * of the coefficient in IEEE 754 format.
+ *
+ * \param[in]  atomsNo Number of atoms
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtrealmp_atoms_packedlen_d( size_t atomsNo);
+ *
+ * ltfat_dgtrealmp_atoms_packedlen_s( size_t atomsNo);
+ * </tt>
+ * \returns Length of the stream in bytes
+ */
+LTFAT_API size_t
+LTFAT_NAME(dgtrealmp_atoms_packedlen)(size_t atomsNo);
+
+/** Pack atom list into a byte stream
+ *
+ * \param[in]     atoms Atom list
+ * \param[in]   atomsNo Number of atoms
+ * \param[out]      buf Output stream, length dgtrealmp_atoms_packedlen()
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtrealmp_atoms_pack_d( const ltfat_dgtrealmp_atom_d atoms[],
+ *                               size_t atomsNo, unsigned char buf[]);
+ *
+ * ltfat_dgtrealmp_atoms_pack_s( const ltfat_dgtrealmp_atom_s atoms[],
+ *                               size_t atomsNo, unsigned char buf[]);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the following was NULL: \a atoms, \a buf
+ * LTFATERR_NOTINRANGE      | An index does not fit to the stream format
+ */
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_atoms_pack)(
+    const LTFAT_NAME(dgtrealmp_atom) atoms[], size_t atomsNo,
+    unsigned char buf[]);
+
+/** Unpack atom list from a byte stream
+ *
+ * \param[in]       buf Input stream
+ * \param[in]    bufLen Length of \a buf in bytes
+ * \param[out]    atoms Output atom list or NULL
+ * \param[in]  atomsLen Length of \a atoms
+ * \param[out]  atomsNo Number of atoms in the stream
+ *
+ * Streams written in the other precision are converted. With \a atoms
+ * equal to NULL, only \a atomsNo is read.
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtrealmp_atoms_unpack_d( const unsigned char buf[], size_t bufLen,
+ *                                 ltfat_dgtrealmp_atom_d atoms[],
+ *                                 size_t atomsLen, size_t* atomsNo);
+ *
+ * ltfat_dgtrealmp_atoms_unpack_s( const unsigned char buf[], size_t bufLen,
+ *                                 ltfat_dgtrealmp_atom_s atoms[],
+ *                                 size_t atomsLen, size_t* atomsNo);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the following was NULL: \a buf, \a atomsNo
+ * LTFATERR_BADARG          | \a buf does not hold a supported stream
+ * LTFATERR_BADSIZE         | \a buf is truncated
+ * LTFATERR_BADREQSIZE      | \a atoms is too short
+ */
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_atoms_unpack)(
+    const unsigned char buf[], size_t bufLen,
+    LTFAT_NAME(dgtrealmp_atom) atoms[], size_t atomsLen, size_t* atomsNo);
+
 /** @}*/
 
 /***********************************************************************/
@@ -799,6 +1070,125 @@ LTFAT_API int
 LTFAT_NAME(dgtrealmp_setparbuf_pedanticsearch)(
     LTFAT_NAME(dgtrealmp_parbuf)* parbuf, int do_pedantic);
 
+/** Set number of threads
+ *
+ * After each selected atom, the residual coefficients of all dictionaries
+ * are updated and their maxima are refreshed. These per-dictionary
+ * updates are distributed among \a nthreads threads if there is enough
+ * work to offset the synchronization. The decomposition does not depend
+ * on the number of threads.
+ * Without OpenMP support compiled in, everything runs in the calling thread.
+ *
+ * \param[in]     parbuf  DGTREALMP parameter buffer
+ * \param[in]   nthreads  Number of threads
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtrealmp_setparbuf_nthreads_d( ltfat_dgtrealmp_parbuf_d* p,
+ *                                       int nthreads);
+ *
+ * ltfat_dgtrealmp_setparbuf_nthreads_s( ltfat_dgtrealmp_parbuf_s* p,
+ *                                       int nthreads);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the following was NULL: \a p
+ * LTFATERR_NOTPOSARG       | \a nthreads was less or equal to 0.
+ */
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_setparbuf_nthreads)(
+    LTFAT_NAME(dgtrealmp_parbuf)* parbuf, int nthreads);
+
+/** Set maximum number of atoms selected in one MP iteration
+ *
+ * With \a batchatoms > 1, each iteration of the plain MP algorithm takes,
+ * in addition to the largest atom, the next largest atoms whose Gram
+ * kernels do not overlap in time with any atom already selected in the
+ * iteration. Atoms smaller than a fraction of the largest one are not taken.
+ * Non-overlapping atoms do not interact, so their residual updates run
+ * concurrently (see dgtrealmp_setparbuf_nthreads()) and the result stays
+ * close to that of the sequential MP.
+ * Every atom counts as one iteration and a batch never exceeds the
+ * iterations left to run, including those requested by iterstep.
+ *
+ * \param[in]      parbuf  DGTREALMP parameter buffer
+ * \param[in]  batchatoms  Maximum number of atoms per iteration
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtrealmp_setparbuf_batchatoms_d( ltfat_dgtrealmp_parbuf_d* p,
+ *                                         size_t batchatoms);
+ *
+ * ltfat_dgtrealmp_setparbuf_batchatoms_s( ltfat_dgtrealmp_parbuf_s* p,
+ *                                         size_t batchatoms);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the following was NULL: \a p
+ * LTFATERR_NOTPOSARG       | \a batchatoms was 0.
+ */
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_setparbuf_batchatoms)(
+    LTFAT_NAME(dgtrealmp_parbuf)* parbuf, size_t batchatoms);
+
+/** Enable collecting per-stage execution times
+ *
+ * When enabled, the iterations measure the wall-clock time spent searching
+ * for the maximum atom, updating the residual and in the remaining
+ * algorithm-specific work. The times can be retrieved with
+ * dgtrealmp_get_stagetimes(). Disabled by default.
+ *
+ * \param[in]      parbuf  DGTREALMP parameter buffer
+ * \param[in]  do_profile  0 disables, anything else enables profiling
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtrealmp_setparbuf_profile_d( ltfat_dgtrealmp_parbuf_d* p,
+ *                                      int do_profile);
+ *
+ * ltfat_dgtrealmp_setparbuf_profile_s( ltfat_dgtrealmp_parbuf_s* p,
+ *                                      int do_profile);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the following was NULL: \a p
+ */
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_setparbuf_profile)(
+    LTFAT_NAME(dgtrealmp_parbuf)* parbuf, int do_profile);
+
+/** Enable dgtrealmp_execute_redecompose()
+ *
+ * The state then keeps copies of the windows and of the last decomposed
+ * signal, L additional samples in total. Disabled by default.
+ *
+ * \param[in]          parbuf  DGTREALMP parameter buffer
+ * \param[in]  do_redecompose  0 disables, anything else enables redecomposition
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtrealmp_setparbuf_redecompose_d( ltfat_dgtrealmp_parbuf_d* p,
+ *                                          int do_redecompose);
+ *
+ * ltfat_dgtrealmp_setparbuf_redecompose_s( ltfat_dgtrealmp_parbuf_s* p,
+ *                                          int do_redecompose);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the following was NULL: \a p
+ */
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_setparbuf_redecompose)(
+    LTFAT_NAME(dgtrealmp_parbuf)* parbuf, int do_redecompose);
+
 /* TODO:
 LTFAT_API int
 LTFAT_NAME(dgtrealmp_parbuf_mod_chirpmod)(
@@ -898,6 +1288,39 @@ LTFAT_API int
 LTFAT_NAME(dgtrealmp_get_numiters)(
         const LTFAT_NAME(dgtrealmp_state)* p, size_t* iters);
 
+/** Get accumulated per-stage execution times
+ *
+ * The times are only collected when enabled by
+ * dgtrealmp_setparbuf_profile() and are reset together with the state.
+ *
+ * \param[in]         p  DGTREALMP state
+ * \param[out]  findmax  Seconds spent searching for the maximum atom
+ * \param[out]   update  Seconds spent updating the residual
+ * \param[out]   select  Seconds spent in the remaining work of the iterations
+ *                       (atom selection, projections, solving systems)
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtrealmp_get_stagetimes_d( ltfat_dgtrealmp_state_d* p,
+ *                                   double* findmax, double* update,
+ *                                   double* select);
+ *
+ * ltfat_dgtrealmp_get_stagetimes_s( ltfat_dgtrealmp_state_s* p,
+ *                                   double* findmax, double* update,
+ *                                   double* select);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the following was NULL: \a p,
+ *                          | \a findmax, \a update, \a select
+ */
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_get_stagetimes)(
+        const LTFAT_NAME(dgtrealmp_state)* p,
+        double* findmax, double* update, double* select);
+
 /** Get pointer to an array of residual coefficients 
  * 
  * \param[in]        p  DGTREALMP state
@@ -982,6 +1405,109 @@ LTFAT_NAME(dgtrealmp_set_iterstepcallback)(
     LTFAT_NAME(dgtrealmp_state)* p,
     LTFAT_NAME(dgtrealmp_iterstep_callback)* callback, void* userdata);
 /** @}*/
+
+/** \name Gram kernel cache
+ *
+ * ltfat_dgtrealmp_init() computes a Gram kernel for each ordered pair of
+ * dictionaries, which for several long windows can take longer than the
+ * decomposition of a short signal. The kernels are kept in a process-wide
+ * cache keyed by the pair of windows, their hop sizes and numbers of
+ * channels, the phase convention and the kernel threshold. The signal
+ * length only matters when it is shorter than the kernels themselves, so
+ * the kernels are usually shared by states of different lengths.
+ *
+ * The least recently used kernels are evicted whenever their approximate
+ * size exceeds the budget set by ltfat_dgtrealmp_kernel_cache_set_budget()
+ * (16 MiB by default). Each state holds its own copy of the kernels.
+ *
+ * Each precision has its own cache. The functions are thread-safe if
+ * the library was compiled with OpenMP.
+ * @{
+ */
+
+/** Set the memory budget of the cache
+ *
+ * Budget 0 disables the cache.
+ *
+ * \param[in]  bytes  Maximum approximate size of the cached kernels in bytes
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtrealmp_kernel_cache_set_budget_d(size_t bytes);
+ *
+ * ltfat_dgtrealmp_kernel_cache_set_budget_s(size_t bytes);
+ * </tt>
+ * \returns
+ * Status code             | Description
+ * ------------------------|--------------------------
+ * LTFATERR_SUCCESS        | No error occurred
+ */
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_kernel_cache_set_budget)(size_t bytes);
+
+/** Destroy all cached kernels
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtrealmp_kernel_cache_clear_d();
+ *
+ * ltfat_dgtrealmp_kernel_cache_clear_s();
+ * </tt>
+ * \returns
+ * Status code             | Description
+ * ------------------------|--------------------------
+ * LTFATERR_SUCCESS        | No error occurred
+ */
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_kernel_cache_clear)();
+
+/** Save the cached kernels to a file
+ *
+ * The file is binary and can only be read by a library of the same
+ * precision built for the same platform.
+ *
+ * \param[in]  filename  Name of the file
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtrealmp_kernel_cache_export_d(const char* filename);
+ *
+ * ltfat_dgtrealmp_kernel_cache_export_s(const char* filename);
+ * </tt>
+ * \returns
+ * Status code             | Description
+ * ------------------------|--------------------------
+ * LTFATERR_SUCCESS        | No error occurred
+ * LTFATERR_NULLPOINTER    | \a filename was NULL
+ * LTFATERR_FAILED         | The file could not be written
+ */
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_kernel_cache_export)(const char* filename);
+
+/** Add kernels from a file written by ltfat_dgtrealmp_kernel_cache_export()
+ *
+ * Cached kernels with the same parameters are replaced.
+ *
+ * \param[in]  filename  Name of the file
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtrealmp_kernel_cache_import_d(const char* filename);
+ *
+ * ltfat_dgtrealmp_kernel_cache_import_s(const char* filename);
+ * </tt>
+ * \returns
+ * Status code             | Description
+ * ------------------------|--------------------------
+ * LTFATERR_SUCCESS        | No error occurred
+ * LTFATERR_NULLPOINTER    | \a filename was NULL
+ * LTFATERR_FAILED         | The file could not be opened
+ * LTFATERR_BADARG         | The file is damaged or was written by an incompatible library
+ * LTFATERR_NOMEM          | Memory allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_kernel_cache_import)(const char* filename);
+/** @}*/
 /** @}*/
 
 LTFAT_API LTFAT_NAME(dgtreal_plan)**
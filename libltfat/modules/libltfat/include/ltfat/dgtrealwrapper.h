@@ -121,6 +121,73 @@ LTFAT_NAME(dgtreal_execute_ana_newarray)(LTFAT_NAME(dgtreal_plan)* p,
 LTFAT_API int
 LTFAT_NAME(dgtreal_execute_ana)(LTFAT_NAME(dgtreal_plan)* p);
 
+/** Perform DGTREAL analysis with planar coefficients
+ *
+ * The real and imaginary parts of the coefficients are stored in
+ * separate arrays. The filter bank algorithm writes them directly, the
+ * other algorithms go through an interleaved buffer of size M2 x N x W
+ * which the plan allocates on the first planar call.
+ *
+ * M2 = M/2 + 1, N = L/a
+ *
+ * \param[in]    p  Transform plan
+ * \param[in]    f  Input signal, size L x W
+ * \param[out]  cr  Real parts of the coefficients, size M2 x N x W
+ * \param[out]  ci  Imaginary parts of the coefficients, size M2 x N x W
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtreal_execute_ana_planar_d(ltfat_dgtreal_plan_d* p, const double f[],
+ *                                    double cr[], double ci[]);
+ *
+ * ltfat_dgtreal_execute_ana_planar_s(ltfat_dgtreal_plan_s* p, const float f[],
+ *                                    float cr[], float ci[]);
+ * </tt>
+ * \returns
+ * Status code             | Description
+ * ------------------------|--------------------------
+ * LTFATERR_SUCCESS        | No error occurred
+ * LTFATERR_NULLPOINTER    | At least one of the arguments was NULL
+ * LTFATERR_NOMEM          | Signalizes memory allocation error
+ */
+LTFAT_API int
+LTFAT_NAME(dgtreal_execute_ana_planar)(LTFAT_NAME(dgtreal_plan)* p,
+                                       const LTFAT_REAL f[],
+                                       LTFAT_REAL cr[], LTFAT_REAL ci[]);
+
+/** Perform DGTREAL synthesis from planar coefficients
+ *
+ * The filter bank algorithm reads the planar coefficients directly, the
+ * other algorithms go through the interleaved buffer of the plan, which
+ * is allocated on the first planar call.
+ *
+ * M2 = M/2 + 1, N = L/a
+ *
+ * \param[in]    p  Transform plan
+ * \param[in]   cr  Real parts of the coefficients, size M2 x N x W
+ * \param[in]   ci  Imaginary parts of the coefficients, size M2 x N x W
+ * \param[out]   f  Reconstructed signal, size L x W
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtreal_execute_syn_planar_d(ltfat_dgtreal_plan_d* p, const double cr[],
+ *                                    const double ci[], double f[]);
+ *
+ * ltfat_dgtreal_execute_syn_planar_s(ltfat_dgtreal_plan_s* p, const float cr[],
+ *                                    const float ci[], float f[]);
+ * </tt>
+ * \returns
+ * Status code             | Description
+ * ------------------------|--------------------------
+ * LTFATERR_SUCCESS        | No error occurred
+ * LTFATERR_NULLPOINTER    | At least one of the arguments was NULL
+ * LTFATERR_NOMEM          | Signalizes memory allocation error
+ */
+LTFAT_API int
+LTFAT_NAME(dgtreal_execute_syn_planar)(LTFAT_NAME(dgtreal_plan)* p,
+                                       const LTFAT_REAL cr[], const LTFAT_REAL ci[],
+                                       LTFAT_REAL f[]);
+
 /** Destroy transform plan
  *
  * \param[in]   p  Transform plan
@@ -153,6 +220,175 @@ LTFAT_NAME(dgtreal_get_L)(LTFAT_NAME(dgtreal_plan)* p);
 LTFAT_API int
 LTFAT_NAME(dgtreal_get_phaseconv)(LTFAT_NAME(dgtreal_plan)* p);
 /** @} */
+
+/** \name DGTREAL plan cache
+ *
+ * Creating a plan involves computing the dual window, factorizing the
+ * windows and planning the FFTs, which can take much longer than the
+ * transform itself. The cache keeps the plans after they are released
+ * and hands them out again when a plan with the same windows, L, W, a, M
+ * and the same parameters is requested.
+ *
+ * A plan contains work buffers, so it is checked out exclusively by one
+ * caller at a time. When an equal plan is requested while all the
+ * matching plans are in use, a new one is created and cached as well.
+ * Released plans are destroyed in the least recently used order whenever
+ * the approximate memory taken by the cached plans exceeds the budget
+ * set by ltfat_dgtreal_plan_cache_set_budget() (64 MiB by default).
+ *
+ * Each precision has its own cache. The functions are thread-safe if
+ * the library was compiled with OpenMP.
+ *
+ * Example:
+ * ~~~~~~~~~~~~~~~{.c}
+ * ltfat_dgtreal_plan_d* p = NULL;
+ * ltfat_dgtreal_plan_cache_get_d(g, gl, L, W, a, M, NULL, NULL, NULL, &p);
+ * ltfat_dgtreal_execute_ana_newarray_d(p, f, c);
+ * ltfat_dgtreal_plan_cache_release_d(&p);
+ * ~~~~~~~~~~~~~~~
+ * @{ */
+
+/** Get a plan with the canonical dual window from the cache
+ *
+ * The plan is created using ltfat_dgtreal_init() if there is no idle plan
+ * with the same parameters. The plan must be returned using
+ * ltfat_dgtreal_plan_cache_release() and not destroyed by ltfat_dgtreal_done().
+ * \a f and \a c become the arrays used by ltfat_dgtreal_execute_ana() and
+ * ltfat_dgtreal_execute_syn().
+ *
+ * \param[in]      g  Window, size gl x 1
+ * \param[in]     gl  Window length
+ * \param[in]      L  Signal length
+ * \param[in]      W  Number of channels of the signal
+ * \param[in]      a  Time hop factor
+ * \param[in]      M  Number of frequency channels
+ * \param[in]      f  Signal array, size L x W or NULL
+ * \param[in]      c  Coefficient array, size M2 x N x W or NULL
+ * \param[in] params  Optional parameters or NULL
+ * \param[out]     p  Transform plan
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtreal_plan_cache_get_d(const double g[], ltfat_int gl, ltfat_int L,
+ *                                ltfat_int W, ltfat_int a, ltfat_int M,
+ *                                double f[], ltfat_complex_d c[],
+ *                                ltfat_dgt_params* params, ltfat_dgtreal_plan_d** p);
+ *
+ * ltfat_dgtreal_plan_cache_get_s(const float g[], ltfat_int gl, ltfat_int L,
+ *                                ltfat_int W, ltfat_int a, ltfat_int M,
+ *                                float f[], ltfat_complex_s c[],
+ *                                ltfat_dgt_params* params, ltfat_dgtreal_plan_s** p);
+ * </tt>
+ * \returns
+ * The same status codes as ltfat_dgtreal_init() and
+ *
+ * Status code             | Description
+ * ------------------------|--------------------------
+ * LTFATERR_BADSIZE        | \a gl was less or equal to 0.
+ */
+LTFAT_API int
+LTFAT_NAME(dgtreal_plan_cache_get)(const LTFAT_REAL g[], ltfat_int gl,
+                                   ltfat_int L, ltfat_int W, ltfat_int a, ltfat_int M,
+                                   LTFAT_REAL f[], LTFAT_COMPLEX c[],
+                                   ltfat_dgt_params* params,
+                                   LTFAT_NAME(dgtreal_plan)** p);
+
+/** Get a plan with the given analysis and synthesis windows from the cache
+ *
+ * As ltfat_dgtreal_plan_cache_get(), but the plan is created using
+ * ltfat_dgtreal_init_gen().
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtreal_plan_cache_get_gen_d(const double ga[], ltfat_int gal,
+ *                                    const double gs[], ltfat_int gsl,
+ *                                    ltfat_int L, ltfat_int W, ltfat_int a, ltfat_int M,
+ *                                    double f[], ltfat_complex_d c[],
+ *                                    ltfat_dgt_params* params, ltfat_dgtreal_plan_d** p);
+ *
+ * ltfat_dgtreal_plan_cache_get_gen_s(const float ga[], ltfat_int gal,
+ *                                    const float gs[], ltfat_int gsl,
+ *                                    ltfat_int L, ltfat_int W, ltfat_int a, ltfat_int M,
+ *                                    float f[], ltfat_complex_s c[],
+ *                                    ltfat_dgt_params* params, ltfat_dgtreal_plan_s** p);
+ * </tt>
+ * \returns
+ * The same status codes as ltfat_dgtreal_init_gen() and
+ *
+ * Status code             | Description
+ * ------------------------|--------------------------
+ * LTFATERR_NULLPOINTER    | \a ga, \a gs or \a p was NULL
+ * LTFATERR_BADSIZE        | \a gal or \a gsl was less or equal to 0.
+ */
+LTFAT_API int
+LTFAT_NAME(dgtreal_plan_cache_get_gen)(const LTFAT_REAL ga[], ltfat_int gal,
+                                       const LTFAT_REAL gs[], ltfat_int gsl,
+                                       ltfat_int L, ltfat_int W, ltfat_int a, ltfat_int M,
+                                       LTFAT_REAL f[], LTFAT_COMPLEX c[],
+                                       ltfat_dgt_params* params,
+                                       LTFAT_NAME(dgtreal_plan)** p);
+
+/** Return a plan to the cache
+ *
+ * The plan stays cached until it is evicted. *p is set to NULL.
+ *
+ * \param[in,out]  p  Transform plan obtained from the cache
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtreal_plan_cache_release_d(ltfat_dgtreal_plan_d** p);
+ *
+ * ltfat_dgtreal_plan_cache_release_s(ltfat_dgtreal_plan_s** p);
+ * </tt>
+ * \returns
+ * Status code             | Description
+ * ------------------------|--------------------------
+ * LTFATERR_SUCCESS        | No error occurred
+ * LTFATERR_NULLPOINTER    | \a p or *p was NULL
+ * LTFATERR_BADARG         | The plan was not obtained from the cache or was already released
+ */
+LTFAT_API int
+LTFAT_NAME(dgtreal_plan_cache_release)(LTFAT_NAME(dgtreal_plan)** p);
+
+/** Set the memory budget of the cache
+ *
+ * Released plans are evicted immediately if the cache exceeds the new
+ * budget. Budget 0 disables caching of released plans.
+ *
+ * \param[in]  bytes  Maximum approximate size of the cached plans in bytes
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtreal_plan_cache_set_budget_d(size_t bytes);
+ *
+ * ltfat_dgtreal_plan_cache_set_budget_s(size_t bytes);
+ * </tt>
+ * \returns
+ * Status code             | Description
+ * ------------------------|--------------------------
+ * LTFATERR_SUCCESS        | No error occurred
+ */
+LTFAT_API int
+LTFAT_NAME(dgtreal_plan_cache_set_budget)(size_t bytes);
+
+/** Destroy all released plans
+ *
+ * Plans which are in use are kept until they are released.
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtreal_plan_cache_clear_d();
+ *
+ * ltfat_dgtreal_plan_cache_clear_s();
+ * </tt>
+ * \returns
+ * Status code             | Description
+ * ------------------------|--------------------------
+ * LTFATERR_SUCCESS        | No error occurred
+ */
+LTFAT_API int
+LTFAT_NAME(dgtreal_plan_cache_clear)();
+/** @} */
 /** @} */
 
 int
@@ -171,6 +407,18 @@ int
 LTFAT_NAME(dgtreal_fb_execute_wrapper)(void* plan, const LTFAT_REAL* f, ltfat_int L, ltfat_int W,
         LTFAT_COMPLEX* c);
 
+int
+LTFAT_NAME(dgtreal_ola_execute_wrapper)(void* plan, const LTFAT_REAL* f, ltfat_int L, ltfat_int W,
+        LTFAT_COMPLEX* c);
+
+int
+LTFAT_NAME(idgtreal_fb_execute_planar_wrapper)(void* plan, const LTFAT_REAL* cr,
+        const LTFAT_REAL* ci, ltfat_int L, ltfat_int W, LTFAT_REAL* f);
+
+int
+LTFAT_NAME(dgtreal_fb_execute_planar_wrapper)(void* plan, const LTFAT_REAL* f,
+        ltfat_int L, ltfat_int W, LTFAT_REAL* cr, LTFAT_REAL* ci);
+
 int
 LTFAT_NAME(idgtreal_long_done_wrapper)(void** plan);
 
@@ -183,4 +431,7 @@ LTFAT_NAME(idgtreal_fb_done_wrapper)(void** plan);
 int
 LTFAT_NAME(dgtreal_fb_done_wrapper)(void** plan);
 
+int
+LTFAT_NAME(dgtreal_ola_done_wrapper)(void** plan);
+
 
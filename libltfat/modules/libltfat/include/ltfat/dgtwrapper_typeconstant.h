@@ -9,9 +9,10 @@ typedef struct ltfat_dgt_params ltfat_dgt_params;
  * @{ */
 typedef enum
 {
-    ltfat_dgt_auto,
-    ltfat_dgt_long,
-    ltfat_dgt_fb
+    ltfat_dgt_auto,     //!< Choose the algorithm depending on the window lengths
+    ltfat_dgt_long,     //!< Factorization algorithm
+    ltfat_dgt_fb,       //!< Filter bank algorithm
+    ltfat_dgt_autotune  //!< Time the available algorithms, see ltfat_dgt_wisdom_export()
 } ltfat_dgt_hint;
 
 /** \name Parameter setup struct
@@ -66,6 +67,30 @@ ltfat_dgt_setpar_hint(ltfat_dgt_params* params, ltfat_dgt_hint hint);
 LTFAT_API int
 ltfat_dgt_setpar_synoverwrites(ltfat_dgt_params* params, int do_synoverwrites);
 
+/** Set number of threads
+ *
+ * The _fb algorithm distributes blocks of frames and the _long algorithm
+ * distributes the independent subproblems of the window factorization
+ * among \a nthreads threads. With FFTW, the long FFTs of the _long
+ * algorithm are additionally planned with \a nthreads threads.
+ * Default is 1.
+ *
+ * \note Threads are only used if the library was compiled with OpenMP
+ * support (USEOPENMP), otherwise the parameter is ignored.
+ *
+ * \returns
+ * Status code          |  Description
+ * ---------------------|----------------
+ * LTFATERR_SUCESS      |  No error occured
+ * LTFATERR_NULLPOINTER |  \a params was NULL
+ * LTFATERR_NOTPOSARG   |  \a nthreads was not positive
+ */
+LTFAT_API int
+ltfat_dgt_setpar_nthreads(ltfat_dgt_params* params, int nthreads);
+
+LTFAT_API int
+ltfat_dgt_getpar_nthreads(ltfat_dgt_params* params);
+
 /** Destroy struct
  *
  * \returns
@@ -77,6 +102,71 @@ ltfat_dgt_setpar_synoverwrites(ltfat_dgt_params* params, int do_synoverwrites);
 LTFAT_API int
 ltfat_dgt_params_free(ltfat_dgt_params* params);
 
+/** @} */
+
+/** \name Autotuning wisdom
+ *
+ * With the ltfat_dgt_autotune hint, the plan creation times all algorithms
+ * applicable to the actual sizes (_fb, _long and, for long signals and
+ * suitable windows, the block-wise OLA analysis) and picks the fastest
+ * for the analysis and for the synthesis separately.
+ * The decision is remembered in a process-wide table keyed by the
+ * transform, the precision, L, W, a, M, the window lengths, the phase
+ * convention and the number of threads, such that subsequent plans with
+ * the same parameters are created without timing.
+ *
+ * Like the FFTW wisdom, the table can be saved to a file and loaded
+ * in another process. Entries which do not apply to the sizes they are
+ * stored with, e.g. from a file written by a different library version,
+ * are ignored and replaced by a new timing.
+ *
+ * The table is thread-safe if the library was compiled with OpenMP.
+ * Otherwise, plans with the ltfat_dgt_autotune hint must not be created
+ * concurrently with each other or with the functions below.
+ *
+ * \note Timing runs the transforms several times on temporary arrays
+ * of the full size, which can take considerably longer than the
+ * plan creation itself.
+ * @{ */
+
+/** Save the autotuning decisions to a text file
+ *
+ * \param[in] filename  File name
+ *
+ * \returns
+ * Status code          |  Description
+ * ---------------------|----------------
+ * LTFATERR_SUCESS      |  No error occured
+ * LTFATERR_NULLPOINTER |  \a filename was NULL
+ * LTFATERR_FAILED      |  The file could not be written
+ */
+LTFAT_API int
+ltfat_dgt_wisdom_export(const char* filename);
+
+/** Load autotuning decisions from a file written by ltfat_dgt_wisdom_export()
+ *
+ * The decisions are merged into the current table, entries from the file
+ * replace the existing ones with the same parameters.
+ *
+ * \param[in] filename  File name
+ *
+ * \returns
+ * Status code          |  Description
+ * ---------------------|----------------
+ * LTFATERR_SUCESS      |  No error occured
+ * LTFATERR_NULLPOINTER |  \a filename was NULL
+ * LTFATERR_FAILED      |  The file could not be read
+ * LTFATERR_BADARG      |  The file is malformed
+ * LTFATERR_NOMEM       |  Memory allocation failed
+ */
+LTFAT_API int
+ltfat_dgt_wisdom_import(const char* filename);
+
+/** Forget all autotuning decisions
+ */
+LTFAT_API void
+ltfat_dgt_wisdom_forget(void);
+
 /** @} */
 /** @} */
 
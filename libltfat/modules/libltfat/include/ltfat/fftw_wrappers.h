@@ -77,3 +77,49 @@ LTFAT_NAME(ifftreal_execute_newarray)(LTFAT_NAME(ifftreal_plan)* p,
 
 LTFAT_API int
 LTFAT_NAME(ifftreal_done)(LTFAT_NAME(ifftreal_plan)** p);
+
+/* Number of threads used by the FFT plans created afterwards.
+ * Only has an effect with the FFTW backend compiled with OpenMP support.
+ * Like the FFTW planner itself, this is not thread safe. */
+LTFAT_API int
+LTFAT_NAME(fft_plan_with_nthreads)(int nthreads);
+
+/* Number of threads set by the last fft_plan_with_nthreads() call, 1 if
+ * it was never called. Calls to the FFT library made directly are not
+ * seen. */
+LTFAT_API int
+LTFAT_NAME(fft_planner_nthreads)(void);
+
+/* Native real FFT of power-of-two lengths
+ *
+ * The real signal of length L is transformed as a complex signal of
+ * length L/2 using radix-4 (and one radix-2) Stockham stages working on
+ * separate real and imaginary arrays, which vectorize without permutes.
+ * Both transforms are unnormalized and can work inplace. The KISS backend
+ * uses it for fftreal and ifftreal of such lengths, with any backend it
+ * can be called directly.
+ */
+
+#ifndef LTFAT_FFTREAL_POW2_MINL
+/* Shorter transforms are left to KISS FFT */
+#define LTFAT_FFTREAL_POW2_MINL 16
+#endif
+
+typedef struct LTFAT_NAME(fftreal_pow2_plan) LTFAT_NAME(fftreal_pow2_plan);
+
+/* L must be a power of two and at least LTFAT_FFTREAL_POW2_MINL */
+LTFAT_API int
+LTFAT_NAME(fftreal_pow2_init)(ltfat_int L, LTFAT_NAME(fftreal_pow2_plan)** p);
+
+/* in: L, out: L/2 + 1 */
+LTFAT_API void
+LTFAT_NAME(fftreal_pow2_execute)(LTFAT_NAME(fftreal_pow2_plan)* p,
+                                 const LTFAT_REAL in[], LTFAT_COMPLEX out[]);
+
+/* in: L/2 + 1, out: L. Imaginary parts of in[0] and in[L/2] are ignored. */
+LTFAT_API void
+LTFAT_NAME(ifftreal_pow2_execute)(LTFAT_NAME(fftreal_pow2_plan)* p,
+                                  const LTFAT_COMPLEX in[], LTFAT_REAL out[]);
+
+LTFAT_API int
+LTFAT_NAME(fftreal_pow2_done)(LTFAT_NAME(fftreal_pow2_plan)** p);
@@ -89,6 +89,70 @@ LTFAT_NAME(idgtreal_fb_init)(const LTFAT_REAL g[], ltfat_int gl,
                              ltfat_int a, ltfat_int M, const ltfat_phaseconvention ptype,
                              unsigned flags, LTFAT_NAME(idgtreal_fb_plan)** plan);
 
+/** Set number of frames transformed by a single IFFT call
+ *
+ * Frames are gathered to a contiguous buffer of \a blocksize frames and
+ * a single batched IFFT is executed for all of them. This reduces the
+ * per-call overhead for short windows. The default block size is
+ * chosen in idgtreal_fb_init depending on \a M. blocksize = 1 transforms
+ * the frames one by one.
+ *
+ * \note This reallocates internal buffers and recreates the FFT plans.
+ *
+ * \param[in]  plan        DGT plan
+ * \param[in]  blocksize   Number of frames in a block
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_idgtreal_fb_set_blocksize_d(ltfat_idgtreal_fb_plan_d* plan, ltfat_int blocksize);
+ *
+ * ltfat_idgtreal_fb_set_blocksize_s(ltfat_idgtreal_fb_plan_s* plan, ltfat_int blocksize);
+ * </tt>
+ *
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a plan was NULL.
+ * LTFATERR_NOTPOSARG       | \a blocksize was less or equal to 0.
+ * LTFATERR_INITFAILED      | FFTW plan creation failed
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(idgtreal_fb_set_blocksize)(LTFAT_NAME(idgtreal_fb_plan)* plan,
+        ltfat_int blocksize);
+
+/** Set number of threads used by the plan
+ *
+ * The inverse FFTs and windowing of the blocks of frames are distributed
+ * among \a nthreads threads. The overlap-add is done in the order of the
+ * blocks, therefore the output does not depend on the number of threads.
+ * Without OpenMP support compiled in, the plan always runs in the
+ * calling thread.
+ *
+ * \param[in]  plan      IDGT plan
+ * \param[in]  nthreads  Number of threads
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_idgtreal_fb_set_nthreads_d(ltfat_idgtreal_fb_plan_d* plan, int nthreads);
+ *
+ * ltfat_idgtreal_fb_set_nthreads_s(ltfat_idgtreal_fb_plan_s* plan, int nthreads);
+ * </tt>
+ *
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a plan was NULL.
+ * LTFATERR_NOTPOSARG       | \a nthreads was less or equal to 0.
+ * LTFATERR_INITFAILED      | FFTW plan creation failed
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(idgtreal_fb_set_nthreads)(LTFAT_NAME(idgtreal_fb_plan)* plan,
+        int nthreads);
+
 LTFAT_API int
 LTFAT_NAME(idgtreal_fb_set_overwriteoutarray)(
     LTFAT_NAME(idgtreal_fb_plan)* p, int do_overwriteoutarray);
@@ -123,6 +187,43 @@ LTFAT_API int
 LTFAT_NAME(idgtreal_fb_execute)(LTFAT_NAME(idgtreal_fb_plan)* plan, const LTFAT_COMPLEX c[],
                                 ltfat_int L, ltfat_int W, LTFAT_REAL f[]);
 
+/** Execute plan for IDGTREAL using the filter bank algorithm with planar coefficients
+ *
+ * The same as idgtreal_fb_execute() except that the real and the imaginary
+ * parts of the coefficients are read from separate arrays directly into
+ * the FFT input.
+ *
+ * \param[in]  plan   DGT plan
+ * \param[in]    cr   Real part of the coefficients, size M2 x N x W
+ * \param[in]    ci   Imaginary part of the coefficients, size M2 x N x W
+ * \param[in]     L   Signal length
+ * \param[in]     W   Number of channels of the signal
+ * \param[out]    f   Output signal, size L x W
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_idgtreal_fb_execute_planar_d(ltfat_idgtreal_fb_plan_d* plan, const double cr[],
+ *                                    const double ci[], ltfat_int L, ltfat_int W,
+ *                                    double f[]);
+ *
+ * ltfat_idgtreal_fb_execute_planar_s(ltfat_idgtreal_fb_plan_s* plan, const float cr[],
+ *                                    const float ci[], ltfat_int L, ltfat_int W,
+ *                                    float f[]);
+ * </tt>
+ *
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the following was NULL: \a f, \a cr, \a ci, \a plan
+ * LTFATERR_BADTRALEN       | \a L must be bigger or equal to \a gl and must be divisible by \a a
+ * LTFATERR_NOTPOSARG       | \a W was less or equal to 0.
+ */
+LTFAT_API int
+LTFAT_NAME(idgtreal_fb_execute_planar)(LTFAT_NAME(idgtreal_fb_plan)* plan,
+                                       const LTFAT_REAL cr[], const LTFAT_REAL ci[],
+                                       ltfat_int L, ltfat_int W, LTFAT_REAL f[]);
+
 /** Destroy the plan
  *
  * \param[in]  plan   DGT plan
@@ -101,6 +101,37 @@ LTFAT_API int
 LTFAT_NAME(idgtreal_long_set_overwriteoutarray)(
     LTFAT_NAME(idgtreal_long_plan)* p, int do_overwriteoutarray);
 
+/** Set number of threads used by the plan
+ *
+ * The iterations of the outermost loop of the factorization algorithm
+ * are distributed among \a nthreads threads, each of them having its own
+ * buffers. There are gcd(a,M) such iterations.
+ * The output does not depend on the number of threads.
+ * Without OpenMP support compiled in, the plan always runs in the
+ * calling thread.
+ *
+ * \param[in]  plan      IDGT plan
+ * \param[in]  nthreads  Number of threads
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_idgtreal_long_set_nthreads_d(ltfat_idgtreal_long_plan_d* plan, int nthreads);
+ *
+ * ltfat_idgtreal_long_set_nthreads_s(ltfat_idgtreal_long_plan_s* plan, int nthreads);
+ * </tt>
+ *
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a plan was NULL.
+ * LTFATERR_NOTPOSARG       | \a nthreads was less or equal to 0.
+ * LTFATERR_INITFAILED      | FFTW plan creation failed
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(idgtreal_long_set_nthreads)(LTFAT_NAME(idgtreal_long_plan)* plan, int nthreads);
+
 /** Execute plan for Inverse Discrete Gabor Transform for real signals using the factorization algorithm
  *
  * \param[in]  plan   IDGT plan
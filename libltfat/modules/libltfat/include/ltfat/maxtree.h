@@ -14,6 +14,12 @@ LTFAT_NAME(maxtree_init)(
     ltfat_int L, ltfat_int Lstep, ltfat_int depth,
     LTFAT_NAME(maxtree)** p);
 
+/* Same as maxtree_init, but nodes have 16 children and the levels are
+ * stored in a single buffer aligned to cache lines. The depth is
+ * chosen automatically. Block maxima are computed using SIMD. */
+LTFAT_API int
+LTFAT_NAME(maxtree_initblocked)(
+    ltfat_int L, ltfat_int Lstep, LTFAT_NAME(maxtree)** p);
 
 LTFAT_API int
 LTFAT_NAME(maxtree_initwitharray)(
@@ -46,6 +52,11 @@ LTFAT_NAME(maxtree_done)(LTFAT_NAME(maxtree)** p);
 int
 LTFAT_NAME(maxtree_updatedirty)(LTFAT_NAME(maxtree)* p);
 
+/* Up to 4 disjoint ranges covered by getdirty. Returns their number. */
+ltfat_int
+LTFAT_NAME(maxtree_getdirtyranges)(
+    LTFAT_NAME(maxtree)* p, const ltfat_int** starts, const ltfat_int** ends);
+
 int
 LTFAT_NAME(maxtree_updaterange)(
     LTFAT_NAME(maxtree)* p, ltfat_int start, ltfat_int stop);
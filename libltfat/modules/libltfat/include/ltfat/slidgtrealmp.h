@@ -14,7 +14,13 @@ typedef int LTFAT_NAME(slidgtrealmp_niter_callback)(void* userdata,
 /* \addtogroup slidgtrealmp
  * @{ */
 
-/** 
+/** Called with the coefficients of every decomposed slice
+ *
+ * When set, the callback replaces the synthesis of the slice and it must
+ * write the winLen = \a L samples of the slice to \a f. \a cres holds the
+ * residual and \a c the selected coefficients of the \a P dictionaries.
+ * In the pipelined mode, the callback can be called concurrently from
+ * several threads, each with a different \a mpstate.
  */
 typedef int LTFAT_NAME(slidgtrealmp_processor_callback)(
         void* userdata, LTFAT_NAME(dgtrealmp_state)* mpstate,
@@ -37,10 +43,27 @@ LTFAT_NAME(slidgtrealmp_execute)(
 LTFAT_API int
 LTFAT_NAME(slidgtrealmp_done)(LTFAT_NAME(slidgtrealmp_state)** p);
 
+/** Clear the processor so that a new stream can be processed
+ *
+ * All buffered samples and the slices pending in the pipeline are
+ * discarded.
+ */
 LTFAT_API int
 LTFAT_NAME(slidgtrealmp_reset)(
         LTFAT_NAME(slidgtrealmp_state)* p);
 
+/** Output the samples still held by the processor
+ *
+ * Processes slidgtrealmp_getprocdelay() samples of silence so that \a out
+ * receives the output belonging to the end of the stream, including the
+ * last pipeLen - 1 slices of the pipelined mode. Each channel of \a out
+ * must hold slidgtrealmp_getprocdelay() samples. Call slidgtrealmp_reset()
+ * before processing another stream.
+ */
+LTFAT_API int
+LTFAT_NAME(slidgtrealmp_flush)(
+        LTFAT_NAME(slidgtrealmp_state)* p, ltfat_int chanNo, LTFAT_REAL* out[]);
+
 LTFAT_API int
 LTFAT_NAME(slidgtrealmp_setcallback)(LTFAT_NAME(slidgtrealmp_state)* p,
         LTFAT_NAME(slidgtrealmp_processor_callback)* callback,
@@ -49,6 +72,24 @@ LTFAT_NAME(slidgtrealmp_setcallback)(LTFAT_NAME(slidgtrealmp_state)* p,
 
 /** \name Advanced interface
  * @{ */
+
+/** Initialize sliding MP decomposing several slices concurrently
+ *
+ * As slidgtrealmp_init(), but the slices are collected in groups of
+ * \a pipeLen and the group is decomposed in parallel, each slice with its
+ * own dgtrealmp state. This adds (pipeLen - 1) slice hops to the
+ * processing delay reported by slidgtrealmp_getprocdelay(). The output is
+ * otherwise the same as with pipeLen = 1, which is equivalent to
+ * slidgtrealmp_init().
+ *
+ * Parallel processing requires the library to be compiled with OpenMP.
+ */
+LTFAT_API int
+LTFAT_NAME(slidgtrealmp_init_pipelined)(
+    LTFAT_NAME(dgtrealmp_parbuf)* pb, ltfat_int L,
+    ltfat_int numChans, ltfat_int bufLenMax, ltfat_int pipeLen,
+    LTFAT_NAME(slidgtrealmp_state)** pout);
+
 LTFAT_API int
 LTFAT_NAME(slidgtrealmp_init_fromstates)(
     LTFAT_NAME(dgtrealmp_state)* mpstate,
@@ -72,3 +113,11 @@ int
 LTFAT_NAME(slidgtrealmp_execute_callback)(void* userdata,
         const LTFAT_REAL in[], int winLen, int taperLen, 
         int zpadLen, int W, LTFAT_REAL out[]);
+
+int
+LTFAT_NAME(slidgtrealmp_execute_pipelined)(
+    LTFAT_NAME(slidgtrealmp_state)* p, const LTFAT_REAL in[], int winLen,
+    int W, LTFAT_REAL out[]);
+
+ltfat_int
+LTFAT_NAME(slidgtrealmp_getpipedelay)( LTFAT_NAME(slidgtrealmp_state)* p);
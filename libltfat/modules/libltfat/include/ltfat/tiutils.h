@@ -196,6 +196,59 @@ LTFAT_NAME(real2complex_array)(const LTFAT_REAL in[], ltfat_int L, LTFAT_COMPLEX
 LTFAT_API int
 LTFAT_NAME(complex2real_array)(const LTFAT_COMPLEX in[], ltfat_int L, LTFAT_REAL out[]);
 
+/** Complex array to separate real and imaginary arrays
+ *
+ * Planar (split-complex) arrays allow kernels working on magnitudes
+ * and phases to run without deinterleaving.
+ *
+ * \param[in]     in  Input array
+ * \param[in]      L  Length of arrays
+ * \param[out]    re  Real parts
+ * \param[out]    im  Imaginary parts
+ *
+ *  #### Function versions ####
+ *  <tt>
+ *  ltfat_complex2planar_array_d(const ltfat_complex_d in[], ltfat_int L, double re[], double im[]);
+ *
+ *  ltfat_complex2planar_array_s(const ltfat_complex_s in[], ltfat_int L, float re[], float im[]);
+ *  </tt>
+ *
+ * \returns
+ * Status code           | Description
+ * ----------------------|--------------------------------------------
+ * LTFATERR_SUCCESS      | Indicates no error
+ * LTFATERR_NULLPOINTER  | Either of the arrays is NULL
+ * LTFATERR_BADSIZE      | Length of the arrays is less or equal to 0.
+ */
+LTFAT_API int
+LTFAT_NAME(complex2planar_array)(const LTFAT_COMPLEX in[], ltfat_int L,
+                                 LTFAT_REAL re[], LTFAT_REAL im[]);
+
+/** Separate real and imaginary arrays to complex array
+ *
+ * \param[in]     re  Real parts
+ * \param[in]     im  Imaginary parts
+ * \param[in]      L  Length of arrays
+ * \param[out]   out  Output array
+ *
+ *  #### Function versions ####
+ *  <tt>
+ *  ltfat_planar2complex_array_d(const double re[], const double im[], ltfat_int L, ltfat_complex_d out[]);
+ *
+ *  ltfat_planar2complex_array_s(const float re[], const float im[], ltfat_int L, ltfat_complex_s out[]);
+ *  </tt>
+ *
+ * \returns
+ * Status code           | Description
+ * ----------------------|--------------------------------------------
+ * LTFATERR_SUCCESS      | Indicates no error
+ * LTFATERR_NULLPOINTER  | Either of the arrays is NULL
+ * LTFATERR_BADSIZE      | Length of the arrays is less or equal to 0.
+ */
+LTFAT_API int
+LTFAT_NAME(planar2complex_array)(const LTFAT_REAL re[], const LTFAT_REAL im[],
+                                 ltfat_int L, LTFAT_COMPLEX out[]);
+
 /** Convert coefficients from the dgtreal format to the dgt format
  * 
  * \param[in]     cdgtreal  Input array
@@ -88,6 +88,15 @@ ltfat_posnumfastmod(ltfat_int a, ltfat_int b);
 LTFAT_API ltfat_int
 ltfat_rangelimit(ltfat_int a, ltfat_int amin, ltfat_int amax);
 
+/** Reads a monotonic clock
+ *
+ * The absolute value is meaningless, only differences of two readings are.
+ *
+ * \returns Time in nanoseconds
+ */
+LTFAT_API long long
+ltfat_monotonic_ns(void);
+
 // Custom headers are down here
 #include "reassign_typeconstant.h"
 
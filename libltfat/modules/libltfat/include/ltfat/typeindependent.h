@@ -4,9 +4,11 @@
 #include "dgtreal_long.h"
 #include "idgtreal_long.h"
 #include "dgtreal_fb.h"
+#include "dgtreal_olastream.h"
 #include "idgtreal_fb.h"
 #include "dgt_multi.h"
 #include "dgt_shear.h"
+#include "dgtreal_shear.h"
 #include "tiutils.h"
 #include "circularbuf.h"
 #include "slicingbuf.h"
@@ -598,7 +600,7 @@ LTFAT_NAME(dgtreal_ola_init)(const LTFAT_REAL *g, ltfat_int gl,
                              const ltfat_phaseconvention ptype,
                              unsigned flags);
 
-LTFAT_API void
+LTFAT_API int
 LTFAT_NAME(dgtreal_ola_execute)(const LTFAT_NAME(dgtreal_ola_plan) plan,
                                 const LTFAT_REAL *f, ltfat_int L,
                                 LTFAT_COMPLEX *cout);
@@ -454,6 +454,7 @@ LTFAT_NAME(analysis_fifo_init)(ltfat_int fifoLen, ltfat_int procDelay,
 
     p->bufLen = fifoLen + 1;
     p->hop = hop; p->winLen = winLen; p->readIdx = fifoLen + 1 - (procDelay);
+    p->procDelay = procDelay;
     p->numChans = numChans;
     p->readchanstride = winLen;
 
@@ -518,6 +519,8 @@ LTFAT_NAME(analysis_fifo_reset)(LTFAT_NAME(analysis_fifo_state)* p)
     CHECKNULL(p);
 
     memset(p->buf, 0, p->numChans * p->bufLen * sizeof * p->buf);
+    p->readIdx = p->bufLen - p->procDelay;
+    p->writeIdx = 0;
 
     return LTFATERR_SUCCESS;
 error:
@@ -681,6 +684,8 @@ LTFAT_NAME(synthesis_fifo_reset)(LTFAT_NAME(synthesis_fifo_state)* p)
     CHECKNULL(p);
 
     memset(p->buf, 0, p->numChans * p->bufLen * sizeof * p->buf);
+    p->readIdx = 0;
+    p->writeIdx = 0;
 
     return LTFATERR_SUCCESS;
 error:
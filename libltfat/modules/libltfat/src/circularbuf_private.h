@@ -10,6 +10,7 @@ struct LTFAT_NAME(analysis_fifo_state)
     ltfat_int bufLen; //!< Length of the previous
     ltfat_int readIdx; //!< Read pos.
     ltfat_int writeIdx; //!< Write pos.
+    ltfat_int procDelay; //!< Initial distance of readIdx behind writeIdx
     ltfat_int numChans;
 };
 
@@ -154,6 +154,7 @@ LTFAT_NAME(dgtreal_ola_init)(const LTFAT_REAL* g, ltfat_int gl,
 
     LTFAT_NAME(dgtreal_ola_plan) plan;
 
+    plan.plan = NULL;
     plan.bl = bl;
     plan.gl = gl;
     plan.W  = W;
@@ -192,12 +193,13 @@ LTFAT_NAME(dgtreal_ola_init)(const LTFAT_REAL* g, ltfat_int gl,
 
 
 
-LTFAT_API void
+LTFAT_API int
 LTFAT_NAME(dgtreal_ola_execute)(const LTFAT_NAME(dgtreal_ola_plan) plan,
                                 const LTFAT_REAL* f, ltfat_int L,
                                 LTFAT_COMPLEX* cout)
 
 {
+    int status = LTFATERR_SUCCESS;
     ltfat_int bl      = plan.bl;
     ltfat_int gl      = plan.gl;
     ltfat_int a       = plan.plan->a;
@@ -211,6 +213,9 @@ LTFAT_NAME(dgtreal_ola_execute)(const LTFAT_NAME(dgtreal_ola_plan) plan,
     ltfat_int W       = plan.W;
     ltfat_int M2      = M / 2 + 1;
 
+    CHECKNULL(f); CHECKNULL(cout);
+    CHECK(LTFATERR_BADTRALEN, !(L % bl), "L must be divisible by bl=%td.", bl);
+
     /* Zero the output array, as we will be adding to it */
     for (ltfat_int ii = 0; ii < M2 * N * W; ii++)
     {
@@ -229,7 +234,7 @@ LTFAT_NAME(dgtreal_ola_execute)(const LTFAT_NAME(dgtreal_ola_plan) plan,
         }
 
         /* Execute the short DGTREAL */
-        LTFAT_NAME(dgtreal_long_execute)(plan.plan);
+        CHECKSTATUS( LTFAT_NAME(dgtreal_long_execute)(plan.plan));
 
         /* Place the results */
         for (ltfat_int w = 0; w < W; w++)
@@ -276,6 +281,8 @@ LTFAT_NAME(dgtreal_ola_execute)(const LTFAT_NAME(dgtreal_ola_plan) plan,
         }
 
     }
+error:
+    return status;
 }
 
 
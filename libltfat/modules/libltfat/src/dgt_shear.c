@@ -48,6 +48,7 @@ LTFAT_NAME(dgt_shear_init)(const LTFAT_COMPLEX* f, const LTFAT_COMPLEX* g,
                            unsigned flags)
 {
     LTFAT_NAME(dgt_shear_plan) plan;
+    memset(&plan, 0, sizeof plan);
 
     plan.a = a;
     plan.M = M;
@@ -285,11 +286,15 @@ LTFAT_NAME(dgt_shear_execute)(const LTFAT_NAME(dgt_shear_plan) plan)
 LTFAT_API void
 LTFAT_NAME(dgt_shear_done)(LTFAT_NAME(dgt_shear_plan) plan)
 {
-    LTFAT_NAME_COMPLEX(dgt_long_done)(&plan.rect_plan);
-    LTFAT_NAME_REAL(fft_done)(&plan.f_plan);
-    LTFAT_NAME_REAL(fft_done)(&plan.g_plan);
-    LTFAT_SAFEFREEALL(plan.finalmod, plan.c_rect, plan.fwork, plan.gwork, plan.p0,
-                      plan.p1);
+    if (plan.rect_plan) LTFAT_NAME_COMPLEX(dgt_long_done)(&plan.rect_plan);
+    if (plan.f_plan) LTFAT_NAME_REAL(fft_done)(&plan.f_plan);
+    if (plan.g_plan) LTFAT_NAME_REAL(fft_done)(&plan.g_plan);
+
+    /* fwork and gwork alias the input arrays if there is no shearing */
+    if (plan.s0 != 0 || plan.s1 != 0)
+        LTFAT_SAFEFREEALL(plan.fwork, plan.gwork);
+
+    LTFAT_SAFEFREEALL(plan.finalmod, plan.c_rect, plan.p0, plan.p1);
 }
 
 
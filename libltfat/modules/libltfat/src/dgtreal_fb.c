@@ -3,6 +3,18 @@
 #include "ltfat/macros.h"
 
 #include "ltfat/thirdparty/fftw3.h"
+#include "dgtreal_fb_private.h"
+#include "threads_private.h"
+
+/* Buffers and FFT plans private to one thread */
+typedef struct
+{
+    LTFAT_NAME_REAL(fftreal_plan)* p_small;  //!< Single frame FFT
+    LTFAT_NAME_REAL(fftreal_plan)* p_block;  //!< FFT of blocksize frames
+    LTFAT_REAL*    sbuf;                     //!< Folded frames, M x blocksize
+    LTFAT_COMPLEX* cbuf;                     //!< Coefficients, M2 x blocksize
+    LTFAT_REAL*    fw;                       //!< Windowed frame, gl
+} LTFAT_NAME(dgtreal_fb_worker);
 
 struct LTFAT_NAME(dgtreal_fb_plan)
 {
@@ -10,10 +22,10 @@ struct LTFAT_NAME(dgtreal_fb_plan)
     ltfat_int M;
     ltfat_int gl;
     ltfat_phaseconvention ptype;
-    LTFAT_NAME_REAL(fftreal_plan)* p_small;
-    LTFAT_REAL*    sbuf;
-    LTFAT_COMPLEX* cbuf;
-    LTFAT_REAL* fw;
+    unsigned flags;
+    ltfat_int blocksize;                     //!< Number of frames per FFT call
+    int nthreads;
+    LTFAT_NAME(dgtreal_fb_worker)* wk;       //!< One per thread
     LTFAT_REAL* gw;
     LTFAT_COMPLEX* cout;
 };
@@ -46,7 +58,6 @@ LTFAT_NAME(dgtreal_fb_init)(const LTFAT_REAL* g,
                             unsigned flags, LTFAT_NAME(dgtreal_fb_plan)** pout)
 {
     LTFAT_NAME(dgtreal_fb_plan)* plan = NULL;
-    ltfat_int M2;
     int status = LTFATERR_SUCCESS;
     CHECKNULL(g); CHECKNULL(pout);
     CHECK(LTFATERR_BADSIZE, gl > 0, "gl must be positive");
@@ -59,18 +70,15 @@ LTFAT_NAME(dgtreal_fb_init)(const LTFAT_REAL* g,
 
     plan->a = a;
     plan->M = M;
-    M2 = M / 2 + 1;
     plan->gl = gl;
     plan->ptype = ptype;
+    plan->flags = flags;
+    plan->nthreads = 1;
 
     CHECKMEM( plan->gw   = LTFAT_NAME_REAL(malloc)(gl));
-    CHECKMEM( plan->fw   = LTFAT_NAME_REAL(malloc)(gl));
-    CHECKMEM( plan->sbuf = LTFAT_NAME_REAL(malloc)(M));
-    CHECKMEM( plan->cbuf = LTFAT_NAME_COMPLEX(malloc)(M2));
 
     CHECKSTATUS(
-        LTFAT_NAME_REAL(fftreal_init)(M, 1, plan->sbuf, plan->cbuf, flags,
-                                      &plan->p_small));
+        LTFAT_NAME(dgtreal_fb_set_blocksize)(plan, ltfat_dgt_fb_defblocksize(M)));
 
     LTFAT_NAME(fftshift)(g, gl, plan->gw);
 
@@ -81,6 +89,85 @@ error:
     return status;
 }
 
+static void
+LTFAT_NAME(dgtreal_fb_workers_done)(LTFAT_NAME(dgtreal_fb_plan)* plan)
+{
+    if (!plan->wk) return;
+
+    for (int t = 0; t < plan->nthreads; t++)
+    {
+        LTFAT_NAME(dgtreal_fb_worker)* wk = plan->wk + t;
+        if (wk->p_small) LTFAT_NAME_REAL(fftreal_done)(&wk->p_small);
+        if (wk->p_block) LTFAT_NAME_REAL(fftreal_done)(&wk->p_block);
+        LTFAT_SAFEFREEALL(wk->sbuf, wk->cbuf, wk->fw);
+    }
+    ltfat_safefree(plan->wk);
+    plan->wk = NULL;
+}
+
+static int
+LTFAT_NAME(dgtreal_fb_workers_init)(LTFAT_NAME(dgtreal_fb_plan)* plan,
+                                    ltfat_int blocksize, int nthreads)
+{
+    ltfat_int M = plan->M, M2 = plan->M / 2 + 1;
+    int status = LTFATERR_SUCCESS;
+
+    LTFAT_NAME(dgtreal_fb_workers_done)(plan);
+    plan->blocksize = blocksize;
+    plan->nthreads = nthreads;
+
+    CHECKMEM( plan->wk = LTFAT_NEWARRAY(LTFAT_NAME(dgtreal_fb_worker), nthreads));
+
+    for (int t = 0; t < nthreads; t++)
+    {
+        LTFAT_NAME(dgtreal_fb_worker)* wk = plan->wk + t;
+        CHECKMEM( wk->sbuf = LTFAT_NAME_REAL(malloc)(M * blocksize));
+        CHECKMEM( wk->cbuf = LTFAT_NAME_COMPLEX(malloc)(M2 * blocksize));
+        CHECKMEM( wk->fw   = LTFAT_NAME_REAL(malloc)(plan->gl));
+
+        CHECKSTATUS(
+            LTFAT_NAME_REAL(fftreal_init)(M, 1, wk->sbuf, wk->cbuf, plan->flags,
+                                          &wk->p_small));
+
+        if (blocksize > 1)
+            CHECKSTATUS(
+                LTFAT_NAME_REAL(fftreal_init)(M, blocksize, wk->sbuf, wk->cbuf,
+                                              plan->flags, &wk->p_block));
+    }
+
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtreal_fb_set_blocksize)(LTFAT_NAME(dgtreal_fb_plan)* plan,
+                                     ltfat_int blocksize)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(plan);
+    CHECK(LTFATERR_NOTPOSARG, blocksize > 0, "blocksize must be positive");
+
+    CHECKSTATUS(
+        LTFAT_NAME(dgtreal_fb_workers_init)(plan, blocksize, plan->nthreads));
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtreal_fb_set_nthreads)(LTFAT_NAME(dgtreal_fb_plan)* plan,
+                                    int nthreads)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(plan);
+    CHECK(LTFATERR_NOTPOSARG, nthreads > 0, "nthreads must be positive");
+
+    CHECKSTATUS(
+        LTFAT_NAME(dgtreal_fb_workers_init)(plan, plan->blocksize,
+                                            ltfat_usablethreads(nthreads)));
+error:
+    return status;
+}
+
 LTFAT_API int
 LTFAT_NAME(dgtreal_fb_done)(LTFAT_NAME(dgtreal_fb_plan)** plan)
 {
@@ -88,55 +175,50 @@ LTFAT_NAME(dgtreal_fb_done)(LTFAT_NAME(dgtreal_fb_plan)** plan)
     int status = LTFATERR_SUCCESS;
     CHECKNULL(plan); CHECKNULL(*plan);
     pp = *plan;
-    LTFAT_SAFEFREEALL(pp->sbuf, pp->cbuf, pp->gw, pp->fw);
-    if (pp->p_small) LTFAT_NAME_REAL(fftreal_done)(&pp->p_small);
+    LTFAT_NAME(dgtreal_fb_workers_done)(pp);
+    ltfat_safefree(pp->gw);
     ltfat_free(pp);
     pp = NULL;
 error:
     return status;
 }
 
-/* #define THE_SUM_REAL { \ */
-/* ltfat_int premarg = plan.ptype?-glh:n*a-glh; \ */
-/* for (ltfat_int m=0;m<M;m++) \ */
-/* { \ */
-/*    rem = ltfat_positiverem(m+(premarg), M); \ */
-/*    sbuf[rem]=0.0; \ */
-/*    fbd=fw+m; \ */
-/*    for (ltfat_int k=0;k<gl/M;k++) \ */
-/*    { \ */
-/*      sbuf[rem]+=(*fbd);         \ */
-/*       fbd+=M; \ */
-/*    } \ */
-/* } \ */
-/* \ */
-/*  LTFAT_FFTW(execute)(plan.p_small);         \ */
-/* \ */
-/* coefsum=(LTFAT_REAL*)cout+2*(n*M2+w*M2*N); \ */
-/* for (ltfat_int m=0;m<M2;m++) \ */
-/* { \ */
-/*    coefsum[2*m]   = CH(creal)(cbuf[m]); \ */
-/*    coefsum[2*m+1] = CH(cimag)(cbuf[m]); \ */
-/* }} */
-
-#define THE_SUM_REAL { \
-LTFAT_NAME(fold_array)(fw,gl,plan->ptype==LTFAT_TIMEINV?-glh:n*a-glh,M,sbuf); \
-LTFAT_NAME_REAL(fftreal_execute)(plan->p_small); \
-memcpy(cout+(n*M2+w*M2*N),cbuf,M2*sizeof*cbuf); \
+/* Windows frame j = n + w*N using periodic boundary conditions and folds it
+ * to length M */
+static void
+LTFAT_NAME(dgtreal_fb_foldframe)(const LTFAT_NAME(dgtreal_fb_plan)* plan,
+                                 const LTFAT_REAL* f, ltfat_int L, ltfat_int N,
+                                 ltfat_int j, LTFAT_REAL* fw, LTFAT_REAL* sbuf)
+{
+    ltfat_int n = j % N, w = j / N;
+    ltfat_int gl = plan->gl, glh = plan->gl / 2;
+    ltfat_int sp = ltfat_positiverem(n * plan->a - glh, L);
+    ltfat_int beforewrap = ltfat_imin(gl, L - sp);
+    const LTFAT_REAL* fbd = f + w * L + sp;
+
+    for (ltfat_int l = 0; l < beforewrap; l++)
+        fw[l] = fbd[l] * plan->gw[l];
+
+    fbd = f + w * L - beforewrap;
+    for (ltfat_int l = beforewrap; l < gl; l++)
+        fw[l] = fbd[l] * plan->gw[l];
+
+    LTFAT_NAME(fold_array)(fw, gl,
+                           plan->ptype == LTFAT_TIMEINV ? -glh : n * plan->a - glh,
+                           plan->M, sbuf);
 }
 
-LTFAT_API int
-LTFAT_NAME(dgtreal_fb_execute)(LTFAT_NAME(dgtreal_fb_plan)* plan,
-                               const LTFAT_REAL* f,
-                               ltfat_int L, ltfat_int W,
-                               LTFAT_COMPLEX* cout)
+/* Coefficients go either to cout or, if it is NULL, to cr and ci */
+static int
+LTFAT_NAME(dgtreal_fb_execute_gen)(LTFAT_NAME(dgtreal_fb_plan)* plan,
+                                   const LTFAT_REAL* f,
+                                   ltfat_int L, ltfat_int W,
+                                   LTFAT_COMPLEX* cout,
+                                   LTFAT_REAL* cr, LTFAT_REAL* ci)
 {
-    ltfat_int a, M, M2, N, gl, glh, glh_d_a;
-    LTFAT_REAL* sbuf, *fw;
-    const LTFAT_REAL* fbd;
-    LTFAT_COMPLEX* cbuf;
+    ltfat_int M, M2, N, B, NW, nblocks;
     int status = LTFATERR_SUCCESS;
-    CHECKNULL(plan); CHECKNULL(f); CHECKNULL(cout);
+    CHECKNULL(plan); CHECKNULL(f);
     CHECK(LTFATERR_BADSIZE, L > 0, "L must be positive");
     CHECK(LTFATERR_BADTRALEN, L >= plan->gl && !(L % plan->a) ,
           "L (passed %td) must be greater or equal to gl and divisible by a (passed %td).",
@@ -144,69 +226,56 @@ LTFAT_NAME(dgtreal_fb_execute)(LTFAT_NAME(dgtreal_fb_plan)* plan,
     CHECK(LTFATERR_NOTPOSARG, W > 0, "W must be positive");
 
     /*  --------- initial declarations -------------- */
-    a = plan->a;
     M = plan->M;
-    N = L / a;
-
-    gl = plan->gl;
-    sbuf = plan->sbuf;
-    cbuf = plan->cbuf;
-    fw = plan->fw;
-
-    /* These are floor operations. */
-    glh = plan->gl / 2;
     M2 = M / 2 + 1;
-
-    /* This is a ceil operation. */
-    glh_d_a = (ltfat_int)ceil((glh * 1.0) / (a));
+    N = L / plan->a;
+    B = plan->blocksize;
 
     /*  ---------- main body ----------- */
-
-    /*----- Handle the first boundary using periodic boundary conditions.*/
-    for (ltfat_int n = 0; n < glh_d_a; n++)
+    /* Coefficients of frame n of channel w are stored at (n + w*N)*M2, so
+     * blocks of B consecutive frames can run over the channel boundaries
+     * and they are copied to the output in one go. The blocks are
+     * independent and are distributed among the threads. */
+    NW = N * W;
+    nblocks = (NW + B - 1) / B;
+
+#ifdef _OPENMP
+    #pragma omp parallel for num_threads(plan->nthreads) if(plan->nthreads > 1) schedule(static)
+#endif
+    for (ltfat_int iblock = 0; iblock < nblocks; iblock++)
     {
-        for (ltfat_int w = 0; w < W; w++)
-        {
-            fbd = f + L - (glh - n * a) + L * w;
-            for (ltfat_int l = 0; l < glh - n * a; l++)
-                fw[l]  = fbd[l] * plan->gw[l];
+        LTFAT_NAME(dgtreal_fb_worker)* wk = plan->wk + ltfat_threadid();
+        ltfat_int jstart = iblock * B;
+        ltfat_int Bcur = ltfat_imin(B, NW - jstart);
 
-            fbd = f - (glh - n * a) + L * w;
-            for (ltfat_int l = glh - n * a; l < gl; l++)
-                fw[l]  = fbd[l] * plan->gw[l];
-
-            THE_SUM_REAL
-        }
-    }
-
-    /* ----- Handle the middle case. --------------------- */
-    for (ltfat_int n = glh_d_a; n < (L - (gl + 1) / 2) / a + 1; n++)
-    {
-        for (ltfat_int w = 0; w < W; w++)
+        if (Bcur == B && wk->p_block)
         {
-            fbd = f + (n * a - glh + L * w);
-            for (ltfat_int l = 0; l < gl; l++)
-                fw[l]  = fbd[l] * plan->gw[l];
-
-            THE_SUM_REAL
+            for (ltfat_int b = 0; b < B; b++)
+                LTFAT_NAME(dgtreal_fb_foldframe)(plan, f, L, N, jstart + b,
+                                                 wk->fw, wk->sbuf + b * M);
+
+            LTFAT_NAME_REAL(fftreal_execute)(wk->p_block);
+            if (cout)
+                memcpy(cout + jstart * M2, wk->cbuf, B * M2 * sizeof * cout);
+            else
+                LTFAT_NAME(complex2planar_array)(wk->cbuf, B * M2,
+                                                 cr + jstart * M2, ci + jstart * M2);
         }
-
-    }
-
-    /* Handle the last boundary using periodic boundary conditions. */
-    for (ltfat_int n = (L - (gl + 1) / 2) / a + 1; n < N; n++)
-    {
-        for (ltfat_int w = 0; w < W; w++)
+        else
         {
-            fbd = f + (n * a - glh + L * w);
-            for (ltfat_int l = 0; l < L - n * a + glh; l++)
-                fw[l]  = fbd[l] * plan->gw[l];
-
-            fbd = f - (L - n * a + glh) + L * w;
-            for (ltfat_int l = L - n * a + glh; l < gl; l++)
-                fw[l]  = fbd[l] * plan->gw[l];
-
-            THE_SUM_REAL
+            for (ltfat_int b = 0; b < Bcur; b++)
+            {
+                LTFAT_NAME(dgtreal_fb_foldframe)(plan, f, L, N, jstart + b,
+                                                 wk->fw, wk->sbuf);
+
+                LTFAT_NAME_REAL(fftreal_execute)(wk->p_small);
+                if (cout)
+                    memcpy(cout + (jstart + b) * M2, wk->cbuf, M2 * sizeof * cout);
+                else
+                    LTFAT_NAME(complex2planar_array)(wk->cbuf, M2,
+                                                     cr + (jstart + b) * M2,
+                                                     ci + (jstart + b) * M2);
+            }
         }
     }
 
@@ -214,4 +283,28 @@ error:
     return status;
 }
 
-#undef THE_SUM_REAL
+LTFAT_API int
+LTFAT_NAME(dgtreal_fb_execute)(LTFAT_NAME(dgtreal_fb_plan)* plan,
+                               const LTFAT_REAL* f,
+                               ltfat_int L, ltfat_int W,
+                               LTFAT_COMPLEX* cout)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(cout);
+    return LTFAT_NAME(dgtreal_fb_execute_gen)(plan, f, L, W, cout, NULL, NULL);
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtreal_fb_execute_planar)(LTFAT_NAME(dgtreal_fb_plan)* plan,
+                                      const LTFAT_REAL* f,
+                                      ltfat_int L, ltfat_int W,
+                                      LTFAT_REAL* cr, LTFAT_REAL* ci)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(cr); CHECKNULL(ci);
+    return LTFAT_NAME(dgtreal_fb_execute_gen)(plan, f, L, W, NULL, cr, ci);
+error:
+    return status;
+}
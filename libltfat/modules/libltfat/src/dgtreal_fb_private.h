@@ -0,0 +1,17 @@
+#ifndef _ltfat_dgtreal_fb_private_h
+#define _ltfat_dgtreal_fb_private_h
+
+/* Frames are transformed in blocks such that the block buffer holds
+ * about LTFAT_FB_BLOCKLEN samples. Long windows do not benefit from
+ * batching, so they are transformed one frame at a time. */
+#define LTFAT_FB_BLOCKLEN 4096
+#define LTFAT_FB_MAXBLOCKSIZE 32
+
+static inline ltfat_int
+ltfat_dgt_fb_defblocksize(ltfat_int M)
+{
+    ltfat_int B = LTFAT_FB_BLOCKLEN / M;
+    return B < 1 ? 1 : (B > LTFAT_FB_MAXBLOCKSIZE ? LTFAT_FB_MAXBLOCKSIZE : B);
+}
+
+#endif
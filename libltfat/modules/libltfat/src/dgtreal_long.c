@@ -1,4 +1,5 @@
 #include "dgtreal_long_private.h"
+#include "threads_private.h"
 
 LTFAT_API int
 LTFAT_NAME(dgtreal_long)(const LTFAT_REAL* f, const LTFAT_REAL* g,
@@ -24,6 +25,59 @@ error:
     return status;
 }
 
+static void
+LTFAT_NAME(dgtreal_long_workers_done)(LTFAT_NAME(dgtreal_long_plan)* plan)
+{
+    if (!plan->wk) return;
+
+    for (int t = 0; t < plan->nthreads; t++)
+    {
+        LTFAT_NAME(dgtreal_long_worker)* wk = plan->wk + t;
+        if (wk->p_before) LTFAT_NAME(fftreal_done)(&wk->p_before);
+        if (wk->p_after)  LTFAT_NAME(ifftreal_done)(&wk->p_after);
+        LTFAT_SAFEFREEALL(wk->sbuf, wk->cbuf, wk->ff, wk->cf);
+    }
+    ltfat_safefree(plan->wk);
+    plan->wk = NULL;
+}
+
+static int
+LTFAT_NAME(dgtreal_long_workers_init)(LTFAT_NAME(dgtreal_long_plan)* plan,
+                                      int nthreads)
+{
+    ltfat_int p = plan->a / plan->c;
+    ltfat_int q = plan->M / plan->c;
+    ltfat_int d = plan->L / plan->M / p;
+    ltfat_int d2 = d / 2 + 1;
+    ltfat_int W = plan->W;
+    int status = LTFATERR_SUCCESS;
+
+    LTFAT_NAME(dgtreal_long_workers_done)(plan);
+    plan->nthreads = nthreads;
+
+    CHECKMEM( plan->wk = LTFAT_NEWARRAY(LTFAT_NAME(dgtreal_long_worker), nthreads));
+
+    for (int t = 0; t < nthreads; t++)
+    {
+        LTFAT_NAME(dgtreal_long_worker)* wk = plan->wk + t;
+        CHECKMEM( wk->sbuf = LTFAT_NAME_REAL(malloc)( d ));
+        CHECKMEM( wk->cbuf = LTFAT_NAME_COMPLEX(malloc)(d2));
+        CHECKMEM( wk->ff = LTFAT_NAME_REAL(malloc)(2 * d2 * p * q * W));
+        CHECKMEM( wk->cf = LTFAT_NAME_REAL(malloc)(2 * d2 * q * q * W));
+
+        CHECKSTATUS(
+            LTFAT_NAME(fftreal_init)(d, 1, wk->sbuf, wk->cbuf, plan->flags,
+                                     &wk->p_before));
+
+        CHECKSTATUS(
+            LTFAT_NAME(ifftreal_init)(d, 1, wk->cbuf, wk->sbuf, plan->flags,
+                                      &wk->p_after));
+    }
+
+error:
+    return status;
+}
+
 LTFAT_API int
 LTFAT_NAME(dgtreal_long_init)( const LTFAT_REAL* g,
                                ltfat_int L, ltfat_int W,
@@ -33,7 +87,7 @@ LTFAT_NAME(dgtreal_long_init)( const LTFAT_REAL* g,
                                unsigned flags, LTFAT_NAME(dgtreal_long_plan)** pout)
 {
     LTFAT_NAME(dgtreal_long_plan)* plan = NULL;
-    ltfat_int minL, N, h_m, b, p, q, d, d2, wfs;
+    ltfat_int minL, N, h_m, wfs;
 
     int status = LTFATERR_SUCCESS;
     CHECK(LTFATERR_NULLPOINTER, (flags & FFTW_ESTIMATE) || cout != NULL,
@@ -59,24 +113,16 @@ LTFAT_NAME(dgtreal_long_init)( const LTFAT_REAL* g,
     plan->L = L;
     plan->W = W;
     plan->ptype = ptype;
+    plan->flags = flags;
     N = L / a;
 
     plan->c = ltfat_gcd(a, M, &plan->h_a, &h_m);
-    b = L / M;
-    p = a / plan->c;
-    q = M / plan->c;
-    d = b / p;
     plan->h_a = -plan->h_a;
 
-    d2 = d / 2 + 1;
     wfs = wfacreal_size(L, a, M);
 
     plan->cout = cout;
     plan->f    = f;
-    CHECKMEM( plan->sbuf = LTFAT_NAME_REAL(malloc)( d ));
-    CHECKMEM( plan->cbuf = LTFAT_NAME_COMPLEX(malloc)(d2));
-    CHECKMEM( plan->ff = LTFAT_NAME_REAL(malloc)(2 * d2 * p * q * W));
-    CHECKMEM( plan->cf = LTFAT_NAME_REAL(malloc)(2 * d2 * q * q * W));
     CHECKMEM( plan->gf = LTFAT_NAME_COMPLEX(malloc)(wfs));
     //CHECKMEM( plan->cwork = (LTFAT_REAL*) LTFAT_NAME_COMPLEX(malloc)(M2 * N * W));
 
@@ -89,11 +135,7 @@ LTFAT_NAME(dgtreal_long_init)( const LTFAT_REAL* g,
         LTFAT_NAME(fftreal_init)(M, N * W,
                                  (LTFAT_REAL*) cout, cout, flags, &plan->p_veryend));
 
-    CHECKSTATUS(
-        LTFAT_NAME(fftreal_init)(d, 1, plan->sbuf, plan->cbuf, flags, &plan->p_before));
-
-    CHECKSTATUS(
-        LTFAT_NAME(ifftreal_init)(d, 1, plan->cbuf, plan->sbuf, flags, &plan->p_after));
+    CHECKSTATUS( LTFAT_NAME(dgtreal_long_workers_init)(plan, 1));
 
     *pout = plan;
     return status;
@@ -110,16 +152,28 @@ LTFAT_NAME(dgtreal_long_done)(LTFAT_NAME(dgtreal_long_plan)** plan)
     CHECKNULL(plan); CHECKNULL(*plan);
     pp = *plan;
     if (pp->p_veryend) LTFAT_NAME(fftreal_done)(&pp->p_veryend);
-    if (pp->p_before)  LTFAT_NAME(fftreal_done)(&pp->p_before);
-    if (pp->p_after)   LTFAT_NAME(ifftreal_done)(&pp->p_after);
-    LTFAT_SAFEFREEALL(pp->sbuf, pp->cbuf,// pp->cwork,
-                      pp->gf, pp->ff, pp->cf);
+    LTFAT_NAME(dgtreal_long_workers_done)(pp);
+    LTFAT_SAFEFREEALL(pp->gf);
     ltfat_free(pp);
     pp = NULL;
 error:
     return status;
 }
 
+LTFAT_API int
+LTFAT_NAME(dgtreal_long_set_nthreads)(LTFAT_NAME(dgtreal_long_plan)* plan,
+                                      int nthreads)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(plan);
+    CHECK(LTFATERR_NOTPOSARG, nthreads > 0, "nthreads must be positive");
+
+    CHECKSTATUS(
+        LTFAT_NAME(dgtreal_long_workers_init)(plan, ltfat_usablethreads(nthreads)));
+error:
+    return status;
+}
+
 LTFAT_API int
 LTFAT_NAME(dgtreal_long_execute)(LTFAT_NAME(dgtreal_long_plan)* plan)
 {
@@ -184,8 +238,12 @@ error:
 
 */
 
-LTFAT_API int
-LTFAT_NAME(dgtreal_walnut_plan)(LTFAT_NAME(dgtreal_long_plan)* plan)
+/* One iteration of the r-loop of the walnut algorithm. Iterations for
+ * different r write to disjoint parts of the output and only use the
+ * buffers from wk. */
+static void
+LTFAT_NAME(dgtreal_walnut_r)(const LTFAT_NAME(dgtreal_long_plan)* plan,
+                             LTFAT_NAME(dgtreal_long_worker)* wk, ltfat_int r)
 {
     /*  --------- initial declarations -------------- */
 
@@ -209,8 +267,8 @@ LTFAT_NAME(dgtreal_walnut_plan)(LTFAT_NAME(dgtreal_long_plan)* plan)
 
     ltfat_int h_a = plan->h_a;
 
-    LTFAT_REAL* sbuf = plan->sbuf;
-    LTFAT_COMPLEX* cbuf = plan->cbuf;
+    LTFAT_REAL* sbuf = wk->sbuf;
+    LTFAT_COMPLEX* cbuf = wk->cbuf;
 
     LTFAT_REAL* cout = (LTFAT_REAL*) plan->cout;
 
@@ -231,25 +289,50 @@ LTFAT_NAME(dgtreal_walnut_plan)(LTFAT_NAME(dgtreal_long_plan)* plan)
     /* Leading dimensions of cf */
     ltfat_int ld3b = 2 * q * q * W;
 
-    /* --------- main loop begins here ------------------- */
-    for (ltfat_int r = 0; r < c; r++)
+    /*  ---------- compute signal factorization ----------- */
+    ffp = wk->ff;
+    fp = f + r;
+    if (p == 1)
     {
-        /*  ---------- compute signal factorization ----------- */
-        ffp = plan->ff;
-        fp = f + r;
-        if (p == 1)
+        /* Integer oversampling case */
+        for (ltfat_int w = 0; w < W; w++)
         {
-            /* Integer oversampling case */
-            for (ltfat_int w = 0; w < W; w++)
+            for (ltfat_int l = 0; l < q; l++)
             {
-                for (ltfat_int l = 0; l < q; l++)
+                for (ltfat_int s = 0; s < d; s++)
+                {
+                    sbuf[s]   = fp[(s * M + l * a) % L];
+                }
+
+                LTFAT_NAME(fftreal_execute)(wk->p_before);
+
+                for (ltfat_int s = 0; s < d2; s++)
+                {
+                    ffp[s * ld2a]   = ltfat_real(cbuf[s]) * scalconst;
+                    ffp[s * ld2a + 1] = ltfat_imag(cbuf[s]) * scalconst;
+                }
+                ffp += 2;
+            }
+            fp += L;
+        }
+        /* fp -= 2 * L * W; */
+    }
+    else
+    {
+        /* rational sampling case */
+
+        for (ltfat_int w = 0; w < W; w++)
+        {
+            for (ltfat_int l = 0; l < q; l++)
+            {
+                for (ltfat_int k = 0; k < p; k++)
                 {
                     for (ltfat_int s = 0; s < d; s++)
                     {
-                        sbuf[s]   = fp[(s * M + l * a) % L];
+                        sbuf[s]   = fp[ ltfat_positiverem(k * M + s * p * M - l * h_a * a, L) ];
                     }
 
-                    LTFAT_NAME(fftreal_execute)(plan->p_before);
+                    LTFAT_NAME(fftreal_execute)(wk->p_before);
 
                     for (ltfat_int s = 0; s < d2; s++)
                     {
@@ -258,142 +341,124 @@ LTFAT_NAME(dgtreal_walnut_plan)(LTFAT_NAME(dgtreal_long_plan)* plan)
                     }
                     ffp += 2;
                 }
-                fp += L;
             }
-            /* fp -= 2 * L * W; */
+            fp += L;
         }
-        else
-        {
-            /* rational sampling case */
+        /* fp -= 2 * L * W; */
+    }
 
-            for (ltfat_int w = 0; w < W; w++)
-            {
-                for (ltfat_int l = 0; l < q; l++)
-                {
-                    for (ltfat_int k = 0; k < p; k++)
-                    {
-                        for (ltfat_int s = 0; s < d; s++)
-                        {
-                            sbuf[s]   = fp[ ltfat_positiverem(k * M + s * p * M - l * h_a * a, L) ];
-                        }
-
-                        LTFAT_NAME(fftreal_execute)(plan->p_before);
-
-                        for (ltfat_int s = 0; s < d2; s++)
-                        {
-                            ffp[s * ld2a]   = ltfat_real(cbuf[s]) * scalconst;
-                            ffp[s * ld2a + 1] = ltfat_imag(cbuf[s]) * scalconst;
-                        }
-                        ffp += 2;
-                    }
-                }
-                fp += L;
-            }
-            /* fp -= 2 * L * W; */
-        }
+    /* ----------- compute matrix multiplication ----------- */
 
-        /* ----------- compute matrix multiplication ----------- */
+    /* Do the matmul  */
+    if (p == 1)
+    {
+        /* Integer oversampling case */
 
-        /* Do the matmul  */
-        if (p == 1)
-        {
-            /* Integer oversampling case */
 
+        /* Rational oversampling case */
+        for (ltfat_int s = 0; s < d2; s++)
+        {
+            gbase = (LTFAT_REAL*)gf + 2 * (r + s * c) * q;
+            fbase = wk->ff + 2 * s * q * W;
+            cbase = wk->cf + 2 * s * q * q * W;
 
-            /* Rational oversampling case */
-            for (ltfat_int s = 0; s < d2; s++)
+            for (ltfat_int nm = 0; nm < q * W; nm++)
             {
-                gbase = (LTFAT_REAL*)gf + 2 * (r + s * c) * q;
-                fbase = plan->ff + 2 * s * q * W;
-                cbase = plan->cf + 2 * s * q * q * W;
-
-                for (ltfat_int nm = 0; nm < q * W; nm++)
+                for (ltfat_int mm = 0; mm < q; mm++)
                 {
-                    for (ltfat_int mm = 0; mm < q; mm++)
-                    {
-                        cbase[0] = gbase[0] * fbase[0] + gbase[1] * fbase[1];
-                        cbase[1] = gbase[0] * fbase[1] - gbase[1] * fbase[0];
-                        gbase += 2;
-                        cbase += 2;
-                    }
-                    gbase -= 2 * q;
-                    fbase += 2;
+                    cbase[0] = gbase[0] * fbase[0] + gbase[1] * fbase[1];
+                    cbase[1] = gbase[0] * fbase[1] - gbase[1] * fbase[0];
+                    gbase += 2;
+                    cbase += 2;
                 }
-                cbase -= 2 * q * q * W;
+                gbase -= 2 * q;
+                fbase += 2;
             }
-
+            cbase -= 2 * q * q * W;
         }
-        else
+
+    }
+    else
+    {
+
+        /* Rational oversampling case */
+        for (ltfat_int s = 0; s < d2; s++)
         {
+            gbase = (LTFAT_REAL*)gf + 2 * (r + s * c) * p * q;
+            fbase = wk->ff + 2 * s * p * q * W;
+            cbase = wk->cf + 2 * s * q * q * W;
 
-            /* Rational oversampling case */
-            for (ltfat_int s = 0; s < d2; s++)
+            for (ltfat_int nm = 0; nm < q * W; nm++)
             {
-                gbase = (LTFAT_REAL*)gf + 2 * (r + s * c) * p * q;
-                fbase = plan->ff + 2 * s * p * q * W;
-                cbase = plan->cf + 2 * s * q * q * W;
-
-                for (ltfat_int nm = 0; nm < q * W; nm++)
+                for (ltfat_int mm = 0; mm < q; mm++)
                 {
-                    for (ltfat_int mm = 0; mm < q; mm++)
+                    cbase[0] = 0.0;
+                    cbase[1] = 0.0;
+                    for (ltfat_int km = 0; km < p; km++)
                     {
-                        cbase[0] = 0.0;
-                        cbase[1] = 0.0;
-                        for (ltfat_int km = 0; km < p; km++)
-                        {
-                            cbase[0] += gbase[0] * fbase[0] + gbase[1] * fbase[1];
-                            cbase[1] += gbase[0] * fbase[1] - gbase[1] * fbase[0];
-                            gbase += 2;
-                            fbase += 2;
-                        }
-                        fbase -= 2 * p;
-                        cbase += 2;
+                        cbase[0] += gbase[0] * fbase[0] + gbase[1] * fbase[1];
+                        cbase[1] += gbase[0] * fbase[1] - gbase[1] * fbase[0];
+                        gbase += 2;
+                        fbase += 2;
                     }
-                    gbase -= 2 * q * p;
-                    fbase += 2 * p;
+                    fbase -= 2 * p;
+                    cbase += 2;
                 }
-                cbase -= 2 * q * q * W;
-                fbase -= 2 * p * q * W;
+                gbase -= 2 * q * p;
+                fbase += 2 * p;
             }
+            cbase -= 2 * q * q * W;
+            fbase -= 2 * p * q * W;
         }
+    }
 
 
 
-        /*  -------  compute inverse coefficient factorization ------- */
-        LTFAT_REAL* cfp = plan->cf;
-        ltfat_int ld5c = 2 * M2 * N;
+    /*  -------  compute inverse coefficient factorization ------- */
+    LTFAT_REAL* cfp = wk->cf;
+    ltfat_int ld5c = 2 * M2 * N;
 
-        /* Cover both integer and rational sampling case */
-        for (ltfat_int w = 0; w < W; w++)
+    /* Cover both integer and rational sampling case */
+    for (ltfat_int w = 0; w < W; w++)
+    {
+        /* Complete inverse fac of coefficients */
+        for (ltfat_int l = 0; l < q; l++)
         {
-            /* Complete inverse fac of coefficients */
-            for (ltfat_int l = 0; l < q; l++)
+            for (ltfat_int u = 0; u < q; u++)
             {
-                for (ltfat_int u = 0; u < q; u++)
+                for (ltfat_int s = 0; s < d2; s++)
                 {
-                    for (ltfat_int s = 0; s < d2; s++)
-                    {
-                        LTFAT_REAL* cbufTmp = (LTFAT_REAL*) &cbuf[s];
-                        cbufTmp[0] = cfp[s * ld3b];
-                        cbufTmp[1] = cfp[s * ld3b + 1];
-                    }
-                    cfp += 2;
+                    LTFAT_REAL* cbufTmp = (LTFAT_REAL*) &cbuf[s];
+                    cbufTmp[0] = cfp[s * ld3b];
+                    cbufTmp[1] = cfp[s * ld3b + 1];
+                }
+                cfp += 2;
 
-                    /* Do inverse fft of length d */
-                    LTFAT_NAME(ifftreal_execute)(plan->p_after);
+                /* Do inverse fft of length d */
+                LTFAT_NAME(ifftreal_execute)(wk->p_after);
 
-                    for (ltfat_int s = 0; s < d; s++)
-                    {
-                        cout[ r + l * c + ltfat_positiverem(u + s * q - l * h_a,
-                                                            N) * 2 * M2 + w * ld5c ] = sbuf[s];
-                    }
+                for (ltfat_int s = 0; s < d; s++)
+                {
+                    cout[ r + l * c + ltfat_positiverem(u + s * q - l * h_a,
+                                                        N) * 2 * M2 + w * ld5c ] = sbuf[s];
                 }
             }
         }
+    }
 
 
-        /* ----------- Main loop ends here ------------------------ */
-    }
+    /* ----------- Main loop ends here ------------------------ */
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtreal_walnut_plan)(LTFAT_NAME(dgtreal_long_plan)* plan)
+{
+    /* --------- main loop begins here ------------------- */
+#ifdef _OPENMP
+    #pragma omp parallel for num_threads(plan->nthreads) if(plan->nthreads > 1) schedule(static)
+#endif
+    for (ltfat_int r = 0; r < plan->c; r++)
+        LTFAT_NAME(dgtreal_walnut_r)(plan, plan->wk + ltfat_threadid(), r);
 
     return 0;
 }
@@ -4,6 +4,16 @@
 
 #include "ltfat/thirdparty/fftw3.h"
 
+/* Buffers and FFT plans of the walnut algorithm private to one thread */
+typedef struct
+{
+    LTFAT_NAME(fftreal_plan)* p_before;
+    LTFAT_NAME(ifftreal_plan)* p_after;
+    LTFAT_REAL* sbuf;
+    LTFAT_COMPLEX* cbuf;
+    LTFAT_REAL* ff, *cf;
+} LTFAT_NAME(dgtreal_long_worker);
+
 struct LTFAT_NAME(dgtreal_long_plan)
 {
     ltfat_int a;
@@ -13,14 +23,12 @@ struct LTFAT_NAME(dgtreal_long_plan)
     ltfat_int c;
     ltfat_int h_a;
     ltfat_phaseconvention ptype;
-    LTFAT_NAME(fftreal_plan)* p_before;
-    LTFAT_NAME(ifftreal_plan)* p_after;
+    unsigned flags;
+    int nthreads;
+    LTFAT_NAME(dgtreal_long_worker)* wk;  //!< One per thread
     LTFAT_NAME(fftreal_plan)* p_veryend;
-    LTFAT_REAL* sbuf;
-    LTFAT_COMPLEX* cbuf;
     const LTFAT_REAL* f;
     LTFAT_COMPLEX* gf;
     LTFAT_REAL* cwork;
     LTFAT_COMPLEX* cout;
-    LTFAT_REAL* ff, *cf;
 };
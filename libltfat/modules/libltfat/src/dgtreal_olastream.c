@@ -0,0 +1,299 @@
+#include "ltfat.h"
+#include "ltfat/types.h"
+#include "ltfat/macros.h"
+
+struct LTFAT_NAME(dgtreal_olastream_plan)
+{
+    LTFAT_NAME(dgtreal_long_plan)* plan; //!< DGT of one zero-extended block
+    ltfat_int bl;      //!< Block length
+    ltfat_int Lext;    //!< Block length including the zero extension
+    ltfat_int W;
+    ltfat_int a;
+    ltfat_int M2;
+    ltfat_int Nblock;  //!< Number of columns centered in the block
+    ltfat_int Nblocke; //!< Number of columns of the extended block
+    ltfat_int bm;      //!< Number of columns belonging to the previous block
+    LTFAT_REAL* buf;     //!< Block of the signal, Lext x W, only bl samples used
+    LTFAT_COMPLEX* cbuf; //!< Coefficients of the extended block, M2 x Nblocke x W
+    LTFAT_COMPLEX* acc;  //!< Overlap-add accumulator, M2 x Nblocke x W
+    ltfat_int bufpos;  //!< Number of samples in buf
+    ltfat_int nblocks; //!< Number of transformed blocks
+    ltfat_int nout;    //!< Number of columns pulled so far
+    ltfat_int Ltot;    //!< Number of samples pushed so far
+    int flushed;
+};
+
+/* Global index of the first column in acc */
+static ltfat_int
+LTFAT_NAME(dgtreal_olastream_accstart)(LTFAT_NAME(dgtreal_olastream_plan)* p)
+{
+    return (p->nblocks - 1) * p->Nblock - p->bm;
+}
+
+/* Global index one past the last final column */
+static ltfat_int
+LTFAT_NAME(dgtreal_olastream_finalend)(LTFAT_NAME(dgtreal_olastream_plan)* p)
+{
+    ltfat_int cend;
+
+    if (p->nblocks == 0) return 0;
+
+    cend = LTFAT_NAME(dgtreal_olastream_accstart)(p);
+
+    // After the last block, the tail does not get any more contributions
+    if (p->flushed && p->bufpos == 0)
+        return ltfat_imin(cend + p->Nblocke, ltfat_idivceil(p->Ltot, p->a));
+
+    return cend + p->Nblock;
+}
+
+static int
+LTFAT_NAME(dgtreal_olastream_canprocess)(LTFAT_NAME(dgtreal_olastream_plan)* p)
+{
+    return p->nout >= LTFAT_NAME(dgtreal_olastream_finalend)(p);
+}
+
+static int
+LTFAT_NAME(dgtreal_olastream_processblock)(LTFAT_NAME(dgtreal_olastream_plan)* p)
+{
+    int status = LTFATERR_SUCCESS;
+    ltfat_int M2 = p->M2, Nblock = p->Nblock, Nblocke = p->Nblocke;
+    ltfat_int bm = p->bm, bp = Nblocke - Nblock - bm;
+
+    // The final columns were pulled, shift the overlapping part to the front
+    for (ltfat_int w = 0; w < p->W; w++)
+    {
+        LTFAT_COMPLEX* accw = p->acc + w * M2 * Nblocke;
+        memmove(accw, accw + M2 * Nblock, M2 * (Nblocke - Nblock) * sizeof * accw);
+        memset(accw + M2 * (Nblocke - Nblock), 0, M2 * Nblock * sizeof * accw);
+    }
+
+    // Zero-pad the last incomplete block
+    for (ltfat_int w = 0; w < p->W; w++)
+        memset(p->buf + w * p->Lext + p->bufpos, 0,
+               (p->bl - p->bufpos) * sizeof * p->buf);
+
+    CHECKSTATUS( LTFAT_NAME(dgtreal_long_execute)(p->plan));
+
+    for (ltfat_int w = 0; w < p->W; w++)
+    {
+        LTFAT_COMPLEX* accw = p->acc + w * M2 * Nblocke;
+        LTFAT_COMPLEX* cbufw = p->cbuf + w * M2 * Nblocke;
+
+        // Columns at and after the block
+        for (ltfat_int ii = 0; ii < M2 * (Nblock + bp); ii++)
+            accw[M2 * bm + ii] += cbufw[ii];
+
+        // Columns before the block wrapped around to the end
+        for (ltfat_int ii = 0; ii < M2 * bm; ii++)
+            accw[ii] += cbufw[M2 * (Nblock + bp) + ii];
+    }
+
+    p->nblocks++;
+    p->bufpos = 0;
+error:
+    return status;
+}
+
+/* Transform the block if it is complete and there is space for the
+ * coefficients */
+static int
+LTFAT_NAME(dgtreal_olastream_advance)(LTFAT_NAME(dgtreal_olastream_plan)* p)
+{
+    int status = LTFATERR_SUCCESS;
+
+    if (!LTFAT_NAME(dgtreal_olastream_canprocess)(p))
+        return status;
+
+    if (p->bufpos == p->bl || (p->flushed && p->bufpos > 0))
+        CHECKSTATUS( LTFAT_NAME(dgtreal_olastream_processblock)(p));
+
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtreal_olastream_init)(const LTFAT_REAL g[], ltfat_int gl,
+                                   ltfat_int W, ltfat_int a, ltfat_int M,
+                                   ltfat_int bl, const ltfat_phaseconvention ptype,
+                                   unsigned flags,
+                                   LTFAT_NAME(dgtreal_olastream_plan)** pout)
+{
+    int status = LTFATERR_SUCCESS;
+    LTFAT_NAME(dgtreal_olastream_plan)* p = NULL;
+    LTFAT_REAL* gext = NULL;
+    ltfat_int lcm, bp;
+
+    CHECKNULL(g); CHECKNULL(pout);
+    CHECK(LTFATERR_BADSIZE, gl > 0, "gl must be positive (passed %td)", gl);
+    CHECK(LTFATERR_NOTPOSARG, W > 0, "W must be positive (passed %td)", W);
+    CHECK(LTFATERR_NOTPOSARG, a > 0, "a must be positive (passed %td)", a);
+    CHECK(LTFATERR_NOTPOSARG, M > 0, "M must be positive (passed %td)", M);
+    CHECK(LTFATERR_NOTPOSARG, bl > 0, "bl must be positive (passed %td)", bl);
+
+    lcm = ltfat_lcm(a, M);
+    CHECK(LTFATERR_BADTRALEN, bl % lcm == 0,
+          "bl must be divisible by lcm(a,M)=%td (passed %td)", lcm, bl);
+
+    CHECKMEM( p = LTFAT_NEW(LTFAT_NAME(dgtreal_olastream_plan)) );
+
+    // The extension must hold the window tails and keep the length
+    // compatible with a and M
+    p->bl = bl;
+    p->Lext = bl + ltfat_idivceil(gl, lcm) * lcm;
+    p->W = W;
+    p->a = a;
+    p->M2 = M / 2 + 1;
+    p->Nblock = bl / a;
+    p->Nblocke = p->Lext / a;
+
+    // Columns with windows starting before the end of the block belong to
+    // the block, the rest to the previous one.
+    bp = ltfat_idivceil(gl / 2, a);
+    p->bm = p->Nblocke - p->Nblock - bp;
+
+    CHECKMEM( gext = LTFAT_NAME_REAL(malloc)(p->Lext));
+    CHECKMEM( p->buf = LTFAT_NAME_REAL(calloc)(p->Lext * W));
+    CHECKMEM( p->cbuf = LTFAT_NAME_COMPLEX(malloc)(p->M2 * p->Nblocke * W));
+    CHECKMEM( p->acc = LTFAT_NAME_COMPLEX(calloc)(p->M2 * p->Nblocke * W));
+
+    CHECKSTATUS( LTFAT_NAME_REAL(fir2long)(g, gl, p->Lext, gext));
+
+    CHECKSTATUS(
+        LTFAT_NAME(dgtreal_long_init)(gext, p->Lext, W, a, M, p->buf, p->cbuf,
+                                      ptype, flags, &p->plan));
+
+    ltfat_free(gext);
+    *pout = p;
+    return status;
+error:
+    ltfat_safefree(gext);
+    if (p) LTFAT_NAME(dgtreal_olastream_done)(&p);
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtreal_olastream_push)(LTFAT_NAME(dgtreal_olastream_plan)* p,
+                                   const LTFAT_REAL f[], ltfat_int L,
+                                   ltfat_int* Lused)
+{
+    int status = LTFATERR_SUCCESS;
+    ltfat_int used = 0;
+    CHECKNULL(p); CHECKNULL(f);
+    CHECK(LTFATERR_BADSIZE, L >= 0, "L cannot be negative (passed %td)", L);
+    CHECK(LTFATERR_BADARG, !p->flushed,
+          "The stream was already flushed, reset the plan first.");
+
+    while (used < L)
+    {
+        ltfat_int chunk;
+
+        if (p->bufpos == p->bl)
+        {
+            if (!LTFAT_NAME(dgtreal_olastream_canprocess)(p))
+                break;
+
+            CHECKSTATUS( LTFAT_NAME(dgtreal_olastream_processblock)(p));
+        }
+
+        chunk = ltfat_imin(p->bl - p->bufpos, L - used);
+
+        for (ltfat_int w = 0; w < p->W; w++)
+            memcpy(p->buf + w * p->Lext + p->bufpos, f + w * L + used,
+                   chunk * sizeof * p->buf);
+
+        p->bufpos += chunk;
+        used += chunk;
+    }
+
+    p->Ltot += used;
+
+    CHECKSTATUS( LTFAT_NAME(dgtreal_olastream_advance)(p));
+
+error:
+    if (Lused) *Lused = used;
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtreal_olastream_flush)(LTFAT_NAME(dgtreal_olastream_plan)* p)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+
+    p->flushed = 1;
+    CHECKSTATUS( LTFAT_NAME(dgtreal_olastream_advance)(p));
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtreal_olastream_pull)(LTFAT_NAME(dgtreal_olastream_plan)* p,
+                                   LTFAT_COMPLEX c[], ltfat_int Ncap,
+                                   ltfat_int* Nout)
+{
+    int status = LTFATERR_SUCCESS;
+    ltfat_int got = 0;
+    CHECKNULL(p); CHECKNULL(c); CHECKNULL(Nout);
+    CHECK(LTFATERR_BADSIZE, Ncap >= 0, "Ncap cannot be negative (passed %td)",
+          Ncap);
+
+    while (got < Ncap)
+    {
+        ltfat_int navail, accoff;
+
+        CHECKSTATUS( LTFAT_NAME(dgtreal_olastream_advance)(p));
+
+        navail = ltfat_imin(LTFAT_NAME(dgtreal_olastream_finalend)(p) - p->nout,
+                            Ncap - got);
+        if (navail <= 0) break;
+
+        accoff = p->nout - LTFAT_NAME(dgtreal_olastream_accstart)(p);
+
+        for (ltfat_int w = 0; w < p->W; w++)
+            memcpy(c + p->M2 * (got + w * Ncap),
+                   p->acc + p->M2 * (accoff + w * p->Nblocke),
+                   p->M2 * navail * sizeof * c);
+
+        p->nout += navail;
+        got += navail;
+    }
+
+error:
+    if (Nout) *Nout = got;
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtreal_olastream_reset)(LTFAT_NAME(dgtreal_olastream_plan)* p)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+
+    memset(p->acc, 0, p->M2 * p->Nblocke * p->W * sizeof * p->acc);
+    p->bufpos = 0;
+    p->nblocks = 0;
+    p->nout = 0;
+    p->Ltot = 0;
+    p->flushed = 0;
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtreal_olastream_done)(LTFAT_NAME(dgtreal_olastream_plan)** p)
+{
+    LTFAT_NAME(dgtreal_olastream_plan)* pp;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(*p);
+    pp = *p;
+
+    if (pp->plan) LTFAT_NAME(dgtreal_long_done)(&pp->plan);
+    ltfat_safefree(pp->buf);
+    ltfat_safefree(pp->cbuf);
+    ltfat_safefree(pp->acc);
+    ltfat_free(pp);
+    *p = NULL;
+error:
+    return status;
+}
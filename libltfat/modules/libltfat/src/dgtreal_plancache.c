@@ -0,0 +1,275 @@
+#include "ltfat.h"
+#include "ltfat/types.h"
+#include "ltfat/macros.h"
+#include "dgtrealwrapper_private.h"
+#include "lrucache_private.h"
+
+/* Cached plan together with the parameters it was created with */
+typedef struct
+{
+    ltfat_lruentry lru;  //!< inuse is set while the plan is checked out
+    LTFAT_NAME(dgtreal_plan)* plan;
+    int gen;           //!< Created by dgtreal_init_gen, gs is meaningful
+    LTFAT_REAL* ga;
+    ltfat_int gal;
+    LTFAT_REAL* gs;
+    ltfat_int gsl;
+    ltfat_int L;
+    ltfat_int W;
+    ltfat_int a;
+    ltfat_int M;
+    ltfat_dgt_params params;
+} LTFAT_NAME(dgtreal_plan_cache_entry);
+
+static void
+LTFAT_NAME(dgtreal_plan_cache_freeentry)(void* entry);
+
+static ltfat_lrucache LTFAT_NAME(dgtreal_plan_cache) =
+    LTFAT_LRUCACHE_INIT(LTFAT_NAME(dgtreal_plan_cache_entry), 16,
+                        LTFAT_DGTREAL_PLAN_CACHE_BUDGET,
+                        LTFAT_NAME(dgtreal_plan_cache_freeentry));
+
+static unsigned long long
+LTFAT_NAME(dgtreal_plan_cache_hash)(const LTFAT_NAME(dgtreal_plan_cache_entry)* e)
+{
+    unsigned long long hash = LTFAT_FNV1A_INIT;
+    ltfat_int dims[] = { e->gen, e->gal, e->gsl, e->L, e->W, e->a, e->M };
+    int pars[] = { e->params.ptype, (int) e->params.fftw_flags, e->params.hint,
+                   e->params.do_synoverwrites, e->params.nthreads
+                 };
+
+    hash = ltfat_fnv1a(hash, dims, sizeof dims);
+    hash = ltfat_fnv1a(hash, pars, sizeof pars);
+    hash = ltfat_fnv1a(hash, e->ga,
+            e->gal * sizeof * e->ga);
+    if (e->gen)
+        hash = ltfat_fnv1a(hash, e->gs,
+                e->gsl * sizeof * e->gs);
+    return hash;
+}
+
+static int
+LTFAT_NAME(dgtreal_plan_cache_samekey)(
+    const LTFAT_NAME(dgtreal_plan_cache_entry)* e1,
+    const LTFAT_NAME(dgtreal_plan_cache_entry)* e2)
+{
+    const ltfat_dgt_params* p1 = &e1->params, *p2 = &e2->params;
+
+    return e1->lru.hash == e2->lru.hash && e1->gen == e2->gen &&
+           e1->gal == e2->gal && e1->gsl == e2->gsl &&
+           e1->L == e2->L && e1->W == e2->W && e1->a == e2->a && e1->M == e2->M &&
+           p1->ptype == p2->ptype && p1->fftw_flags == p2->fftw_flags &&
+           p1->hint == p2->hint && p1->do_synoverwrites == p2->do_synoverwrites &&
+           p1->nthreads == p2->nthreads &&
+           !memcmp(e1->ga, e2->ga, e1->gal * sizeof * e1->ga) &&
+           (!e1->gen || !memcmp(e1->gs, e2->gs, e1->gsl * sizeof * e1->gs));
+}
+
+static size_t
+LTFAT_NAME(dgtreal_plan_cache_entrybytes)(const LTFAT_NAME(dgtreal_plan_cache_entry)* e)
+{
+    return sizeof * e->plan + e->plan->membytes + (e->gal + e->gsl) * sizeof * e->ga;
+}
+
+static void
+LTFAT_NAME(dgtreal_plan_cache_freeentry)(void* entry)
+{
+    LTFAT_NAME(dgtreal_plan_cache_entry)* e =
+        (LTFAT_NAME(dgtreal_plan_cache_entry)*) entry;
+
+    if (e->plan) LTFAT_NAME(dgtreal_done)(&e->plan);
+    ltfat_safefree(e->ga);
+    ltfat_safefree(e->gs);
+}
+
+/* The following functions must be called from within the
+ * ltfat_dgtreal_plan_cache critical section */
+static LTFAT_NAME(dgtreal_plan)*
+LTFAT_NAME(dgtreal_plan_cache_checkout)(const LTFAT_NAME(dgtreal_plan_cache_entry)* e)
+{
+    ltfat_lrucache* c = &LTFAT_NAME(dgtreal_plan_cache);
+    LTFAT_NAME(dgtreal_plan_cache_entry)* table =
+        (LTFAT_NAME(dgtreal_plan_cache_entry)*) c->table;
+
+    for (ltfat_int ii = 0; ii < c->no; ii++)
+        if (!table[ii].lru.inuse &&
+            LTFAT_NAME(dgtreal_plan_cache_samekey)(table + ii, e))
+        {
+            table[ii].lru.inuse = 1;
+            return table[ii].plan;
+        }
+
+    return NULL;
+}
+
+static int
+LTFAT_NAME(dgtreal_plan_cache_checkin)(LTFAT_NAME(dgtreal_plan)* p)
+{
+    ltfat_lrucache* c = &LTFAT_NAME(dgtreal_plan_cache);
+    LTFAT_NAME(dgtreal_plan_cache_entry)* table =
+        (LTFAT_NAME(dgtreal_plan_cache_entry)*) c->table;
+
+    for (ltfat_int ii = 0; ii < c->no; ii++)
+        if (table[ii].plan == p && table[ii].lru.inuse)
+        {
+            // The plan can grow while in use, e.g. by the planar buffer
+            c->bytes -= table[ii].lru.bytes;
+            table[ii].lru.bytes = LTFAT_NAME(dgtreal_plan_cache_entrybytes)(table + ii);
+            c->bytes += table[ii].lru.bytes;
+            table[ii].lru.inuse = 0;
+            ltfat_lrucache_touch(c, ii);
+            ltfat_lrucache_evict(c, c->budget);
+            return LTFATERR_SUCCESS;
+        }
+
+    return LTFATERR_BADARG;
+}
+/* End of the functions requiring the critical section */
+
+static int
+LTFAT_NAME(dgtreal_plan_cache_get_common)(
+    const LTFAT_REAL ga[], ltfat_int gal, const LTFAT_REAL gs[], ltfat_int gsl,
+    ltfat_int L, ltfat_int W, ltfat_int a, ltfat_int M,
+    LTFAT_REAL f[], LTFAT_COMPLEX c[], ltfat_dgt_params* params,
+    LTFAT_NAME(dgtreal_plan)** pout)
+{
+    int status = LTFATERR_SUCCESS;
+    LTFAT_NAME(dgtreal_plan_cache_entry) e;
+    LTFAT_NAME(dgtreal_plan)* p = NULL;
+
+    memset(&e, 0, sizeof e);
+    CHECKNULL(ga); CHECKNULL(pout);
+    CHECK(LTFATERR_BADSIZE, gal > 0, "gal must be positive (passed %td)", gal);
+
+    if (params)
+        e.params = *params;
+    else
+        ltfat_dgt_params_defaults(&e.params);
+
+    e.gen = gs != NULL;
+    e.gal = gal; e.gsl = e.gen ? gsl : 0;
+    e.L = L; e.W = W; e.a = a; e.M = M;
+
+    // Shallow copies suffice for the lookup
+    e.ga = (LTFAT_REAL*) ga; e.gs = (LTFAT_REAL*) gs;
+    e.lru.hash = LTFAT_NAME(dgtreal_plan_cache_hash)(&e);
+
+#ifdef _OPENMP
+    #pragma omp critical(ltfat_dgtreal_plan_cache)
+#endif
+    p = LTFAT_NAME(dgtreal_plan_cache_checkout)(&e);
+
+    if (!p)
+    {
+        // Planning can take long, do it outside of the critical section
+        if (e.gen)
+            CHECKSTATUS(
+                LTFAT_NAME(dgtreal_init_gen)(ga, gal, gs, gsl, L, W, a, M, f, c,
+                                             &e.params, &e.plan));
+        else
+            CHECKSTATUS(
+                LTFAT_NAME(dgtreal_init)(ga, gal, L, W, a, M, f, c,
+                                         &e.params, &e.plan));
+
+        e.ga = NULL; e.gs = NULL;
+        CHECKMEM( e.ga = LTFAT_NAME_REAL(malloc)(gal));
+        memcpy(e.ga, ga, gal * sizeof * e.ga);
+        if (e.gen)
+        {
+            CHECKMEM( e.gs = LTFAT_NAME_REAL(malloc)(gsl));
+            memcpy(e.gs, gs, gsl * sizeof * e.gs);
+        }
+
+        e.lru.bytes = LTFAT_NAME(dgtreal_plan_cache_entrybytes)(&e);
+        e.lru.inuse = 1;
+        p = e.plan;
+
+#ifdef _OPENMP
+        #pragma omp critical(ltfat_dgtreal_plan_cache)
+#endif
+        status = ltfat_lrucache_insert(&LTFAT_NAME(dgtreal_plan_cache), &e);
+
+        CHECKSTATUS(status);
+    }
+
+    p->f = f; p->c = c;
+    *pout = p;
+    return status;
+error:
+    if (e.plan) LTFAT_NAME(dgtreal_plan_cache_freeentry)(&e);
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtreal_plan_cache_get)(const LTFAT_REAL g[], ltfat_int gl,
+                                   ltfat_int L, ltfat_int W, ltfat_int a, ltfat_int M,
+                                   LTFAT_REAL f[], LTFAT_COMPLEX c[],
+                                   ltfat_dgt_params* params,
+                                   LTFAT_NAME(dgtreal_plan)** p)
+{
+    return LTFAT_NAME(dgtreal_plan_cache_get_common)(g, gl, NULL, 0, L, W, a, M,
+            f, c, params, p);
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtreal_plan_cache_get_gen)(const LTFAT_REAL ga[], ltfat_int gal,
+                                       const LTFAT_REAL gs[], ltfat_int gsl,
+                                       ltfat_int L, ltfat_int W, ltfat_int a, ltfat_int M,
+                                       LTFAT_REAL f[], LTFAT_COMPLEX c[],
+                                       ltfat_dgt_params* params,
+                                       LTFAT_NAME(dgtreal_plan)** p)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(gs);
+    CHECK(LTFATERR_BADSIZE, gsl > 0, "gsl must be positive (passed %td)", gsl);
+
+    return LTFAT_NAME(dgtreal_plan_cache_get_common)(ga, gal, gs, gsl, L, W, a, M,
+            f, c, params, p);
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtreal_plan_cache_release)(LTFAT_NAME(dgtreal_plan)** p)
+{
+    int status = LTFATERR_SUCCESS;
+    int found;
+    CHECKNULL(p); CHECKNULL(*p);
+
+#ifdef _OPENMP
+    #pragma omp critical(ltfat_dgtreal_plan_cache)
+#endif
+    found = LTFAT_NAME(dgtreal_plan_cache_checkin)(*p);
+
+    CHECK(LTFATERR_BADARG, found == LTFATERR_SUCCESS,
+          "The plan was not obtained from the cache or was already released.");
+
+    *p = NULL;
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtreal_plan_cache_set_budget)(size_t bytes)
+{
+#ifdef _OPENMP
+    #pragma omp critical(ltfat_dgtreal_plan_cache)
+#endif
+    {
+        LTFAT_NAME(dgtreal_plan_cache).budget = bytes;
+        ltfat_lrucache_evict(&LTFAT_NAME(dgtreal_plan_cache), bytes);
+    }
+
+    return LTFATERR_SUCCESS;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtreal_plan_cache_clear)()
+{
+#ifdef _OPENMP
+    #pragma omp critical(ltfat_dgtreal_plan_cache)
+#endif
+    ltfat_lrucache_clear(&LTFAT_NAME(dgtreal_plan_cache));
+
+    return LTFATERR_SUCCESS;
+}
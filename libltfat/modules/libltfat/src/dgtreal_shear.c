@@ -0,0 +1,772 @@
+#include "ltfat.h"
+#include "ltfat/types.h"
+#include "ltfat/macros.h"
+
+#include "ltfat/thirdparty/fftw3.h"
+
+struct LTFAT_NAME(dgtreal_shear_plan)
+{
+    ltfat_int L;
+    ltfat_int W;
+    ltfat_int M;
+    ltfat_int N;
+    ltfat_int Wp;         //!< Number of complex channels, ceil(W/2)
+    int* halfshift;       //!< Per column: frequency grid offset by b/2
+    LTFAT_NAME(dgtreal_long_plan)* rect; //!< Used if there is no shear
+    LTFAT_NAME(dgt_shear_plan) shear;
+    int has_shear;
+    LTFAT_COMPLEX* fpack; //!< Pairs of real channels, L x Wp
+    LTFAT_COMPLEX* cpack; //!< Coefficients of fpack, M x N x Wp
+    const LTFAT_REAL* f;
+    LTFAT_COMPLEX* c;
+};
+
+struct LTFAT_NAME(idgtreal_shear_plan)
+{
+    ltfat_int L;
+    ltfat_int W;
+    ltfat_int M;
+    ltfat_int N;
+    ltfat_int Wp;
+    ltfat_int s0;
+    ltfat_int s1;
+    int* halfshift;
+    ltfat_int* outidx;    //!< Position in c of each coefficient of c_rect
+    ltfat_int* phsidx;    //!< Index to finalmod of each coefficient of c_rect
+    LTFAT_COMPLEX* finalmod;
+    LTFAT_COMPLEX* p0;
+    LTFAT_COMPLEX* p1;
+    LTFAT_COMPLEX* c_rect; //!< M x N x Wp
+    LTFAT_COMPLEX* fwork;  //!< L x Wp
+    LTFAT_NAME(idgtreal_long_plan)* rect; //!< Used if there is no shear
+    LTFAT_NAME_COMPLEX(idgt_long_plan)* rect_plan;
+    LTFAT_NAME_REAL(ifft_plan)* if_plan;
+    const LTFAT_COMPLEX* c;
+    LTFAT_REAL* f;
+};
+
+struct LTFAT_NAME(dgtreal_shearola_plan)
+{
+    LTFAT_NAME(dgtreal_shear_plan)* plan;
+    ltfat_int bl;
+    ltfat_int gl;
+    ltfat_int W;
+    ltfat_int a;
+    ltfat_int M2;
+    LTFAT_REAL* buf;     //!< Zero-extended block, (bl + gl) x W
+    LTFAT_COMPLEX* cbuf; //!< Coefficients of the block, M2 x Nblocke x W
+};
+
+// long is only "at least 32 bit"
+static inline long long ltfat_positiverem_long(long long a, long long b)
+{
+    const long long c = a % b;
+    return (c < 0 ? c + b : c);
+}
+
+static inline ltfat_int
+LTFAT_NAME(dgtreal_shear_mirror)(ltfat_int m, ltfat_int M, int halfshift)
+{
+    return ltfat_positiverem(-m - halfshift, M);
+}
+
+/* Follows the index computations of dgt_shear_execute. For each
+ * coefficient of the rectangular lattice, it finds its position in the
+ * output and the index to finalmod. Checks that the mapping is
+ * a bijection and finds the frequency offset of each column. */
+static int
+LTFAT_NAME(dgtreal_shear_map)(ltfat_int L, ltfat_int a, ltfat_int M,
+                              ltfat_int s0, ltfat_int s1, ltfat_int br,
+                              ltfat_int outidx[], ltfat_int phsidx[],
+                              int halfshift[])
+{
+    ltfat_int b = L / M;
+    ltfat_int N = L / a;
+    long long twoN = 2 * N;
+    ltfat_int* offset = NULL;
+    char* visited = NULL;
+    int status = LTFATERR_SUCCESS;
+
+    if (s0 == 0)
+    {
+        CHECK(LTFATERR_BADARG, br == b, "br must be equal to L/M=%td when s0==0", b);
+    }
+    else
+    {
+        /* The sheared rectangular lattice ar x br, ar = a*b/br, must divide
+         * L and its atoms must land on the time positions n*a, which
+         * requires ar/a = b/br and s0*br/a to be integers */
+        CHECK(LTFATERR_BADARG, !(b % br) && !(L % (a * b / br)) &&
+              !((s0 * br) % a),
+              "The shear parameters s0=%td, br=%td are not compatible with a=%td, M=%td",
+              s0, br, a, M);
+    }
+
+    CHECKMEM( offset = LTFAT_NEWARRAY(ltfat_int, N));
+    CHECKMEM( visited = LTFAT_NEWARRAY(char, M * N));
+    for (ltfat_int n = 0; n < N; n++) offset[n] = -1;
+
+    if (s0 == 0)
+    {
+        const long long cc3 = ltfat_positiverem_long(s1 * (L + 1), twoN);
+        const long long tmp1 = ltfat_positiverem_long(cc3 * a, twoN);
+
+        for (ltfat_int k = 0; k < N; k++)
+        {
+            long long phs = ltfat_positiverem_long((tmp1 * k) % twoN * k, twoN);
+            const long long part1 = ltfat_positiverem_long(-s1 * k * a, L);
+            offset[k] = part1 % b;
+
+            for (ltfat_int m = 0; m < M; m++)
+            {
+                outidx[m + k * M] = ((part1 + b * m) % L) / b + k * M;
+                phsidx[m + k * M] = phs;
+            }
+        }
+    }
+    else
+    {
+        ltfat_int ar = a * b / br;
+        ltfat_int Mr = L / br;
+        ltfat_int Nr = L / ar;
+        const long long cc1 = ar / a;
+        const long long cc2 = ltfat_positiverem_long(-s0 * br / a, twoN);
+        const long long cc3 = ltfat_positiverem_long(a * s1 * (L + 1), twoN);
+        const long long cc4 = ltfat_positiverem_long(cc2 * br * (L + 1), twoN);
+        const long long cc5 = ltfat_positiverem_long(2 * cc1 * br, twoN);
+        const long long cc6 = ltfat_positiverem_long((s0 * s1 + 1) * br, L);
+
+        for (ltfat_int k = 0; k < Nr; k++)
+        {
+            const long long part1 = ltfat_positiverem_long(-s1 * k * ar, L);
+            for (ltfat_int m = 0; m < Mr; m++)
+            {
+                const long long sq1 = k * cc1 + cc2 * m;
+                const long long pos = (part1 + cc6 * m) % L;
+                ltfat_int n = sq1 % N;
+                ltfat_int inidx = ltfat_positiverem(-k, Nr) + m * Nr;
+
+                outidx[inidx] = pos / b + n * M;
+                phsidx[inidx] = ltfat_positiverem_long(
+                                    (cc3 * sq1 * sq1) % twoN - (m * (cc4 * m + k * cc5)) % twoN,
+                                    twoN);
+
+                CHECK(LTFATERR_BADARG, offset[n] < 0 || offset[n] == pos % b,
+                      "The shear parameters do not describe a lattice");
+                offset[n] = pos % b;
+            }
+        }
+    }
+
+    for (ltfat_int ii = 0; ii < M * N; ii++)
+    {
+        CHECK(LTFATERR_BADARG, !visited[outidx[ii]],
+              "The shear parameters do not describe a lattice");
+        visited[outidx[ii]] = 1;
+    }
+
+    for (ltfat_int n = 0; n < N; n++)
+    {
+        CHECK(LTFATERR_NOTSUPPORTED, offset[n] == 0 || 2 * offset[n] == b,
+              "The lattice is not symmetric, only rectangular and quincunx lattices are supported");
+        halfshift[n] = offset[n] != 0;
+    }
+
+error:
+    LTFAT_SAFEFREEALL(offset, visited);
+    return status;
+}
+
+static int
+LTFAT_NAME(dgtreal_shear_checkargs)(const LTFAT_REAL g[], ltfat_int L,
+                                    ltfat_int W, ltfat_int a, ltfat_int M,
+                                    ltfat_int br, void* plan)
+{
+    ltfat_int minL;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(g); CHECKNULL(plan);
+    CHECK(LTFATERR_BADSIZE, L > 0, "L (passed %td) must be positive", L);
+    CHECK(LTFATERR_NOTPOSARG, W > 0, "W must be positive");
+    CHECK(LTFATERR_NOTPOSARG, a > 0, "a must be positive");
+    CHECK(LTFATERR_NOTPOSARG, M > 0, "M must be positive");
+    CHECK(LTFATERR_NOTPOSARG, br > 0, "br must be positive");
+
+    minL = ltfat_lcm(a, M);
+    CHECK(LTFATERR_BADTRALEN, !(L % minL),
+          "L must divisible by lcm(a,M)=%td.", minL);
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtreal_shear)(const LTFAT_REAL f[], const LTFAT_REAL g[],
+                          ltfat_int L, ltfat_int W, ltfat_int a, ltfat_int M,
+                          ltfat_int s0, ltfat_int s1, ltfat_int br,
+                          LTFAT_COMPLEX c[])
+{
+    LTFAT_NAME(dgtreal_shear_plan)* plan = NULL;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(f); CHECKNULL(c);
+
+    CHECKSTATUS(
+        LTFAT_NAME(dgtreal_shear_init)(g, L, W, a, M, s0, s1, br, f, c,
+                                       FFTW_ESTIMATE, &plan));
+
+    LTFAT_NAME(dgtreal_shear_execute)(plan);
+
+    LTFAT_NAME(dgtreal_shear_done)(&plan);
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtreal_shear_init)(const LTFAT_REAL g[], ltfat_int L, ltfat_int W,
+                               ltfat_int a, ltfat_int M,
+                               ltfat_int s0, ltfat_int s1, ltfat_int br,
+                               const LTFAT_REAL f[], LTFAT_COMPLEX c[],
+                               unsigned flags,
+                               LTFAT_NAME(dgtreal_shear_plan)** pout)
+{
+    LTFAT_NAME(dgtreal_shear_plan)* p = NULL;
+    ltfat_int* outidx = NULL, *phsidx = NULL;
+    LTFAT_COMPLEX* gc = NULL;
+    ltfat_int N;
+    int status = LTFATERR_SUCCESS;
+
+    CHECKSTATUS( LTFAT_NAME(dgtreal_shear_checkargs)(g, L, W, a, M, br, pout));
+    CHECKMEM( p = LTFAT_NEW(LTFAT_NAME(dgtreal_shear_plan)));
+
+    N = L / a;
+    p->L = L; p->W = W; p->M = M; p->N = N;
+    p->Wp = (W + 1) / 2;
+    p->f = f; p->c = c;
+
+    CHECKMEM( p->halfshift = LTFAT_NEWARRAY(int, N));
+    CHECKMEM( outidx = LTFAT_NEWARRAY(ltfat_int, M * N));
+    CHECKMEM( phsidx = LTFAT_NEWARRAY(ltfat_int, M * N));
+    CHECKSTATUS( LTFAT_NAME(dgtreal_shear_map)(L, a, M, s0, s1, br,
+                 outidx, phsidx, p->halfshift));
+
+    if (s0 == 0 && s1 == 0)
+    {
+        CHECKSTATUS(
+            LTFAT_NAME(dgtreal_long_init)(g, L, W, a, M, f, c, LTFAT_FREQINV,
+                                          flags, &p->rect));
+    }
+    else
+    {
+        CHECKMEM( p->fpack = LTFAT_NAME_COMPLEX(malloc)(L * p->Wp));
+        CHECKMEM( p->cpack = LTFAT_NAME_COMPLEX(malloc)(M * N * p->Wp));
+        CHECKMEM( gc = LTFAT_NAME_COMPLEX(malloc)(L));
+        for (ltfat_int l = 0; l < L; l++) gc[l] = g[l];
+
+        /* The window is only used during init */
+        p->shear = LTFAT_NAME(dgt_shear_init)(p->fpack, gc, L, p->Wp, a, M,
+                                              s0, s1, br, p->cpack, flags);
+        p->has_shear = 1;
+        CHECK(LTFATERR_INITFAILED, p->shear.rect_plan && p->shear.c_rect &&
+              p->shear.finalmod, "Shear DGT plan creation failed");
+    }
+
+    LTFAT_SAFEFREEALL(outidx, phsidx, gc);
+    *pout = p;
+    return status;
+error:
+    LTFAT_SAFEFREEALL(outidx, phsidx, gc);
+    if (p) LTFAT_NAME(dgtreal_shear_done)(&p);
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtreal_shear_execute)(LTFAT_NAME(dgtreal_shear_plan)* p)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+    CHECKNULL(p->f); CHECKNULL(p->c);
+    return LTFAT_NAME(dgtreal_shear_execute_newarray)(p, p->f, p->c);
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtreal_shear_execute_newarray)(LTFAT_NAME(dgtreal_shear_plan)* p,
+        const LTFAT_REAL f[], LTFAT_COMPLEX c[])
+{
+    ltfat_int L, M, M2, N;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(f); CHECKNULL(c);
+
+    if (p->rect)
+        return LTFAT_NAME(dgtreal_long_execute_newarray)(p->rect, f, c);
+
+    L = p->L; M = p->M; M2 = M / 2 + 1; N = p->N;
+
+    /* Channel 2*j goes to the real and channel 2*j+1 to the imaginary part */
+    for (ltfat_int j = 0; j < p->Wp; j++)
+    {
+        LTFAT_REAL* fp = (LTFAT_REAL*) (p->fpack + j * L);
+        const LTFAT_REAL* fre = f + 2 * j * L;
+        const LTFAT_REAL* fim = 2 * j + 1 < p->W ? fre + L : NULL;
+
+        for (ltfat_int l = 0; l < L; l++)
+        {
+            fp[2 * l]     = fre[l];
+            fp[2 * l + 1] = fim ? fim[l] : (LTFAT_REAL) 0.0;
+        }
+    }
+
+    LTFAT_NAME(dgt_shear_execute)(p->shear);
+
+    /* Separate the channels using the conjugate symmetry of the lattice */
+    for (ltfat_int j = 0; j < p->Wp; j++)
+    {
+        int has_im = 2 * j + 1 < p->W;
+        for (ltfat_int n = 0; n < N; n++)
+        {
+            const LTFAT_REAL* cp = (const LTFAT_REAL*) (p->cpack + n * M + j * M * N);
+            LTFAT_REAL* cre = (LTFAT_REAL*) (c + n * M2 + 2 * j * M2 * N);
+            LTFAT_REAL* cim = cre + 2 * M2 * N;
+
+            for (ltfat_int m = 0; m < M2; m++)
+            {
+                ltfat_int mm = LTFAT_NAME(dgtreal_shear_mirror)(m, M, p->halfshift[n]);
+                LTFAT_REAL zr = cp[2 * m], zi = cp[2 * m + 1];
+                LTFAT_REAL mr = cp[2 * mm], mi = -cp[2 * mm + 1];
+
+                cre[2 * m]     = (LTFAT_REAL) 0.5 * (zr + mr);
+                cre[2 * m + 1] = (LTFAT_REAL) 0.5 * (zi + mi);
+
+                if (has_im)
+                {
+                    cim[2 * m]     = (LTFAT_REAL) 0.5 * (zi - mi);
+                    cim[2 * m + 1] = (LTFAT_REAL) 0.5 * (mr - zr);
+                }
+            }
+        }
+    }
+
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtreal_shear_done)(LTFAT_NAME(dgtreal_shear_plan)** plan)
+{
+    LTFAT_NAME(dgtreal_shear_plan)* p;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(plan); CHECKNULL(*plan);
+    p = *plan;
+
+    if (p->rect) LTFAT_NAME(dgtreal_long_done)(&p->rect);
+    if (p->has_shear) LTFAT_NAME(dgt_shear_done)(p->shear);
+
+    LTFAT_SAFEFREEALL(p->halfshift, p->fpack, p->cpack);
+    ltfat_free(p);
+    *plan = NULL;
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(idgtreal_shear)(const LTFAT_COMPLEX c[], const LTFAT_REAL g[],
+                           ltfat_int L, ltfat_int W, ltfat_int a, ltfat_int M,
+                           ltfat_int s0, ltfat_int s1, ltfat_int br,
+                           LTFAT_REAL f[])
+{
+    LTFAT_NAME(idgtreal_shear_plan)* plan = NULL;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(c); CHECKNULL(f);
+
+    CHECKSTATUS(
+        LTFAT_NAME(idgtreal_shear_init)(g, L, W, a, M, s0, s1, br, c, f,
+                                        FFTW_ESTIMATE, &plan));
+
+    LTFAT_NAME(idgtreal_shear_execute)(plan);
+
+    LTFAT_NAME(idgtreal_shear_done)(&plan);
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(idgtreal_shear_init)(const LTFAT_REAL g[], ltfat_int L, ltfat_int W,
+                                ltfat_int a, ltfat_int M,
+                                ltfat_int s0, ltfat_int s1, ltfat_int br,
+                                const LTFAT_COMPLEX c[], LTFAT_REAL f[],
+                                unsigned flags,
+                                LTFAT_NAME(idgtreal_shear_plan)** pout)
+{
+    LTFAT_NAME(idgtreal_shear_plan)* p = NULL;
+    LTFAT_NAME_REAL(fft_plan)* g_plan = NULL;
+    LTFAT_COMPLEX* gwork = NULL;
+    ltfat_int N;
+    int status = LTFATERR_SUCCESS;
+
+    CHECKSTATUS( LTFAT_NAME(dgtreal_shear_checkargs)(g, L, W, a, M, br, pout));
+    CHECKMEM( p = LTFAT_NEW(LTFAT_NAME(idgtreal_shear_plan)));
+
+    N = L / a;
+    p->L = L; p->W = W; p->M = M; p->N = N;
+    p->Wp = (W + 1) / 2;
+    p->s0 = s0; p->s1 = s1;
+    p->c = c; p->f = f;
+
+    CHECKMEM( p->halfshift = LTFAT_NEWARRAY(int, N));
+    CHECKMEM( p->outidx = LTFAT_NEWARRAY(ltfat_int, M * N));
+    CHECKMEM( p->phsidx = LTFAT_NEWARRAY(ltfat_int, M * N));
+    CHECKSTATUS( LTFAT_NAME(dgtreal_shear_map)(L, a, M, s0, s1, br,
+                 p->outidx, p->phsidx, p->halfshift));
+
+    if (s0 == 0 && s1 == 0)
+    {
+        CHECKSTATUS(
+            LTFAT_NAME(idgtreal_long_init)(g, L, W, a, M, NULL, f, LTFAT_FREQINV,
+                                           flags | FFTW_ESTIMATE, &p->rect));
+        LTFAT_SAFEFREEALL(p->outidx, p->phsidx);
+        p->outidx = NULL; p->phsidx = NULL;
+        *pout = p;
+        return status;
+    }
+
+    /* The synthesis is the adjoint of dgt_shear with the window g */
+    CHECKMEM( p->finalmod = LTFAT_NAME_COMPLEX(malloc)(2 * N));
+    CHECKMEM( p->c_rect = LTFAT_NAME_COMPLEX(malloc)(M * N * p->Wp));
+    CHECKMEM( p->fwork = LTFAT_NAME_COMPLEX(malloc)(L * p->Wp));
+    CHECKMEM( gwork = LTFAT_NAME_COMPLEX(malloc)(L));
+
+    for (ltfat_int n = 0; n < 2 * N; n++)
+    {
+        LTFAT_REAL* fm = (LTFAT_REAL*) (p->finalmod + n);
+        LTFAT_REAL phs = (LTFAT_REAL) M_PI * (LTFAT_REAL) n / ((LTFAT_REAL) N);
+        fm[0] = cos(phs);
+        fm[1] = sin(phs);
+    }
+
+    for (ltfat_int l = 0; l < L; l++) gwork[l] = g[l];
+
+    if (s1)
+    {
+        CHECKMEM( p->p1 = LTFAT_NAME_COMPLEX(malloc)(L));
+        LTFAT_NAME(pchirp)(L, s1, p->p1);
+        for (ltfat_int l = 0; l < L; l++) gwork[l] *= p->p1[l];
+    }
+
+    if (s0 == 0)
+    {
+        CHECKSTATUS(
+            LTFAT_NAME_COMPLEX(idgt_long_init)(gwork, L, p->Wp, a, M,
+                                               p->c_rect, p->fwork, LTFAT_FREQINV,
+                                               flags, &p->rect_plan));
+    }
+    else
+    {
+        ltfat_int b  = L / M;
+        ltfat_int ar = a * b / br;
+        ltfat_int Nr = L / ar;
+
+        CHECKMEM( p->p0 = LTFAT_NAME_COMPLEX(malloc)(L));
+        LTFAT_NAME(pchirp)(L, -s0, p->p0);
+
+        CHECKSTATUS(
+            LTFAT_NAME_REAL(fft_init)(L, 1, gwork, gwork, FFTW_ESTIMATE, &g_plan));
+        LTFAT_NAME_REAL(fft_execute)(g_plan);
+
+        for (ltfat_int l = 0; l < L; l++)
+            gwork[l] = gwork[l] * p->p0[l] / ((LTFAT_REAL) L);
+
+        CHECKSTATUS(
+            LTFAT_NAME_REAL(ifft_init)(L, p->Wp, p->fwork, p->fwork, flags,
+                                       &p->if_plan));
+        CHECKSTATUS(
+            LTFAT_NAME_COMPLEX(idgt_long_init)(gwork, L, p->Wp, br, Nr,
+                                               p->c_rect, p->fwork, LTFAT_FREQINV,
+                                               flags, &p->rect_plan));
+    }
+
+    if (g_plan) LTFAT_NAME_REAL(fft_done)(&g_plan);
+    ltfat_safefree(gwork);
+    *pout = p;
+    return status;
+error:
+    if (g_plan) LTFAT_NAME_REAL(fft_done)(&g_plan);
+    ltfat_safefree(gwork);
+    if (p) LTFAT_NAME(idgtreal_shear_done)(&p);
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(idgtreal_shear_execute)(LTFAT_NAME(idgtreal_shear_plan)* p)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+    CHECKNULL(p->c); CHECKNULL(p->f);
+    return LTFAT_NAME(idgtreal_shear_execute_newarray)(p, p->c, p->f);
+error:
+    return status;
+}
+
+/* Coefficient at (m,n) of the full, conjugate symmetric set. ccol points to
+ * column n of the M2 kept channels. */
+static inline void
+LTFAT_NAME(idgtreal_shear_symval)(const LTFAT_REAL ccol[], ltfat_int M,
+                                  int halfshift, ltfat_int m,
+                                  LTFAT_REAL* re, LTFAT_REAL* im)
+{
+    ltfat_int M2 = M / 2 + 1;
+    ltfat_int mm = LTFAT_NAME(dgtreal_shear_mirror)(m, M, halfshift);
+    LTFAT_REAL xr, xi, yr, yi;
+
+    /* x is the value at m, y is the conjugated value at the mirror */
+    if (m < M2) { xr = ccol[2 * m]; xi = ccol[2 * m + 1]; }
+    else        { xr = ccol[2 * mm]; xi = -ccol[2 * mm + 1]; }
+
+    if (mm < M2) { yr = ccol[2 * mm]; yi = -ccol[2 * mm + 1]; }
+    else         { yr = ccol[2 * m]; yi = ccol[2 * m + 1]; }
+
+    *re = (LTFAT_REAL) 0.5 * (xr + yr);
+    *im = (LTFAT_REAL) 0.5 * (xi + yi);
+}
+
+LTFAT_API int
+LTFAT_NAME(idgtreal_shear_execute_newarray)(LTFAT_NAME(idgtreal_shear_plan)* p,
+        const LTFAT_COMPLEX c[], LTFAT_REAL f[])
+{
+    ltfat_int L, M, M2, N;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(c); CHECKNULL(f);
+
+    if (p->rect)
+        return LTFAT_NAME(idgtreal_long_execute_newarray)(p->rect, c, f);
+
+    L = p->L; M = p->M; M2 = M / 2 + 1; N = p->N;
+
+    /* Pack pairs of channels and undo the final modulation and reordering */
+    for (ltfat_int j = 0; j < p->Wp; j++)
+    {
+        const LTFAT_REAL* cre = (const LTFAT_REAL*) (c + 2 * j * M2 * N);
+        const LTFAT_REAL* cim = 2 * j + 1 < p->W ? cre + 2 * M2 * N : NULL;
+        LTFAT_COMPLEX* crect = p->c_rect + j * M * N;
+
+        for (ltfat_int ii = 0; ii < M * N; ii++)
+        {
+            ltfat_int n = p->outidx[ii] / M;
+            ltfat_int m = p->outidx[ii] % M;
+            LTFAT_REAL ar, ai, br = 0, bi = 0;
+            LTFAT_COMPLEX z;
+            LTFAT_REAL* zp = (LTFAT_REAL*) &z;
+
+            LTFAT_NAME(idgtreal_shear_symval)(cre + 2 * n * M2, M,
+                                              p->halfshift[n], m, &ar, &ai);
+            if (cim)
+                LTFAT_NAME(idgtreal_shear_symval)(cim + 2 * n * M2, M,
+                                                  p->halfshift[n], m, &br, &bi);
+
+            zp[0] = ar - bi;
+            zp[1] = ai + br;
+            crect[ii] = z * conj(p->finalmod[p->phsidx[ii]]);
+        }
+    }
+
+    LTFAT_NAME_COMPLEX(idgt_long_execute)(p->rect_plan);
+
+    if (p->s0)
+    {
+        for (ltfat_int j = 0; j < p->Wp; j++)
+            for (ltfat_int l = 0; l < L; l++)
+                p->fwork[l + j * L] *= conj(p->p0[l]);
+
+        LTFAT_NAME_REAL(ifft_execute)(p->if_plan);
+    }
+
+    if (p->s1)
+    {
+        for (ltfat_int j = 0; j < p->Wp; j++)
+            for (ltfat_int l = 0; l < L; l++)
+                p->fwork[l + j * L] *= conj(p->p1[l]);
+    }
+
+    for (ltfat_int j = 0; j < p->Wp; j++)
+    {
+        const LTFAT_REAL* fp = (const LTFAT_REAL*) (p->fwork + j * L);
+        LTFAT_REAL* fre = f + 2 * j * L;
+
+        for (ltfat_int l = 0; l < L; l++)
+            fre[l] = fp[2 * l];
+
+        if (2 * j + 1 < p->W)
+        {
+            LTFAT_REAL* fim = fre + L;
+            for (ltfat_int l = 0; l < L; l++)
+                fim[l] = fp[2 * l + 1];
+        }
+    }
+
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(idgtreal_shear_done)(LTFAT_NAME(idgtreal_shear_plan)** plan)
+{
+    LTFAT_NAME(idgtreal_shear_plan)* p;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(plan); CHECKNULL(*plan);
+    p = *plan;
+
+    if (p->rect) LTFAT_NAME(idgtreal_long_done)(&p->rect);
+    if (p->rect_plan) LTFAT_NAME_COMPLEX(idgt_long_done)(&p->rect_plan);
+    if (p->if_plan) LTFAT_NAME_REAL(ifft_done)(&p->if_plan);
+
+    LTFAT_SAFEFREEALL(p->halfshift, p->outidx, p->phsidx, p->finalmod,
+                      p->p0, p->p1, p->c_rect, p->fwork);
+    ltfat_free(p);
+    *plan = NULL;
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtreal_shearola)(const LTFAT_REAL f[], const LTFAT_REAL g[],
+                             ltfat_int L, ltfat_int gl, ltfat_int W,
+                             ltfat_int a, ltfat_int M,
+                             ltfat_int s0, ltfat_int s1, ltfat_int br,
+                             ltfat_int bl, LTFAT_COMPLEX c[])
+{
+    LTFAT_NAME(dgtreal_shearola_plan)* plan = NULL;
+    int status = LTFATERR_SUCCESS;
+
+    CHECKSTATUS(
+        LTFAT_NAME(dgtreal_shearola_init)(g, gl, W, a, M, s0, s1, br, bl,
+                                          FFTW_ESTIMATE, &plan));
+
+    status = LTFAT_NAME(dgtreal_shearola_execute)(plan, f, L, c);
+
+    LTFAT_NAME(dgtreal_shearola_done)(&plan);
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtreal_shearola_init)(const LTFAT_REAL g[], ltfat_int gl,
+                                  ltfat_int W, ltfat_int a, ltfat_int M,
+                                  ltfat_int s0, ltfat_int s1, ltfat_int br,
+                                  ltfat_int bl, unsigned flags,
+                                  LTFAT_NAME(dgtreal_shearola_plan)** pout)
+{
+    LTFAT_NAME(dgtreal_shearola_plan)* p = NULL;
+    LTFAT_REAL* gext = NULL;
+    ltfat_int Lext;
+    int status = LTFATERR_SUCCESS;
+
+    CHECKNULL(g); CHECKNULL(pout);
+    CHECK(LTFATERR_NOTPOSARG, gl > 0, "gl must be positive");
+    CHECK(LTFATERR_NOTPOSARG, bl > 0, "bl must be positive");
+    CHECK(LTFATERR_NOTPOSARG, W > 0, "W must be positive");
+    CHECK(LTFATERR_NOTPOSARG, a > 0, "a must be positive");
+    CHECK(LTFATERR_NOTPOSARG, M > 0, "M must be positive");
+    CHECK(LTFATERR_BADTRALEN, !(bl % a), "bl must be divisible by a=%td", a);
+    CHECK(LTFATERR_BADARG, !(gl % (2 * a)), "gl must be divisible by 2*a=%td",
+          2 * a);
+
+    CHECKMEM( p = LTFAT_NEW(LTFAT_NAME(dgtreal_shearola_plan)));
+
+    Lext = bl + gl;
+    p->bl = bl; p->gl = gl; p->W = W; p->a = a; p->M2 = M / 2 + 1;
+
+    /* The last gl samples of each channel stay zero */
+    CHECKMEM( p->buf = LTFAT_NAME_REAL(calloc)(Lext * W));
+    CHECKMEM( p->cbuf = LTFAT_NAME_COMPLEX(malloc)(p->M2 * (Lext / a) * W));
+    CHECKMEM( gext = LTFAT_NAME_REAL(malloc)(Lext));
+    LTFAT_NAME_REAL(fir2long)(g, gl, Lext, gext);
+
+    CHECKSTATUS(
+        LTFAT_NAME(dgtreal_shear_init)(gext, Lext, W, a, M, s0, s1, br,
+                                       p->buf, p->cbuf, flags, &p->plan));
+
+    ltfat_safefree(gext);
+    *pout = p;
+    return status;
+error:
+    ltfat_safefree(gext);
+    if (p) LTFAT_NAME(dgtreal_shearola_done)(&p);
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtreal_shearola_execute)(LTFAT_NAME(dgtreal_shearola_plan)* p,
+                                     const LTFAT_REAL f[], ltfat_int L,
+                                     LTFAT_COMPLEX c[])
+{
+    ltfat_int bl, gl, M2, N, Lext, Nb, b2, Nblock, Nblocke, W;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(f); CHECKNULL(c);
+    CHECK(LTFATERR_BADTRALEN, L > 0 && !(L % p->bl),
+          "L must be a positive multiple of bl=%td", p->bl);
+
+    bl      = p->bl;
+    gl      = p->gl;
+    M2      = p->M2;
+    W       = p->W;
+    N       = L / p->a;
+    Lext    = bl + gl;
+    Nb      = L / bl;
+    b2      = gl / p->a / 2;
+    Nblock  = bl / p->a;
+    Nblocke = Lext / p->a;
+
+    /* Zero the output array, as we will be adding to it */
+    memset(c, 0, M2 * N * W * sizeof * c);
+
+    for (ltfat_int ii = 0; ii < Nb; ii++)
+    {
+        ltfat_int s_ii;
+
+        for (ltfat_int w = 0; w < W; w++)
+            memcpy(p->buf + Lext * w, f + ii * bl + w * L, bl * sizeof * f);
+
+        LTFAT_NAME(dgtreal_shear_execute)(p->plan);
+
+        for (ltfat_int w = 0; w < W; w++)
+        {
+            /* Place large block */
+            LTFAT_COMPLEX* c_p    = c + ii * M2 * Nblock + w * M2 * N;
+            LTFAT_COMPLEX* cbuf_p = p->cbuf + w * M2 * Nblocke;
+            for (ltfat_int ii2 = 0; ii2 < M2 * Nblock; ii2++)
+                c_p[ii2] += cbuf_p[ii2];
+
+            /* Small block + */
+            s_ii = ltfat_positiverem(ii + 1, Nb);
+            c_p    = c + s_ii * M2 * Nblock + w * M2 * N;
+            cbuf_p = p->cbuf + M2 * Nblock + w * M2 * Nblocke;
+            for (ltfat_int ii2 = 0; ii2 < M2 * b2; ii2++)
+                c_p[ii2] += cbuf_p[ii2];
+
+            /* Small block - */
+            s_ii = ltfat_positiverem(ii - 1, Nb) + 1;
+            c_p    = c + M2 * (s_ii * Nblock - b2) + w * M2 * N;
+            cbuf_p = p->cbuf + M2 * (Nblock + b2) + w * M2 * Nblocke;
+            for (ltfat_int ii2 = 0; ii2 < M2 * b2; ii2++)
+                c_p[ii2] += cbuf_p[ii2];
+        }
+    }
+
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtreal_shearola_done)(LTFAT_NAME(dgtreal_shearola_plan)** plan)
+{
+    LTFAT_NAME(dgtreal_shearola_plan)* p;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(plan); CHECKNULL(*plan);
+    p = *plan;
+
+    if (p->plan) LTFAT_NAME(dgtreal_shear_done)(&p->plan);
+
+    LTFAT_SAFEFREEALL(p->buf, p->cbuf);
+    ltfat_free(p);
+    *plan = NULL;
+error:
+    return status;
+}
@@ -1,4 +1,5 @@
 #include "dgtrealmp_private.h"
+#include "dgtwrapper_private.h"
 
 LTFAT_REAL
 LTFAT_NAME(pedantic_callback)(void* userdata,
@@ -117,11 +118,9 @@ LTFAT_NAME(dgtrealmp_init_gen)(
     if (p->params->iterstep == 0)
         p->params->iterstep = p->params->maxit;
 
-#ifdef NOBLASLAPACK
-    CHECK( LTFATERR_NOBLASLAPACK,
-           p->params->alg != ltfat_dgtmp_alg_locomp,
-           "LocOMP requires LAPACK, but libltfat was compiled without it.");
-#endif
+    CHECK( LTFATERR_BADARG,
+           p->params->batchatoms == 1 || p->params->alg == ltfat_dgtmp_alg_mp,
+           "Selecting more atoms per iteration is only supported by plain MP.");
 
     p->params->initwasrun = 1;
 
@@ -141,6 +140,20 @@ LTFAT_NAME(dgtrealmp_init_gen)(
         p->M2[k] = M[k] / 2 + 1; p->N[k] = L / a[k];
     }
 
+    // Windows for the local DGTs of dgtrealmp_execute_redecompose
+    if (p->params->do_redecompose)
+    {
+        CHECKMEM( p->g  = LTFAT_NEWARRAY( LTFAT_REAL*, P));
+        CHECKMEM( p->gl = LTFAT_NEWARRAY( ltfat_int, P));
+
+        for (ltfat_int k = 0; k < P; k++)
+        {
+            p->gl[k] = gl[k];
+            CHECKMEM( p->g[k] = LTFAT_NAME_REAL(malloc)(gl[k]));
+            memcpy(p->g[k], g[k], gl[k] * sizeof * p->g[k]);
+        }
+    }
+
     p->P = P; p->L = L;
 
     CHECKMEM( dgtparams = ltfat_dgt_params_allocdef());
@@ -232,18 +245,31 @@ LTFAT_NAME(dgtrealmp_init_gen)(
         p->params->do_pedantic = 1;
     }
 
+    if (p->params->batchatoms > 1)
+    {
+        ltfat_int K = (ltfat_int) p->params->batchatoms;
+        p->iterstate->batchCandMax = LTFAT_DGTREALMP_BATCHCANDS * K;
+        CHECKMEM( p->iterstate->batchPos = LTFAT_NEWARRAY( kpoint, K ));
+        CHECKMEM( p->iterstate->batchCval = LTFAT_NAME_COMPLEX(malloc)( K ));
+        CHECKMEM( p->iterstate->batchRange = LTFAT_NEWARRAY( krange, K * P ));
+        CHECKMEM( p->iterstate->batchCandPos =
+                      LTFAT_NEWARRAY( kpoint, p->iterstate->batchCandMax ));
+        CHECKMEM( p->iterstate->batchCandVal =
+                      LTFAT_NAME_REAL(malloc)( p->iterstate->batchCandMax ));
+    }
+
     if (p->params->ptype == LTFAT_FREQINV)
     {
-        CHECKMEM(p->iterstate->cvalModBuf = LTFAT_NEWARRAY(LTFAT_COMPLEX*, P * P));
-        for (ltfat_int k1 = 0; k1 < P; k1++)
+        // One set of buffers for each atom updated concurrently
+        ltfat_int bufNo = P * P * (ltfat_int) p->params->batchatoms;
+        CHECKMEM(p->iterstate->cvalModBuf = LTFAT_NEWARRAY(LTFAT_COMPLEX*, bufNo));
+        p->iterstate->cvalModBufNo = bufNo;
+        for (ltfat_int bIdx = 0; bIdx < bufNo; bIdx++)
         {
-            for (ltfat_int k2 = 0; k2 < P; k2++)
-            {
-                LTFAT_NAME(kerns)* currkern = p->gramkerns[k1 + k2 * P];
-                ltfat_int h2 = ltfat_idivceil( currkern->size.height , currkern->Mstep);
-                CHECKMEM(p->iterstate->cvalModBuf[k1 + k2 * P] =
-                             LTFAT_NAME_COMPLEX(malloc)( h2));
-            }
+            LTFAT_NAME(kerns)* currkern = p->gramkerns[bIdx % (P * P)];
+            ltfat_int h2 = ltfat_idivceil( currkern->size.height , currkern->Mstep);
+            CHECKMEM(p->iterstate->cvalModBuf[bIdx] =
+                         LTFAT_NAME_COMPLEX(malloc)( h2));
         }
     }
 
@@ -298,6 +324,17 @@ LTFAT_NAME(dgtrealmp_reset)(LTFAT_NAME(dgtrealmp_state)* p, const LTFAT_REAL* f)
     istate->currit = 0;
     istate->curratoms = 0;
     istate->err = 0.0;
+    istate->tfindmax = 0.0;
+    istate->tupdate = 0.0;
+    istate->tstep = 0.0;
+
+    if (p->params->do_redecompose)
+    {
+        if (!p->f)
+            CHECKMEM( p->f = LTFAT_NAME_REAL(malloc)(p->L));
+        if (p->f != f)
+            memcpy(p->f, f, p->L * sizeof * p->f);
+    }
 
     for (ltfat_int l = 0; l < p->L; l++)
         istate->err += f[l] * f[l];
@@ -328,6 +365,7 @@ LTFAT_NAME(dgtrealmp_reset)(LTFAT_NAME(dgtrealmp_state)* p, const LTFAT_REAL* f)
         memset( p->iterstate->suppind[k], 0 ,
                 p->M2[k] * p->N[k] * sizeof * p->iterstate->suppind[k] );
     }
+    istate->suppListNo = 0;
 
     kpoint origpos;
     LTFAT_NAME(dgtrealmp_execute_findmaxatom)(p, &origpos);
@@ -347,6 +385,8 @@ LTFAT_NAME(dgtrealmp_execute_niters)(
     int status = LTFAT_DGTREALMP_STATUS_CANCONTINUE;
 
     LTFAT_NAME(dgtrealmpiter_state)* s = p->iterstate;
+    int do_profile = p->params->do_profile;
+    long long tstart = 0;
 
     if (s->fnorm2 == 0.0)
         return LTFAT_DGTREALMP_STATUS_EMPTY;
@@ -359,10 +399,19 @@ LTFAT_NAME(dgtrealmp_execute_niters)(
 
         s->currit++;
 
+        if (do_profile) tstart = ltfat_monotonic_ns();
+
         if ( LTFAT_NAME(dgtrealmp_execute_findmaxatom)(p, &origpos)
              != LTFATERR_SUCCESS )
             return LTFAT_DGTREALMP_STATUS_EMPTY;
 
+        if (do_profile)
+        {
+            long long tnow = ltfat_monotonic_ns();
+            s->tfindmax += 1e-9 * (tnow - tstart);
+            tstart = tnow;
+        }
+
         if (ltfat_norm(s->c[PTOI(origpos)]) < p->params->atprodreltoladj)
         {
             printf("At prod: %.6f \n",10.0*log10(ltfat_norm(s->c[PTOI(origpos)])));
@@ -374,8 +423,27 @@ LTFAT_NAME(dgtrealmp_execute_niters)(
         switch ( p->params->alg)
         {
         case ltfat_dgtmp_alg_mp:
-            s->err -= LTFAT_NAME(dgtrealmp_execute_mp)( p, s->c[PTOI(origpos)], origpos,
-                      cout);
+            if (p->params->batchatoms > 1)
+            {
+                size_t atomsNo, maxextra = p->params->batchatoms - 1;
+                size_t atomsleft = s->curratoms < p->params->maxatoms ?
+                                   p->params->maxatoms - s->curratoms : 0;
+                size_t itleft = s->currit < p->params->maxit ?
+                                p->params->maxit - s->currit : 0;
+                // Do not run past itno, the callers rely on it e.g. for iterstep
+                size_t callleft = itno - iter - 1;
+                if (maxextra > atomsleft) maxextra = atomsleft;
+                if (maxextra > itleft)    maxextra = itleft;
+                if (maxextra > callleft)  maxextra = callleft;
+
+                s->err -= LTFAT_NAME(dgtrealmp_execute_batchmp)( p, origpos, maxextra,
+                          cout, &atomsNo);
+                s->currit += atomsNo - 1;
+                iter += atomsNo - 1;
+            }
+            else
+                s->err -= LTFAT_NAME(dgtrealmp_execute_mp)( p, s->c[PTOI(origpos)], origpos,
+                          cout);
             break;
         case ltfat_dgtmp_alg_locomp:
             status  = LTFAT_NAME(dgtrealmp_execute_locomp)( p, origpos, cout);
@@ -388,6 +456,8 @@ LTFAT_NAME(dgtrealmp_execute_niters)(
             break;
         }
 
+        if (do_profile) s->tstep += 1e-9 * (ltfat_monotonic_ns() - tstart);
+
         if (s->err < 0)
             return LTFAT_DGTREALMP_STATUS_STALLED;
 
@@ -470,8 +540,6 @@ LTFAT_NAME(dgtrealmp_execute_decompose)(
     LTFAT_NAME(dgtrealmp_state)* p, const LTFAT_REAL f[], LTFAT_COMPLEX* c[])
 {
     int status = LTFATERR_SUCCESS;
-    int status2 = LTFATERR_SUCCESS;
-    int statuscallback = LTFATERR_SUCCESS;
 
     CHECKNULL(p); CHECKNULL(f); CHECKNULL(c);
 
@@ -483,6 +551,19 @@ LTFAT_NAME(dgtrealmp_execute_decompose)(
         memset(c[k], 0, p->M2[k] * p->N[k] * sizeof * c[k]);
     }
 
+    return LTFAT_NAME(dgtrealmp_execute_resume)(p, c);
+error:
+    return status;
+}
+
+int
+LTFAT_NAME(dgtrealmp_execute_resume)(
+    LTFAT_NAME(dgtrealmp_state)* p, LTFAT_COMPLEX* c[])
+{
+    int status = LTFATERR_SUCCESS;
+    int status2 = LTFATERR_SUCCESS;
+    int statuscallback = LTFATERR_SUCCESS;
+
     while ( LTFAT_DGTREALMP_STATUS_CANCONTINUE ==
             ( status2 = LTFAT_NAME(dgtrealmp_execute_niters)(
                             p, p->params->iterstep, c)))
@@ -514,6 +595,30 @@ LTFAT_NAME(dgtrealmp_done)( LTFAT_NAME(dgtrealmp_state)** p)
 
     LTFAT_SAFEFREEALL(pp->a,pp->M,pp->M2,pp->N,pp->chanmask,pp->couttmp);
 
+    if (pp->catoms)
+    {
+        for (ltfat_int k = 0; k < pp->P; k++)
+            ltfat_safefree(pp->catoms[k]);
+        ltfat_free(pp->catoms);
+    }
+
+    if (pp->g)
+    {
+        for (ltfat_int k = 0; k < pp->P; k++)
+            ltfat_safefree(pp->g[k]);
+        ltfat_free(pp->g);
+    }
+
+    if (pp->fbplans)
+    {
+        for (ltfat_int k = 0; k < pp->P; k++)
+            if (pp->fbplans[k])
+                LTFAT_NAME(dgtreal_fb_done)(&pp->fbplans[k]);
+        ltfat_free(pp->fbplans);
+    }
+
+    LTFAT_SAFEFREEALL(pp->gl, pp->f);
+
 
     if (pp->params)
         ltfat_dgtmp_params_free(pp->params);
@@ -573,6 +678,8 @@ LTFAT_NAME(dgtrealmpiter_init)(
     CHECKMEM( s->maxcolspos =  LTFAT_NEWARRAY(ltfat_int*, P));
     CHECKMEM( s->tmaxtree =  LTFAT_NEWARRAY( LTFAT_NAME(maxtree)*, P));
     CHECKMEM( s->fmaxtree =  LTFAT_NEWARRAY( LTFAT_NAME(maxtree)**, P));
+    CHECKMEM( s->dictmax    = LTFAT_NAME_REAL(calloc)(P) );
+    CHECKMEM( s->dictmaxpos = LTFAT_NEWARRAY(ltfat_int, P));
     s->P = P;
 
     for (ltfat_int p = 0; p < P; p++)
@@ -584,17 +691,13 @@ LTFAT_NAME(dgtrealmpiter_init)(
         CHECKMEM( s->suppind[p] = LTFAT_NEWARRAY(unsigned int, N * M2 ));
         CHECKMEM( s->maxcols[p]    = LTFAT_NAME_REAL(malloc)(N) );
         CHECKMEM( s->maxcolspos[p] = LTFAT_NEWARRAY(ltfat_int, N) );
-        CHECKSTATUS( LTFAT_NAME(maxtree_init)(N, N,
-                                              ltfat_imax(0, ltfat_pow2base(ltfat_nextpow2(N)) - 4),
-                                              &s->tmaxtree[p]));
+        CHECKSTATUS( LTFAT_NAME(maxtree_initblocked)(N, N, &s->tmaxtree[p]));
 
         CHECKMEM( s->fmaxtree[p] = LTFAT_NEWARRAY(LTFAT_NAME(maxtree)*, N));
         for (ltfat_int n = 0; n < N; n++ )
         {
-            CHECKSTATUS( LTFAT_NAME(maxtree_init)(
-                             M2, M[p],
-                             ltfat_imax(0, ltfat_pow2base(ltfat_nextpow2(M[p])) - 4),
-                             &s->fmaxtree[p][n]));
+            CHECKSTATUS( LTFAT_NAME(maxtree_initblocked)(
+                             M2, M[p], &s->fmaxtree[p][n]));
         }
 
     }
@@ -631,6 +734,8 @@ LTFAT_NAME(dgtrealmpiter_done)(LTFAT_NAME(dgtrealmpiter_state)** state)
         ltfat_free(s->suppind);
     }
 
+    ltfat_safefree(s->suppList);
+
     if (s->maxcols)
     {
         for (ltfat_int p = 0; p < s->P; p++)
@@ -670,12 +775,16 @@ LTFAT_NAME(dgtrealmpiter_done)(LTFAT_NAME(dgtrealmpiter_state)** state)
 
     if (s->cvalModBuf)
     {
-        for (ltfat_int p = 0; p < s->P * s->P; p++)
+        for (ltfat_int p = 0; p < s->cvalModBufNo; p++)
             ltfat_safefree(s->cvalModBuf[p]);
 
         ltfat_free(s->cvalModBuf);
     }
 
+    LTFAT_SAFEFREEALL(s->batchPos, s->batchCval, s->batchRange,
+                      s->batchCandPos, s->batchCandVal);
+    ltfat_safefree(s->dictmax);
+    ltfat_safefree(s->dictmaxpos);
     ltfat_safefree(s->gramBuf);
     ltfat_safefree(s->cvalBuf);
     ltfat_safefree(s->cvalinvBuf);
@@ -776,6 +885,24 @@ error:
     return status;
 }
 
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_get_stagetimes)(
+    const LTFAT_NAME(dgtrealmp_state)* p,
+    double* findmax, double* update, double* select)
+{
+    int status = LTFATERR_SUCCESS;
+    LTFAT_NAME(dgtrealmpiter_state)* s;
+    CHECKNULL(p); CHECKNULL(findmax); CHECKNULL(update); CHECKNULL(select);
+    s = p->iterstate;
+
+    *findmax = s->tfindmax;
+    *update = s->tupdate;
+    /* Residual updates done by dgtrealmp_revert are not part of any step */
+    *select = s->tstep > s->tupdate ? s->tstep - s->tupdate : 0.0;
+error:
+    return status;
+}
+
 LTFAT_API ltfat_int
 LTFAT_NAME(dgtrealmp_get_dictno)(
     const LTFAT_NAME(dgtrealmp_state)* p)
@@ -0,0 +1,328 @@
+#include "ltfat.h"
+#include "ltfat/types.h"
+#include "ltfat/macros.h"
+#include "dgtrealmp_private.h"
+#include <stdint.h>
+#include <stdlib.h>
+
+#define LTFAT_DGTREALMP_ATOMS_HEADERLEN 16
+#define LTFAT_DGTREALMP_ATOMS_VERSION 1
+
+/* Dense coefficient buffers used when the caller works with atom lists */
+static int
+LTFAT_NAME(dgtrealmp_atoms_densebuf)(LTFAT_NAME(dgtrealmp_state)* p)
+{
+    int status = LTFATERR_SUCCESS;
+
+    if (p->catoms) return status;
+
+    CHECKMEM( p->catoms = LTFAT_NEWARRAY(LTFAT_COMPLEX*, p->P));
+    for (ltfat_int k = 0; k < p->P; k++)
+        CHECKMEM( p->catoms[k] = LTFAT_NAME_COMPLEX(malloc)(p->M2[k] * p->N[k]));
+
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_coefs2atoms)(
+    const LTFAT_NAME(dgtrealmp_state)* p, const LTFAT_COMPLEX* c[],
+    LTFAT_NAME(dgtrealmp_atom) atoms[], size_t atomsLen, size_t* atomsNo)
+{
+    int status = LTFATERR_SUCCESS;
+    size_t atIdx = 0;
+    CHECKNULL(p); CHECKNULL(c); CHECKNULL(atoms); CHECKNULL(atomsNo);
+
+    for (ltfat_int k = 0; k < p->P; k++)
+    {
+        CHECKNULL(c[k]);
+        for (ltfat_int n = 0; n < p->N[k]; n++)
+        {
+            const LTFAT_COMPLEX* cCol = c[k] + n * p->M2[k];
+            for (ltfat_int m = 0; m < p->M2[k]; m++)
+            {
+                if (ltfat_real(cCol[m]) == 0 && ltfat_imag(cCol[m]) == 0)
+                    continue;
+
+                CHECK(LTFATERR_BADREQSIZE, atIdx < atomsLen,
+                      "atoms is too short (passed %zu)", atomsLen);
+
+                atoms[atIdx].w = k;
+                atoms[atIdx].m = m;
+                atoms[atIdx].n = n;
+                atoms[atIdx].c = cCol[m];
+                atIdx++;
+            }
+        }
+    }
+
+    *atomsNo = atIdx;
+error:
+    return status;
+}
+
+/* Orders by dictionary, time and frequency like dgtrealmp_coefs2atoms */
+static int
+ltfat_dgtrealmp_atoms_kpointcmp(const void* a, const void* b)
+{
+    const kpoint* ka = (const kpoint*) a;
+    const kpoint* kb = (const kpoint*) b;
+
+    if (ka->w != kb->w) return ka->w < kb->w ? -1 : 1;
+    if (ka->n != kb->n) return ka->n < kb->n ? -1 : 1;
+    if (ka->m != kb->m) return ka->m < kb->m ? -1 : 1;
+    return 0;
+}
+
+/* Atom list from the support recorded during the decomposition, the cost
+ * depends on the number of atoms rather than on the number of coefficients */
+static int
+LTFAT_NAME(dgtrealmp_supp2atoms)(
+    LTFAT_NAME(dgtrealmp_state)* p, const LTFAT_COMPLEX* c[],
+    LTFAT_NAME(dgtrealmp_atom) atoms[], size_t atomsLen, size_t* atomsNo)
+{
+    int status = LTFATERR_SUCCESS;
+    LTFAT_NAME(dgtrealmpiter_state)* s = p->iterstate;
+    size_t atIdx = 0;
+
+    LTFAT_NAME(dgtrealmp_supplist_compact)(p);
+    qsort(s->suppList, s->suppListNo, sizeof * s->suppList,
+          ltfat_dgtrealmp_atoms_kpointcmp);
+
+    for (size_t ii = 0; ii < s->suppListNo; ii++)
+    {
+        kpoint pos = s->suppList[ii];
+        LTFAT_COMPLEX cval = c[PTOI(pos)];
+
+        if (ltfat_real(cval) == 0 && ltfat_imag(cval) == 0)
+            continue;
+
+        CHECK(LTFATERR_BADREQSIZE, atIdx < atomsLen,
+              "atoms is too short (passed %zu)", atomsLen);
+
+        atoms[atIdx].w = pos.w;
+        atoms[atIdx].m = pos.m;
+        atoms[atIdx].n = pos.n;
+        atoms[atIdx].c = cval;
+        atIdx++;
+    }
+
+    *atomsNo = atIdx;
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_execute_decompose_atoms)(
+    LTFAT_NAME(dgtrealmp_state)* p, const LTFAT_REAL f[],
+    LTFAT_NAME(dgtrealmp_atom) atoms[], size_t atomsLen, size_t* atomsNo)
+{
+    int status = LTFATERR_SUCCESS;
+    int status2 = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(f); CHECKNULL(atoms); CHECKNULL(atomsNo);
+
+    CHECKSTATUS( LTFAT_NAME(dgtrealmp_atoms_densebuf)(p));
+
+    if (!p->iterstate->suppList)
+    {
+        p->iterstate->suppListLen = p->params->maxatoms + p->params->batchatoms;
+        CHECKMEM( p->iterstate->suppList =
+                      LTFAT_NEWARRAY(kpoint, p->iterstate->suppListLen));
+    }
+
+    CHECKSTATUS( status2 =
+                     LTFAT_NAME(dgtrealmp_execute_decompose)(p, f, p->catoms));
+
+    // The list is dropped if it could not grow
+    if (p->iterstate->suppList)
+        CHECKSTATUS(
+            LTFAT_NAME(dgtrealmp_supp2atoms)(p, (const LTFAT_COMPLEX**) p->catoms,
+                                             atoms, atomsLen, atomsNo));
+    else
+        CHECKSTATUS(
+            LTFAT_NAME(dgtrealmp_coefs2atoms)(p, (const LTFAT_COMPLEX**) p->catoms,
+                                              atoms, atomsLen, atomsNo));
+
+    return status2;
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_execute_synthesize_atoms)(
+    LTFAT_NAME(dgtrealmp_state)* p, const LTFAT_NAME(dgtrealmp_atom) atoms[],
+    size_t atomsNo, LTFAT_REAL f[])
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(atoms); CHECKNULL(f);
+
+    CHECKSTATUS( LTFAT_NAME(dgtrealmp_atoms_densebuf)(p));
+
+    for (ltfat_int k = 0; k < p->P; k++)
+        memset(p->catoms[k], 0, p->M2[k] * p->N[k] * sizeof * p->catoms[k]);
+
+    for (size_t atIdx = 0; atIdx < atomsNo; atIdx++)
+    {
+        ltfat_int w = atoms[atIdx].w, m = atoms[atIdx].m, n = atoms[atIdx].n;
+
+        CHECK(LTFATERR_NOTINRANGE, w >= 0 && w < p->P &&
+              m >= 0 && m < p->M2[w] && n >= 0 && n < p->N[w],
+              "Atom %zu lies outside of the dictionaries", atIdx);
+
+        p->catoms[w][n * p->M2[w] + m] += atoms[atIdx].c;
+    }
+
+    CHECKSTATUS(
+        LTFAT_NAME(dgtrealmp_execute_synthesize)(
+            p, (const LTFAT_COMPLEX**) p->catoms, p->chanmask, f));
+
+error:
+    return status;
+}
+
+LTFAT_API size_t
+LTFAT_NAME(dgtrealmp_atoms_packedlen)(size_t atomsNo)
+{
+    return LTFAT_DGTREALMP_ATOMS_HEADERLEN +
+           atomsNo * (2 + 4 + 4 + 2 * sizeof(LTFAT_REAL));
+}
+
+static inline void
+ltfat_dgtrealmp_atoms_putle(unsigned char* buf, uint64_t val, int bytes)
+{
+    for (int b = 0; b < bytes; b++)
+        buf[b] = (unsigned char) (val >> (8 * b));
+}
+
+static inline uint64_t
+ltfat_dgtrealmp_atoms_getle(const unsigned char* buf, int bytes)
+{
+    uint64_t val = 0;
+    for (int b = 0; b < bytes; b++)
+        val |= ((uint64_t) buf[b]) << (8 * b);
+    return val;
+}
+
+/* IEEE 754 values are moved through integers of the same size so that the
+ * byte order does not depend on the host */
+static inline void
+LTFAT_NAME(dgtrealmp_atoms_putreal)(unsigned char* buf, LTFAT_REAL val)
+{
+#ifdef LTFAT_DOUBLE
+    uint64_t bits;
+#else
+    uint32_t bits;
+#endif
+    memcpy(&bits, &val, sizeof val);
+    ltfat_dgtrealmp_atoms_putle(buf, bits, sizeof val);
+}
+
+static inline LTFAT_REAL
+LTFAT_NAME(dgtrealmp_atoms_getreal)(const unsigned char* buf, int bytes)
+{
+    uint64_t bits = ltfat_dgtrealmp_atoms_getle(buf, bytes);
+    if (bytes == 8)
+    {
+        double val;
+        memcpy(&val, &bits, sizeof val);
+        return (LTFAT_REAL) val;
+    }
+    else
+    {
+        uint32_t bits32 = (uint32_t) bits;
+        float val;
+        memcpy(&val, &bits32, sizeof val);
+        return (LTFAT_REAL) val;
+    }
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_atoms_pack)(
+    const LTFAT_NAME(dgtrealmp_atom) atoms[], size_t atomsNo,
+    unsigned char buf[])
+{
+    int status = LTFATERR_SUCCESS;
+    unsigned char* bufPtr = buf + LTFAT_DGTREALMP_ATOMS_HEADERLEN;
+    CHECKNULL(buf);
+    if (atomsNo > 0) CHECKNULL(atoms);
+
+    memcpy(buf, "LTMP", 4);
+    buf[4] = LTFAT_DGTREALMP_ATOMS_VERSION;
+    buf[5] = sizeof(LTFAT_REAL);
+    buf[6] = 0; buf[7] = 0;
+    ltfat_dgtrealmp_atoms_putle(buf + 8, atomsNo, 8);
+
+    for (size_t atIdx = 0; atIdx < atomsNo; atIdx++)
+    {
+        const LTFAT_NAME(dgtrealmp_atom)* at = atoms + atIdx;
+
+        CHECK(LTFATERR_NOTINRANGE, at->w >= 0 && at->w <= 0xFFFF &&
+              at->m >= 0 && (uint64_t) at->m <= 0xFFFFFFFF &&
+              at->n >= 0 && (uint64_t) at->n <= 0xFFFFFFFF,
+              "Atom %zu cannot be stored", atIdx);
+
+        ltfat_dgtrealmp_atoms_putle(bufPtr, at->w, 2);
+        ltfat_dgtrealmp_atoms_putle(bufPtr + 2, at->m, 4);
+        ltfat_dgtrealmp_atoms_putle(bufPtr + 6, at->n, 4);
+        bufPtr += 10;
+        LTFAT_NAME(dgtrealmp_atoms_putreal)(bufPtr, ltfat_real(at->c));
+        bufPtr += sizeof(LTFAT_REAL);
+        LTFAT_NAME(dgtrealmp_atoms_putreal)(bufPtr, ltfat_imag(at->c));
+        bufPtr += sizeof(LTFAT_REAL);
+    }
+
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_atoms_unpack)(
+    const unsigned char buf[], size_t bufLen,
+    LTFAT_NAME(dgtrealmp_atom) atoms[], size_t atomsLen, size_t* atomsNo)
+{
+    int status = LTFATERR_SUCCESS;
+    int realbytes;
+    uint64_t atomsInBuf;
+    const unsigned char* bufPtr = buf + LTFAT_DGTREALMP_ATOMS_HEADERLEN;
+    CHECKNULL(buf); CHECKNULL(atomsNo);
+
+    CHECK(LTFATERR_BADSIZE, bufLen >= LTFAT_DGTREALMP_ATOMS_HEADERLEN,
+          "Stream is too short (passed %zu)", bufLen);
+    CHECK(LTFATERR_BADARG, memcmp(buf, "LTMP", 4) == 0,
+          "Stream does not contain atoms");
+    CHECK(LTFATERR_BADARG, buf[4] == LTFAT_DGTREALMP_ATOMS_VERSION,
+          "Unsupported stream version %d", buf[4]);
+
+    realbytes = buf[5];
+    CHECK(LTFATERR_BADARG, realbytes == 4 || realbytes == 8,
+          "Unsupported real size %d", realbytes);
+
+    atomsInBuf = ltfat_dgtrealmp_atoms_getle(buf + 8, 8);
+    CHECK(LTFATERR_BADSIZE,
+          atomsInBuf <= (bufLen - LTFAT_DGTREALMP_ATOMS_HEADERLEN) /
+          (uint64_t) (10 + 2 * realbytes), "Stream is truncated");
+
+    *atomsNo = (size_t) atomsInBuf;
+    if (!atoms) return status;
+
+    CHECK(LTFATERR_BADREQSIZE, atomsLen >= *atomsNo,
+          "atoms is too short (passed %zu, required %zu)", atomsLen, *atomsNo);
+
+    for (size_t atIdx = 0; atIdx < *atomsNo; atIdx++)
+    {
+        LTFAT_NAME(dgtrealmp_atom)* at = atoms + atIdx;
+        LTFAT_REAL* cr = (LTFAT_REAL*) &at->c;
+
+        at->w = (ltfat_int) ltfat_dgtrealmp_atoms_getle(bufPtr, 2);
+        at->m = (ltfat_int) ltfat_dgtrealmp_atoms_getle(bufPtr + 2, 4);
+        at->n = (ltfat_int) ltfat_dgtrealmp_atoms_getle(bufPtr + 6, 4);
+        bufPtr += 10;
+        cr[0] = LTFAT_NAME(dgtrealmp_atoms_getreal)(bufPtr, realbytes);
+        bufPtr += realbytes;
+        cr[1] = LTFAT_NAME(dgtrealmp_atoms_getreal)(bufPtr, realbytes);
+        bufPtr += realbytes;
+    }
+
+error:
+    return status;
+}
@@ -2,6 +2,9 @@
 #include "ltfat/types.h"
 #include "ltfat/macros.h"
 #include "dgtrealmp_private.h"
+#include "threads_private.h"
+#include "dgtwrapper_private.h"
+#include "simd_private.h"
 
 #define NLOOP \
     for ( ltfat_int nidx = n2start, knidx = kstart2.n; \
@@ -34,13 +37,41 @@ ltfat_int m2endtmp = ltfat_imin(m2end - k->srange[knidx].end, p->M2[w2]);\
 for ( ltfat_int mmidx = k->srange[knidx].start, midx = m2start + mmidx, kmidx = kstart2.m + mmidx*k->Mstep; \
     midx < m2endtmp; midx++, mmidx++, kmidx+=k->Mstep ) {body}}\
 
+/* Like MLOOPBOTH but passes whole contiguous runs of midx to body as
+ * midx0, kmidx0 and mlen. Only valid if k->Mstep == 1 */
+#define  MSEGMENTSBOTH(body){\
+ltfat_int movertmp = ltfat_imin(mover - k->srange[knidx].end, p->M2[w2]);\
+if (movertmp > 0){\
+    ltfat_int midx0 = 0, kmidx0 = kstart2.m + kdim2.height - moverM2;\
+    ltfat_int mlen = movertmp; {body}}\
+\
+ltfat_int m2endtmp = ltfat_imin(m2end - k->srange[knidx].end, p->M2[w2]);\
+ltfat_int midx0 = m2start + k->srange[knidx].start;\
+if (m2endtmp > midx0){\
+    ltfat_int kmidx0 = kstart2.m + k->srange[knidx].start;\
+    ltfat_int mlen = m2endtmp - midx0; {body}}}
+
 #define LTFAT_DGTREALMP_APPLYKERNEL(ctmp){\
 LTFAT_COMPLEX cvaltmp = ctmp;\
 if (do_substract){ LTFAT_DGTREALMP_APPLYKERNEL_SIGN(cvaltmp, -) }\
 else{              LTFAT_DGTREALMP_APPLYKERNEL_SIGN(cvaltmp, +) }}
 
 #define LTFAT_DGTREALMP_APPLYKERNEL_SIGN(ctmp, SIGN){\
-if (p->params->ptype == LTFAT_TIMEINV){\
+if (k->Mstep == 1 && p->params->ptype == LTFAT_TIMEINV){\
+NLOOPBOTH(\
+    LTFAT_COMPLEX* currcCol = s->c[w2] + nidx * p->M2[w2];\
+    LTFAT_COMPLEX* kcurrCol = k->kval + knidx * k->size.height;\
+    LTFAT_COMPLEX  cvaltmp2 = SIGN (ctmp * kexp[knidx]);\
+MSEGMENTSBOTH(\
+    LTFAT_NAME(dgtrealmp_caxpy)(currcCol + midx0, cvaltmp2, kcurrCol + kmidx0, mlen); ))}\
+else if (k->Mstep == 1 && kmod){\
+NLOOPBOTH(\
+    LTFAT_COMPLEX* currcCol = s->c[w2] + nidx * p->M2[w2];\
+    LTFAT_COMPLEX* kcurrCol = kmod + knidx * k->size.height;\
+    LTFAT_COMPLEX  cvaltmp2 = SIGN ctmp;\
+MSEGMENTSBOTH(\
+    LTFAT_NAME(dgtrealmp_caxpy)(currcCol + midx0, cvaltmp2, kcurrCol + kmidx0, mlen); ))}\
+else if (p->params->ptype == LTFAT_TIMEINV){\
 NLOOPBOTH(\
     LTFAT_COMPLEX* currcCol = s->c[w2] + nidx * p->M2[w2];\
     LTFAT_COMPLEX* kcurrCol = k->kval + knidx * k->size.height;\
@@ -50,20 +81,19 @@ MLOOPBOTH(\
 else if (p->params->ptype == LTFAT_FREQINV){\
     for(ltfat_int kmidx = kstart2.m, mmidx = 0; kmidx < k->size.height;\
         kmidx += k->Mstep, mmidx++){\
-        s->cvalModBuf[kIdx][mmidx] = ctmp * kexp[kmidx];}\
+        modbuf[mmidx] = ctmp * kexp[kmidx];}\
 NLOOPBOTH(\
     LTFAT_COMPLEX* currcCol = s->c[w2] + nidx * p->M2[w2];\
     LTFAT_COMPLEX* kcurrCol = k->kval + knidx * k->size.height;\
 MLOOPBOTH(\
-    currcCol[midx] = currcCol[midx] SIGN s->cvalModBuf[kIdx][mmidx] * kcurrCol[kmidx]; \
+    currcCol[midx] = currcCol[midx] SIGN modbuf[mmidx] * kcurrCol[kmidx]; \
     ))}}
 
 #define LTFAT_DGTREALMP_MARKMODIFIED \
 NLOOPBOTH(\
     LTFAT_NAME(maxtree_setdirty)(s->fmaxtree[w2][nidx],\
                                  m2start + k->srange[knidx].start,\
-                                 m2start + kdim2.height - k->srange[knidx].end);)\
-    LTFAT_NAME(maxtree_setdirty)(s->tmaxtree[w2],       n2start, n2start + kdim2.width);
+                                 m2start + kdim2.height - k->srange[knidx].end);)
 
 int
 LTFAT_NAME(dgtrealmp_execute_locomp)(
@@ -371,6 +401,63 @@ LTFAT_NAME(dgtrealmp_execute_cyclicmp)(
     return LTFAT_DGTREALMP_STATUS_CANCONTINUE;
 }
 
+void
+LTFAT_NAME(dgtrealmp_supplist_compact)(LTFAT_NAME(dgtrealmp_state)* p)
+{
+    LTFAT_NAME(dgtrealmpiter_state)* s = p->iterstate;
+    // The highest bit of suppind marks the positions already kept
+    const unsigned int mark = ~(~0u >> 1);
+    size_t kept = 0;
+
+    for (size_t ii = 0; ii < s->suppListNo; ii++)
+    {
+        kpoint pos = s->suppList[ii];
+        unsigned int* supp = &s->suppind[PTOI(pos)];
+
+        if (*supp && !(*supp & mark))
+        {
+            *supp |= mark;
+            s->suppList[kept++] = pos;
+        }
+    }
+
+    for (size_t ii = 0; ii < kept; ii++)
+        s->suppind[PTOI(s->suppList[ii])] &= ~mark;
+
+    s->suppListNo = kept;
+}
+
+/* Must be called before suppind of pos is incremented */
+static inline void
+LTFAT_NAME(dgtrealmp_execute_addsupp)(LTFAT_NAME(dgtrealmp_state)* p, kpoint pos)
+{
+    LTFAT_NAME(dgtrealmpiter_state)* s = p->iterstate;
+
+    if (!s->suppList || s->suppind[PTOI(pos)]) return;
+
+    if (s->suppListNo == s->suppListLen)
+    {
+        LTFAT_NAME(dgtrealmp_supplist_compact)(p);
+
+        if (2 * s->suppListNo > s->suppListLen)
+        {
+            kpoint* newList = (kpoint*) ltfat_realloc(
+                                  s->suppList, s->suppListNo * sizeof * newList,
+                                  2 * s->suppListLen * sizeof * newList);
+            // Without the list, the atom list is obtained from the coefficients
+            if (!newList)
+            {
+                ltfat_free(s->suppList); s->suppList = NULL;
+                return;
+            }
+            s->suppList = newList;
+            s->suppListLen *= 2;
+        }
+    }
+
+    s->suppList[s->suppListNo++] = pos;
+}
+
 LTFAT_REAL
 LTFAT_NAME(dgtrealmp_execute_mp)(
     LTFAT_NAME(dgtrealmp_state)* p, LTFAT_COMPLEX cval,
@@ -383,6 +470,7 @@ LTFAT_NAME(dgtrealmp_execute_mp)(
 
     LTFAT_NAME(dgtrealmp_execute_updateresiduum)( p, pos, cvaldual, 1);
 
+    LTFAT_NAME(dgtrealmp_execute_addsupp)(p, pos);
     p->iterstate->suppind[PTOI(pos)]++;
     cout[PTOI(pos)] += cvaldual;
     return projenergy;
@@ -500,80 +588,327 @@ LTFAT_NAME(dgtrealmp_execute_conjatpairprod)(
 }
 
 
-int
-LTFAT_NAME(dgtrealmp_execute_updateresiduum)(
-    LTFAT_NAME(dgtrealmp_state)* p, kpoint origpos, LTFAT_COMPLEX cval,
-    int do_substract)
+/* y[l] += alpha * x[l] for l = 0,...,len-1 */
+static inline void
+LTFAT_NAME(dgtrealmp_caxpy)(
+    LTFAT_COMPLEX* y, LTFAT_COMPLEX alpha, const LTFAT_COMPLEX* x, ltfat_int len)
 {
+    ltfat_int l = 0;
+#ifdef LTFAT_VSWAPPAIRS
+    LTFAT_REAL* yr = (LTFAT_REAL*) y;
+    const LTFAT_REAL* xr = (const LTFAT_REAL*) x;
+    LTFAT_REAL aimtmp[LTFAT_VLEN];
+    for (int v = 0; v < LTFAT_VLEN; v += 2)
+    {
+        aimtmp[v]     = -ltfat_imag(alpha);
+        aimtmp[v + 1] =  ltfat_imag(alpha);
+    }
+    ltfat_vreal are = LTFAT_VSET1(ltfat_real(alpha));
+    ltfat_vreal aim = LTFAT_VLOAD(aimtmp);
 
+    for (; l + LTFAT_VLEN / 2 <= len; l += LTFAT_VLEN / 2)
+    {
+        ltfat_vreal xv = LTFAT_VLOAD(xr + 2 * l);
+        ltfat_vreal prod = LTFAT_VADD( LTFAT_VMUL(are, xv),
+                                       LTFAT_VMUL(aim, LTFAT_VSWAPPAIRS(xv)));
+        LTFAT_VSTORE(yr + 2 * l, LTFAT_VADD(LTFAT_VLOAD(yr + 2 * l), prod));
+    }
+#endif
+    for (; l < len; l++)
+        y[l] += alpha * x[l];
+}
+
+/* Columns of dictionary w2 touched by the update of the atom at origpos,
+ * [*start, *end) with 0 <= *start < N[w2] and *end possibly wrapping over. */
+static void
+LTFAT_NAME(dgtrealmp_execute_timerange)(
+    LTFAT_NAME(dgtrealmp_state)* p, kpoint origpos, ltfat_int w2,
+    ltfat_int* start, ltfat_int* end)
+{
+    ltfat_int m2start, n2start;
+    ksize   kdim2; kanchor kmid2; kpoint  kstart2;
+    kpoint pos; pos.w = w2;
 
+    LTFAT_NAME(dgtrealmp_execute_indices)(
+        p, origpos, &pos, &m2start, &n2start, &kdim2, &kmid2, &kstart2);
+
+    *start = n2start;
+    *end   = n2start + kdim2.width;
+}
+
+/* Updates coefficients of dictionary w2. Dictionaries do not share any
+ * state here so this can run concurrently for different w2. Concurrent
+ * updates of the same dictionary must touch disjoint columns and use
+ * different slots. The time maxtree is left for the caller to mark. */
+static void
+LTFAT_NAME(dgtrealmp_execute_updateresiduum_dict)(
+    LTFAT_NAME(dgtrealmp_state)* p, kpoint origpos, LTFAT_COMPLEX cval,
+    int do_substract, ltfat_int w2, ltfat_int slot)
+{
+    ltfat_int  m2start, n2start, m2end, mover, n2end, nover, moverM2;
+    kpoint pos;
+    ksize   kdim2; kanchor kmid2; kpoint  kstart2;
+
+    LTFAT_NAME(dgtrealmpiter_state)* s = p->iterstate;
     int uniquenyquest = p->M[origpos.w] % 2 == 0;
     int do_conj = !( origpos.m == 0 ||
                      (origpos.m == p->M2[origpos.w] - 1 && uniquenyquest));
-
-    LTFAT_NAME(dgtrealmpiter_state)* s = p->iterstate;
     LTFAT_COMPLEX cval2 = conj(cval);
     kpoint origposconj = origpos;
     origposconj.m = p->M[origpos.w] - origpos.m;
 
-    /* This loop is trivially pararelizable */
+    ltfat_int kIdx = origpos.w + s->P * w2;
+    LTFAT_NAME(kerns)* k     = p->gramkerns[kIdx];
+    LTFAT_COMPLEX* kexp = LTFAT_NAME(dgtrealmp_execute_pickmod)(
+                              k, origpos.m, origpos.n, p->params->ptype);
+    LTFAT_COMPLEX* kmod = NULL;
+    if (k->kvalmod)
+        kmod = k->kvalmod[ltfat_positiverem( origpos.n * k->kSkip, k->kNo)];
+    LTFAT_COMPLEX* modbuf = NULL;
+    if (s->cvalModBuf)
+        modbuf = s->cvalModBuf[kIdx + s->P * s->P * slot];
+
+    pos.w = w2;
+    LTFAT_NAME(dgtrealmp_execute_indices)(
+        p, origpos, &pos, &m2start, &n2start, &kdim2, &kmid2, &kstart2);
+
+    m2end = m2start + kdim2.height;
+    mover = ltfat_imax(0, m2end - p->M[w2]);
+    moverM2 = mover;
+    if (kdim2.height > p->M2[w2])
+        moverM2 = kdim2.height - ltfat_imax(0, p->M[w2] - m2start);
+    /* m2start = ltfat_imin(m2start, p->M2[w2]); */
+
+    n2end = n2start + kdim2.width;
+    nover = ltfat_imax(0, n2end - p->N[w2]);
+    if (nover > 0)
+        n2end = p->N[w2];
+
+    LTFAT_DGTREALMP_APPLYKERNEL(cval)
+
+    LTFAT_DGTREALMP_MARKMODIFIED
+
+    ltfat_int posinkern  = kmid2.hmid - 2 * pos.m;
+    ltfat_int posinkern2 = kmid2.hmid + 2 * (p->M2[w2] - 1 - pos.m) + 1 -
+                           uniquenyquest ;
+    if (do_conj)
+    {
+        if (posinkern >= 0 || posinkern2 < kdim2.height)
+        {
+            kexp = LTFAT_NAME(dgtrealmp_execute_pickmod)(
+                       k, origposconj.m, origpos.n, p->params->ptype);
+
+            LTFAT_NAME(dgtrealmp_execute_indices)(
+                p, origposconj, &pos, &m2start, &n2start, &kdim2, &kmid2, &kstart2);
+
+            m2end = m2start + kdim2.height;
+            mover = ltfat_imax(0, m2end - p->M[w2]);
+            moverM2 = mover;
+            if (kdim2.height > p->M2[w2])
+                moverM2 = kdim2.height - ltfat_imax(0, p->M[w2] - m2start);
+            /* m2end = ltfat_imin(m2end, p->M2[w2]); */
+
+            LTFAT_DGTREALMP_APPLYKERNEL(cval2)
+        }
+    }
+}
+
+int
+LTFAT_NAME(dgtrealmp_execute_updateresiduum)(
+    LTFAT_NAME(dgtrealmp_state)* p, kpoint origpos, LTFAT_COMPLEX cval,
+    int do_substract)
+{
+    LTFAT_NAME(dgtrealmpiter_state)* s = p->iterstate;
+    int nthreads = ltfat_usablethreads(p->params->nthreads);
+    ltfat_int work = 0;
+    long long tstart = p->params->do_profile ? ltfat_monotonic_ns() : 0;
+
+    if (nthreads > 1)
+        for (ltfat_int w2 = 0; w2 < s->P; w2++)
+        {
+            LTFAT_NAME(kerns)* k = p->gramkerns[origpos.w + s->P * w2];
+            work += k->size.height * k->size.width;
+        }
+
+#ifdef _OPENMP
+    #pragma omp parallel for num_threads(nthreads) schedule(dynamic, 1) \
+        if(nthreads > 1 && work >= LTFAT_DGTREALMP_PARALLEL_MINWORK)
+#endif
+    for (ltfat_int w2 = 0; w2 < s->P; w2++)
+        LTFAT_NAME(dgtrealmp_execute_updateresiduum_dict)(
+            p, origpos, cval, do_substract, w2, 0);
+
     for (ltfat_int w2 = 0; w2 < s->P; w2++)
     {
-        ltfat_int  m2start, n2start, m2end, mover, n2end, nover, moverM2;
-        kpoint pos;
-        ksize   kdim2; kanchor kmid2; kpoint  kstart2;
+        ltfat_int start, end;
+        LTFAT_NAME(dgtrealmp_execute_timerange)(p, origpos, w2, &start, &end);
+        LTFAT_NAME(maxtree_setdirty)(s->tmaxtree[w2], start, end);
+    }
 
-        ltfat_int kIdx = origpos.w + s->P * w2;
-        LTFAT_NAME(kerns)* k     = p->gramkerns[kIdx];
-        LTFAT_COMPLEX* kexp = LTFAT_NAME(dgtrealmp_execute_pickmod)(
-                                  k, origpos.m, origpos.n, p->params->ptype);
+    if (p->params->do_profile) s->tupdate += 1e-9 * (ltfat_monotonic_ns() - tstart);
 
-        pos.w = w2;
-        LTFAT_NAME(dgtrealmp_execute_indices)(
-            p, origpos, &pos, &m2start, &n2start, &kdim2, &kmid2, &kstart2);
+    return 0;
+}
 
-        m2end = m2start + kdim2.height;
-        mover = ltfat_imax(0, m2end - p->M[w2]);
-        moverM2 = mover;
-        if (kdim2.height > p->M2[w2])
-            moverM2 = kdim2.height - ltfat_imax(0, p->M[w2] - m2start);
-        /* m2start = ltfat_imin(m2start, p->M2[w2]); */
+/* Circular intervals [s1,e1) and [s2,e2) modulo N */
+static inline int
+ltfat_dgtrealmp_rangesoverlap(ltfat_int s1, ltfat_int e1,
+                              ltfat_int s2, ltfat_int e2, ltfat_int N)
+{
+    return ltfat_positiverem(s2 - s1, N) < e1 - s1 ||
+           ltfat_positiverem(s1 - s2, N) < e2 - s2;
+}
 
-        n2end = n2start + kdim2.width;
-        nover = ltfat_imax(0, n2end - p->N[w2]);
-        if (nover > 0)
-            n2end = p->N[w2];
+LTFAT_REAL
+LTFAT_NAME(dgtrealmp_execute_batchmp)(
+    LTFAT_NAME(dgtrealmp_state)* p, kpoint origpos, size_t maxextra,
+    LTFAT_COMPLEX** cout, size_t* atomsNo)
+{
+    LTFAT_NAME(dgtrealmpiter_state)* s = p->iterstate;
+    ltfat_int P = s->P;
+    ltfat_int candNo = 0, candMax = s->batchCandMax;
+    size_t posNo = 0;
+    LTFAT_REAL projenergy = 0;
+    int nthreads = ltfat_usablethreads(p->params->nthreads);
+    ltfat_int work = 0;
+    long long tstart;
+
+    /* The largest atom comes first, the maxima were refreshed by findmaxatom */
+    LTFAT_REAL thr = (LTFAT_REAL) LTFAT_DGTREALMP_BATCHMINREL *
+                     s->maxcols[origpos.w][origpos.n];
+
+    s->batchPos[posNo++] = origpos;
+
+    /* Largest column maxima in descending order. They are taken from the
+     * time maxtrees one at a time, the columns already taken are masked
+     * in the meantime. */
+    if (maxextra > 0)
+    {
+        while (candNo < candMax)
+        {
+            LTFAT_REAL val = -1;
+            ltfat_int w = 0, n = 0;
 
-        LTFAT_DGTREALMP_APPLYKERNEL(cval)
+            /* The first dictionary wins ties, like in findmaxatom */
+            for (ltfat_int k = 0; k < P; k++)
+            {
+                LTFAT_REAL kval; ltfat_int kn;
+                LTFAT_NAME(maxtree_findmax)(s->tmaxtree[k], &kval, &kn);
+                if (kval > val) { val = kval; w = k; n = kn; }
+            }
 
-        LTFAT_DGTREALMP_MARKMODIFIED
+            if (val < thr) break;
 
-        ltfat_int posinkern  = kmid2.hmid - 2 * pos.m;
-        ltfat_int posinkern2 = kmid2.hmid + 2 * (p->M2[w2] - 1 - pos.m) + 1 -
-                               uniquenyquest ;
-        if (do_conj)
+            s->batchCandVal[candNo] = val;
+            s->batchCandPos[candNo++] = kpoint_init(s->maxcolspos[w][n], n, w);
+            s->maxcols[w][n] = -1;
+            LTFAT_NAME(maxtree_updaterange)(s->tmaxtree[w], n, n + 1);
+        }
+
+        for (ltfat_int cIdx = 0; cIdx < candNo; cIdx++)
+        {
+            kpoint cpos = s->batchCandPos[cIdx];
+            s->maxcols[cpos.w][cpos.n] = s->batchCandVal[cIdx];
+            LTFAT_NAME(maxtree_updaterange)(s->tmaxtree[cpos.w], cpos.n, cpos.n + 1);
+        }
+    }
+
+    for (ltfat_int w2 = 0; w2 < P; w2++)
+        LTFAT_NAME(dgtrealmp_execute_timerange)(
+            p, origpos, w2, &s->batchRange[w2].start, &s->batchRange[w2].end);
+
+    /* Greedily add candidates not interacting with any atom taken so far */
+    for (ltfat_int cIdx = 0; cIdx < candNo && posNo <= maxextra; cIdx++)
+    {
+        kpoint cpos = s->batchCandPos[cIdx];
+        krange* crange = s->batchRange + posNo * P;
+        int overlaps = 0;
+
+        for (ltfat_int w2 = 0; w2 < P && !overlaps; w2++)
         {
-            if (posinkern >= 0 || posinkern2 < kdim2.height)
+            LTFAT_NAME(dgtrealmp_execute_timerange)(
+                p, cpos, w2, &crange[w2].start, &crange[w2].end);
+
+            for (size_t bIdx = 0; bIdx < posNo && !overlaps; bIdx++)
             {
-                kexp = LTFAT_NAME(dgtrealmp_execute_pickmod)(
-                           k, origposconj.m, origpos.n, p->params->ptype);
+                krange* brange = s->batchRange + bIdx * P + w2;
+                overlaps = ltfat_dgtrealmp_rangesoverlap(
+                               brange->start, brange->end,
+                               crange[w2].start, crange[w2].end, p->N[w2]);
+            }
+        }
 
-                LTFAT_NAME(dgtrealmp_execute_indices)(
-                    p, origposconj, &pos, &m2start, &n2start, &kdim2, &kmid2, &kstart2);
+        if (!overlaps)
+            s->batchPos[posNo++] = cpos;
+    }
+
+    /* The atoms do not interact so their coefficients are still valid */
+    for (size_t bIdx = 0; bIdx < posNo; bIdx++)
+    {
+        LTFAT_REAL atenergy;
+        kpoint pos = s->batchPos[bIdx];
+        LTFAT_NAME(dgtrealmp_execute_dualprodandprojenergy)(
+            p, pos, s->c[PTOI(pos)], &s->batchCval[bIdx], &atenergy);
+        projenergy += atenergy;
+
+        if (nthreads > 1)
+            for (ltfat_int w2 = 0; w2 < P; w2++)
+            {
+                LTFAT_NAME(kerns)* k = p->gramkerns[pos.w + P * w2];
+                work += k->size.height * k->size.width;
+            }
+    }
+
+    tstart = p->params->do_profile ? ltfat_monotonic_ns() : 0;
 
-                m2end = m2start + kdim2.height;
-                mover = ltfat_imax(0, m2end - p->M[w2]);
-                moverM2 = mover;
-                if (kdim2.height > p->M2[w2])
-                    moverM2 = kdim2.height - ltfat_imax(0, p->M[w2] - m2start);
-                /* m2end = ltfat_imin(m2end, p->M2[w2]); */
+#ifdef _OPENMP
+    #pragma omp parallel for num_threads(nthreads) schedule(dynamic, 1) \
+        if(nthreads > 1 && work >= LTFAT_DGTREALMP_PARALLEL_MINWORK)
+#endif
+    for (ltfat_int tIdx = 0; tIdx < (ltfat_int) posNo * P; tIdx++)
+        LTFAT_NAME(dgtrealmp_execute_updateresiduum_dict)(
+            p, s->batchPos[tIdx / P], s->batchCval[tIdx / P], 1,
+            tIdx % P, tIdx / P);
+
+    if (p->params->do_profile) s->tupdate += 1e-9 * (ltfat_monotonic_ns() - tstart);
+
+    /* Marking the time maxtrees dirty would merge the ranges into a single
+     * one possibly spanning the whole signal. The touched columns are
+     * refreshed here instead. */
+#ifdef _OPENMP
+    #pragma omp parallel for num_threads(nthreads) schedule(dynamic, 1) \
+        if(nthreads > 1 && work >= LTFAT_DGTREALMP_PARALLEL_MINWORK)
+#endif
+    for (ltfat_int w2 = 0; w2 < P; w2++)
+        for (size_t bIdx = 0; bIdx < posNo; bIdx++)
+        {
+            krange* brange = s->batchRange + bIdx * P + w2;
+            ltfat_int N = p->N[w2];
+            ltfat_int end = ltfat_imin(brange->end, brange->start + N);
 
-                LTFAT_DGTREALMP_APPLYKERNEL(cval2)
+            for (ltfat_int n = brange->start; n < end; n++)
+            {
+                ltfat_int nidx = n < N ? n : n - N;
+                LTFAT_NAME(maxtree_findmax)( s->fmaxtree[w2][nidx],
+                                             &s->maxcols[w2][nidx],
+                                             &s->maxcolspos[w2][nidx]);
             }
+
+            LTFAT_NAME(maxtree_updaterange)(s->tmaxtree[w2], brange->start, end);
         }
 
+    for (size_t bIdx = 0; bIdx < posNo; bIdx++)
+    {
+        kpoint pos = s->batchPos[bIdx];
+
+        if ( bIdx > 0 && !s->suppind[PTOI(pos)] ) s->curratoms++;
+        LTFAT_NAME(dgtrealmp_execute_addsupp)(p, pos);
+        s->suppind[PTOI(pos)]++;
+        cout[PTOI(pos)] += s->batchCval[bIdx];
     }
-    return 0;
+
+    *atomsNo = posNo;
+    return projenergy;
 }
 
 inline LTFAT_COMPLEX*
@@ -622,47 +957,99 @@ LTFAT_NAME(dgtrealmp_execute_indices)(
     return 0;
 }
 
-int
-LTFAT_NAME(dgtrealmp_execute_findmaxatom)(
-    LTFAT_NAME(dgtrealmp_state)* p, kpoint* pos)
+/* Refreshes maxima of columns [dirtystart,dirtyend) modulo N */
+static void
+LTFAT_NAME(dgtrealmp_execute_refreshcols)(
+    LTFAT_NAME(dgtrealmp_state)* p, ltfat_int k,
+    ltfat_int dirtystart, ltfat_int dirtyend)
 {
     LTFAT_NAME(dgtrealmpiter_state)* s = p->iterstate;
-    LTFAT_REAL val = 0.0;
-    int retval = LTFATERR_CANNOTHAPPEN;
+    ltfat_int N = p->N[k];
 
-    for (ltfat_int k = 0; k < s->P; k++)
+    ltfat_int over = 0;
+    if (dirtyend - dirtystart >= N)
+    {
+        // Several updates spread over the whole signal
+        dirtystart = 0;
+        dirtyend = N;
+    }
+    else
     {
-        LTFAT_REAL valTmp; ltfat_int nTmp;
-        ltfat_int dirtystart, dirtyend;
-        LTFAT_NAME(maxtree_getdirty)(s->tmaxtree[k], &dirtystart, &dirtyend);
-
-        ltfat_int N = p->N[k];
-
         dirtystart = ltfat_positiverem(dirtystart, N);
         dirtyend =   ltfat_positiverem(dirtyend,   N);
 
-        ltfat_int over = 0;
         if (dirtyend < dirtystart)
         {
             over = dirtyend;
             dirtyend = N;
         }
+    }
+
+    for (ltfat_int nidx = 0; nidx < over; nidx++)
+        LTFAT_NAME(maxtree_findmax)( s->fmaxtree[k][nidx],
+                                     &s->maxcols[k][nidx],
+                                     &s->maxcolspos[k][nidx]);
+
+    for (ltfat_int nidx = dirtystart; nidx < dirtyend; nidx++)
+        LTFAT_NAME(maxtree_findmax)( s->fmaxtree[k][nidx],
+                                     &s->maxcols[k][nidx],
+                                     &s->maxcolspos[k][nidx]);
+}
+
+/* Refreshes maxima of the modified columns of dictionary k */
+static void
+LTFAT_NAME(dgtrealmp_execute_findmaxatom_dict)(
+    LTFAT_NAME(dgtrealmp_state)* p, ltfat_int k)
+{
+    LTFAT_NAME(dgtrealmpiter_state)* s = p->iterstate;
+    const ltfat_int* dirtystarts;
+    const ltfat_int* dirtyends;
 
-        for (ltfat_int nidx = 0; nidx < over; nidx++)
-            LTFAT_NAME(maxtree_findmax)( s->fmaxtree[k][nidx],
-                                         &s->maxcols[k][nidx],
-                                         &s->maxcolspos[k][nidx]);
+    /* Disjoint ranges avoid refreshing the columns in between */
+    ltfat_int rangesNo =
+        LTFAT_NAME(maxtree_getdirtyranges)(s->tmaxtree[k],
+                                           &dirtystarts, &dirtyends);
 
-        for (ltfat_int nidx = dirtystart; nidx < dirtyend; nidx++)
-            LTFAT_NAME(maxtree_findmax)( s->fmaxtree[k][nidx],
-                                         &s->maxcols[k][nidx],
-                                         &s->maxcolspos[k][nidx]);
+    for (ltfat_int r = 0; r < rangesNo; r++)
+        LTFAT_NAME(dgtrealmp_execute_refreshcols)(p, k, dirtystarts[r],
+                dirtyends[r]);
 
-        LTFAT_NAME(maxtree_findmax)(s->tmaxtree[k], &valTmp, &nTmp);
+    LTFAT_NAME(maxtree_findmax)(s->tmaxtree[k], &s->dictmax[k],
+                                &s->dictmaxpos[k]);
+}
 
-        if ( valTmp > val )
+int
+LTFAT_NAME(dgtrealmp_execute_findmaxatom)(
+    LTFAT_NAME(dgtrealmp_state)* p, kpoint* pos)
+{
+    LTFAT_NAME(dgtrealmpiter_state)* s = p->iterstate;
+    LTFAT_REAL val = 0.0;
+    int retval = LTFATERR_CANNOTHAPPEN;
+    int nthreads = ltfat_usablethreads(p->params->nthreads);
+    ltfat_int work = 0;
+
+    if (nthreads > 1)
+        for (ltfat_int k = 0; k < s->P; k++)
+        {
+            ltfat_int dirtystart, dirtyend;
+            LTFAT_NAME(maxtree_getdirty)(s->tmaxtree[k], &dirtystart, &dirtyend);
+            work += ltfat_imin(dirtyend - dirtystart, p->N[k]) * p->M2[k];
+        }
+
+#ifdef _OPENMP
+    #pragma omp parallel for num_threads(nthreads) schedule(dynamic, 1) \
+        if(nthreads > 1 && work >= LTFAT_DGTREALMP_PARALLEL_MINWORK)
+#endif
+    for (ltfat_int k = 0; k < s->P; k++)
+        LTFAT_NAME(dgtrealmp_execute_findmaxatom_dict)(p, k);
+
+    /* Reduction in a fixed order keeps the result independent of nthreads */
+    for (ltfat_int k = 0; k < s->P; k++)
+    {
+        if ( s->dictmax[k] > val )
         {
-            val = valTmp; pos->m = s->maxcolspos[k][nTmp]; pos->n = nTmp; pos->w = k;
+            ltfat_int nTmp = s->dictmaxpos[k];
+            val = s->dictmax[k]; pos->m = s->maxcolspos[k][nTmp]; pos->n = nTmp; pos->w = k;
             retval = LTFATERR_SUCCESS;
         }
     }
@@ -711,21 +1098,3 @@ LTFAT_NAME(dgtrealmp_execute_findneighbors)(
 
     return 0;
 }
-
-#ifdef NOBLASLAPACK
-
-LTFAT_API int
-LTFAT_NAME_COMPLEX(hermsystemsolver_init)(ltfat_int UNUSED(M),
-        LTFAT_NAME_COMPLEX(hermsystemsolver_plan)** UNUSED(p)) {return 0;}
-
-
-LTFAT_API int
-LTFAT_NAME_COMPLEX(hermsystemsolver_execute)(
-    LTFAT_NAME_COMPLEX(hermsystemsolver_plan)* UNUSED(p),
-    const LTFAT_COMPLEX* UNUSED(A), ltfat_int UNUSED(M),
-    LTFAT_COMPLEX* UNUSED(b)) {return 0;}
-
-LTFAT_API int
-LTFAT_NAME_COMPLEX(hermsystemsolver_done)(
-    LTFAT_NAME_COMPLEX(hermsystemsolver_plan)** UNUSED(p)) {return 0;}
-#endif
@@ -4,14 +4,13 @@
 #include "dgtrealmp_private.h"
 
 
-int
-LTFAT_NAME(dgtrealmp_kernel_init)(
+static int
+LTFAT_NAME(dgtrealmp_kernel_compute)(
     const LTFAT_REAL* g[], ltfat_int gl[], ltfat_int a[], ltfat_int M[],
-    ltfat_int L, LTFAT_REAL reltol, ltfat_phaseconvention ptype,
+    ltfat_int Lshort, LTFAT_REAL reltol, ltfat_phaseconvention ptype,
     LTFAT_NAME(kerns)** pout)
 {
-    ltfat_int modNo, amin, Mmax, lefttail0, righttail0, lefttail1, righttail1,
-              Lshort, Nshort;
+    ltfat_int modNo, amin, Mmax, Nshort;
     LTFAT_REAL* g0tmp = NULL, *g1tmp = NULL;
     LTFAT_COMPLEX* kernlarge = NULL;
     LTFAT_NAME(kerns)* ktmp = NULL;
@@ -29,17 +28,6 @@ LTFAT_NAME(dgtrealmp_kernel_init)(
     amin = ltfat_imin(a[0], a[1]);
     Mmax = ltfat_imax(M[0], M[1]);
 
-    LTFAT_NAME(dgtrealmp_essentialsupport)(g[0], gl[0], (LTFAT_REAL) 1e-6, &lefttail0,
-                                           &righttail0);
-    LTFAT_NAME(dgtrealmp_essentialsupport)(g[1], gl[1], (LTFAT_REAL) 1e-6, &lefttail1,
-                                           &righttail1);
-
-    Lshort = 2 * ltfat_imax(lefttail0, righttail0) +
-             2 * ltfat_imax(lefttail1, righttail1);
-
-    Lshort = ltfat_dgtlength( ltfat_imin(Lshort, L), amin, Mmax);
-    /* Lshort = 2048; */
-
     Nshort = Lshort / amin;
 
     CHECKMEM(g0tmp     = LTFAT_NAME_REAL(malloc)(Lshort));
@@ -122,6 +110,28 @@ LTFAT_NAME(dgtrealmp_kernel_init)(
             LTFAT_NAME(dgtrealmp_kernel_modtiexp)(
                 ktmp->size, ktmp->mid, m * kernskip, amin, Mmax, ktmp->mods[m]);
 
+    // With frequency-invariant phase, the modulation runs along the columns.
+    // Applying it beforehand leaves just a scaled kernel for the update.
+    if (ptype == LTFAT_FREQINV && ktmp->kNo <= LTFAT_DGTREALMP_MAXKERNMODS)
+    {
+        ltfat_int kernsize = ktmp->size.height * ktmp->size.width;
+        CHECKMEM( ktmp->kvalmod = LTFAT_NEWARRAY(LTFAT_COMPLEX*, ktmp->kNo));
+
+        for (ltfat_int k = 0; k < ktmp->kNo; k++)
+        {
+            CHECKMEM(ktmp->kvalmod[k] = LTFAT_NAME_COMPLEX(malloc)(kernsize));
+
+            for (ltfat_int n = 0; n < ktmp->size.width; n++)
+            {
+                LTFAT_COMPLEX* kcol    = ktmp->kval + n * ktmp->size.height;
+                LTFAT_COMPLEX* kmodcol = ktmp->kvalmod[k] + n * ktmp->size.height;
+
+                for (ltfat_int m = 0; m < ktmp->size.height; m++)
+                    kmodcol[m] = ktmp->mods[k][m] * kcol[m];
+            }
+        }
+    }
+
 
     // Compute ranges of values in the columns ...
     for (ltfat_int knidx = 0; knidx < ktmp->size.width; knidx++)
@@ -171,6 +181,124 @@ error:
     return status;
 }
 
+int
+LTFAT_NAME(dgtrealmp_kernel_init)(
+    const LTFAT_REAL* g[], ltfat_int gl[], ltfat_int a[], ltfat_int M[],
+    ltfat_int L, LTFAT_REAL reltol, ltfat_phaseconvention ptype,
+    LTFAT_NAME(kerns)** pout)
+{
+    ltfat_int lefttail0, righttail0, lefttail1, righttail1, Lshort;
+    int status = LTFATERR_SUCCESS;
+
+    LTFAT_NAME(dgtrealmp_essentialsupport)(g[0], gl[0], (LTFAT_REAL) 1e-6, &lefttail0,
+                                           &righttail0);
+    LTFAT_NAME(dgtrealmp_essentialsupport)(g[1], gl[1], (LTFAT_REAL) 1e-6, &lefttail1,
+                                           &righttail1);
+
+    Lshort = 2 * ltfat_imax(lefttail0, righttail0) +
+             2 * ltfat_imax(lefttail1, righttail1);
+
+    Lshort = ltfat_dgtlength( ltfat_imin(Lshort, L),
+                              ltfat_imin(a[0], a[1]), ltfat_imax(M[0], M[1]));
+
+    // The kernel depends on L only through Lshort
+    CHECKSTATUS(
+        LTFAT_NAME(dgtrealmp_kernel_cache_get)(g, gl, a, M, Lshort, reltol,
+                                               ptype, pout));
+    if (*pout) return status;
+
+    CHECKSTATUS(
+        LTFAT_NAME(dgtrealmp_kernel_compute)(g, gl, a, M, Lshort, reltol,
+                                             ptype, pout));
+
+    // The kernel is usable even if it could not be cached
+    LTFAT_NAME(dgtrealmp_kernel_cache_put)(g, gl, a, M, Lshort, reltol,
+                                           ptype, *pout);
+
+error:
+    return status;
+}
+
+int
+LTFAT_NAME(dgtrealmp_kernel_clone)(
+    const LTFAT_NAME(kerns)* kin, LTFAT_NAME(kerns)** kout)
+{
+    LTFAT_NAME(kerns)* ktmp = NULL;
+    ltfat_int kernsize, modlen, atprodsLen;
+    int status = LTFATERR_SUCCESS;
+
+    CHECKNULL(kin); CHECKNULL(kout);
+
+    kernsize = kin->size.height * kin->size.width;
+    modlen = LTFAT_NAME(dgtrealmp_kernel_modlen)(kin);
+    atprodsLen = ltfat_idivceil( kin->size.height, 2);
+
+    CHECKMEM( ktmp = LTFAT_NEW(LTFAT_NAME(kerns)) );
+    *ktmp = *kin;
+    ktmp->kval = NULL; ktmp->range = NULL; ktmp->srange = NULL;
+    ktmp->mods = NULL; ktmp->kvalmod = NULL; ktmp->atprods = NULL;
+    ktmp->oneover1minatprodnorms = NULL; ktmp->cloned = 0;
+
+    CHECKMEM( ktmp->kval = LTFAT_NAME_COMPLEX(malloc)( kernsize));
+    memcpy(ktmp->kval, kin->kval, kernsize * sizeof * ktmp->kval);
+    CHECKMEM( ktmp->range = LTFAT_NEWARRAY(krange, kin->size.width) );
+    memcpy(ktmp->range, kin->range, kin->size.width * sizeof * ktmp->range);
+    CHECKMEM( ktmp->srange = LTFAT_NEWARRAY(krange, kin->size.width) );
+    memcpy(ktmp->srange, kin->srange, kin->size.width * sizeof * ktmp->srange);
+    CHECKMEM( ktmp->atprods = LTFAT_NAME_COMPLEX(malloc)( atprodsLen));
+    memcpy(ktmp->atprods, kin->atprods, atprodsLen * sizeof * ktmp->atprods);
+    CHECKMEM( ktmp->oneover1minatprodnorms = LTFAT_NAME_REAL(malloc)( atprodsLen));
+    memcpy(ktmp->oneover1minatprodnorms, kin->oneover1minatprodnorms,
+           atprodsLen * sizeof * ktmp->oneover1minatprodnorms);
+
+    CHECKMEM( ktmp->mods = LTFAT_NEWARRAY(LTFAT_COMPLEX*, kin->kNo));
+    for (ltfat_int k = 0; k < kin->kNo && modlen > 0; k++)
+    {
+        CHECKMEM( ktmp->mods[k] = LTFAT_NAME_COMPLEX(malloc)(modlen));
+        memcpy(ktmp->mods[k], kin->mods[k], modlen * sizeof * ktmp->mods[k]);
+    }
+
+    if (kin->kvalmod)
+    {
+        CHECKMEM( ktmp->kvalmod = LTFAT_NEWARRAY(LTFAT_COMPLEX*, kin->kNo));
+        for (ltfat_int k = 0; k < kin->kNo; k++)
+        {
+            CHECKMEM( ktmp->kvalmod[k] = LTFAT_NAME_COMPLEX(malloc)(kernsize));
+            memcpy(ktmp->kvalmod[k], kin->kvalmod[k],
+                   kernsize * sizeof * ktmp->kvalmod[k]);
+        }
+    }
+
+    *kout = ktmp;
+    return status;
+error:
+    if (ktmp) LTFAT_NAME(dgtrealmp_kernel_done)(&ktmp);
+    return status;
+}
+
+ltfat_int
+LTFAT_NAME(dgtrealmp_kernel_modlen)(const LTFAT_NAME(kerns)* k)
+{
+    if (k->ptype == LTFAT_FREQINV)
+        return k->size.height;
+    else if (k->ptype == LTFAT_TIMEINV)
+        return k->size.width;
+    return 0;
+}
+
+size_t
+LTFAT_NAME(dgtrealmp_kernel_bytes)(const LTFAT_NAME(kerns)* k)
+{
+    size_t kernsize = k->size.height * k->size.width;
+    size_t atprodsLen = ltfat_idivceil( k->size.height, 2);
+
+    return sizeof * k +
+           kernsize * sizeof * k->kval * (1 + (k->kvalmod ? k->kNo : 0)) +
+           2 * k->size.width * sizeof * k->range +
+           atprodsLen * (sizeof * k->atprods + sizeof * k->oneover1minatprodnorms) +
+           k->kNo * LTFAT_NAME(dgtrealmp_kernel_modlen)(k) * sizeof * k->kval;
+}
+
 int
 LTFAT_NAME(dgtrealmp_kernel_done)(LTFAT_NAME(kerns)** k)
 {
@@ -195,6 +323,13 @@ LTFAT_NAME(dgtrealmp_kernel_done)(LTFAT_NAME(kerns)** k)
             ltfat_safefree( kk->mods[kIdx] );
         ltfat_free(kk->mods);
     }
+
+    if (kk->kvalmod)
+    {
+        for (ltfat_int kIdx = 0; kIdx < kk->kNo; kIdx++)
+            ltfat_safefree( kk->kvalmod[kIdx] );
+        ltfat_free(kk->kvalmod);
+    }
     
 
     ltfat_safefree(kk);
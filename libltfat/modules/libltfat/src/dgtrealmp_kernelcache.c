@@ -0,0 +1,544 @@
+#include "ltfat.h"
+#include "ltfat/types.h"
+#include "ltfat/macros.h"
+#include "dgtrealmp_private.h"
+#include "lrucache_private.h"
+#include <stdint.h>
+
+#define LTFAT_DGTREALMP_KERNEL_CACHE_VERSION 1
+
+/* Cached kernel together with the parameters it was computed from */
+typedef struct
+{
+    ltfat_lruentry lru;
+    LTFAT_NAME(kerns)* k;
+    LTFAT_REAL* g[2];
+    ltfat_int gl[2];
+    ltfat_int a[2];
+    ltfat_int M[2];
+    ltfat_int Lshort;
+    LTFAT_REAL reltol;
+    ltfat_phaseconvention ptype;
+} LTFAT_NAME(dgtrealmp_kernel_cache_entry);
+
+static void
+LTFAT_NAME(dgtrealmp_kernel_cache_freeentry)(void* entry);
+
+static ltfat_lrucache LTFAT_NAME(dgtrealmp_kernel_cache) =
+    LTFAT_LRUCACHE_INIT(LTFAT_NAME(dgtrealmp_kernel_cache_entry), 64,
+                        LTFAT_DGTREALMP_KERNEL_CACHE_BUDGET,
+                        LTFAT_NAME(dgtrealmp_kernel_cache_freeentry));
+
+static unsigned long long
+LTFAT_NAME(dgtrealmp_kernel_cache_hash)(
+    const LTFAT_NAME(dgtrealmp_kernel_cache_entry)* e)
+{
+    unsigned long long hash = LTFAT_FNV1A_INIT;
+    ltfat_int dims[] = { e->gl[0], e->gl[1], e->a[0], e->a[1], e->M[0], e->M[1],
+                         e->Lshort, e->ptype
+                       };
+
+    hash = ltfat_fnv1a(hash, dims, sizeof dims);
+    hash = ltfat_fnv1a(hash, &e->reltol,
+            sizeof e->reltol);
+    for (int ii = 0; ii < 2; ii++)
+        hash = ltfat_fnv1a(hash, e->g[ii],
+                e->gl[ii] * sizeof * e->g[ii]);
+    return hash;
+}
+
+static int
+LTFAT_NAME(dgtrealmp_kernel_cache_samekey)(
+    const LTFAT_NAME(dgtrealmp_kernel_cache_entry)* e1,
+    const LTFAT_NAME(dgtrealmp_kernel_cache_entry)* e2)
+{
+    return e1->lru.hash == e2->lru.hash &&
+           e1->gl[0] == e2->gl[0] && e1->gl[1] == e2->gl[1] &&
+           e1->a[0] == e2->a[0] && e1->a[1] == e2->a[1] &&
+           e1->M[0] == e2->M[0] && e1->M[1] == e2->M[1] &&
+           e1->Lshort == e2->Lshort && e1->reltol == e2->reltol &&
+           e1->ptype == e2->ptype &&
+           !memcmp(e1->g[0], e2->g[0], e1->gl[0] * sizeof * e1->g[0]) &&
+           !memcmp(e1->g[1], e2->g[1], e1->gl[1] * sizeof * e1->g[1]);
+}
+
+static void
+LTFAT_NAME(dgtrealmp_kernel_cache_freeentry)(void* entry)
+{
+    LTFAT_NAME(dgtrealmp_kernel_cache_entry)* e =
+        (LTFAT_NAME(dgtrealmp_kernel_cache_entry)*) entry;
+
+    if (e->k) LTFAT_NAME(dgtrealmp_kernel_done)(&e->k);
+    ltfat_safefree(e->g[0]);
+    ltfat_safefree(e->g[1]);
+}
+
+/* Fills the key of e. The windows are not copied. */
+static void
+LTFAT_NAME(dgtrealmp_kernel_cache_setkey)(
+    const LTFAT_REAL* g[], ltfat_int gl[], ltfat_int a[], ltfat_int M[],
+    ltfat_int Lshort, LTFAT_REAL reltol, ltfat_phaseconvention ptype,
+    LTFAT_NAME(dgtrealmp_kernel_cache_entry)* e)
+{
+    memset(e, 0, sizeof * e);
+    for (int ii = 0; ii < 2; ii++)
+    {
+        e->g[ii] = (LTFAT_REAL*) g[ii]; e->gl[ii] = gl[ii];
+        e->a[ii] = a[ii]; e->M[ii] = M[ii];
+    }
+    e->Lshort = Lshort; e->reltol = reltol; e->ptype = ptype;
+    e->lru.hash = LTFAT_NAME(dgtrealmp_kernel_cache_hash)(e);
+}
+
+/* Replaces the shallow window copies in e with owned ones */
+static int
+LTFAT_NAME(dgtrealmp_kernel_cache_ownkey)(
+    LTFAT_NAME(dgtrealmp_kernel_cache_entry)* e)
+{
+    int status = LTFATERR_SUCCESS;
+    const LTFAT_REAL* g[2] = { e->g[0], e->g[1] };
+
+    e->g[0] = NULL; e->g[1] = NULL;
+    for (int ii = 0; ii < 2; ii++)
+    {
+        CHECKMEM( e->g[ii] = LTFAT_NAME_REAL(malloc)(e->gl[ii]));
+        memcpy(e->g[ii], g[ii], e->gl[ii] * sizeof * e->g[ii]);
+    }
+error:
+    return status;
+}
+
+/* The following functions must be called from within the
+ * ltfat_dgtrealmp_kernel_cache critical section */
+static ltfat_int
+LTFAT_NAME(dgtrealmp_kernel_cache_find)(
+    const LTFAT_NAME(dgtrealmp_kernel_cache_entry)* e)
+{
+    ltfat_lrucache* c = &LTFAT_NAME(dgtrealmp_kernel_cache);
+    LTFAT_NAME(dgtrealmp_kernel_cache_entry)* table =
+        (LTFAT_NAME(dgtrealmp_kernel_cache_entry)*) c->table;
+
+    for (ltfat_int ii = 0; ii < c->no; ii++)
+        if (LTFAT_NAME(dgtrealmp_kernel_cache_samekey)(table + ii, e))
+            return ii;
+
+    return -1;
+}
+
+/* Takes ownership of the entry. An entry with an equal key is replaced. */
+static int
+LTFAT_NAME(dgtrealmp_kernel_cache_insert)(
+    LTFAT_NAME(dgtrealmp_kernel_cache_entry)* e)
+{
+    ltfat_lrucache* c = &LTFAT_NAME(dgtrealmp_kernel_cache);
+    ltfat_int idx = LTFAT_NAME(dgtrealmp_kernel_cache_find)(e);
+    int status;
+
+    if (idx >= 0)
+        ltfat_lrucache_remove(c, idx);
+
+    status = ltfat_lrucache_insert(c, e);
+    if (status != LTFATERR_SUCCESS)
+        LTFAT_NAME(dgtrealmp_kernel_cache_freeentry)(e);
+
+    return status;
+}
+/* End of the functions requiring the critical section */
+
+int
+LTFAT_NAME(dgtrealmp_kernel_cache_get)(
+    const LTFAT_REAL* g[], ltfat_int gl[], ltfat_int a[], ltfat_int M[],
+    ltfat_int Lshort, LTFAT_REAL reltol, ltfat_phaseconvention ptype,
+    LTFAT_NAME(kerns)** kout)
+{
+    LTFAT_NAME(dgtrealmp_kernel_cache_entry) e;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(kout);
+    *kout = NULL;
+
+    LTFAT_NAME(dgtrealmp_kernel_cache_setkey)(g, gl, a, M, Lshort, reltol,
+            ptype, &e);
+
+    // Copying is cheap compared to computing the kernel, but it cannot be done
+    // outside of the critical section since the entry can be evicted
+#ifdef _OPENMP
+    #pragma omp critical(ltfat_dgtrealmp_kernel_cache)
+#endif
+    {
+        ltfat_int idx = LTFAT_NAME(dgtrealmp_kernel_cache_find)(&e);
+        if (idx >= 0)
+        {
+            LTFAT_NAME(dgtrealmp_kernel_cache_entry)* found =
+                (LTFAT_NAME(dgtrealmp_kernel_cache_entry)*)
+                LTFAT_NAME(dgtrealmp_kernel_cache).table + idx;
+            ltfat_lrucache_touch(&LTFAT_NAME(dgtrealmp_kernel_cache), idx);
+            status = LTFAT_NAME(dgtrealmp_kernel_clone)(found->k, kout);
+        }
+    }
+
+error:
+    return status;
+}
+
+int
+LTFAT_NAME(dgtrealmp_kernel_cache_put)(
+    const LTFAT_REAL* g[], ltfat_int gl[], ltfat_int a[], ltfat_int M[],
+    ltfat_int Lshort, LTFAT_REAL reltol, ltfat_phaseconvention ptype,
+    const LTFAT_NAME(kerns)* k)
+{
+    LTFAT_NAME(dgtrealmp_kernel_cache_entry) e;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(k);
+
+    LTFAT_NAME(dgtrealmp_kernel_cache_setkey)(g, gl, a, M, Lshort, reltol,
+            ptype, &e);
+
+    e.lru.bytes = LTFAT_NAME(dgtrealmp_kernel_bytes)(k) +
+                  (gl[0] + gl[1]) * sizeof * e.g[0];
+
+    if (e.lru.bytes > LTFAT_NAME(dgtrealmp_kernel_cache).budget)
+        return status;
+
+    CHECKSTATUS( LTFAT_NAME(dgtrealmp_kernel_cache_ownkey)(&e));
+    CHECKSTATUS( LTFAT_NAME(dgtrealmp_kernel_clone)(k, &e.k));
+
+#ifdef _OPENMP
+    #pragma omp critical(ltfat_dgtrealmp_kernel_cache)
+#endif
+    status = LTFAT_NAME(dgtrealmp_kernel_cache_insert)(&e);
+
+    return status;
+error:
+    LTFAT_NAME(dgtrealmp_kernel_cache_freeentry)(&e);
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_kernel_cache_set_budget)(size_t bytes)
+{
+#ifdef _OPENMP
+    #pragma omp critical(ltfat_dgtrealmp_kernel_cache)
+#endif
+    {
+        LTFAT_NAME(dgtrealmp_kernel_cache).budget = bytes;
+        ltfat_lrucache_evict(&LTFAT_NAME(dgtrealmp_kernel_cache), bytes);
+    }
+
+    return LTFATERR_SUCCESS;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_kernel_cache_clear)()
+{
+#ifdef _OPENMP
+    #pragma omp critical(ltfat_dgtrealmp_kernel_cache)
+#endif
+    ltfat_lrucache_clear(&LTFAT_NAME(dgtrealmp_kernel_cache));
+
+    return LTFATERR_SUCCESS;
+}
+
+/* The file consists of a header followed by the entries. Everything is
+ * stored in the native byte order and the header records the type sizes
+ * so that files from incompatible builds are rejected. */
+typedef struct
+{
+    char     magic[4];
+    uint32_t version;
+    uint32_t realsize;
+    uint32_t intsize;
+    uint32_t byteorder;
+    uint32_t reserved;
+    uint64_t entryNo;
+} ltfat_dgtrealmp_kernel_cache_header;
+
+static int
+LTFAT_NAME(dgtrealmp_kernel_cache_write)(FILE* fp, const void* data,
+        size_t size, size_t count)
+{
+    return count == 0 || fwrite(data, size, count, fp) == count;
+}
+
+static int
+LTFAT_NAME(dgtrealmp_kernel_cache_read)(FILE* fp, void* data,
+                                        size_t size, size_t count)
+{
+    return count == 0 || fread(data, size, count, fp) == count;
+}
+
+static int
+LTFAT_NAME(dgtrealmp_kernel_cache_writeentry)(
+    FILE* fp, const LTFAT_NAME(dgtrealmp_kernel_cache_entry)* e)
+{
+    const LTFAT_NAME(kerns)* k = e->k;
+    ltfat_int kernsize = k->size.height * k->size.width;
+    ltfat_int modlen = LTFAT_NAME(dgtrealmp_kernel_modlen)(k);
+    ltfat_int atprodsLen = ltfat_idivceil( k->size.height, 2);
+    ltfat_int dims[] = { e->gl[0], e->gl[1], e->a[0], e->a[1], e->M[0], e->M[1],
+                         e->Lshort, e->ptype,
+                         k->size.height, k->size.width, k->mid.hmid, k->mid.wmid,
+                         k->kNo, k->kSkip, k->Mstep, k->astep, k->atprodsNo,
+                         k->kvalmod != NULL
+                       };
+    LTFAT_REAL reals[] = { e->reltol, k->absthr };
+    double rats[] = { k->Mrat, k->arat };
+    int ok = 1;
+
+#define WRITE(data, count) \
+    ok = ok && LTFAT_NAME(dgtrealmp_kernel_cache_write)(fp, data, sizeof *(data), count)
+
+    WRITE(dims, sizeof dims / sizeof * dims);
+    WRITE(reals, 2);
+    WRITE(rats, 2);
+    WRITE(e->g[0], e->gl[0]);
+    WRITE(e->g[1], e->gl[1]);
+    WRITE(k->kval, kernsize);
+    WRITE(k->range, k->size.width);
+    WRITE(k->srange, k->size.width);
+    WRITE(k->atprods, atprodsLen);
+    WRITE(k->oneover1minatprodnorms, atprodsLen);
+    for (ltfat_int kIdx = 0; kIdx < k->kNo; kIdx++)
+        WRITE(k->mods[kIdx], modlen);
+    for (ltfat_int kIdx = 0; kIdx < k->kNo && k->kvalmod; kIdx++)
+        WRITE(k->kvalmod[kIdx], kernsize);
+
+#undef WRITE
+    return ok;
+}
+
+/* Checks the lattice dependent fields dims[8..16] and rats of an entry read
+ * from a file against what dgtrealmp_kernel_init computes for its a, M, Lshort
+ * and ptype. They determine allocation sizes and indexing. */
+static int
+LTFAT_NAME(dgtrealmp_kernel_cache_kernelok)(
+    const LTFAT_NAME(dgtrealmp_kernel_cache_entry)* e, const ltfat_int dims[],
+    const double rats[])
+{
+    ltfat_int amin = ltfat_imin(e->a[0], e->a[1]);
+    ltfat_int Mmax = ltfat_imax(e->M[0], e->M[1]);
+    double Mrat = ((double) e->M[0]) / e->M[1];
+    double arat = ((double) e->a[1]) / e->a[0];
+    ltfat_int kNo;
+
+    /* Lshort is a multiple of lcm(amin, Mmax) */
+    if (e->Lshort % amin || e->Lshort % Mmax)
+        return 0;
+
+    kNo = ltfat_lcm(amin, Mmax) / amin;
+    if (e->ptype == LTFAT_FREQINV && arat < 1.0)
+        kNo = ltfat_lcm(amin, Mmax) / e->a[0];
+    else if (e->ptype == LTFAT_TIMEINV && Mrat < 1.0)
+        kNo = (ltfat_int)(kNo * Mrat);
+
+    return dims[8] > 0 && dims[8] <= Mmax &&
+           dims[9] > 0 && dims[9] <= e->Lshort / amin &&
+           dims[10] >= 0 && dims[10] < dims[8] &&
+           dims[11] >= 0 && dims[11] < dims[9] &&
+           dims[12] > 0 && dims[12] == kNo && dims[13] == 1 &&
+           dims[14] == (Mrat > 1 ? (ltfat_int) Mrat : 1) &&
+           dims[15] == (arat > 1 ? (ltfat_int) arat : 1) &&
+           dims[16] >= 0 && dims[16] <= ltfat_idivceil(dims[8], 2) &&
+           rats[0] == Mrat && rats[1] == arat;
+}
+
+/* Checks the column ranges of an entry read from a file. The MP update
+ * loops index the kernel and the coefficients with them unchecked. */
+static int
+LTFAT_NAME(dgtrealmp_kernel_cache_rangesok)(const LTFAT_NAME(kerns)* k)
+{
+    for (ltfat_int n = 0; n < k->size.width; n++)
+    {
+        const krange* r = k->range + n;
+        const krange* sr = k->srange + n;
+
+        if (r->start < 0 || r->end < 0 || r->start + r->end >= k->size.height ||
+            sr->start != r->start / k->Mstep || sr->end != r->end / k->Mstep)
+            return 0;
+    }
+    return 1;
+}
+
+/* Returns LTFATERR_BADARG if the file is truncated or damaged */
+static int
+LTFAT_NAME(dgtrealmp_kernel_cache_readentry)(
+    FILE* fp, LTFAT_NAME(dgtrealmp_kernel_cache_entry)* e)
+{
+    LTFAT_NAME(kerns)* k = NULL;
+    ltfat_int kernsize, modlen, atprodsLen;
+    ltfat_int dims[18];
+    LTFAT_REAL reals[2];
+    double rats[2];
+    int ok = 1;
+    int status = LTFATERR_SUCCESS;
+
+    memset(e, 0, sizeof * e);
+
+#define READ(data, count) \
+    ok = ok && LTFAT_NAME(dgtrealmp_kernel_cache_read)(fp, data, sizeof *(data), count)
+
+    READ(dims, sizeof dims / sizeof * dims);
+    READ(reals, 2);
+    READ(rats, 2);
+    CHECK(LTFATERR_BADARG, ok, "The file is truncated.");
+
+    for (int ii = 0; ii < 2; ii++)
+    {
+        e->gl[ii] = dims[ii]; e->a[ii] = dims[2 + ii]; e->M[ii] = dims[4 + ii];
+    }
+    e->Lshort = dims[6]; e->ptype = (ltfat_phaseconvention) dims[7];
+    e->reltol = reals[0];
+
+    CHECK(LTFATERR_BADARG,
+          e->gl[0] > 0 && e->gl[1] > 0 && e->a[0] > 0 && e->a[1] > 0 &&
+          e->M[0] > 0 && e->M[1] > 0 && e->Lshort > 0 &&
+          ltfat_phaseconvention_is_valid(e->ptype) &&
+          LTFAT_NAME(dgtrealmp_kernel_cache_kernelok)(e, dims, rats),
+          "The file is damaged.");
+
+    CHECKMEM( k = LTFAT_NEW(LTFAT_NAME(kerns)) );
+    k->size.height = dims[8]; k->size.width = dims[9];
+    k->mid.hmid = dims[10]; k->mid.wmid = dims[11];
+    k->kNo = dims[12]; k->kSkip = dims[13]; k->Mstep = dims[14];
+    k->astep = dims[15]; k->atprodsNo = dims[16];
+    k->absthr = reals[1]; k->Mrat = rats[0]; k->arat = rats[1];
+    k->ptype = e->ptype;
+
+    kernsize = k->size.height * k->size.width;
+    modlen = LTFAT_NAME(dgtrealmp_kernel_modlen)(k);
+    atprodsLen = ltfat_idivceil( k->size.height, 2);
+
+    CHECKMEM( e->g[0] = LTFAT_NAME_REAL(malloc)(e->gl[0]));
+    CHECKMEM( e->g[1] = LTFAT_NAME_REAL(malloc)(e->gl[1]));
+    CHECKMEM( k->kval = LTFAT_NAME_COMPLEX(malloc)( kernsize));
+    CHECKMEM( k->range = LTFAT_NEWARRAY(krange, k->size.width) );
+    CHECKMEM( k->srange = LTFAT_NEWARRAY(krange, k->size.width) );
+    CHECKMEM( k->atprods = LTFAT_NAME_COMPLEX(malloc)( atprodsLen));
+    CHECKMEM( k->oneover1minatprodnorms = LTFAT_NAME_REAL(malloc)( atprodsLen));
+    CHECKMEM( k->mods = LTFAT_NEWARRAY(LTFAT_COMPLEX*, k->kNo));
+
+    READ(e->g[0], e->gl[0]);
+    READ(e->g[1], e->gl[1]);
+    READ(k->kval, kernsize);
+    READ(k->range, k->size.width);
+    READ(k->srange, k->size.width);
+    READ(k->atprods, atprodsLen);
+    READ(k->oneover1minatprodnorms, atprodsLen);
+
+    for (ltfat_int kIdx = 0; kIdx < k->kNo && ok; kIdx++)
+    {
+        CHECKMEM( k->mods[kIdx] = LTFAT_NAME_COMPLEX(malloc)(modlen));
+        READ(k->mods[kIdx], modlen);
+    }
+
+    if (dims[17])
+    {
+        CHECKMEM( k->kvalmod = LTFAT_NEWARRAY(LTFAT_COMPLEX*, k->kNo));
+        for (ltfat_int kIdx = 0; kIdx < k->kNo && ok; kIdx++)
+        {
+            CHECKMEM( k->kvalmod[kIdx] = LTFAT_NAME_COMPLEX(malloc)(kernsize));
+            READ(k->kvalmod[kIdx], kernsize);
+        }
+    }
+
+#undef READ
+    CHECK(LTFATERR_BADARG, ok, "The file is truncated.");
+    CHECK(LTFATERR_BADARG, LTFAT_NAME(dgtrealmp_kernel_cache_rangesok)(k),
+          "The file is damaged.");
+
+    e->k = k;
+    e->lru.hash = LTFAT_NAME(dgtrealmp_kernel_cache_hash)(e);
+    e->lru.bytes = LTFAT_NAME(dgtrealmp_kernel_bytes)(k) +
+                   (e->gl[0] + e->gl[1]) * sizeof * e->g[0];
+    return status;
+error:
+    if (k) LTFAT_NAME(dgtrealmp_kernel_done)(&k);
+    LTFAT_NAME(dgtrealmp_kernel_cache_freeentry)(e);
+    return status;
+}
+
+static void
+LTFAT_NAME(dgtrealmp_kernel_cache_initheader)(
+    ltfat_dgtrealmp_kernel_cache_header* h, uint64_t entryNo)
+{
+    memset(h, 0, sizeof * h);
+    memcpy(h->magic, "LTKC", 4);
+    h->version = LTFAT_DGTREALMP_KERNEL_CACHE_VERSION;
+    h->realsize = sizeof(LTFAT_REAL);
+    h->intsize = sizeof(ltfat_int);
+    h->byteorder = 0x01020304;
+    h->entryNo = entryNo;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_kernel_cache_export)(const char* filename)
+{
+    FILE* fp = NULL;
+    ltfat_dgtrealmp_kernel_cache_header h;
+    int written = 1;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(filename);
+
+    fp = fopen(filename, "wb");
+    CHECK(LTFATERR_FAILED, fp, "Cannot open %s for writing.", filename);
+
+#ifdef _OPENMP
+    #pragma omp critical(ltfat_dgtrealmp_kernel_cache)
+#endif
+    {
+        LTFAT_NAME(dgtrealmp_kernel_cache_initheader)(
+            &h, LTFAT_NAME(dgtrealmp_kernel_cache).no);
+        written = fwrite(&h, sizeof h, 1, fp) == 1;
+
+        for (ltfat_int ii = 0; ii < LTFAT_NAME(dgtrealmp_kernel_cache).no; ii++)
+            written = written &&
+                      LTFAT_NAME(dgtrealmp_kernel_cache_writeentry)(
+                          fp, (const LTFAT_NAME(dgtrealmp_kernel_cache_entry)*)
+                          LTFAT_NAME(dgtrealmp_kernel_cache).table + ii);
+    }
+
+    written = !fclose(fp) && written;
+    CHECK(LTFATERR_FAILED, written, "Writing to %s failed.", filename);
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_kernel_cache_import)(const char* filename)
+{
+    FILE* fp = NULL;
+    ltfat_dgtrealmp_kernel_cache_header h, hexp;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(filename);
+
+    fp = fopen(filename, "rb");
+    CHECK(LTFATERR_FAILED, fp, "Cannot open %s for reading.", filename);
+
+    CHECK(LTFATERR_BADARG, fread(&h, sizeof h, 1, fp) == 1,
+          "%s is not a kernel cache file.", filename);
+
+    LTFAT_NAME(dgtrealmp_kernel_cache_initheader)(&hexp, h.entryNo);
+    CHECK(LTFATERR_BADARG, !memcmp(h.magic, hexp.magic, 4),
+          "%s is not a kernel cache file.", filename);
+    CHECK(LTFATERR_BADARG,
+          h.version == hexp.version && h.realsize == hexp.realsize &&
+          h.intsize == hexp.intsize && h.byteorder == hexp.byteorder,
+          "%s was written by an incompatible build or precision.", filename);
+
+    for (uint64_t ii = 0; ii < h.entryNo; ii++)
+    {
+        LTFAT_NAME(dgtrealmp_kernel_cache_entry) e;
+
+        CHECKSTATUS( LTFAT_NAME(dgtrealmp_kernel_cache_readentry)(fp, &e));
+
+#ifdef _OPENMP
+        #pragma omp critical(ltfat_dgtrealmp_kernel_cache)
+#endif
+        status = LTFAT_NAME(dgtrealmp_kernel_cache_insert)(&e);
+
+        CHECKSTATUS(status);
+    }
+
+error:
+    if (fp) fclose(fp);
+    return status;
+}
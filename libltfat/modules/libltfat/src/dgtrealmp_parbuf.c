@@ -356,3 +356,43 @@ LTFAT_NAME(dgtrealmp_setparbuf_pedanticsearch)(
 error:
     return status;
 }
+
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_setparbuf_nthreads)(
+    LTFAT_NAME(dgtrealmp_parbuf)* p, int nthreads)
+{
+    int status = LTFATERR_FAILED; CHECKNULL(p);
+    return ltfat_dgtmp_setpar_nthreads(p->params, nthreads);
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_setparbuf_batchatoms)(
+    LTFAT_NAME(dgtrealmp_parbuf)* p, size_t batchatoms)
+{
+    int status = LTFATERR_FAILED; CHECKNULL(p);
+    return ltfat_dgtmp_setpar_batchatoms(p->params, batchatoms);
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_setparbuf_profile)(
+    LTFAT_NAME(dgtrealmp_parbuf)* p, int do_profile)
+{
+    int status = LTFATERR_FAILED; CHECKNULL(p);
+    return ltfat_dgtmp_setpar_profile(p->params, do_profile);
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_setparbuf_redecompose)(
+    LTFAT_NAME(dgtrealmp_parbuf)* p, int do_redecompose)
+{
+    int status = LTFATERR_FAILED; CHECKNULL(p);
+    return ltfat_dgtmp_setpar_redecompose(p->params, do_redecompose);
+error:
+    return status;
+}
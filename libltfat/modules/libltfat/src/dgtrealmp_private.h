@@ -37,6 +37,10 @@ struct ltfat_dgtmp_params
     size_t                cycles;
     ltfat_phaseconvention ptype;
     int                   do_pedantic;
+    int                   nthreads;
+    size_t                batchatoms;
+    int                   do_profile;
+    int                   do_redecompose;
 };
 
 typedef struct
@@ -69,6 +73,21 @@ typedef struct
 #define kpoint_init2(m,n,n2,w) LTFAT_STRUCTINIT(kpoint,m,n,w,n2)
 #define kpoint_isequal(k1,k2) (k1.m == k2.m && k1.n == k2.n && k1.w == k2.w)
 
+/* Minimum number of coefficients touched by a per-dictionary update
+ * for it to be split among threads */
+#define LTFAT_DGTREALMP_PARALLEL_MINWORK 4096
+
+/* Kernels with at most this many modulations are stored premodulated */
+#define LTFAT_DGTREALMP_MAXKERNMODS 16
+
+/* Batched MP only takes atoms with energy above this fraction of the
+ * largest one and looks for them among this many candidates per atom */
+#define LTFAT_DGTREALMP_BATCHMINREL 0.25
+#define LTFAT_DGTREALMP_BATCHCANDS 4
+
+/* Default memory budget of the Gram kernel cache */
+#define LTFAT_DGTREALMP_KERNEL_CACHE_BUDGET (16 * 1024 * 1024)
+
 
 typedef struct
 {
@@ -78,6 +97,7 @@ typedef struct
     ltfat_int         kSkip;
     LTFAT_COMPLEX**    mods;
     LTFAT_COMPLEX*     kval;
+    LTFAT_COMPLEX**    kvalmod;
     krange*           range;
     krange*          srange;
     LTFAT_REAL       absthr;
@@ -100,14 +120,28 @@ typedef struct
     ltfat_int**            maxcolspos;
     LTFAT_NAME(maxtree)**  tmaxtree;
     LTFAT_NAME(maxtree)*** fmaxtree;
+    LTFAT_REAL*            dictmax;
+    ltfat_int*             dictmaxpos;
     unsigned int**         suppind;
     long double            err;
     long double            fnorm2;
     size_t                 currit;
     size_t                 curratoms;
+    // Profiling related, seconds
+    double                 tfindmax;
+    double                 tupdate;
+    double                 tstep;
     ltfat_int              P;
     ltfat_int*             N;
     LTFAT_COMPLEX**        cvalModBuf;
+    ltfat_int              cvalModBufNo;
+    // Batched MP related
+    kpoint*                batchPos;
+    LTFAT_COMPLEX*         batchCval;
+    krange*                batchRange;
+    kpoint*                batchCandPos;
+    LTFAT_REAL*            batchCandVal;
+    ltfat_int              batchCandMax;
     // LocOMP related
     LTFAT_COMPLEX*         gramBuf;
     LTFAT_COMPLEX*         cvalBuf;
@@ -118,6 +152,11 @@ typedef struct
     kpoint*                pBuf;
     size_t                 pBufSize;
     size_t                 pBufNo;
+    // Atom list output related. Positions which joined the support, can
+    // contain removed and repeated ones. Only kept when allocated.
+    kpoint*                suppList;
+    size_t                 suppListNo;
+    size_t                 suppListLen;
 } LTFAT_NAME(dgtrealmpiter_state);
 
 
@@ -142,6 +181,11 @@ struct LTFAT_NAME(dgtrealmp_state)
     ltfat_int         L;
     ltfat_dgtmp_params* params;
     LTFAT_COMPLEX**     couttmp;
+    LTFAT_COMPLEX**     catoms; // Dense coefficients for the atom list API
+    LTFAT_REAL**             g;  // Copies of the windows if do_redecompose
+    ltfat_int*              gl;
+    LTFAT_NAME(dgtreal_fb_plan)** fbplans; // P plans, created on demand
+    LTFAT_REAL*              f;  // Copy of the last decomposed signal if do_redecompose
     LTFAT_NAME(dgtrealmp_state_closure)** closures;
     LTFAT_NAME(dgtrealmp_iterstep_callback)* callback;
     void* userdata;
@@ -199,6 +243,30 @@ LTFAT_NAME(dgtrealmp_kernel_init)(
 int
 LTFAT_NAME(dgtrealmp_kernel_done)(LTFAT_NAME(kerns)** k);
 
+int
+LTFAT_NAME(dgtrealmp_kernel_clone)(
+    const LTFAT_NAME(kerns)* kin, LTFAT_NAME(kerns)** kout);
+
+ltfat_int
+LTFAT_NAME(dgtrealmp_kernel_modlen)(const LTFAT_NAME(kerns)* k);
+
+size_t
+LTFAT_NAME(dgtrealmp_kernel_bytes)(const LTFAT_NAME(kerns)* k);
+
+/* Sets *kout to a copy of the cached kernel or to NULL if there is none */
+int
+LTFAT_NAME(dgtrealmp_kernel_cache_get)(
+    const LTFAT_REAL* g[], ltfat_int gl[], ltfat_int a[], ltfat_int M[],
+    ltfat_int Lshort, LTFAT_REAL reltol, ltfat_phaseconvention ptype,
+    LTFAT_NAME(kerns)** kout);
+
+/* Stores a copy of k. Failing to do so does not affect k. */
+int
+LTFAT_NAME(dgtrealmp_kernel_cache_put)(
+    const LTFAT_REAL* g[], ltfat_int gl[], ltfat_int a[], ltfat_int M[],
+    ltfat_int Lshort, LTFAT_REAL reltol, ltfat_phaseconvention ptype,
+    const LTFAT_NAME(kerns)* k);
+
 int
 LTFAT_NAME(dgtrealmp_kernel_modfi)(
     const LTFAT_COMPLEX* kfirst, ksize size, kanchor mid, ltfat_int n, ltfat_int a, ltfat_int M,
@@ -266,6 +334,12 @@ LTFAT_NAME(dgtrealmp_execute_updateresiduum)(
     LTFAT_NAME(dgtrealmp_state)* p, kpoint pos, LTFAT_COMPLEX cval,
     int do_substract);
 
+/* Iterates until a stopping criterion is met. The iteration step callback
+ * is called every iterstep iterations. */
+int
+LTFAT_NAME(dgtrealmp_execute_resume)(
+    LTFAT_NAME(dgtrealmp_state)* p, LTFAT_COMPLEX* c[]);
+
 LTFAT_REAL
 LTFAT_NAME(dgtrealmp_execute_atenergy)(
     LTFAT_COMPLEX ainprod, LTFAT_COMPLEX cval);
@@ -289,6 +363,15 @@ LTFAT_NAME(dgtrealmp_execute_mp)(
     LTFAT_NAME(dgtrealmp_state)* p, LTFAT_COMPLEX cval,
     kpoint pos, LTFAT_COMPLEX** cout);
 
+/* Leaves only the current support positions in suppList, each one once */
+void
+LTFAT_NAME(dgtrealmp_supplist_compact)(LTFAT_NAME(dgtrealmp_state)* p);
+
+LTFAT_REAL
+LTFAT_NAME(dgtrealmp_execute_batchmp)(
+    LTFAT_NAME(dgtrealmp_state)* p, kpoint origpos, size_t maxextra,
+    LTFAT_COMPLEX** cout, size_t* atomsNo);
+
 int
 LTFAT_NAME(dgtrealmp_execute_cyclicmp)(
     LTFAT_NAME(dgtrealmp_state)* p,
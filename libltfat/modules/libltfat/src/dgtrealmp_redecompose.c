@@ -0,0 +1,198 @@
+#include "ltfat.h"
+#include "ltfat/types.h"
+#include "ltfat/macros.h"
+#include "ltfat/thirdparty/fftw3.h"
+#include "dgtrealmp_private.h"
+
+/* Re-decomposition of a signal which changed in samples [start,end).
+ *
+ * All atoms whose support intersects [start,end) are removed from the
+ * approximation first. The residual of the remaining atoms is then equal to
+ * the old signal in [start,end), so the residual changes exactly by the
+ * difference of the new and the old signal there. Its coefficients are
+ * obtained by a DGT of a short signal covering the affected columns and the
+ * columns are marked dirty in the maxtrees. The iterations then continue
+ * from the current state. */
+
+/* Range of columns [n0, n0 + ncols) of dictionary k whose atoms can overlap
+ * [start,end). Atoms are supported on na + (-gl,gl). n0 can be negative. */
+static void
+LTFAT_NAME(dgtrealmp_redecompose_cols)(
+    LTFAT_NAME(dgtrealmp_state)* p, ltfat_int k, ltfat_int start, ltfat_int end,
+    ltfat_int* n0, ltfat_int* ncols)
+{
+    /* floor((start - gl)/a) using that a divides L and gl <= L */
+    *n0 = (start + p->L - p->gl[k]) / p->a[k] - p->N[k];
+    *ncols = ltfat_idivceil(end + p->gl[k], p->a[k]) - *n0;
+}
+
+/* Adds coefficients of fdiff placed at [start,end) to the residual of
+ * dictionary k and marks the touched columns */
+static int
+LTFAT_NAME(dgtrealmp_redecompose_adddiff)(
+    LTFAT_NAME(dgtrealmp_state)* p, ltfat_int k, const LTFAT_REAL fdiff[],
+    ltfat_int start, ltfat_int end)
+{
+    int status = LTFATERR_SUCCESS;
+    LTFAT_NAME(dgtrealmpiter_state)* s = p->iterstate;
+    LTFAT_REAL* floc = NULL;
+    LTFAT_COMPLEX* cloc = NULL;
+    LTFAT_COMPLEX* phase = NULL;
+    ltfat_int n0, ncols, a = p->a[k], M = p->M[k], M2 = p->M2[k], N = p->N[k];
+
+    LTFAT_NAME(dgtrealmp_redecompose_cols)(p, k, start, end, &n0, &ncols);
+
+    /* Padding keeps the windows of the affected columns from wrapping
+     * around in the short signal */
+    ltfat_int padcols = ltfat_idivceil(p->gl[k], a);
+    ltfat_int Nloc = ncols + 2 * padcols, Lloc = Nloc * a;
+    ltfat_int s0 = (n0 - padcols) * a;
+
+    if (!p->fbplans[k])
+        CHECKSTATUS(
+            LTFAT_NAME(dgtreal_fb_init)(p->g[k], p->gl[k], a, M,
+                                        p->params->ptype, FFTW_ESTIMATE,
+                                        &p->fbplans[k]));
+
+    CHECKMEM( floc = LTFAT_NAME_REAL(calloc)(Lloc));
+    CHECKMEM( cloc = LTFAT_NAME_COMPLEX(malloc)(M2 * Nloc));
+
+    memcpy(floc + start - s0, fdiff, (end - start) * sizeof * floc);
+
+    CHECKSTATUS(
+        LTFAT_NAME(dgtreal_fb_execute)(p->fbplans[k], floc, Lloc, 1, cloc));
+
+    /* The frequency-invariant phase is relative to the signal start */
+    if (p->params->ptype == LTFAT_FREQINV)
+    {
+        ltfat_int s0M = ltfat_positiverem(s0, M);
+        CHECKMEM( phase = LTFAT_NAME_COMPLEX(malloc)(M2));
+        for (ltfat_int m = 0; m < M2; m++)
+            phase[m] = exp( I * (LTFAT_REAL) ( -2.0 * M_PI * ((m * s0M) % M) /
+                                               ((double) M)));
+    }
+
+    for (ltfat_int j = 0; j < ncols; j++)
+    {
+        ltfat_int n = ltfat_positiverem(n0 + j, N);
+        LTFAT_COMPLEX* cCol = s->c[k] + n * M2;
+        const LTFAT_COMPLEX* clocCol = cloc + (padcols + j) * M2;
+
+        if (phase)
+            for (ltfat_int m = 0; m < M2; m++)
+                cCol[m] += phase[m] * clocCol[m];
+        else
+            for (ltfat_int m = 0; m < M2; m++)
+                cCol[m] += clocCol[m];
+
+        LTFAT_NAME(maxtree_setdirty)(s->fmaxtree[k][n], 0, M2);
+    }
+
+    n0 = ltfat_positiverem(n0, N);
+    LTFAT_NAME(maxtree_setdirty)(s->tmaxtree[k], n0, n0 + ncols);
+
+error:
+    LTFAT_SAFEFREEALL(floc, cloc, phase);
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_execute_redecompose)(
+    LTFAT_NAME(dgtrealmp_state)* p, const LTFAT_REAL fnew[],
+    ltfat_int start, ltfat_int len, LTFAT_COMPLEX* c[])
+{
+    int status = LTFATERR_SUCCESS;
+    LTFAT_NAME(dgtrealmpiter_state)* s = NULL;
+    LTFAT_REAL* fdiff = NULL;
+    long double oldenergy = 0.0, newenergy = 0.0;
+    ltfat_int end;
+    int do_full = 0;
+
+    CHECKNULL(p); CHECKNULL(fnew); CHECKNULL(c);
+    CHECK(LTFATERR_BADARG, p->params->do_redecompose,
+          "Redecomposition was not enabled for this state");
+    CHECK(LTFATERR_BADARG, p->f,
+          "dgtrealmp_execute_decompose must be called first");
+    CHECK(LTFATERR_NOTPOSARG, len > 0, "len must be positive (passed %td)", len);
+    CHECK(LTFATERR_NOTINRANGE, start >= 0 && start <= p->L - len,
+          "Range [%td,%td) is not within [0,%td)", start, start + len, p->L);
+
+    s = p->iterstate;
+    end = start + len;
+
+    for (ltfat_int k = 0; k < p->P; k++)
+    {
+        ltfat_int n0, ncols;
+        CHECKNULL(c[k]);
+        LTFAT_NAME(dgtrealmp_redecompose_cols)(p, k, start, end, &n0, &ncols);
+        if (ncols + 2 * ltfat_idivceil(p->gl[k], p->a[k]) > p->N[k])
+            do_full = 1;
+    }
+
+    /* The edit reaches all columns, the local update would not be cheaper */
+    if (do_full)
+    {
+        memcpy(p->f + start, fnew, len * sizeof * p->f);
+        return LTFAT_NAME(dgtrealmp_execute_decompose)(p, p->f, c);
+    }
+
+    if (!p->fbplans)
+        CHECKMEM( p->fbplans = LTFAT_NEWARRAY(LTFAT_NAME(dgtreal_fb_plan)*, p->P));
+
+    CHECKMEM( fdiff = LTFAT_NAME_REAL(malloc)(len));
+
+    for (ltfat_int l = 0; l < len; l++)
+    {
+        LTFAT_REAL fold = p->f[start + l];
+        fdiff[l] = fnew[l] - fold;
+        oldenergy += fold * fold;
+        newenergy += fnew[l] * fnew[l];
+    }
+
+    /* Removing the atoms, the residual energy is tracked by invmp */
+    for (ltfat_int k = 0; k < p->P; k++)
+    {
+        ltfat_int n0, ncols;
+        LTFAT_NAME(dgtrealmp_redecompose_cols)(p, k, start, end, &n0, &ncols);
+
+        for (ltfat_int j = 0; j < ncols; j++)
+        {
+            ltfat_int n = ltfat_positiverem(n0 + j, p->N[k]);
+            for (ltfat_int m = 0; m < p->M2[k]; m++)
+            {
+                kpoint pos = kpoint_init(m, n, k);
+                if ( ltfat_norm(c[PTOI(pos)]) > 0 )
+                    s->err += LTFAT_NAME(dgtrealmp_execute_invmp)( p, pos, c);
+
+                if ( s->suppind[PTOI(pos)] )
+                {
+                    s->suppind[PTOI(pos)] = 0;
+                    s->curratoms--;
+                }
+            }
+        }
+    }
+
+    /* No atom is left in [start,end) so the residual there was the old signal */
+    s->err += newenergy - oldenergy;
+    s->fnorm2 += newenergy - oldenergy;
+    p->params->errtoladj = powl((long double)10.0,
+                                p->params->errtoldb / 10.0) * s->fnorm2;
+    memcpy(p->f + start, fnew, len * sizeof * p->f);
+
+    for (ltfat_int k = 0; k < p->P; k++)
+        CHECKSTATUS(
+            LTFAT_NAME(dgtrealmp_redecompose_adddiff)(p, k, fdiff, start, end));
+
+    ltfat_free(fdiff); fdiff = NULL;
+
+    s->currit = 0;
+    s->tfindmax = 0.0;
+    s->tupdate = 0.0;
+    s->tstep = 0.0;
+
+    return LTFAT_NAME(dgtrealmp_execute_resume)(p, c);
+error:
+    ltfat_safefree(fdiff);
+    return status;
+}
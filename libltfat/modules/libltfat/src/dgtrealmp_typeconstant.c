@@ -20,6 +20,10 @@ ltfat_dgtmp_params_defaults(ltfat_dgtmp_params* params)
     params->cycles = 1;
     params->atprodreltoldb = -80.0;
     params->ptype = LTFAT_TIMEINV;
+    params->nthreads = 1;
+    params->batchatoms = 1;
+    params->do_profile = 0;
+    params->do_redecompose = 0;
 error:
     return status;
 }
@@ -86,6 +90,30 @@ error:
     return status;
 }
 
+LTFAT_API int
+ltfat_dgtmp_setpar_profile(
+    ltfat_dgtmp_params* params, int do_profile)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(params);
+
+    params->do_profile = do_profile;
+error:
+    return status;
+}
+
+LTFAT_API int
+ltfat_dgtmp_setpar_redecompose(
+    ltfat_dgtmp_params* params, int do_redecompose)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(params);
+
+    params->do_redecompose = do_redecompose;
+error:
+    return status;
+}
+
 LTFAT_API int
 ltfat_dgtmp_setpar_alg(
     ltfat_dgtmp_params* params, ltfat_dgtmp_alg alg)
@@ -144,6 +172,34 @@ error:
     return status;
 }
 
+LTFAT_API int
+ltfat_dgtmp_setpar_nthreads(
+    ltfat_dgtmp_params* params, int nthreads)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(params);
+
+    CHECK(LTFATERR_NOTPOSARG, nthreads > 0, "nthreads must be greater than 0");
+    params->nthreads = nthreads;
+
+error:
+    return status;
+}
+
+LTFAT_API int
+ltfat_dgtmp_setpar_batchatoms(
+    ltfat_dgtmp_params* params, size_t batchatoms)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(params);
+
+    CHECK(LTFATERR_NOTPOSARG, batchatoms > 0, "batchatoms must be greater than 0");
+    params->batchatoms = batchatoms;
+
+error:
+    return status;
+}
+
 LTFAT_API int
 ltfat_dgtmp_setpar_errtoldb(
     ltfat_dgtmp_params* params, double errtoldb)
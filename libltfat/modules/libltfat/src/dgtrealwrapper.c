@@ -70,6 +70,24 @@ LTFAT_NAME(dgtreal_fb_execute_wrapper)(void* plan,
                (LTFAT_NAME(dgtreal_fb_plan)*) plan, f, L, W, c);
 }
 
+int
+LTFAT_NAME(idgtreal_fb_execute_planar_wrapper)(void* plan,
+        const LTFAT_REAL* cr, const LTFAT_REAL* ci, ltfat_int L, ltfat_int W,
+        LTFAT_REAL* f)
+{
+    return LTFAT_NAME(idgtreal_fb_execute_planar)(
+               (LTFAT_NAME(idgtreal_fb_plan)*) plan, cr, ci, L, W, f);
+}
+
+int
+LTFAT_NAME(dgtreal_fb_execute_planar_wrapper)(void* plan,
+        const LTFAT_REAL* f, ltfat_int L, ltfat_int W,
+        LTFAT_REAL* cr, LTFAT_REAL* ci)
+{
+    return LTFAT_NAME(dgtreal_fb_execute_planar)(
+               (LTFAT_NAME(dgtreal_fb_plan)*) plan, f, L, W, cr, ci);
+}
+
 int
 LTFAT_NAME(idgtreal_long_done_wrapper)(void** plan)
 {
@@ -94,6 +112,29 @@ LTFAT_NAME(dgtreal_fb_done_wrapper)(void** plan)
     return LTFAT_NAME(dgtreal_fb_done)((LTFAT_NAME(dgtreal_fb_plan)**) plan);
 }
 
+int
+LTFAT_NAME(dgtreal_ola_execute_wrapper)(void* plan,
+                                        const LTFAT_REAL* f, ltfat_int L, ltfat_int UNUSED(W), LTFAT_COMPLEX* c)
+{
+    return LTFAT_NAME(dgtreal_ola_execute)(*(LTFAT_NAME(dgtreal_ola_plan)*) plan,
+                                           f, L, c);
+}
+
+int
+LTFAT_NAME(dgtreal_ola_done_wrapper)(void** plan)
+{
+    LTFAT_NAME(dgtreal_ola_plan)* pp = (LTFAT_NAME(dgtreal_ola_plan)*) *plan;
+
+    if (pp->plan)
+        LTFAT_NAME(dgtreal_ola_done)(*pp);
+    else
+        LTFAT_SAFEFREEALL(pp->buf, pp->gext, pp->cbuf);
+
+    ltfat_free(pp);
+    *plan = NULL;
+    return LTFATERR_SUCCESS;
+}
+
 LTFAT_API int
 LTFAT_NAME(dgtreal_execute_proj)(
     LTFAT_NAME(dgtreal_plan)* p, const LTFAT_COMPLEX cin[],
@@ -154,6 +195,61 @@ error:
     return status;
 }
 
+/* Interleaved coefficients for the planar execute functions of the
+ * algorithms without a planar variant. Allocated on the first call. */
+static int
+LTFAT_NAME(dgtreal_planarbuf)(LTFAT_NAME(dgtreal_plan)* p, ltfat_int* cl)
+{
+    int status = LTFATERR_SUCCESS;
+    *cl = (p->M / 2 + 1) * (p->L / p->a) * p->W;
+
+    if (!p->cplanar)
+    {
+        CHECKMEM( p->cplanar = LTFAT_NAME_COMPLEX(malloc)(*cl));
+        p->membytes += *cl * sizeof * p->cplanar;
+    }
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtreal_execute_ana_planar)(
+    LTFAT_NAME(dgtreal_plan)* p, const LTFAT_REAL f[],
+    LTFAT_REAL cr[], LTFAT_REAL ci[])
+{
+    ltfat_int cl;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(f); CHECKNULL(cr); CHECKNULL(ci);
+
+    if (p->fwdtra_planar)
+        return p->fwdtra_planar(p->fwdtra_userdata, f, p->L, p->W, cr, ci);
+
+    CHECKSTATUS( LTFAT_NAME(dgtreal_planarbuf)(p, &cl));
+    CHECKSTATUS( p->fwdtra(p->fwdtra_userdata, f, p->L, p->W, p->cplanar));
+    CHECKSTATUS( LTFAT_NAME(complex2planar_array)(p->cplanar, cl, cr, ci));
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtreal_execute_syn_planar)(
+    LTFAT_NAME(dgtreal_plan)* p, const LTFAT_REAL cr[], const LTFAT_REAL ci[],
+    LTFAT_REAL f[])
+{
+    ltfat_int cl;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(cr); CHECKNULL(ci); CHECKNULL(f);
+
+    if (p->backtra_planar)
+        return p->backtra_planar(p->backtra_userdata, cr, ci, p->L, p->W, f);
+
+    CHECKSTATUS( LTFAT_NAME(dgtreal_planarbuf)(p, &cl));
+    CHECKSTATUS( LTFAT_NAME(planar2complex_array)(cr, ci, cl, p->cplanar));
+    CHECKSTATUS( p->backtra(p->backtra_userdata, p->cplanar, p->L, p->W, f));
+error:
+    return status;
+}
+
 LTFAT_API int
 LTFAT_NAME(dgtreal_done)(LTFAT_NAME(dgtreal_plan)** p)
 {
@@ -169,6 +265,7 @@ LTFAT_NAME(dgtreal_done)(LTFAT_NAME(dgtreal_plan)** p)
         CHECKSTATUS( pp->backdonefunc(&pp->backtra_userdata));
 
     //ltfat_safefree(pp->f);
+    ltfat_safefree(pp->cplanar);
     ltfat_free(pp);
     pp = NULL;
 error:
@@ -221,162 +318,389 @@ error:
     return status;
 }
 
-LTFAT_API int
-LTFAT_NAME(dgtreal_init_gen)(const LTFAT_REAL ga[], ltfat_int gal,
-                             const LTFAT_REAL gs[], ltfat_int gsl,
-                             ltfat_int L, ltfat_int W, ltfat_int a, ltfat_int M,
-                             LTFAT_REAL f[], LTFAT_COMPLEX c[],
-                             ltfat_dgt_params* params, LTFAT_NAME(dgtreal_plan)** pout)
+/* Block length for the OLA analysis or 0 if it cannot be used. The
+ * window must fit in a multiple of lcm(a,M) and span an even number of
+ * hops. The blocks must be several window lengths long to pay off. */
+static ltfat_int
+LTFAT_NAME(dgtreal_ola_blocklen)(ltfat_int L, ltfat_int gl, ltfat_int a, ltfat_int M)
 {
-    int status = LTFATERR_SUCCESS;
-    LTFAT_NAME(dgtreal_plan)* p = NULL;
-    ltfat_dgt_params paramsLoc;
-
-    LTFAT_REAL* g2 = NULL;
-
     ltfat_int minL = ltfat_lcm(a, M);
 
-    if (params)
-        paramsLoc = *params;
-    else
-        ltfat_dgt_params_defaults(&paramsLoc);
+    if (gl % minL || (gl / a) % 2)
+        return 0;
 
-    CHECKNULL( pout );
-    CHECK(LTFATERR_BADTRALEN, !(L % minL),
-          "L must divisible by lcm(a,M)=%d.", minL);
+    for (ltfat_int bl = minL; bl <= L / 2; bl += minL)
+        if (!(L % bl) && bl >= LTFAT_DGTREAL_OLA_MINBLOCKS * gl)
+            return bl;
 
-    CHECKMEM( p = LTFAT_NEW(LTFAT_NAME(dgtreal_plan)) );
-    p->M = M, p->a = a, p->L = L, p->W = W, p->c = c; p->f = f;
+    return 0;
+}
 
-    if (ltfat_dgt_long == paramsLoc.hint)
+/* Whether the backend can compute the analysis (fwd) or the synthesis
+ * for the given sizes */
+static int
+LTFAT_NAME(dgtreal_backend_applies)(ltfat_dgt_backend backend, int fwd,
+                                    ltfat_int L, ltfat_int gl, ltfat_int a, ltfat_int M)
+{
+    switch (backend)
     {
-        // Make the dual window longer if it is not already
-        CHECKMEM( g2 = LTFAT_NAME_REAL(malloc)(L) );
-        LTFAT_NAME(fir2long)(gs, gsl, L, g2);
+    case ltfat_dgt_backend_long:
+        return 1;
+    case ltfat_dgt_backend_fb:
+        return gl <= L;
+    case ltfat_dgt_backend_ola:
+        return fwd && LTFAT_NAME(dgtreal_ola_blocklen)(L, gl, a, M) > 0;
+    }
 
-        p->backtra = &LTFAT_NAME(idgtreal_long_execute_wrapper);
-        p->backdonefunc = &LTFAT_NAME(idgtreal_long_done_wrapper);
+    return 0;
+}
+
+static int
+LTFAT_NAME(dgtreal_init_fwd)(LTFAT_NAME(dgtreal_plan)* p, ltfat_dgt_backend backend,
+                             const LTFAT_REAL ga[], ltfat_int gal, LTFAT_COMPLEX c[],
+                             const ltfat_dgt_params* params)
+{
+    LTFAT_REAL* g2 = NULL;
+    ltfat_int L = p->L, W = p->W, a = p->a, M = p->M;
+    int status = LTFATERR_SUCCESS;
+
+    if (ltfat_dgt_backend_fb == backend)
+    {
+        p->fwdtra = &LTFAT_NAME(dgtreal_fb_execute_wrapper);
+        p->fwdtra_planar = &LTFAT_NAME(dgtreal_fb_execute_planar_wrapper);
+        p->fwddonefunc = &LTFAT_NAME(dgtreal_fb_done_wrapper);
 
-        LTFAT_NAME(idgtreal_long_plan)* backtra_tmp = NULL;
         CHECKSTATUS(
-            LTFAT_NAME(idgtreal_long_init)( g2, L, W, a, M, c, p->f, paramsLoc.ptype,
-                                            paramsLoc.fftw_flags,
-                                            &backtra_tmp));
+            LTFAT_NAME(dgtreal_fb_init)( ga, gal, a, M, params->ptype,
+                                         params->fftw_flags,
+                                         (LTFAT_NAME(dgtreal_fb_plan)**)&p->fwdtra_userdata));
 
-        LTFAT_NAME(idgtreal_long_set_overwriteoutarray)(
-            backtra_tmp, paramsLoc.do_synoverwrites);
-        p->backtra_userdata = (void*) backtra_tmp;
+        if (params->nthreads > 1)
+            CHECKSTATUS(
+                LTFAT_NAME(dgtreal_fb_set_nthreads)(
+                    (LTFAT_NAME(dgtreal_fb_plan)*) p->fwdtra_userdata,
+                    params->nthreads));
+
+        p->membytes += (2 * gal + 2 * M) * params->nthreads * sizeof(LTFAT_COMPLEX);
+    }
+    else if (ltfat_dgt_backend_ola == backend)
+    {
+        LTFAT_NAME(dgtreal_ola_plan)* ola = NULL;
+        ltfat_int bl = LTFAT_NAME(dgtreal_ola_blocklen)(L, gal, a, M);
+        CHECK(LTFATERR_BADARG, bl > 0, "OLA cannot be used with the given parameters");
+
+        p->fwdtra = &LTFAT_NAME(dgtreal_ola_execute_wrapper);
+        p->fwddonefunc = &LTFAT_NAME(dgtreal_ola_done_wrapper);
+
+        CHECKMEM( ola = LTFAT_NEW(LTFAT_NAME(dgtreal_ola_plan)) );
+        p->fwdtra_userdata = (void*) ola;
+
+        *ola = LTFAT_NAME(dgtreal_ola_init)(ga, gal, W, a, M, bl, params->ptype,
+                                            params->fftw_flags);
+        CHECK(LTFATERR_INITFAILED, ola->plan && ola->buf && ola->gext && ola->cbuf,
+              "OLA plan creation failed");
 
+        if (params->nthreads > 1)
+            CHECKSTATUS(
+                LTFAT_NAME(dgtreal_long_set_nthreads)(ola->plan, params->nthreads));
+
+        p->membytes += 2 * (bl + gal) * (W + 1) * sizeof(LTFAT_COMPLEX);
+    }
+    else
+    {
         p->fwdtra = &LTFAT_NAME(dgtreal_long_execute_wrapper);
         p->fwddonefunc = &LTFAT_NAME(dgtreal_long_done_wrapper);
 
         // Ensure the original window is long enough
+        CHECKMEM( g2 = LTFAT_NAME_REAL(malloc)(L) );
         LTFAT_NAME(fir2long)(ga, gal, L, g2);
 
         CHECKSTATUS(
-            LTFAT_NAME(dgtreal_long_init)( g2, L, W, a, M, p->f, c, paramsLoc.ptype,
-                                           paramsLoc.fftw_flags,
+            LTFAT_NAME(dgtreal_long_init)( g2, L, W, a, M, p->f, c, params->ptype,
+                                           params->fftw_flags,
                                            (LTFAT_NAME(dgtreal_long_plan)**)&p->fwdtra_userdata));
 
-        ltfat_safefree(g2);
+        if (params->nthreads > 1)
+            CHECKSTATUS(
+                LTFAT_NAME(dgtreal_long_set_nthreads)(
+                    (LTFAT_NAME(dgtreal_long_plan)*) p->fwdtra_userdata,
+                    params->nthreads));
+
+        p->membytes += (L + L * W) * sizeof(LTFAT_COMPLEX);
     }
-    else if ( ltfat_dgt_fb == paramsLoc.hint )
+
+error:
+    ltfat_safefree(g2);
+    return status;
+}
+
+static int
+LTFAT_NAME(dgtreal_init_back)(LTFAT_NAME(dgtreal_plan)* p, ltfat_dgt_backend backend,
+                              const LTFAT_REAL gs[], ltfat_int gsl, LTFAT_COMPLEX c[],
+                              const ltfat_dgt_params* params)
+{
+    LTFAT_REAL* g2 = NULL;
+    ltfat_int L = p->L, W = p->W, a = p->a, M = p->M;
+    int status = LTFATERR_SUCCESS;
+
+    if (ltfat_dgt_backend_fb == backend)
     {
-        // Use _fb functions only
+        LTFAT_NAME(idgtreal_fb_plan)* backtra_tmp = NULL;
         p->backtra = &LTFAT_NAME(idgtreal_fb_execute_wrapper);
+        p->backtra_planar = &LTFAT_NAME(idgtreal_fb_execute_planar_wrapper);
         p->backdonefunc = &LTFAT_NAME(idgtreal_fb_done_wrapper);
 
-        LTFAT_NAME(idgtreal_fb_plan)* backtra_tmp = NULL;
         CHECKSTATUS(
-            LTFAT_NAME(idgtreal_fb_init)( gs, gsl, a, M, paramsLoc.ptype,
-                                          paramsLoc.fftw_flags,
+            LTFAT_NAME(idgtreal_fb_init)( gs, gsl, a, M, params->ptype,
+                                          params->fftw_flags,
                                           &backtra_tmp));
+        p->backtra_userdata = (void*) backtra_tmp;
 
         LTFAT_NAME(idgtreal_fb_set_overwriteoutarray)(backtra_tmp,
-                paramsLoc.do_synoverwrites);
-        p->backtra_userdata = (void*) backtra_tmp;
+                params->do_synoverwrites);
 
-        p->fwdtra = &LTFAT_NAME(dgtreal_fb_execute_wrapper);
-        p->fwddonefunc = &LTFAT_NAME(dgtreal_fb_done_wrapper);
+        if (params->nthreads > 1)
+            CHECKSTATUS(
+                LTFAT_NAME(idgtreal_fb_set_nthreads)(backtra_tmp, params->nthreads));
+
+        p->membytes += (2 * gsl + 2 * M) * params->nthreads * sizeof(LTFAT_COMPLEX);
+    }
+    else
+    {
+        LTFAT_NAME(idgtreal_long_plan)* backtra_tmp = NULL;
+        p->backtra = &LTFAT_NAME(idgtreal_long_execute_wrapper);
+        p->backdonefunc = &LTFAT_NAME(idgtreal_long_done_wrapper);
+
+        // Make the dual window longer if it is not already
+        CHECKMEM( g2 = LTFAT_NAME_REAL(malloc)(L) );
+        LTFAT_NAME(fir2long)(gs, gsl, L, g2);
 
         CHECKSTATUS(
-            LTFAT_NAME(dgtreal_fb_init)( ga, gal, a, M, paramsLoc.ptype,
-                                         paramsLoc.fftw_flags,
-                                         (LTFAT_NAME(dgtreal_fb_plan)**)&p->fwdtra_userdata));
+            LTFAT_NAME(idgtreal_long_init)( g2, L, W, a, M, c, p->f, params->ptype,
+                                            params->fftw_flags,
+                                            &backtra_tmp));
+        p->backtra_userdata = (void*) backtra_tmp;
+
+        LTFAT_NAME(idgtreal_long_set_overwriteoutarray)(
+            backtra_tmp, params->do_synoverwrites);
+
+        if (params->nthreads > 1)
+            CHECKSTATUS(
+                LTFAT_NAME(idgtreal_long_set_nthreads)(backtra_tmp, params->nthreads));
 
+        p->membytes += (L + 2 * L * W) * sizeof(LTFAT_COMPLEX);
     }
-    else if ( ltfat_dgt_auto == paramsLoc.hint )
+
+error:
+    ltfat_safefree(g2);
+    return status;
+}
+
+/* Best of LTFAT_DGT_AUTOTUNE_RUNS runs, after one untimed warm-up run */
+static long long
+LTFAT_NAME(dgtreal_autotune_timefwd)(LTFAT_NAME(dgtreal_plan)* p,
+                                     const LTFAT_REAL f[], LTFAT_COMPLEX c[])
+{
+    long long tbest = -1;
+
+    for (int r = -1; r < LTFAT_DGT_AUTOTUNE_RUNS; r++)
     {
-        // Decide whether to use _fb or _long depending on the window lengths
-        if (gsl < L)
-        {
-            p->backtra = &LTFAT_NAME(idgtreal_fb_execute_wrapper);
-            p->backdonefunc = &LTFAT_NAME(idgtreal_fb_done_wrapper);
+        long long t = ltfat_monotonic_ns();
+        p->fwdtra(p->fwdtra_userdata, f, p->L, p->W, c);
+        t = ltfat_monotonic_ns() - t;
 
-            LTFAT_NAME(idgtreal_fb_plan)* backtra_tmp = NULL;
-            LTFAT_NAME(idgtreal_fb_init)( gs, gsl, a, M, paramsLoc.ptype,
-                                          paramsLoc.fftw_flags,
-                                          &backtra_tmp);
+        if (r >= 0 && (tbest < 0 || t < tbest))
+            tbest = t;
+    }
+    return tbest;
+}
 
-            LTFAT_NAME(idgtreal_fb_set_overwriteoutarray)(backtra_tmp,
-                    paramsLoc.do_synoverwrites);
-            p->backtra_userdata = (void*) backtra_tmp;
-        }
-        else
-        {
-            p->backtra = &LTFAT_NAME(idgtreal_long_execute_wrapper);
-            p->backdonefunc = &LTFAT_NAME(idgtreal_long_done_wrapper);
+static long long
+LTFAT_NAME(dgtreal_autotune_timeback)(LTFAT_NAME(dgtreal_plan)* p,
+                                      const LTFAT_COMPLEX c[], LTFAT_REAL f[])
+{
+    long long tbest = -1;
 
-            CHECKMEM( g2 = LTFAT_NAME_REAL(malloc)(L) );
-            LTFAT_NAME(fir2long)(gs, gsl, L, g2);
+    for (int r = -1; r < LTFAT_DGT_AUTOTUNE_RUNS; r++)
+    {
+        long long t = ltfat_monotonic_ns();
+        p->backtra(p->backtra_userdata, c, p->L, p->W, f);
+        t = ltfat_monotonic_ns() - t;
 
-            LTFAT_NAME(idgtreal_long_plan)* backtra_tmp = NULL;
-            LTFAT_NAME(idgtreal_long_init)(g2, L, W, a, M, c, p->f, paramsLoc.ptype,
-                                           paramsLoc.fftw_flags, &backtra_tmp);
+        if (r >= 0 && (tbest < 0 || t < tbest))
+            tbest = t;
+    }
+    return tbest;
+}
 
-            LTFAT_NAME(idgtreal_long_set_overwriteoutarray)(
-                backtra_tmp, paramsLoc.do_synoverwrites);
-            p->backtra_userdata = (void*) backtra_tmp;
+/* Times all algorithms applicable to the given sizes on temporary arrays
+ * and returns the fastest ones */
+static int
+LTFAT_NAME(dgtreal_autotune)(const LTFAT_REAL ga[], ltfat_int gal,
+                             const LTFAT_REAL gs[], ltfat_int gsl,
+                             ltfat_int L, ltfat_int W, ltfat_int a, ltfat_int M,
+                             const ltfat_dgt_params* params,
+                             ltfat_dgt_backend* fwd, ltfat_dgt_backend* back)
+{
+    LTFAT_NAME(dgtreal_plan) pt;
+    LTFAT_REAL* fbuf = NULL;
+    LTFAT_COMPLEX* cbuf = NULL;
+    const ltfat_dgt_backend cand[] = { ltfat_dgt_backend_fb, ltfat_dgt_backend_long,
+                                       ltfat_dgt_backend_ola
+                                     };
+    ltfat_dgt_backend fwdcand[3], backcand[3];
+    int fwdno = 0, backno = 0;
+    long long tbest;
+    int status = LTFATERR_SUCCESS;
 
-            ltfat_safefree(g2);
-        }
+    memset(&pt, 0, sizeof pt);
+    pt.L = L; pt.W = W; pt.a = a; pt.M = M;
 
-        if (gal < L)
-        {
-            p->fwdtra = &LTFAT_NAME(dgtreal_fb_execute_wrapper);
-            p->fwddonefunc = &LTFAT_NAME(dgtreal_fb_done_wrapper);
+    for (int ii = 0; ii < 3; ii++)
+    {
+        ltfat_dgt_backend backend = cand[ii];
+        if (LTFAT_NAME(dgtreal_backend_applies)(backend, 1, L, gal, a, M))
+            fwdcand[fwdno++] = backend;
+        if (LTFAT_NAME(dgtreal_backend_applies)(backend, 0, L, gsl, a, M))
+            backcand[backno++] = backend;
+    }
 
-            LTFAT_NAME(dgtreal_fb_init)(ga, gal, a, M, paramsLoc.ptype,
-                                        paramsLoc.fftw_flags,
-                                        (LTFAT_NAME(dgtreal_fb_plan)**)&p->fwdtra_userdata);
+    CHECKMEM( fbuf = LTFAT_NAME_REAL(calloc)(L * W));
+    CHECKMEM( cbuf = LTFAT_NAME_COMPLEX(calloc)((M / 2 + 1) * (L / a) * W));
+    pt.f = fbuf;
 
-        }
-        else
-        {
-            p->fwdtra = &LTFAT_NAME(dgtreal_long_execute_wrapper);
-            p->fwddonefunc = &LTFAT_NAME(dgtreal_long_done_wrapper);
+    tbest = -1;
+    for (int ii = 0; ii < fwdno; ii++)
+    {
+        long long t;
+        CHECKSTATUS(
+            LTFAT_NAME(dgtreal_init_fwd)(&pt, fwdcand[ii], ga, gal, cbuf, params));
 
-            CHECKMEM( g2 = LTFAT_NAME_REAL(malloc)(L) );
-            LTFAT_NAME(fir2long)(ga, gal, L, g2);
+        t = LTFAT_NAME(dgtreal_autotune_timefwd)(&pt, fbuf, cbuf);
+        pt.fwddonefunc(&pt.fwdtra_userdata);
+        pt.fwdtra_userdata = NULL;
 
+        if (tbest < 0 || t < tbest) { tbest = t; *fwd = fwdcand[ii]; }
+    }
 
-            LTFAT_NAME(dgtreal_long_init)( g2, L, W, a, M, p->f, c, paramsLoc.ptype,
-                                           paramsLoc.fftw_flags,
-                                           (LTFAT_NAME(dgtreal_long_plan)**)&p->fwdtra_userdata);
+    tbest = -1;
+    for (int ii = 0; ii < backno; ii++)
+    {
+        long long t;
+        CHECKSTATUS(
+            LTFAT_NAME(dgtreal_init_back)(&pt, backcand[ii], gs, gsl, cbuf, params));
+
+        t = LTFAT_NAME(dgtreal_autotune_timeback)(&pt, cbuf, fbuf);
+        pt.backdonefunc(&pt.backtra_userdata);
+        pt.backtra_userdata = NULL;
+
+        if (tbest < 0 || t < tbest) { tbest = t; *back = backcand[ii]; }
+    }
+
+error:
+    if (pt.fwdtra_userdata) pt.fwddonefunc(&pt.fwdtra_userdata);
+    if (pt.backtra_userdata) pt.backdonefunc(&pt.backtra_userdata);
+    LTFAT_SAFEFREEALL(fbuf, cbuf);
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtreal_init_gen)(const LTFAT_REAL ga[], ltfat_int gal,
+                             const LTFAT_REAL gs[], ltfat_int gsl,
+                             ltfat_int L, ltfat_int W, ltfat_int a, ltfat_int M,
+                             LTFAT_REAL f[], LTFAT_COMPLEX c[],
+                             ltfat_dgt_params* params, LTFAT_NAME(dgtreal_plan)** pout)
+{
+    int status = LTFATERR_SUCCESS;
+    LTFAT_NAME(dgtreal_plan)* p = NULL;
+    ltfat_dgt_params paramsLoc;
+    ltfat_dgt_backend fwd = ltfat_dgt_backend_long, back = ltfat_dgt_backend_long;
+    int fftnthreads = 0; // FFT planner threads to restore, 0 if unchanged
+
+    ltfat_int minL = ltfat_lcm(a, M);
+
+    if (params)
+        paramsLoc = *params;
+    else
+        ltfat_dgt_params_defaults(&paramsLoc);
+
+    CHECKNULL( pout );
+    CHECK(LTFATERR_BADTRALEN, !(L % minL),
+          "L must divisible by lcm(a,M)=%d.", minL);
+
+    CHECKMEM( p = LTFAT_NEW(LTFAT_NAME(dgtreal_plan)) );
+    p->M = M, p->a = a, p->L = L, p->W = W, p->c = c; p->f = f;
+
+    // Long FFTs in the _long plans are threaded by the FFT library itself.
+    // The planner setting is process-wide, it is restored at the end.
+    if (paramsLoc.nthreads > 1)
+    {
+        fftnthreads = LTFAT_NAME_REAL(fft_planner_nthreads)();
+        CHECKSTATUS( LTFAT_NAME_REAL(fft_plan_with_nthreads)(paramsLoc.nthreads));
+    }
 
-            ltfat_safefree(g2);
+    if (ltfat_dgt_long == paramsLoc.hint)
+    {
+        fwd = ltfat_dgt_backend_long;
+        back = ltfat_dgt_backend_long;
+    }
+    else if ( ltfat_dgt_fb == paramsLoc.hint )
+    {
+        // Use _fb functions only
+        fwd = ltfat_dgt_backend_fb;
+        back = ltfat_dgt_backend_fb;
+    }
+    else if ( ltfat_dgt_auto == paramsLoc.hint )
+    {
+        // Decide whether to use _fb or _long depending on the window lengths
+        back = gsl < L ? ltfat_dgt_backend_fb : ltfat_dgt_backend_long;
+        fwd  = gal < L ? ltfat_dgt_backend_fb : ltfat_dgt_backend_long;
+    }
+    else if ( ltfat_dgt_autotune == paramsLoc.hint )
+    {
+        // Reuse an earlier decision or time the algorithms
+        ltfat_dgt_wisdom wis;
+        memset(&wis, 0, sizeof wis);
+        strcpy(wis.transform,
+               sizeof(LTFAT_REAL) == sizeof(double) ? "dgtreal_d" : "dgtreal_s");
+        wis.L = L; wis.W = W; wis.a = a; wis.M = M; wis.gal = gal; wis.gsl = gsl;
+        wis.ptype = paramsLoc.ptype; wis.nthreads = paramsLoc.nthreads;
+
+        // Entries imported from a file may not fit the sizes, those are
+        // timed again and replaced
+        if (!ltfat_dgt_wisdom_lookup(&wis) ||
+            !LTFAT_NAME(dgtreal_backend_applies)(wis.fwd, 1, L, gal, a, M) ||
+            !LTFAT_NAME(dgtreal_backend_applies)(wis.back, 0, L, gsl, a, M))
+        {
+            CHECKSTATUS(
+                LTFAT_NAME(dgtreal_autotune)(ga, gal, gs, gsl, L, W, a, M, &paramsLoc,
+                                             &wis.fwd, &wis.back));
+            CHECKSTATUS( ltfat_dgt_wisdom_store(&wis));
         }
+
+        fwd = wis.fwd;
+        back = wis.back;
     }
     else
     {
         CHECKCANTHAPPEN("No such dgtreal hint");
     }
 
+    CHECKSTATUS(
+        LTFAT_NAME(dgtreal_init_back)(p, back, gs, gsl, c, &paramsLoc));
+
+    CHECKSTATUS(
+        LTFAT_NAME(dgtreal_init_fwd)(p, fwd, ga, gal, c, &paramsLoc));
+
+    if (fftnthreads > 0)
+        LTFAT_NAME_REAL(fft_plan_with_nthreads)(fftnthreads);
+
     *pout = p;
 
     return status;
 error:
-    ltfat_safefree(g2);
+    if (fftnthreads > 0)
+        LTFAT_NAME_REAL(fft_plan_with_nthreads)(fftnthreads);
     if (p) LTFAT_NAME(dgtreal_done)(&p);
     return status;
 
@@ -2,8 +2,19 @@
 #define _ltfat_dgtrealwrapper_private_h
 #include "dgtwrapper_private.h"
 
+/* Number of timed runs of each algorithm in the autotuning */
+#define LTFAT_DGT_AUTOTUNE_RUNS 3
+
+/* Minimum OLA block length in multiples of the window length */
+#define LTFAT_DGTREAL_OLA_MINBLOCKS 8
+
+/* Default memory budget of the plan cache in bytes */
+#define LTFAT_DGTREAL_PLAN_CACHE_BUDGET (64 * 1024 * 1024)
+
 typedef int LTFAT_NAME(complextorealtransform)(void* userdata, const LTFAT_COMPLEX* c, ltfat_int L, ltfat_int W, LTFAT_REAL* f);
 typedef int LTFAT_NAME(realtocomplextransform)(void* userdata, const LTFAT_REAL* f, ltfat_int L, ltfat_int W, LTFAT_COMPLEX* c);
+typedef int LTFAT_NAME(planartorealtransform)(void* userdata, const LTFAT_REAL* cr, const LTFAT_REAL* ci, ltfat_int L, ltfat_int W, LTFAT_REAL* f);
+typedef int LTFAT_NAME(realtoplanartransform)(void* userdata, const LTFAT_REAL* f, ltfat_int L, ltfat_int W, LTFAT_REAL* cr, LTFAT_REAL* ci);
 
 struct LTFAT_NAME(dgtreal_plan)
 {
@@ -20,6 +31,10 @@ struct LTFAT_NAME(dgtreal_plan)
     LTFAT_NAME(realtocomplextransform)* fwdtra;
     void* fwdtra_userdata;
     LTFAT_NAME(donefunc)* fwddonefunc;
+    LTFAT_NAME(planartorealtransform)* backtra_planar; //!< NULL if the backend is interleaved only
+    LTFAT_NAME(realtoplanartransform)* fwdtra_planar; //!< NULL if the backend is interleaved only
+    size_t membytes; //!< Approximate memory taken by the backend plans and cplanar
+    LTFAT_COMPLEX* cplanar; //!< Buffer of the planar execute functions for interleaved only backends
 };
 
 #endif
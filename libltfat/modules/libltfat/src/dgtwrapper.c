@@ -303,8 +303,10 @@ LTFAT_NAME(dgt_init_gen)(const LTFAT_TYPE ga[], ltfat_int gal,
                                      (LTFAT_NAME(dgt_fb_plan)**)&p->fwdtra_userdata));
 
     }
-    else if ( ltfat_dgt_auto == paramsLoc.hint )
+    else if ( ltfat_dgt_auto == paramsLoc.hint ||
+              ltfat_dgt_autotune == paramsLoc.hint )
     {
+        // Autotuning is only done for the real transform
         // Decide whether to use _fb or _long depending on the window lengths
         if (gsl < L)
         {
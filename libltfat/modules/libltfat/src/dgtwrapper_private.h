@@ -8,8 +8,42 @@ struct ltfat_dgt_params
     unsigned fftw_flags;
     ltfat_dgt_hint hint;
     int do_synoverwrites;
+    int nthreads;
 };
 
+/* Algorithms the DGT wrappers can dispatch to */
+typedef enum
+{
+    ltfat_dgt_backend_long,
+    ltfat_dgt_backend_fb,
+    ltfat_dgt_backend_ola
+} ltfat_dgt_backend;
+
+/* Entry of the process-wide table of autotuning decisions */
+typedef struct
+{
+    char transform[16];       // Transform name including the precision suffix
+    ltfat_int L;
+    ltfat_int W;
+    ltfat_int a;
+    ltfat_int M;
+    ltfat_int gal;
+    ltfat_int gsl;
+    int ptype;
+    int nthreads;
+    ltfat_dgt_backend fwd;    // Analysis
+    ltfat_dgt_backend back;   // Synthesis
+} ltfat_dgt_wisdom;
+
+/* Fills in fwd and back if an entry with the same key exists.
+ * Returns 1 if the entry was found and 0 otherwise. */
+int
+ltfat_dgt_wisdom_lookup(ltfat_dgt_wisdom* w);
+
+/* Adds the entry to the table, replacing an entry with the same key */
+int
+ltfat_dgt_wisdom_store(const ltfat_dgt_wisdom* w);
+
 typedef int LTFAT_NAME(donefunc)(void** pla);
 
 typedef int LTFAT_NAME(complextocomplextransform)(void* userdata, const LTFAT_COMPLEX* c, ltfat_int L, ltfat_int W, LTFAT_COMPLEX* f);
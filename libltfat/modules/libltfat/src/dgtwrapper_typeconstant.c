@@ -5,6 +5,12 @@
 
 #include "ltfat/thirdparty/fftw3.h"
 
+static const char* ltfat_dgt_backend_names[] = { "long", "fb", "ola" };
+
+static ltfat_dgt_wisdom* ltfat_dgt_wisdom_table = NULL;
+static ltfat_int ltfat_dgt_wisdom_no = 0;
+static ltfat_int ltfat_dgt_wisdom_cap = 0;
+
 int
 ltfat_dgt_params_defaults(ltfat_dgt_params* params)
 {
@@ -14,6 +20,7 @@ ltfat_dgt_params_defaults(ltfat_dgt_params* params)
     params->fftw_flags = FFTW_ESTIMATE;
     params->hint = ltfat_dgt_auto;
     params->do_synoverwrites = 1;
+    params->nthreads = 1;
 error:
     return status;
 }
@@ -70,6 +77,24 @@ error:
     return status;
 }
 
+LTFAT_API int
+ltfat_dgt_setpar_nthreads(ltfat_dgt_params* params, int nthreads)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(params);
+    CHECK(LTFATERR_NOTPOSARG, nthreads > 0, "nthreads must be positive");
+    params->nthreads = nthreads;
+error:
+    return status;
+}
+
+LTFAT_API int
+ltfat_dgt_getpar_nthreads(ltfat_dgt_params* params)
+{
+    if(params) return params->nthreads;
+    else return LTFATERR_NULLPOINTER;
+}
+
 LTFAT_API int
 ltfat_dgt_setpar_hint(ltfat_dgt_params* params,
                               ltfat_dgt_hint hint)
@@ -101,3 +126,190 @@ ltfat_dgt_params_free(ltfat_dgt_params* params)
 error:
     return status;
 }
+
+static int
+ltfat_dgt_wisdom_samekey(const ltfat_dgt_wisdom* w1, const ltfat_dgt_wisdom* w2)
+{
+    return !strcmp(w1->transform, w2->transform) &&
+           w1->L == w2->L && w1->W == w2->W && w1->a == w2->a && w1->M == w2->M &&
+           w1->gal == w2->gal && w1->gsl == w2->gsl &&
+           w1->ptype == w2->ptype && w1->nthreads == w2->nthreads;
+}
+
+/* The following two functions must be called from within the
+ * ltfat_dgt_wisdom critical section */
+static ltfat_int
+ltfat_dgt_wisdom_find(const ltfat_dgt_wisdom* w)
+{
+    for (ltfat_int ii = 0; ii < ltfat_dgt_wisdom_no; ii++)
+        if (ltfat_dgt_wisdom_samekey(ltfat_dgt_wisdom_table + ii, w))
+            return ii;
+
+    return -1;
+}
+
+static int
+ltfat_dgt_wisdom_insert(const ltfat_dgt_wisdom* w)
+{
+    ltfat_int idx;
+    int status = LTFATERR_SUCCESS;
+
+    idx = ltfat_dgt_wisdom_find(w);
+    if (idx < 0)
+    {
+        if (ltfat_dgt_wisdom_no == ltfat_dgt_wisdom_cap)
+        {
+            ltfat_int newcap = ltfat_dgt_wisdom_cap > 0 ? 2 * ltfat_dgt_wisdom_cap : 16;
+            ltfat_dgt_wisdom* newtable;
+            CHECKMEM( newtable = (ltfat_dgt_wisdom*)
+                                 ltfat_realloc(ltfat_dgt_wisdom_table,
+                                               ltfat_dgt_wisdom_cap * sizeof * newtable,
+                                               newcap * sizeof * newtable));
+            ltfat_dgt_wisdom_table = newtable;
+            ltfat_dgt_wisdom_cap = newcap;
+        }
+        idx = ltfat_dgt_wisdom_no++;
+    }
+
+    ltfat_dgt_wisdom_table[idx] = *w;
+error:
+    return status;
+}
+
+int
+ltfat_dgt_wisdom_lookup(ltfat_dgt_wisdom* w)
+{
+    ltfat_int idx;
+
+#ifdef _OPENMP
+    #pragma omp critical(ltfat_dgt_wisdom)
+#endif
+    {
+        idx = ltfat_dgt_wisdom_find(w);
+        if (idx >= 0)
+        {
+            w->fwd = ltfat_dgt_wisdom_table[idx].fwd;
+            w->back = ltfat_dgt_wisdom_table[idx].back;
+        }
+    }
+
+    return idx >= 0;
+}
+
+int
+ltfat_dgt_wisdom_store(const ltfat_dgt_wisdom* w)
+{
+    int status;
+
+#ifdef _OPENMP
+    #pragma omp critical(ltfat_dgt_wisdom)
+#endif
+    status = ltfat_dgt_wisdom_insert(w);
+
+    return status;
+}
+
+LTFAT_API int
+ltfat_dgt_wisdom_export(const char* filename)
+{
+    FILE* fp = NULL;
+    int written = 1;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(filename);
+
+    fp = fopen(filename, "w");
+    CHECK(LTFATERR_FAILED, fp, "Cannot open %s for writing.", filename);
+
+    written = fprintf(fp, "# ltfat dgt wisdom\n") > 0;
+
+#ifdef _OPENMP
+    #pragma omp critical(ltfat_dgt_wisdom)
+#endif
+    for (ltfat_int ii = 0; ii < ltfat_dgt_wisdom_no; ii++)
+    {
+        const ltfat_dgt_wisdom* w = ltfat_dgt_wisdom_table + ii;
+        written = written &&
+                  fprintf(fp, "%s %lld %lld %lld %lld %lld %lld %d %d %s %s\n",
+                          w->transform, (long long) w->L, (long long) w->W,
+                          (long long) w->a, (long long) w->M,
+                          (long long) w->gal, (long long) w->gsl,
+                          w->ptype, w->nthreads,
+                          ltfat_dgt_backend_names[w->fwd],
+                          ltfat_dgt_backend_names[w->back]) > 0;
+    }
+
+    written = !fclose(fp) && written;
+    CHECK(LTFATERR_FAILED, written, "Writing to %s failed.", filename);
+error:
+    return status;
+}
+
+static int
+ltfat_dgt_backend_from_name(const char* name, ltfat_dgt_backend* backend)
+{
+    for (int ii = 0; ii < (int)(sizeof ltfat_dgt_backend_names /
+                                sizeof * ltfat_dgt_backend_names); ii++)
+        if (!strcmp(name, ltfat_dgt_backend_names[ii]))
+        {
+            *backend = (ltfat_dgt_backend) ii;
+            return 1;
+        }
+
+    return 0;
+}
+
+LTFAT_API int
+ltfat_dgt_wisdom_import(const char* filename)
+{
+    FILE* fp = NULL;
+    char line[256];
+    int lineno = 0;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(filename);
+
+    fp = fopen(filename, "r");
+    CHECK(LTFATERR_FAILED, fp, "Cannot open %s for reading.", filename);
+
+    while (fgets(line, sizeof line, fp))
+    {
+        ltfat_dgt_wisdom w;
+        long long L, W, a, M, gal, gsl;
+        char fwdname[16], backname[16];
+        int nread;
+        lineno++;
+
+        if (line[0] == '#' || line[0] == '\n')
+            continue;
+
+        nread = sscanf(line, "%15s %lld %lld %lld %lld %lld %lld %d %d %15s %15s",
+                       w.transform, &L, &W, &a, &M, &gal, &gsl,
+                       &w.ptype, &w.nthreads, fwdname, backname);
+
+        CHECK(LTFATERR_BADARG,
+              nread == 11 && ltfat_dgt_backend_from_name(fwdname, &w.fwd) &&
+              ltfat_dgt_backend_from_name(backname, &w.back),
+              "Malformed line %d in %s.", lineno, filename);
+
+        w.L = L; w.W = W; w.a = a; w.M = M; w.gal = gal; w.gsl = gsl;
+
+        CHECKSTATUS( ltfat_dgt_wisdom_store(&w));
+    }
+
+error:
+    if (fp) fclose(fp);
+    return status;
+}
+
+LTFAT_API void
+ltfat_dgt_wisdom_forget(void)
+{
+#ifdef _OPENMP
+    #pragma omp critical(ltfat_dgt_wisdom)
+#endif
+    {
+        ltfat_safefree(ltfat_dgt_wisdom_table);
+        ltfat_dgt_wisdom_table = NULL;
+        ltfat_dgt_wisdom_no = 0;
+        ltfat_dgt_wisdom_cap = 0;
+    }
+}
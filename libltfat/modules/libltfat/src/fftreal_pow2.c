@@ -0,0 +1,294 @@
+#include "ltfat.h"
+#include "ltfat/types.h"
+#include "ltfat/macros.h"
+#include "simd_private.h"
+
+struct LTFAT_NAME(fftreal_pow2_plan)
+{
+    ltfat_int L;
+    ltfat_int n;       //!< Length of the complex transform, L/2
+    LTFAT_REAL* tw;    //!< Twiddle factors of the radix-4 stages
+    LTFAT_REAL* rtw;   //!< exp(-2*pi*i*k/L), k=0,...,n, real parts followed by imag. parts
+    LTFAT_REAL* buf;   //!< Two pairs of split complex arrays, 4 x n
+};
+
+/* One radix-4 Stockham stage. Sub-transforms of length nn are
+ * interleaved with stride s. For each of the m = nn/4 butterflies, the
+ * q loop runs over contiguous memory and it is vectorized. */
+static void
+LTFAT_NAME(fftreal_pow2_radix4)(ltfat_int nn, ltfat_int s, const LTFAT_REAL* tw,
+                                const LTFAT_REAL* xr, const LTFAT_REAL* xi,
+                                LTFAT_REAL* yr, LTFAT_REAL* yi)
+{
+    ltfat_int m = nn / 4, sm = s * m;
+
+    for (ltfat_int p = 0; p < m; p++)
+    {
+        LTFAT_REAL w1r = tw[p], w1i = tw[m + p];
+        LTFAT_REAL w2r = tw[2 * m + p], w2i = tw[3 * m + p];
+        LTFAT_REAL w3r = tw[4 * m + p], w3i = tw[5 * m + p];
+        const LTFAT_REAL* ar = xr + s * p, *ai = xi + s * p;
+        LTFAT_REAL* or0 = yr + 4 * s * p, *oi0 = yi + 4 * s * p;
+        ltfat_int q = 0;
+
+#if LTFAT_VLEN > 1
+        if (s >= LTFAT_VLEN)
+        {
+            ltfat_vreal vw1r = LTFAT_VSET1(w1r), vw1i = LTFAT_VSET1(w1i);
+            ltfat_vreal vw2r = LTFAT_VSET1(w2r), vw2i = LTFAT_VSET1(w2i);
+            ltfat_vreal vw3r = LTFAT_VSET1(w3r), vw3i = LTFAT_VSET1(w3i);
+
+            for (; q < s; q += LTFAT_VLEN)
+            {
+                ltfat_vreal a_r = LTFAT_VLOAD(ar + q), a_i = LTFAT_VLOAD(ai + q);
+                ltfat_vreal b_r = LTFAT_VLOAD(ar + sm + q), b_i = LTFAT_VLOAD(ai + sm + q);
+                ltfat_vreal c_r = LTFAT_VLOAD(ar + 2 * sm + q), c_i = LTFAT_VLOAD(ai + 2 * sm + q);
+                ltfat_vreal d_r = LTFAT_VLOAD(ar + 3 * sm + q), d_i = LTFAT_VLOAD(ai + 3 * sm + q);
+
+                ltfat_vreal apc_r = LTFAT_VADD(a_r, c_r), apc_i = LTFAT_VADD(a_i, c_i);
+                ltfat_vreal amc_r = LTFAT_VSUB(a_r, c_r), amc_i = LTFAT_VSUB(a_i, c_i);
+                ltfat_vreal bpd_r = LTFAT_VADD(b_r, d_r), bpd_i = LTFAT_VADD(b_i, d_i);
+                ltfat_vreal bmd_r = LTFAT_VSUB(b_r, d_r), bmd_i = LTFAT_VSUB(b_i, d_i);
+                ltfat_vreal t_r, t_i;
+
+                LTFAT_VSTORE(or0 + q, LTFAT_VADD(apc_r, bpd_r));
+                LTFAT_VSTORE(oi0 + q, LTFAT_VADD(apc_i, bpd_i));
+
+                // (a - c) - i(b - d)
+                t_r = LTFAT_VADD(amc_r, bmd_i); t_i = LTFAT_VSUB(amc_i, bmd_r);
+                LTFAT_VSTORE(or0 + s + q, LTFAT_VSUB(LTFAT_VMUL(vw1r, t_r), LTFAT_VMUL(vw1i, t_i)));
+                LTFAT_VSTORE(oi0 + s + q, LTFAT_VADD(LTFAT_VMUL(vw1r, t_i), LTFAT_VMUL(vw1i, t_r)));
+
+                t_r = LTFAT_VSUB(apc_r, bpd_r); t_i = LTFAT_VSUB(apc_i, bpd_i);
+                LTFAT_VSTORE(or0 + 2 * s + q, LTFAT_VSUB(LTFAT_VMUL(vw2r, t_r), LTFAT_VMUL(vw2i, t_i)));
+                LTFAT_VSTORE(oi0 + 2 * s + q, LTFAT_VADD(LTFAT_VMUL(vw2r, t_i), LTFAT_VMUL(vw2i, t_r)));
+
+                // (a - c) + i(b - d)
+                t_r = LTFAT_VSUB(amc_r, bmd_i); t_i = LTFAT_VADD(amc_i, bmd_r);
+                LTFAT_VSTORE(or0 + 3 * s + q, LTFAT_VSUB(LTFAT_VMUL(vw3r, t_r), LTFAT_VMUL(vw3i, t_i)));
+                LTFAT_VSTORE(oi0 + 3 * s + q, LTFAT_VADD(LTFAT_VMUL(vw3r, t_i), LTFAT_VMUL(vw3i, t_r)));
+            }
+        }
+#endif
+
+        for (; q < s; q++)
+        {
+            LTFAT_REAL apc_r = ar[q] + ar[2 * sm + q], apc_i = ai[q] + ai[2 * sm + q];
+            LTFAT_REAL amc_r = ar[q] - ar[2 * sm + q], amc_i = ai[q] - ai[2 * sm + q];
+            LTFAT_REAL bpd_r = ar[sm + q] + ar[3 * sm + q], bpd_i = ai[sm + q] + ai[3 * sm + q];
+            LTFAT_REAL bmd_r = ar[sm + q] - ar[3 * sm + q], bmd_i = ai[sm + q] - ai[3 * sm + q];
+            LTFAT_REAL t_r, t_i;
+
+            or0[q] = apc_r + bpd_r;
+            oi0[q] = apc_i + bpd_i;
+
+            t_r = amc_r + bmd_i; t_i = amc_i - bmd_r;
+            or0[s + q] = w1r * t_r - w1i * t_i;
+            oi0[s + q] = w1r * t_i + w1i * t_r;
+
+            t_r = apc_r - bpd_r; t_i = apc_i - bpd_i;
+            or0[2 * s + q] = w2r * t_r - w2i * t_i;
+            oi0[2 * s + q] = w2r * t_i + w2i * t_r;
+
+            t_r = amc_r - bmd_i; t_i = amc_i + bmd_r;
+            or0[3 * s + q] = w3r * t_r - w3i * t_i;
+            oi0[3 * s + q] = w3r * t_i + w3i * t_r;
+        }
+    }
+}
+
+/* The last stage if log2(n) is odd. No twiddle factors are needed. */
+static void
+LTFAT_NAME(fftreal_pow2_radix2)(ltfat_int s,
+                                const LTFAT_REAL* xr, const LTFAT_REAL* xi,
+                                LTFAT_REAL* yr, LTFAT_REAL* yi)
+{
+    ltfat_int q = 0;
+
+#if LTFAT_VLEN > 1
+    for (; q + LTFAT_VLEN <= s; q += LTFAT_VLEN)
+    {
+        ltfat_vreal a_r = LTFAT_VLOAD(xr + q), a_i = LTFAT_VLOAD(xi + q);
+        ltfat_vreal b_r = LTFAT_VLOAD(xr + s + q), b_i = LTFAT_VLOAD(xi + s + q);
+        LTFAT_VSTORE(yr + q, LTFAT_VADD(a_r, b_r));
+        LTFAT_VSTORE(yi + q, LTFAT_VADD(a_i, b_i));
+        LTFAT_VSTORE(yr + s + q, LTFAT_VSUB(a_r, b_r));
+        LTFAT_VSTORE(yi + s + q, LTFAT_VSUB(a_i, b_i));
+    }
+#endif
+
+    for (; q < s; q++)
+    {
+        LTFAT_REAL a_r = xr[q], a_i = xi[q], b_r = xr[s + q], b_i = xi[s + q];
+        yr[q] = a_r + b_r; yi[q] = a_i + b_i;
+        yr[s + q] = a_r - b_r; yi[s + q] = a_i - b_i;
+    }
+}
+
+/* Forward complex FFT of length n of the split array (xr,xi) using
+ * (yr,yi) as the second buffer. The result is in (*zr,*zi), which
+ * points to one of the two. */
+static void
+LTFAT_NAME(fftreal_pow2_fftsplit)(LTFAT_NAME(fftreal_pow2_plan)* p,
+                                  LTFAT_REAL* xr, LTFAT_REAL* xi,
+                                  LTFAT_REAL* yr, LTFAT_REAL* yi,
+                                  LTFAT_REAL** zr, LTFAT_REAL** zi)
+{
+    const LTFAT_REAL* tw = p->tw;
+    ltfat_int nn = p->n, s = 1;
+
+    for (; nn >= 4; nn /= 4, s *= 4)
+    {
+        LTFAT_REAL* tmp;
+        LTFAT_NAME(fftreal_pow2_radix4)(nn, s, tw, xr, xi, yr, yi);
+        tw += 6 * (nn / 4);
+        tmp = xr; xr = yr; yr = tmp;
+        tmp = xi; xi = yi; yi = tmp;
+    }
+
+    if (nn == 2)
+    {
+        LTFAT_NAME(fftreal_pow2_radix2)(s, xr, xi, yr, yi);
+        xr = yr; xi = yi;
+    }
+
+    *zr = xr; *zi = xi;
+}
+
+LTFAT_API int
+LTFAT_NAME(fftreal_pow2_init)(ltfat_int L, LTFAT_NAME(fftreal_pow2_plan)** pout)
+{
+    LTFAT_NAME(fftreal_pow2_plan)* p = NULL;
+    ltfat_int n, twl = 0;
+    LTFAT_REAL* tw;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(pout);
+    CHECK(LTFATERR_BADARG, ltfat_ispow2(L) && L >= LTFAT_FFTREAL_POW2_MINL,
+          "L must be a power of two and at least %d (passed %td)",
+          LTFAT_FFTREAL_POW2_MINL, L);
+
+    n = L / 2;
+    for (ltfat_int nn = n; nn >= 4; nn /= 4)
+        twl += 6 * (nn / 4);
+
+    CHECKMEM( p = LTFAT_NEW(LTFAT_NAME(fftreal_pow2_plan)) );
+    p->L = L; p->n = n;
+    CHECKMEM( p->tw = LTFAT_NAME_REAL(malloc)(twl));
+    CHECKMEM( p->rtw = LTFAT_NAME_REAL(malloc)(2 * (n + 1)));
+    CHECKMEM( p->buf = LTFAT_NAME_REAL(malloc)(4 * n));
+
+    tw = p->tw;
+    for (ltfat_int nn = n; nn >= 4; nn /= 4)
+    {
+        ltfat_int m = nn / 4;
+        for (ltfat_int k = 1; k <= 3; k++)
+            for (ltfat_int pp = 0; pp < m; pp++)
+            {
+                double ang = -2.0 * M_PI * (double)(k * pp) / (double) nn;
+                tw[2 * (k - 1) * m + pp] = (LTFAT_REAL) cos(ang);
+                tw[(2 * (k - 1) + 1) * m + pp] = (LTFAT_REAL) sin(ang);
+            }
+        tw += 6 * m;
+    }
+
+    for (ltfat_int k = 0; k <= n; k++)
+    {
+        double ang = -2.0 * M_PI * (double) k / (double) L;
+        p->rtw[k] = (LTFAT_REAL) cos(ang);
+        p->rtw[n + 1 + k] = (LTFAT_REAL) sin(ang);
+    }
+
+    *pout = p;
+    return status;
+error:
+    if (p) LTFAT_NAME(fftreal_pow2_done)(&p);
+    return status;
+}
+
+/* The even and odd samples are transformed as the real and imaginary
+ * parts of a complex signal Z of length n. Then
+ * X[k] = E[k] + exp(-2*pi*i*k/L) O[k], where
+ * E[k] = (Z[k] + conj(Z[n-k]))/2 and O[k] = -i(Z[k] - conj(Z[n-k]))/2. */
+LTFAT_API void
+LTFAT_NAME(fftreal_pow2_execute)(LTFAT_NAME(fftreal_pow2_plan)* p,
+                                 const LTFAT_REAL in[], LTFAT_COMPLEX out[])
+{
+    ltfat_int n = p->n;
+    LTFAT_REAL* xr = p->buf, *xi = xr + n, *yr = xi + n, *yi = yr + n;
+    LTFAT_REAL* zr, *zi;
+    const LTFAT_REAL* wr = p->rtw, *wi = p->rtw + n + 1;
+    LTFAT_REAL (*outTmp)[2] = (LTFAT_REAL(*)[2]) out;
+
+    for (ltfat_int k = 0; k < n; k++)
+    {
+        xr[k] = in[2 * k];
+        xi[k] = in[2 * k + 1];
+    }
+
+    LTFAT_NAME(fftreal_pow2_fftsplit)(p, xr, xi, yr, yi, &zr, &zi);
+
+    for (ltfat_int k = 0; k <= n; k++)
+    {
+        ltfat_int kk = k < n ? k : 0, nk = k > 0 ? n - k : 0;
+        LTFAT_REAL zkr = zr[kk], zki = zi[kk], znr = zr[nk], zni = -zi[nk];
+        LTFAT_REAL er = (zkr + znr) / 2, ei = (zki + zni) / 2;
+        LTFAT_REAL o_r = (zki - zni) / 2, o_i = -(zkr - znr) / 2;
+
+        outTmp[k][0] = er + wr[k] * o_r - wi[k] * o_i;
+        outTmp[k][1] = ei + wr[k] * o_i + wi[k] * o_r;
+    }
+}
+
+/* Inverse of the above scaled by L: Z[k] = (X[k] + conj(X[n-k])) +
+ * i exp(2*pi*i*k/L) (X[k] - conj(X[n-k])) is transformed by the
+ * unnormalized inverse FFT of length n using
+ * ifft(Z) = swap(fft(swap(Z))), where swap exchanges the real and the
+ * imaginary parts. */
+LTFAT_API void
+LTFAT_NAME(ifftreal_pow2_execute)(LTFAT_NAME(fftreal_pow2_plan)* p,
+                                  const LTFAT_COMPLEX in[], LTFAT_REAL out[])
+{
+    ltfat_int n = p->n;
+    LTFAT_REAL* xr = p->buf, *xi = xr + n, *yr = xi + n, *yi = yr + n;
+    LTFAT_REAL* zr, *zi;
+    const LTFAT_REAL* wr = p->rtw, *wi = p->rtw + n + 1;
+    const LTFAT_REAL (*inTmp)[2] = (const LTFAT_REAL(*)[2]) in;
+
+    xr[0] = inTmp[0][0] + inTmp[n][0];
+    xi[0] = inTmp[0][0] - inTmp[n][0];
+
+    for (ltfat_int k = 1; k < n; k++)
+    {
+        LTFAT_REAL xkr = inTmp[k][0], xki = inTmp[k][1];
+        LTFAT_REAL xnr = inTmp[n - k][0], xni = -inTmp[n - k][1];
+        LTFAT_REAL dr = xkr - xnr, di = xki - xni;
+        LTFAT_REAL vr = wr[k] * dr + wi[k] * di, vi = wr[k] * di - wi[k] * dr;
+
+        xr[k] = xkr + xnr - vi;
+        xi[k] = xki + xni + vr;
+    }
+
+    LTFAT_NAME(fftreal_pow2_fftsplit)(p, xi, xr, yi, yr, &zi, &zr);
+
+    for (ltfat_int k = 0; k < n; k++)
+    {
+        out[2 * k] = zr[k];
+        out[2 * k + 1] = zi[k];
+    }
+}
+
+LTFAT_API int
+LTFAT_NAME(fftreal_pow2_done)(LTFAT_NAME(fftreal_pow2_plan)** p)
+{
+    LTFAT_NAME(fftreal_pow2_plan)* pp;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(*p);
+    pp = *p;
+    ltfat_safefree(pp->tw);
+    ltfat_safefree(pp->rtw);
+    ltfat_safefree(pp->buf);
+    ltfat_free(pp);
+    *p = NULL;
+error:
+    return status;
+}
@@ -413,3 +413,32 @@ LTFAT_NAME(ifftreal_done)(LTFAT_NAME(ifftreal_plan)** p)
 error:
     return status;
 }
+
+static int LTFAT_NAME(fft_nthreads) = 1;
+
+LTFAT_API int
+LTFAT_NAME(fft_plan_with_nthreads)(int nthreads)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECK(LTFATERR_NOTPOSARG, nthreads > 0, "nthreads must be positive");
+#ifdef _OPENMP
+    {
+        static int threads_initialized = 0;
+        if (!threads_initialized)
+        {
+            CHECKINIT( LTFAT_FFTW(init_threads)(), "FFTW threads initialization failed.");
+            threads_initialized = 1;
+        }
+        LTFAT_FFTW(plan_with_nthreads)(nthreads);
+    }
+#endif
+    LTFAT_NAME(fft_nthreads) = nthreads;
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(fft_planner_nthreads)(void)
+{
+    return LTFAT_NAME(fft_nthreads);
+}
@@ -1,11 +1,11 @@
-files = dgt.c dgtreal_fb.c dgt_multi.c dgt_ola.c dgt_shear.c	\
+files = dgt.c dgtreal_fb.c dgt_multi.c dgt_ola.c dgtreal_olastream.c dgt_shear.c \
 		dgtreal_long.c dwilt.c idwilt.c wmdct.c iwmdct.c \
 		filterbank.c ifilterbank.c heapint.c heap.c wfacreal.c \
 		idgtreal_long.c idgtreal_fb.c iwfacreal.c pfilt.c reassign_ti.c \
 		windows.c  \
-		dgt_shearola.c utils.c rtdgtreal.c circularbuf.c slicingbuf.c \
-		dgtrealwrapper.c dgtrealmp.c dgtrealmp_parbuf.c dgtrealmp_kernel.c dgtrealmp_guts.c maxtree.c \
-		slidgtrealmp.c
+		dgt_shearola.c dgtreal_shear.c utils.c rtdgtreal.c circularbuf.c slicingbuf.c \
+		dgtrealwrapper.c dgtreal_plancache.c dgtrealmp.c dgtrealmp_parbuf.c dgtrealmp_kernel.c dgtrealmp_guts.c dgtrealmp_atoms.c dgtrealmp_kernelcache.c dgtrealmp_redecompose.c maxtree.c \
+		slidgtrealmp.c fftreal_pow2.c
 
 files_complextransp =\
 ci_utils.c ci_windows.c spread.c wavelets.c goertzel.c \
@@ -22,7 +22,7 @@ files_fftw_complextransp = dct.c dst.c
 files_notypechange = memalloc.c error.c version.c argchecks.c \
 					 dgtwrapper_typeconstant.c dgtrealmp_typeconstant.c  \
 				   	 reassign_typeconstant.c wavelets_typeconstant.c \
-					 integer_manip.c firwin_typeconstant.c
+					 integer_manip.c firwin_typeconstant.c utils_typeconstant.c lrucache.c
 
 FFTBACKEND ?= FFTW
 
@@ -48,6 +48,8 @@ ifndef NOBLASLAPACK
 	files += $(files_blaslapack)
 	files_complextransp += $(files_blaslapack_complextransp)
  	LFLAGS+=$(BLASLAPACKLIBS)
+else
+	files += hermsystemsolver.c
 endif
 
 extradepincludes:=\#include <stddef.h>\n
@@ -0,0 +1,238 @@
+#include "ltfat.h"
+#include "ltfat/types.h"
+#include "ltfat/macros.h"
+#include "simd_private.h"
+
+/* Native replacement of the LAPACK ?hesv based solver used when libltfat
+ * is compiled with NOBLASLAPACK.
+ *
+ * The system is factorized as A = L*D*L^H with L unit lower triangular and
+ * D real diagonal, i.e. Cholesky without the square roots. There is no
+ * pivoting so A must be positive definite, which holds for Gram matrices of
+ * linearly independent atoms.
+ *
+ * The factorization is computed row by row (bordering). Row i only depends
+ * on the leading i+1 rows of A, so when the leading k rows of A did not
+ * change since the last call, rows 0,...,k-1 of the factor are reused and
+ * only the remaining ones are computed. In particular, changing or
+ * appending the last atom costs O(M^2) instead of O(M^3).
+ */
+struct LTFAT_NAME_COMPLEX(hermsystemsolver_plan)
+{
+    ltfat_int Mmax;
+    ltfat_int Mcap; // Row stride of A and L
+    ltfat_int Mfac; // Size of the currently factorized system
+    LTFAT_COMPLEX* A; // Lower triangle of the factorized system by rows
+    LTFAT_COMPLEX* L; // Strictly lower part of L by rows
+    LTFAT_COMPLEX* w; // Row of L times D
+    LTFAT_REAL*    d;
+};
+
+LTFAT_API int
+LTFAT_NAME_COMPLEX(hermsystemsolver_init)(ltfat_int M,
+        LTFAT_NAME_COMPLEX(hermsystemsolver_plan)** pout)
+{
+    int status = LTFATERR_SUCCESS;
+    LTFAT_NAME_COMPLEX(hermsystemsolver_plan)* p = NULL;
+
+    CHECKNULL(pout);
+    CHECK(LTFATERR_NOTPOSARG, M > 0, "M must be positive (passed %td)", M);
+
+    CHECKMEM( p = LTFAT_NEW(LTFAT_NAME_COMPLEX(hermsystemsolver_plan)));
+    p->Mmax = M;
+
+    *pout = p;
+    return status;
+error:
+    if (p) LTFAT_NAME_COMPLEX(hermsystemsolver_done)(&p);
+    if (pout) *pout = NULL;
+    return status;
+}
+
+/* Buffers grow with the largest system seen so far, since the systems are
+ * usually much smaller than Mmax. */
+static int
+LTFAT_NAME_COMPLEX(hermsystemsolver_reserve)(
+    LTFAT_NAME_COMPLEX(hermsystemsolver_plan)* p, ltfat_int M)
+{
+    int status = LTFATERR_SUCCESS;
+    ltfat_int Mcap;
+
+    if (M <= p->Mcap) return status;
+
+    Mcap = ltfat_imin(ltfat_imax(M, 2 * p->Mcap), p->Mmax);
+
+    LTFAT_SAFEFREEALL(p->A, p->L, p->w, p->d);
+    p->Mcap = 0; p->Mfac = 0;
+
+    CHECKMEM( p->A = LTFAT_NAME_COMPLEX(malloc)(Mcap * Mcap));
+    CHECKMEM( p->L = LTFAT_NAME_COMPLEX(malloc)(Mcap * Mcap));
+    CHECKMEM( p->w = LTFAT_NAME_COMPLEX(malloc)(Mcap));
+    CHECKMEM( p->d = LTFAT_NAME_REAL(malloc)(Mcap));
+    p->Mcap = Mcap;
+error:
+    return status;
+}
+
+/* Returns sum of x[t]*conj(y[t]) if do_conj and sum of x[t]*y[t] otherwise */
+static inline LTFAT_COMPLEX
+LTFAT_NAME_COMPLEX(hermsystemsolver_dot)(
+    const LTFAT_COMPLEX* x, const LTFAT_COMPLEX* y, ltfat_int len,
+    int do_conj)
+{
+    const LTFAT_REAL* xr = (const LTFAT_REAL*) x;
+    const LTFAT_REAL* yr = (const LTFAT_REAL*) y;
+    /* Sums of re*re, im*im, re*im and im*re products */
+    LTFAT_REAL rr = 0, ii = 0, ri = 0, ir = 0;
+    LTFAT_COMPLEX out;
+    LTFAT_REAL* outr = (LTFAT_REAL*) &out;
+    ltfat_int t = 0;
+
+#ifdef LTFAT_VSWAPPAIRS
+    LTFAT_REAL lanes[LTFAT_VLEN];
+    ltfat_vreal vdirect = LTFAT_VSET1(0);
+    ltfat_vreal vcross  = LTFAT_VSET1(0);
+
+    for (; t + LTFAT_VLEN / 2 <= len; t += LTFAT_VLEN / 2)
+    {
+        ltfat_vreal vx = LTFAT_VLOAD(xr + 2 * t);
+        ltfat_vreal vy = LTFAT_VLOAD(yr + 2 * t);
+        vdirect = LTFAT_VADD(vdirect, LTFAT_VMUL(vx, vy));
+        vcross  = LTFAT_VADD(vcross, LTFAT_VMUL(vx, LTFAT_VSWAPPAIRS(vy)));
+    }
+
+    LTFAT_VSTORE(lanes, vdirect);
+    for (ltfat_int l = 0; l < LTFAT_VLEN; l += 2)
+    {
+        rr += lanes[l];
+        ii += lanes[l + 1];
+    }
+
+    LTFAT_VSTORE(lanes, vcross);
+    for (ltfat_int l = 0; l < LTFAT_VLEN; l += 2)
+    {
+        ri += lanes[l];
+        ir += lanes[l + 1];
+    }
+#endif
+
+    for (; t < len; t++)
+    {
+        rr += xr[2 * t]     * yr[2 * t];
+        ii += xr[2 * t + 1] * yr[2 * t + 1];
+        ri += xr[2 * t]     * yr[2 * t + 1];
+        ir += xr[2 * t + 1] * yr[2 * t];
+    }
+
+    if (do_conj)
+    {
+        outr[0] = rr + ii;
+        outr[1] = ir - ri;
+    }
+    else
+    {
+        outr[0] = rr - ii;
+        outr[1] = ri + ir;
+    }
+
+    return out;
+}
+
+/* Solves A*x = b using the lower triangle of the column-major M x M matrix A.
+ * b is overwritten by x. Returns i+1 if the factorization broke down at
+ * row i i.e. A is not positive definite. */
+LTFAT_API int
+LTFAT_NAME_COMPLEX(hermsystemsolver_execute)(
+    LTFAT_NAME_COMPLEX(hermsystemsolver_plan)* p,
+    const LTFAT_COMPLEX* A, ltfat_int M, LTFAT_COMPLEX* b)
+{
+    int status = LTFATERR_SUCCESS;
+    ltfat_int Mcap, kstart;
+
+    CHECKNULL(p); CHECKNULL(A); CHECKNULL(b);
+    CHECK(LTFATERR_BADARG, M > 0 && M <= p->Mmax,
+          "M must be in range [1,%td] (passed %td)", p->Mmax, M);
+
+    CHECKSTATUS( LTFAT_NAME_COMPLEX(hermsystemsolver_reserve)(p, M));
+    Mcap = p->Mcap;
+
+    /* Number of leading rows which can be reused */
+    kstart = 0;
+    for (; kstart < ltfat_imin(M, p->Mfac); kstart++)
+    {
+        const LTFAT_COMPLEX* Arow = p->A + kstart * Mcap;
+        ltfat_int j = 0;
+        while (j <= kstart && Arow[j] == A[j * M + kstart]) j++;
+        if (j <= kstart) break;
+    }
+
+    for (ltfat_int i = kstart; i < M; i++)
+    {
+        LTFAT_COMPLEX* Arow = p->A + i * Mcap;
+        LTFAT_COMPLEX* Lrow = p->L + i * Mcap;
+
+        for (ltfat_int j = 0; j <= i; j++)
+            Arow[j] = A[j * M + i];
+
+        /* L(i,j) = ( A(i,j) - sum_t<j L(i,t)*d(t)*conj(L(j,t)) ) / d(j) */
+        for (ltfat_int j = 0; j < i; j++)
+        {
+            LTFAT_COMPLEX* Ljrow = p->L + j * Mcap;
+            LTFAT_COMPLEX  s = Arow[j] -
+                               LTFAT_NAME_COMPLEX(hermsystemsolver_dot)(
+                                   p->w, Ljrow, j, 1);
+            p->w[j] = s;
+            Lrow[j] = s / p->d[j];
+        }
+
+        /* d(i) = A(i,i) - sum_t<i L(i,t)*d(t)*conj(L(i,t)) */
+        LTFAT_REAL di = ltfat_real(Arow[i]);
+        for (ltfat_int j = 0; j < i; j++)
+            di -= ltfat_real(p->w[j] * conj(Lrow[j]));
+
+        if (!(di > 0))
+        {
+            p->Mfac = i;
+            return (int) i + 1;
+        }
+        p->d[i] = di;
+    }
+    p->Mfac = M;
+
+    /* L*y = b */
+    for (ltfat_int i = 1; i < M; i++)
+        b[i] -= LTFAT_NAME_COMPLEX(hermsystemsolver_dot)(
+                    p->L + i * Mcap, b, i, 0);
+
+    /* D*z = y */
+    for (ltfat_int i = 0; i < M; i++)
+        b[i] /= p->d[i];
+
+    /* L^H*x = z */
+    for (ltfat_int i = M - 1; i > 0; i--)
+    {
+        const LTFAT_COMPLEX* Lrow = p->L + i * Mcap;
+        LTFAT_COMPLEX bi = b[i];
+        for (ltfat_int j = 0; j < i; j++)
+            b[j] -= conj(Lrow[j]) * bi;
+    }
+
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME_COMPLEX(hermsystemsolver_done)(
+    LTFAT_NAME_COMPLEX(hermsystemsolver_plan)** p)
+{
+    LTFAT_NAME_COMPLEX(hermsystemsolver_plan)* pp;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(*p);
+    pp = *p;
+    LTFAT_SAFEFREEALL(pp->A, pp->L, pp->w, pp->d);
+
+    ltfat_free(pp);
+    *p = NULL;
+error:
+    return status;
+}
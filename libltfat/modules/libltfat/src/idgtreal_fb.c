@@ -3,6 +3,18 @@
 #include "ltfat/macros.h"
 
 #include "ltfat/thirdparty/fftw3.h"
+#include "dgtreal_fb_private.h"
+#include "threads_private.h"
+
+/* Buffers and IFFT plans private to one thread */
+typedef struct
+{
+    LTFAT_NAME(ifftreal_plan)* p_small;  //!< Single frame IFFT
+    LTFAT_NAME(ifftreal_plan)* p_block;  //!< IFFT of blocksize frames
+    LTFAT_COMPLEX* cbuf;                 //!< Coefficients, M2 x blocksize
+    LTFAT_REAL*    crbuf;                //!< Frames, M x blocksize
+    LTFAT_REAL*    ff;                   //!< Windowed frames, max(gl,M) x blocksize
+} LTFAT_NAME(idgtreal_fb_worker);
 
 struct LTFAT_NAME(idgtreal_fb_plan)
 {
@@ -10,26 +22,17 @@ struct LTFAT_NAME(idgtreal_fb_plan)
     ltfat_int M;
     ltfat_int gl;
     ltfat_phaseconvention ptype;
-    LTFAT_COMPLEX* cbuf;
-    LTFAT_REAL*    crbuf;
+    unsigned flags;
+    ltfat_int blocksize;                 //!< Number of frames per IFFT call
+    int nthreads;
+    LTFAT_NAME(idgtreal_fb_worker)* wk;  //!< One per thread
     LTFAT_REAL*    gw;
-    LTFAT_REAL*    ff;
-    LTFAT_NAME(ifftreal_plan)* p_small;
     int do_overwriteoutarray;
 };
 
 
 /* ------------------- IDGTREAL ---------------------- */
 
-#define THE_SUM_REAL { \
-    memcpy(cbuf,cin+n*M2+w*M2*N, M2*sizeof*cbuf); \
-    LTFAT_NAME(ifftreal_execute)(p->p_small); \
-    LTFAT_NAME_REAL(circshift)(crbuf,M,p->ptype==LTFAT_TIMEINV?glh:-n*a+glh,ff); \
-    LTFAT_NAME_REAL(periodize_array)(ff,M,gl,ff); \
-    for (ltfat_int ii=0; ii<gl; ii++) \
-        ff[ii] *= gw[ii]; \
-}
-
 LTFAT_API int
 LTFAT_NAME(idgtreal_fb)(const LTFAT_COMPLEX* cin, const LTFAT_REAL* g,
                         ltfat_int L, ltfat_int gl, ltfat_int W,
@@ -68,7 +71,6 @@ LTFAT_NAME(idgtreal_fb_init)(const LTFAT_REAL* g, ltfat_int gl,
                              ltfat_int a, ltfat_int M, const ltfat_phaseconvention ptype,
                              unsigned flags, LTFAT_NAME(idgtreal_fb_plan)** pout)
 {
-    ltfat_int M2;
     LTFAT_NAME(idgtreal_fb_plan)* p = NULL;
     int status = LTFATERR_SUCCESS;
     CHECKNULL(g); CHECKNULL(pout);
@@ -82,17 +84,13 @@ LTFAT_NAME(idgtreal_fb_init)(const LTFAT_REAL* g, ltfat_int gl,
 
     p->ptype = ptype; p->a = a; p->M = M; p->gl = gl;
     p->do_overwriteoutarray = 1;
+    p->flags = flags;
+    p->nthreads = 1;
 
-    /* This is a floor operation. */
-    M2 = M / 2 + 1;
-
-    CHECKMEM( p->cbuf  = LTFAT_NAME_COMPLEX(malloc)(M2));
-    CHECKMEM( p->crbuf = LTFAT_NAME_REAL(malloc)(M));
     CHECKMEM( p->gw    = LTFAT_NAME_REAL(malloc)(gl));
-    CHECKMEM( p->ff    = LTFAT_NAME_REAL(malloc)(gl > M ? gl : M));
 
     CHECKSTATUS(
-        LTFAT_NAME(ifftreal_init)(M, 1, p->cbuf, p->crbuf, flags, &p->p_small));
+        LTFAT_NAME(idgtreal_fb_set_blocksize)(p, ltfat_dgt_fb_defblocksize(M)));
 
     LTFAT_NAME_REAL(fftshift)(g, gl, p->gw);
 
@@ -103,6 +101,88 @@ error:
     return status;
 }
 
+static void
+LTFAT_NAME(idgtreal_fb_workers_done)(LTFAT_NAME(idgtreal_fb_plan)* p)
+{
+    if (!p->wk) return;
+
+    for (int t = 0; t < p->nthreads; t++)
+    {
+        LTFAT_NAME(idgtreal_fb_worker)* wk = p->wk + t;
+        if (wk->p_small) LTFAT_NAME(ifftreal_done)(&wk->p_small);
+        if (wk->p_block) LTFAT_NAME(ifftreal_done)(&wk->p_block);
+        LTFAT_SAFEFREEALL(wk->cbuf, wk->crbuf, wk->ff);
+    }
+    ltfat_safefree(p->wk);
+    p->wk = NULL;
+}
+
+static int
+LTFAT_NAME(idgtreal_fb_workers_init)(LTFAT_NAME(idgtreal_fb_plan)* p,
+                                     ltfat_int blocksize, int nthreads)
+{
+    ltfat_int M = p->M, M2 = p->M / 2 + 1;
+    ltfat_int ffl = p->gl > M ? p->gl : M;
+    int status = LTFATERR_SUCCESS;
+
+    LTFAT_NAME(idgtreal_fb_workers_done)(p);
+    p->blocksize = blocksize;
+    p->nthreads = nthreads;
+
+    CHECKMEM( p->wk = LTFAT_NEWARRAY(LTFAT_NAME(idgtreal_fb_worker), nthreads));
+
+    for (int t = 0; t < nthreads; t++)
+    {
+        LTFAT_NAME(idgtreal_fb_worker)* wk = p->wk + t;
+        CHECKMEM( wk->cbuf  = LTFAT_NAME_COMPLEX(malloc)(M2 * blocksize));
+        CHECKMEM( wk->crbuf = LTFAT_NAME_REAL(malloc)(M * blocksize));
+        CHECKMEM( wk->ff    = LTFAT_NAME_REAL(malloc)(ffl * blocksize));
+
+        CHECKSTATUS(
+            LTFAT_NAME(ifftreal_init)(M, 1, wk->cbuf, wk->crbuf, p->flags,
+                                      &wk->p_small));
+
+        if (blocksize > 1)
+            CHECKSTATUS(
+                LTFAT_NAME(ifftreal_init)(M, blocksize, wk->cbuf, wk->crbuf,
+                                          p->flags, &wk->p_block));
+    }
+
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(idgtreal_fb_set_blocksize)(LTFAT_NAME(idgtreal_fb_plan)* p,
+                                      ltfat_int blocksize)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+    CHECK(LTFATERR_NOTPOSARG, blocksize > 0,
+          "blocksize (passed %td) must be positive.", blocksize);
+
+    CHECKSTATUS(
+        LTFAT_NAME(idgtreal_fb_workers_init)(p, blocksize, p->nthreads));
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(idgtreal_fb_set_nthreads)(LTFAT_NAME(idgtreal_fb_plan)* p,
+                                     int nthreads)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+    CHECK(LTFATERR_NOTPOSARG, nthreads > 0,
+          "nthreads (passed %d) must be positive.", nthreads);
+
+    CHECKSTATUS(
+        LTFAT_NAME(idgtreal_fb_workers_init)(p, p->blocksize,
+                                             ltfat_usablethreads(nthreads)));
+error:
+    return status;
+}
+
 LTFAT_API int
 LTFAT_NAME(idgtreal_fb_done)(LTFAT_NAME(idgtreal_fb_plan)** p)
 {
@@ -110,105 +190,155 @@ LTFAT_NAME(idgtreal_fb_done)(LTFAT_NAME(idgtreal_fb_plan)** p)
     int status = LTFATERR_SUCCESS;
     CHECKNULL(p); CHECKNULL(*p);
     pp = *p;
-    LTFAT_SAFEFREEALL(pp->cbuf, pp->crbuf, pp->ff, pp->gw);
-    if (pp->p_small) LTFAT_NAME(ifftreal_done)(&pp->p_small);
+    LTFAT_NAME(idgtreal_fb_workers_done)(pp);
+    ltfat_safefree(pp->gw);
     ltfat_free(pp);
     pp = NULL;
 error:
     return status;
 }
 
-LTFAT_API int
-LTFAT_NAME(idgtreal_fb_execute)(LTFAT_NAME(idgtreal_fb_plan)* p,
-                                const LTFAT_COMPLEX* cin,
-                                ltfat_int L, ltfat_int W, LTFAT_REAL* f)
+/* Windows the frame j = n + w*N stored in crbuf */
+static void
+LTFAT_NAME(idgtreal_fb_windowframe)(const LTFAT_NAME(idgtreal_fb_plan)* p,
+                                    const LTFAT_REAL* crbuf, ltfat_int N,
+                                    ltfat_int j, LTFAT_REAL* ff)
+{
+    ltfat_int n = j % N;
+    ltfat_int M = p->M, a = p->a, gl = p->gl, glh = p->gl / 2;
+
+    LTFAT_NAME_REAL(circshift)(crbuf, M, p->ptype == LTFAT_TIMEINV ? glh : -n * a + glh, ff);
+    LTFAT_NAME_REAL(periodize_array)(ff, M, gl, ff);
+
+    for (ltfat_int ii = 0; ii < gl; ii++)
+        ff[ii] *= p->gw[ii];
+}
+
+/* Adds the windowed frame j = n + w*N to the output using periodic
+ * boundary conditions */
+static void
+LTFAT_NAME(idgtreal_fb_addframe)(const LTFAT_NAME(idgtreal_fb_plan)* p,
+                                 const LTFAT_REAL* ff, ltfat_int L,
+                                 ltfat_int N, ltfat_int j, LTFAT_REAL* f)
+{
+    ltfat_int n = j % N, w = j / N;
+    ltfat_int gl = p->gl, glh = p->gl / 2;
+    ltfat_int sp = ltfat_positiverem(n * p->a - glh, L);
+    ltfat_int beforewrap = ltfat_imin(gl, L - sp);
+    LTFAT_REAL* fw = f + w * L;
+
+    /* Add the ff vector to f at position sp. */
+    for (ltfat_int ii = 0; ii < beforewrap; ii++)
+        fw[sp + ii] += ff[ii];
+
+    for (ltfat_int ii = beforewrap; ii < gl; ii++)
+        fw[ii - beforewrap] += ff[ii];
+}
+
+/* Coefficients are read either from cin or, if it is NULL, from cr and ci */
+static int
+LTFAT_NAME(idgtreal_fb_execute_gen)(LTFAT_NAME(idgtreal_fb_plan)* p,
+                                    const LTFAT_COMPLEX* cin,
+                                    const LTFAT_REAL* cr, const LTFAT_REAL* ci,
+                                    ltfat_int L, ltfat_int W, LTFAT_REAL* f)
 {
-    ltfat_int M2, M, a, gl, N, ep, sp, glh, glh_d_a;
-    LTFAT_COMPLEX* cbuf;
-    LTFAT_REAL* crbuf, *gw, *ff;
+    ltfat_int M2, M, N, B, NW, nblocks, ffl;
     int status = LTFATERR_SUCCESS;
-    CHECKNULL(p); CHECKNULL(cin); CHECKNULL(f);
+    CHECKNULL(p); CHECKNULL(f);
     CHECK(LTFATERR_BADTRALEN, L >= p->gl && !(L % p->a) ,
           "L (passed %td) must be greater or equal to gl and divisible by a (passed %td).", L, p->a);
     CHECK(LTFATERR_NOTPOSARG, W > 0, "W (passed %td) must be positive.", W);
 
     M = p->M;
-    a = p->a;
-    gl = p->gl;
-    N = L / a;
+    N = L / p->a;
+    B = p->blocksize;
+    ffl = p->gl > M ? p->gl : M;
 
     /* This is a floor operation. */
     M2 = M / 2 + 1;
 
-    /* This is a floor operation. */
-    glh = gl / 2;
-
-    /* This is a ceil operation. */
-    glh_d_a = (ltfat_int)ceil((glh * 1.0) / (a));
-
-    cbuf  = p->cbuf;
-    crbuf = p->crbuf;
-    gw  = p->gw;
-    ff  = p->ff;
-
     if(p->do_overwriteoutarray)
         memset(f, 0, L * W * sizeof * f);
 
-    for (ltfat_int w = 0; w < W; w++)
+    /* Frames are processed in blocks of B consecutive columns of cin,
+     * a block can run over the channel boundary. The IFFTs and windowing
+     * of the blocks run in parallel, but the overlap-add is done in the
+     * block order so that the result does not depend on the number of
+     * threads. */
+    NW = N * W;
+    nblocks = (NW + B - 1) / B;
+
+#ifdef _OPENMP
+    #pragma omp parallel for ordered num_threads(p->nthreads) if(p->nthreads > 1) schedule(static, 1)
+#endif
+    for (ltfat_int iblock = 0; iblock < nblocks; iblock++)
     {
-        LTFAT_REAL* fw = f + w * L;
+        LTFAT_NAME(idgtreal_fb_worker)* wk = p->wk + ltfat_threadid();
+        ltfat_int jstart = iblock * B;
+        ltfat_int Bcur = ltfat_imin(B, NW - jstart);
 
-        /* ----- Handle the first boundary using periodic boundary conditions. --- */
-        for (ltfat_int n = 0; n < glh_d_a; n++)
+        if (Bcur == B && wk->p_block)
         {
-            THE_SUM_REAL;
-
-            sp = ltfat_positiverem(n * a - glh, L);
-            ep = ltfat_positiverem(n * a - glh + gl - 1, L);
-
-            /* % Add the ff vector to f at position sp. */
-            for (ltfat_int ii = 0; ii < L - sp; ii++)
-                fw[sp + ii] += ff[ii];
-
-            for (ltfat_int ii = 0; ii < ep + 1; ii++)
-                fw[ii] += ff[L - sp + ii];
+            if (cin)
+                memcpy(wk->cbuf, cin + jstart * M2, B * M2 * sizeof * wk->cbuf);
+            else
+                LTFAT_NAME(planar2complex_array)(cr + jstart * M2, ci + jstart * M2,
+                                                 B * M2, wk->cbuf);
+            LTFAT_NAME(ifftreal_execute)(wk->p_block);
+
+            for (ltfat_int b = 0; b < B; b++)
+                LTFAT_NAME(idgtreal_fb_windowframe)(p, wk->crbuf + b * M, N,
+                                                    jstart + b, wk->ff + b * ffl);
         }
-
-
-        /* ----- Handle the middle case. --------------------- */
-        for (ltfat_int n = glh_d_a; n < (L - (gl + 1) / 2) / a + 1; n++)
+        else
         {
-            THE_SUM_REAL;
-
-            sp = ltfat_positiverem(n * a - glh, L);
-            ep = ltfat_positiverem(n * a - glh + gl - 1, L);
-
-            /* Add the ff vector to f at position sp. */
-            for (ltfat_int ii = 0; ii < ep - sp + 1; ii++)
-                fw[ii + sp] += ff[ii];
+            for (ltfat_int b = 0; b < Bcur; b++)
+            {
+                if (cin)
+                    memcpy(wk->cbuf, cin + (jstart + b) * M2, M2 * sizeof * wk->cbuf);
+                else
+                    LTFAT_NAME(planar2complex_array)(cr + (jstart + b) * M2,
+                                                     ci + (jstart + b) * M2,
+                                                     M2, wk->cbuf);
+                LTFAT_NAME(ifftreal_execute)(wk->p_small);
+
+                LTFAT_NAME(idgtreal_fb_windowframe)(p, wk->crbuf, N,
+                                                    jstart + b, wk->ff + b * ffl);
+            }
         }
 
-        /* Handle the last boundary using periodic boundary conditions. */
-        for (ltfat_int n = (L - (gl + 1) / 2) / a + 1; n < N; n++)
-        {
-            THE_SUM_REAL;
-
-            sp = ltfat_positiverem(n * a - glh, L);
-            ep = ltfat_positiverem(n * a - glh + gl - 1, L);
-
-            /* Add the ff vector to f at position sp. */
-            for (ltfat_int ii = 0; ii < L - sp; ii++)
-                fw[sp + ii] += ff[ii];
-
-            for (ltfat_int ii = 0; ii < ep + 1; ii++)
-                fw[ii] += ff[L - sp + ii];
-        }
+#ifdef _OPENMP
+        #pragma omp ordered
+#endif
+        for (ltfat_int b = 0; b < Bcur; b++)
+            LTFAT_NAME(idgtreal_fb_addframe)(p, wk->ff + b * ffl, L, N,
+                                             jstart + b, f);
     }
 
 error:
     return status;
 }
 
+LTFAT_API int
+LTFAT_NAME(idgtreal_fb_execute)(LTFAT_NAME(idgtreal_fb_plan)* p,
+                                const LTFAT_COMPLEX* cin,
+                                ltfat_int L, ltfat_int W, LTFAT_REAL* f)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(cin);
+    return LTFAT_NAME(idgtreal_fb_execute_gen)(p, cin, NULL, NULL, L, W, f);
+error:
+    return status;
+}
 
-
-#undef THE_SUM_REAL
+LTFAT_API int
+LTFAT_NAME(idgtreal_fb_execute_planar)(LTFAT_NAME(idgtreal_fb_plan)* p,
+                                       const LTFAT_REAL* cr, const LTFAT_REAL* ci,
+                                       ltfat_int L, ltfat_int W, LTFAT_REAL* f)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(cr); CHECKNULL(ci);
+    return LTFAT_NAME(idgtreal_fb_execute_gen)(p, NULL, cr, ci, L, W, f);
+error:
+    return status;
+}
@@ -3,6 +3,18 @@
 #include "ltfat/macros.h"
 
 #include "ltfat/thirdparty/fftw3.h"
+#include "threads_private.h"
+
+/* Buffers and FFT plans of the walnut algorithm private to one thread */
+typedef struct
+{
+    LTFAT_COMPLEX* ff;
+    LTFAT_COMPLEX* cf;
+    LTFAT_COMPLEX* cbuf;
+    LTFAT_REAL* sbuf;
+    LTFAT_NAME(ifftreal_plan)* p_before;
+    LTFAT_NAME(fftreal_plan)* p_after;
+} LTFAT_NAME(idgtreal_long_worker);
 
 struct LTFAT_NAME(idgtreal_long_plan)
 {
@@ -14,18 +26,15 @@ struct LTFAT_NAME(idgtreal_long_plan)
     ltfat_int h_a;
     ltfat_phaseconvention ptype;
     LTFAT_REAL scalconst;
+    unsigned flags;
+    int nthreads;
+    LTFAT_NAME(idgtreal_long_worker)* wk;  //!< One per thread
     LTFAT_REAL* f;
     LTFAT_COMPLEX* cin;
     LTFAT_COMPLEX* gf;
-    LTFAT_COMPLEX* ff;
-    LTFAT_COMPLEX* cf;
-    LTFAT_COMPLEX* cbuf;
     LTFAT_REAL* cwork;
     int freecwork;
-    LTFAT_REAL* sbuf;
     LTFAT_NAME(ifftreal_plan)* p_veryend;
-    LTFAT_NAME(ifftreal_plan)* p_before;
-    LTFAT_NAME(fftreal_plan)* p_after;
     int do_overwriteoutarray;
 };
 
@@ -64,6 +73,59 @@ error:
     return status;
 }
 
+static void
+LTFAT_NAME(idgtreal_long_workers_done)(LTFAT_NAME(idgtreal_long_plan)* p)
+{
+    if (!p->wk) return;
+
+    for (int t = 0; t < p->nthreads; t++)
+    {
+        LTFAT_NAME(idgtreal_long_worker)* wk = p->wk + t;
+        if (wk->p_before) LTFAT_NAME(ifftreal_done)(&wk->p_before);
+        if (wk->p_after)  LTFAT_NAME(fftreal_done)(&wk->p_after);
+        LTFAT_SAFEFREEALL(wk->ff, wk->cf, wk->cbuf, wk->sbuf);
+    }
+    ltfat_safefree(p->wk);
+    p->wk = NULL;
+}
+
+static int
+LTFAT_NAME(idgtreal_long_workers_init)(LTFAT_NAME(idgtreal_long_plan)* p,
+                                       int nthreads)
+{
+    ltfat_int pp = p->a / p->c;
+    ltfat_int q = p->M / p->c;
+    ltfat_int d = p->L / p->M / pp;
+    ltfat_int d2 = d / 2 + 1;
+    ltfat_int W = p->W;
+    int status = LTFATERR_SUCCESS;
+
+    LTFAT_NAME(idgtreal_long_workers_done)(p);
+    p->nthreads = nthreads;
+
+    CHECKMEM( p->wk = LTFAT_NEWARRAY(LTFAT_NAME(idgtreal_long_worker), nthreads));
+
+    for (int t = 0; t < nthreads; t++)
+    {
+        LTFAT_NAME(idgtreal_long_worker)* wk = p->wk + t;
+        CHECKMEM( wk->ff    = LTFAT_NAME_COMPLEX(malloc)(d2 * pp * q * W));
+        CHECKMEM( wk->cf    = LTFAT_NAME_COMPLEX(malloc)(d2 * q * q * W));
+        CHECKMEM( wk->cbuf  = LTFAT_NAME_COMPLEX(malloc)(d2));
+        CHECKMEM( wk->sbuf  = LTFAT_NAME_REAL(malloc)(d));
+
+        CHECKSTATUS(
+            LTFAT_NAME(ifftreal_init)(d, 1, wk->cbuf, wk->sbuf, p->flags,
+                                      &wk->p_before));
+
+        CHECKSTATUS(
+            LTFAT_NAME(fftreal_init)(d, 1, wk->sbuf, wk->cbuf, p->flags,
+                                     &wk->p_after));
+    }
+
+error:
+    return status;
+}
+
 LTFAT_API int
 LTFAT_NAME(idgtreal_long_init)( const LTFAT_REAL* g,
                                 ltfat_int L, ltfat_int W,
@@ -72,7 +134,7 @@ LTFAT_NAME(idgtreal_long_init)( const LTFAT_REAL* g,
                                 const ltfat_phaseconvention ptype, unsigned flags,
                                 LTFAT_NAME(idgtreal_long_plan)** pout)
 {
-    ltfat_int minL, h_m, b, N, p, q, d, d2, size;
+    ltfat_int minL, h_m, b, N, p, d, size;
     // Downcast to int
     LTFAT_NAME(idgtreal_long_plan)* plan = NULL;
     int status = LTFATERR_SUCCESS;
@@ -98,23 +160,16 @@ LTFAT_NAME(idgtreal_long_init)( const LTFAT_REAL* g,
 
     plan->a = a; plan->L = L; plan->M = M; plan->W = W; plan->ptype = ptype;
     plan->do_overwriteoutarray = 1;
+    plan->flags = flags;
     b = L / M;
     N = L / a;
 
     plan->c = ltfat_gcd(a, M, &plan->h_a, &h_m);
     p = a / plan->c;
-    q = M / plan->c;
     d = b / p;
 
-    /* This is a floor operation. */
-    d2 = d / 2 + 1;
-
     size = wfacreal_size(L, a, M);
     CHECKMEM( plan->gf    = LTFAT_NAME_COMPLEX(malloc)(size));
-    CHECKMEM( plan->ff    = LTFAT_NAME_COMPLEX(malloc)(d2 * p * q * W));
-    CHECKMEM( plan->cf    = LTFAT_NAME_COMPLEX(malloc)(d2 * q * q * W));
-    CHECKMEM( plan->cbuf  = LTFAT_NAME_COMPLEX(malloc)(d2));
-    CHECKMEM( plan->sbuf  = LTFAT_NAME_REAL(malloc)(d));
     plan->cin = cin;
     plan->f = f;
 
@@ -141,12 +196,7 @@ LTFAT_NAME(idgtreal_long_init)( const LTFAT_REAL* g,
     /* Scaling constant needed because of FFTWs normalization. */
     plan->scalconst = (LTFAT_REAL) ( 1.0 / ((double)d * sqrt((double)M)));
 
-    CHECKSTATUS(
-        LTFAT_NAME(ifftreal_init)(d, 1, plan->cbuf, plan->sbuf, flags,
-                                  &plan->p_before));
-
-    CHECKSTATUS(
-        LTFAT_NAME(fftreal_init)(d, 1, plan->sbuf, plan->cbuf, flags, &plan->p_after));
+    CHECKSTATUS( LTFAT_NAME(idgtreal_long_workers_init)(plan, 1));
 
     *pout = plan;
     return status;
@@ -163,10 +213,9 @@ LTFAT_NAME(idgtreal_long_done)(LTFAT_NAME(idgtreal_long_plan)** plan)
     CHECKNULL(plan); CHECKNULL(*plan);
     p = *plan;
 
-    if (p->p_before)  LTFAT_NAME(ifftreal_done)(&p->p_before);
-    if (p->p_after)   LTFAT_NAME(fftreal_done)(&p->p_after);
     if (p->p_veryend) LTFAT_NAME(ifftreal_done)(&p->p_veryend);
-    LTFAT_SAFEFREEALL(p->gf, p->ff, p->cf, p->cbuf, p->sbuf);
+    LTFAT_NAME(idgtreal_long_workers_done)(p);
+    LTFAT_SAFEFREEALL(p->gf);
     if ( p->freecwork) ltfat_free(p->cwork);
     ltfat_free(p);
     p = NULL;
@@ -174,6 +223,21 @@ error:
     return status;
 }
 
+LTFAT_API int
+LTFAT_NAME(idgtreal_long_set_nthreads)(LTFAT_NAME(idgtreal_long_plan)* p,
+                                       int nthreads)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+    CHECK(LTFATERR_NOTPOSARG, nthreads > 0,
+          "nthreads (passed %d) must be positive.", nthreads);
+
+    CHECKSTATUS(
+        LTFAT_NAME(idgtreal_long_workers_init)(p, ltfat_usablethreads(nthreads)));
+error:
+    return status;
+}
+
 LTFAT_API int
 LTFAT_NAME(idgtreal_long_execute)(LTFAT_NAME(idgtreal_long_plan)* p)
 {
@@ -215,8 +279,12 @@ error:
     return status;
 }
 
-LTFAT_API void
-LTFAT_NAME(idgtreal_walnut_execute)(LTFAT_NAME(idgtreal_long_plan)* p)
+/* One iteration of the r-loop of the walnut algorithm. Iterations for
+ * different r write to disjoint parts of the output and only use the
+ * buffers from wk. */
+static void
+LTFAT_NAME(idgtreal_walnut_r)(const LTFAT_NAME(idgtreal_long_plan)* p,
+                              LTFAT_NAME(idgtreal_long_worker)* wk, ltfat_int r)
 {
     ltfat_int b = p->L / p->M;
     ltfat_int N = p->L / p->a;
@@ -247,98 +315,105 @@ LTFAT_NAME(idgtreal_walnut_execute)(LTFAT_NAME(idgtreal_long_plan)* p)
     /* Leading dimensions of the 4dim array. */
     ltfat_int ld2ff = pp * q * W;
 
-    /* -------- Main loop ----------------------------------- */
-    for (ltfat_int r = 0; r < c; r++)
-    {
-        /* -------- compute coefficient factorization ----------- */
+    /* -------- compute coefficient factorization ----------- */
 
-        LTFAT_COMPLEX* cfp = p->cf;
+    LTFAT_COMPLEX* cfp = wk->cf;
 
-        for (ltfat_int w = 0; w < W; w++)
+    for (ltfat_int w = 0; w < W; w++)
+    {
+        /* Complete inverse fac of coefficients */
+        for (ltfat_int l = 0; l < q; l++)
         {
-            /* Complete inverse fac of coefficients */
-            for (ltfat_int l = 0; l < q; l++)
+            for (ltfat_int u = 0; u < q; u++)
             {
-                for (ltfat_int u = 0; u < q; u++)
+                for (ltfat_int s = 0; s < d; s++)
                 {
-                    for (ltfat_int s = 0; s < d; s++)
-                    {
-                        p->sbuf[s] = p->cwork[r + l * c +
-                                              ltfat_positiverem(u + s * q - l * h_a, N) *
-                                              M + w * ld4c];
-                    }
-
-                    /* Do inverse fft of length d */
-                    LTFAT_NAME(fftreal_execute)(p->p_after);
-
-                    for (ltfat_int s = 0; s < d2; s++)
-                    {
-                        cfp[s * ld3b] = p->cbuf[s];
-                    }
-                    /* Advance the cf pointer. This is only done in this
-                    * one place, because the loops are placed such that
-                    * this pointer will advance linearly through
-                    * memory. Reordering the loops will break this. */
-                    cfp++;
+                    wk->sbuf[s] = p->cwork[r + l * c +
+                                          ltfat_positiverem(u + s * q - l * h_a, N) *
+                                          M + w * ld4c];
                 }
+
+                /* Do inverse fft of length d */
+                LTFAT_NAME(fftreal_execute)(wk->p_after);
+
+                for (ltfat_int s = 0; s < d2; s++)
+                {
+                    cfp[s * ld3b] = wk->cbuf[s];
+                }
+                /* Advance the cf pointer. This is only done in this
+                * one place, because the loops are placed such that
+                * this pointer will advance linearly through
+                * memory. Reordering the loops will break this. */
+                cfp++;
             }
         }
-        /* -------- compute matrix multiplication ---------- */
-        /* Do the matmul  */
-        for (ltfat_int s = 0; s < d2; s++)
-        {
-            const LTFAT_COMPLEX* gbase = p->gf + (r + s * c) * pp * q;
-            LTFAT_COMPLEX*       fbase = p->ff + s * pp * q * W;
-            const LTFAT_COMPLEX* cbase = p->cf + s * q * q * W;
+    }
+    /* -------- compute matrix multiplication ---------- */
+    /* Do the matmul  */
+    for (ltfat_int s = 0; s < d2; s++)
+    {
+        const LTFAT_COMPLEX* gbase = p->gf + (r + s * c) * pp * q;
+        LTFAT_COMPLEX*       fbase = wk->ff + s * pp * q * W;
+        const LTFAT_COMPLEX* cbase = wk->cf + s * q * q * W;
 
-            for (ltfat_int nm = 0; nm < q * W; nm++)
+        for (ltfat_int nm = 0; nm < q * W; nm++)
+        {
+            for (ltfat_int km = 0; km < pp; km++)
             {
-                for (ltfat_int km = 0; km < pp; km++)
+                fbase[km + nm * pp] = 0.0;
+                for (ltfat_int mm = 0; mm < q; mm++)
                 {
-                    fbase[km + nm * pp] = 0.0;
-                    for (ltfat_int mm = 0; mm < q; mm++)
-                    {
-                        fbase[km + nm * pp] += gbase[km + mm * pp] * cbase[mm + nm * q];
-                    }
-                    /* Scale because of FFTWs normalization. */
-                    fbase[km + nm * pp] = fbase[km + nm * pp] * scalconst;
+                    fbase[km + nm * pp] += gbase[km + mm * pp] * cbase[mm + nm * q];
                 }
+                /* Scale because of FFTWs normalization. */
+                fbase[km + nm * pp] = fbase[km + nm * pp] * scalconst;
             }
         }
-        /* ----------- compute inverse signal factorization ---------- */
+    }
+    /* ----------- compute inverse signal factorization ---------- */
 
-        LTFAT_COMPLEX* ffp = p->ff;
-        LTFAT_REAL*    fp  = p->f + r;
+    LTFAT_COMPLEX* ffp = wk->ff;
+    LTFAT_REAL*    fp  = p->f + r;
 
-        for (ltfat_int w = 0; w < W; w++)
+    for (ltfat_int w = 0; w < W; w++)
+    {
+        for (ltfat_int l = 0; l < q; l++)
         {
-            for (ltfat_int l = 0; l < q; l++)
+            for (ltfat_int k = 0; k < pp; k++)
             {
-                for (ltfat_int k = 0; k < pp; k++)
+                for (ltfat_int s = 0; s < d2; s++)
                 {
-                    for (ltfat_int s = 0; s < d2; s++)
-                    {
-                        p->cbuf[s] = ffp[s * ld2ff];
-                    }
-
-                    LTFAT_NAME(ifftreal_execute)(p->p_before);
-
-                    for (ltfat_int s = 0; s < d; s++)
-                    {
-                        if (p->do_overwriteoutarray)
-                            fp[ltfat_positiverem(k * M + s * pp * M - l * h_a * a, L)] = p->sbuf[s];
-                        else
-                            fp[ltfat_positiverem(k * M + s * pp * M - l * h_a * a, L)] += p->sbuf[s];
-                    }
-
-                    /* Advance the ff pointer. This is only done in this
-                    * one place, because the loops are placed such that
-                    * this pointer will advance linearly through
-                    * memory. Reordering the loops will break this. */
-                    ffp++;
+                    wk->cbuf[s] = ffp[s * ld2ff];
                 }
+
+                LTFAT_NAME(ifftreal_execute)(wk->p_before);
+
+                for (ltfat_int s = 0; s < d; s++)
+                {
+                    if (p->do_overwriteoutarray)
+                        fp[ltfat_positiverem(k * M + s * pp * M - l * h_a * a, L)] = wk->sbuf[s];
+                    else
+                        fp[ltfat_positiverem(k * M + s * pp * M - l * h_a * a, L)] += wk->sbuf[s];
+                }
+
+                /* Advance the ff pointer. This is only done in this
+                * one place, because the loops are placed such that
+                * this pointer will advance linearly through
+                * memory. Reordering the loops will break this. */
+                ffp++;
             }
-            fp += L;
         }
+        fp += L;
     }
 }
+
+LTFAT_API void
+LTFAT_NAME(idgtreal_walnut_execute)(LTFAT_NAME(idgtreal_long_plan)* p)
+{
+    /* -------- Main loop ----------------------------------- */
+#ifdef _OPENMP
+    #pragma omp parallel for num_threads(p->nthreads) if(p->nthreads > 1) schedule(static)
+#endif
+    for (ltfat_int r = 0; r < p->c; r++)
+        LTFAT_NAME(idgtreal_walnut_r)(p, p->wk + ltfat_threadid(), r);
+}
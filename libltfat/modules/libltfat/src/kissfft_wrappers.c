@@ -191,6 +191,7 @@ struct LTFAT_NAME(fftreal_plan)
     LTFAT_COMPLEX* tmp;
     LTFAT_KISS(fft_plan)* kiss_plan_cpx;
     LTFAT_KISS(fftr_plan)* kiss_plan;
+    LTFAT_NAME(fftreal_pow2_plan)* pow2_plan; //!< Used instead of kiss_plan for powers of two
 };
 
 LTFAT_API int
@@ -237,7 +238,11 @@ LTFAT_NAME(fftreal_init_common)(ltfat_int L, ltfat_int W,
               "during execution.", L, nextfastL);
     }
 
-    if (L % 2)
+    if (ltfat_ispow2(L) && L >= LTFAT_FFTREAL_POW2_MINL)
+    {
+        CHECKSTATUS( LTFAT_NAME(fftreal_pow2_init)(L, &fftwp->pow2_plan));
+    }
+    else if (L % 2)
     {
         if (L != nextfastL)
         {
@@ -292,7 +297,16 @@ LTFAT_NAME(fftreal_execute_newarray)(LTFAT_NAME(fftreal_plan)* p,
 
     M2 = p->L / 2 + 1;
 
-    if (p->L % 2)
+    if (p->pow2_plan)
+    {
+        ltfat_int step = p->L;
+        if (in == (const LTFAT_REAL*) out)
+            step = 2 * M2;
+
+        for (ltfat_int w = 0; w < p->W; w++)
+            LTFAT_NAME(fftreal_pow2_execute)(p->pow2_plan, in + w * step, out + w * M2);
+    }
+    else if (p->L % 2)
     {
         ltfat_int step = p->L;
         if (in == (const LTFAT_REAL*) out)
@@ -345,6 +359,7 @@ LTFAT_NAME(fftreal_done)(LTFAT_NAME(fftreal_plan)** p)
     if (pp->tmp) ltfat_free(pp->tmp);
     if (pp->kiss_plan) ltfat_free(pp->kiss_plan);
     if (pp->kiss_plan_cpx) ltfat_free(pp->kiss_plan_cpx);
+    if (pp->pow2_plan) LTFAT_NAME(fftreal_pow2_done)(&pp->pow2_plan);
     ltfat_free(pp);
     pp = NULL;
 error:
@@ -400,7 +415,16 @@ LTFAT_NAME(ifftreal_execute_newarray)(LTFAT_NAME(ifftreal_plan)* pin,
 
     M2 = p->L / 2 + 1;
 
-    if (p->L % 2)
+    if (p->pow2_plan)
+    {
+        ltfat_int step = p->L;
+        if (in == (const LTFAT_COMPLEX*) out)
+            step = 2 * M2;
+
+        for (ltfat_int w = 0; w < p->W; w++)
+            LTFAT_NAME(ifftreal_pow2_execute)(p->pow2_plan, in + w * M2, out + w * step);
+    }
+    else if (p->L % 2)
     {
         ltfat_int step = p->L;
         if (in == (const LTFAT_COMPLEX*) out)
@@ -452,3 +476,22 @@ LTFAT_NAME(ifftreal_done)(LTFAT_NAME(ifftreal_plan)** p)
 {
     return LTFAT_NAME(fftreal_done)((LTFAT_NAME(fftreal_plan)**) p);
 }
+
+static int LTFAT_NAME(fft_nthreads) = 1;
+
+LTFAT_API int
+LTFAT_NAME(fft_plan_with_nthreads)(int nthreads)
+{
+    int status = LTFATERR_SUCCESS;
+    // KISS FFT plans are always single-threaded
+    CHECK(LTFATERR_NOTPOSARG, nthreads > 0, "nthreads must be positive");
+    LTFAT_NAME(fft_nthreads) = nthreads;
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(fft_planner_nthreads)(void)
+{
+    return LTFAT_NAME(fft_nthreads);
+}
@@ -0,0 +1,86 @@
+#include "ltfat.h"
+#include "ltfat/macros.h"
+#include "lrucache_private.h"
+
+unsigned long long
+ltfat_fnv1a(unsigned long long hash, const void* data, size_t len)
+{
+    const unsigned char* bytes = (const unsigned char*) data;
+
+    for (size_t ii = 0; ii < len; ii++)
+    {
+        hash ^= bytes[ii];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+void
+ltfat_lrucache_remove(ltfat_lrucache* c, ltfat_int idx)
+{
+    ltfat_lruentry* e = ltfat_lrucache_entry(c, idx);
+
+    c->bytes -= e->bytes;
+    c->freeentry(e);
+    c->no--;
+    if (idx != c->no)
+        memcpy(e, ltfat_lrucache_entry(c, c->no), c->entrysize);
+}
+
+void
+ltfat_lrucache_evict(ltfat_lrucache* c, size_t budget)
+{
+    while (c->bytes > budget)
+    {
+        ltfat_int oldest = -1;
+
+        for (ltfat_int ii = 0; ii < c->no; ii++)
+        {
+            ltfat_lruentry* e = ltfat_lrucache_entry(c, ii);
+            if (!e->inuse &&
+                (oldest < 0 || e->lastuse < ltfat_lrucache_entry(c, oldest)->lastuse))
+                oldest = ii;
+        }
+
+        if (oldest < 0) break;
+
+        ltfat_lrucache_remove(c, oldest);
+    }
+}
+
+int
+ltfat_lrucache_insert(ltfat_lrucache* c, const void* entry)
+{
+    int status = LTFATERR_SUCCESS;
+
+    if (c->no == c->cap)
+    {
+        ltfat_int newcap = c->cap > 0 ? 2 * c->cap : c->initcap;
+        void* newtable;
+        CHECKMEM( newtable = ltfat_realloc(c->table, c->cap * c->entrysize,
+                                           newcap * c->entrysize));
+        c->table = newtable;
+        c->cap = newcap;
+    }
+
+    memcpy(ltfat_lrucache_entry(c, c->no), entry, c->entrysize);
+    ltfat_lrucache_touch(c, c->no);
+    c->bytes += ((const ltfat_lruentry*) entry)->bytes;
+    c->no++;
+    ltfat_lrucache_evict(c, c->budget);
+error:
+    return status;
+}
+
+void
+ltfat_lrucache_clear(ltfat_lrucache* c)
+{
+    ltfat_lrucache_evict(c, 0);
+
+    if (c->no == 0)
+    {
+        ltfat_safefree(c->table);
+        c->table = NULL;
+        c->cap = 0;
+    }
+}
@@ -0,0 +1,76 @@
+#ifndef _ltfat_lrucache_private_h
+#define _ltfat_lrucache_private_h
+
+/* Table of cache entries with a memory budget and the least recently used
+ * eviction, shared by the DGT plan cache and the MP kernel cache.
+ *
+ * The entries are stored by value. Every entry struct must start with an
+ * ltfat_lruentry member. None of the functions lock, the caches call them
+ * from within their own critical sections.
+ */
+
+#define LTFAT_FNV1A_INIT 14695981039346656037ULL
+
+typedef struct
+{
+    unsigned long long hash;
+    size_t bytes;      //!< Approximate size of the entry
+    int inuse;         //!< The entry cannot be evicted
+    unsigned long long lastuse;  //!< Access stamp for the LRU eviction
+} ltfat_lruentry;
+
+typedef void ltfat_lrucache_freeentry(void* entry);
+
+typedef struct
+{
+    void* table;
+    size_t entrysize;
+    ltfat_int no;
+    ltfat_int cap;
+    ltfat_int initcap;  //!< Capacity of the first allocation of the table
+    size_t bytes;
+    size_t budget;
+    unsigned long long clock;
+    ltfat_lrucache_freeentry* freeentry;
+} ltfat_lrucache;
+
+/* Initializer of a static ltfat_lrucache */
+#define LTFAT_LRUCACHE_INIT(entrytype, initcap, budget, freeentry) \
+    { NULL, sizeof(entrytype), 0, 0, (initcap), 0, (budget), 0, (freeentry) }
+
+/* FNV-1a */
+unsigned long long
+ltfat_fnv1a(unsigned long long hash, const void* data, size_t len);
+
+static inline ltfat_lruentry*
+ltfat_lrucache_entry(const ltfat_lrucache* c, ltfat_int idx)
+{
+    return (ltfat_lruentry*)((char*) c->table + idx * c->entrysize);
+}
+
+/* Stamps the entry as the most recently used one */
+static inline void
+ltfat_lrucache_touch(ltfat_lrucache* c, ltfat_int idx)
+{
+    ltfat_lrucache_entry(c, idx)->lastuse = ++c->clock;
+}
+
+/* Frees the entry and moves the last one in its place */
+void
+ltfat_lrucache_remove(ltfat_lrucache* c, ltfat_int idx);
+
+/* Frees the least recently used entries not in use until the cache fits
+ * the budget */
+void
+ltfat_lrucache_evict(ltfat_lrucache* c, size_t budget);
+
+/* Copies the entry to the table, stamps it and evicts down to c->budget.
+ * On LTFATERR_NOMEM the entry is left to the caller. */
+int
+ltfat_lrucache_insert(ltfat_lrucache* c, const void* entry);
+
+/* Frees all entries not in use and the table itself if none is left */
+void
+ltfat_lrucache_clear(ltfat_lrucache* c);
+
+#endif
@@ -1,6 +1,12 @@
 #include "ltfat.h"
 #include "ltfat/types.h"
 #include "ltfat/macros.h"
+#include "simd_private.h"
+
+/* Number of children of a node in the blocked layout */
+#define LTFAT_MAXTREE_BLOCK 16
+/* Number of disjoint dirty ranges kept before they are merged */
+#define LTFAT_MAXTREE_DIRTYNO 4
 
 struct LTFAT_NAME(maxtree)
 {
@@ -18,6 +24,10 @@ struct LTFAT_NAME(maxtree)
     ltfat_int*   levelL;
     ltfat_int    W;
     int is_complexinput;
+    int is_blocked;
+    ltfat_int dirtyNo;
+    ltfat_int dirtystarts[LTFAT_MAXTREE_DIRTYNO];
+    ltfat_int dirtyends[LTFAT_MAXTREE_DIRTYNO];
     LTFAT_NAME(maxtree_complexinput_callback)* callback;
     void* userdata;
 };
@@ -96,6 +106,72 @@ error:
     return status;
 }
 
+/* The blocked layout stores all internal levels top-down in a single
+ * aligned buffer. Every level is padded to a multiple of
+ * LTFAT_MAXTREE_BLOCK such that the children of any node form one full
+ * block starting at a cache line boundary. */
+LTFAT_API int
+LTFAT_NAME(maxtree_initblocked)(
+    ltfat_int L, ltfat_int Lstep, LTFAT_NAME(maxtree)** pout)
+{
+    LTFAT_NAME(maxtree)* p = NULL;
+    ltfat_int depth, Llevel, cumL;
+    int status = LTFATERR_SUCCESS;
+
+    CHECK(LTFATERR_NOTPOSARG, L > 0,
+          "L must be positive (passed %td)" , L);
+
+    depth = 0; Llevel = L;
+    do
+    {
+        Llevel = ltfat_idivceil(Llevel, LTFAT_MAXTREE_BLOCK);
+        depth++;
+    }
+    while (Llevel > 1);
+
+    CHECKMEM( p = LTFAT_NEW( LTFAT_NAME(maxtree)) );
+    CHECKMEM( p->levelL = LTFAT_NEWARRAY(ltfat_int, depth + 1) );
+    CHECKMEM( p->treePtrs = LTFAT_NEWARRAY(LTFAT_REAL*, depth + 1) );
+    CHECKMEM( p->treePosPtrs = LTFAT_NEWARRAY(ltfat_int*, depth ) );
+
+    p->levelL[depth] = L;
+    for (ltfat_int d = depth - 1; d >= 0; d--)
+        p->levelL[d] = ltfat_idivceil(p->levelL[d + 1], LTFAT_MAXTREE_BLOCK);
+
+    cumL = 0;
+    for (ltfat_int d = 0; d < depth; d++)
+        cumL += LTFAT_MAXTREE_BLOCK *
+                ltfat_idivceil(p->levelL[d], LTFAT_MAXTREE_BLOCK);
+
+    CHECKMEM( p->treeVals = LTFAT_NAME_REAL(malloc)( cumL ));
+    CHECKMEM( p->treePos = LTFAT_NEWARRAY(ltfat_int, cumL ) );
+
+    /* The padding must never win */
+    for (ltfat_int l = 0; l < cumL; l++)
+        p->treeVals[l] = (LTFAT_REAL) - HUGE_VAL;
+
+    cumL = 0;
+    for (ltfat_int d = 0; d < depth; d++)
+    {
+        p->treePosPtrs[d] = p->treePos + cumL;
+        p->treePtrs[d] = p->treeVals + cumL;
+        cumL += LTFAT_MAXTREE_BLOCK *
+                ltfat_idivceil(p->levelL[d], LTFAT_MAXTREE_BLOCK);
+    }
+
+    p->depth = depth; p->L = L; p->nextL = cumL; p->Lstep = Lstep;
+    p->is_blocked = 1;
+
+    p->dirtystart = p->Lstep;
+    p->dirtyend   = 0;
+
+    *pout = p;
+    return LTFATERR_SUCCESS;
+error:
+    if (p) LTFAT_NAME(maxtree_done)(&p);
+    return status;
+}
+
 LTFAT_API int
 LTFAT_NAME(maxtree_done)(LTFAT_NAME(maxtree)** p)
 {
@@ -162,6 +238,48 @@ LTFAT_NAME(maxtree_setdirty)(LTFAT_NAME(maxtree)* p, ltfat_int start,
 {
     if (start < p->dirtystart) p->dirtystart = start;
     if (end   > p->dirtyend)  p->dirtyend  = end;
+
+    if (start >= end) return 0;
+
+    /* Absorb all ranges overlapping or touching the new one */
+    for (ltfat_int r = 0; r < p->dirtyNo; )
+    {
+        if (start <= p->dirtyends[r] && p->dirtystarts[r] <= end)
+        {
+            if (p->dirtystarts[r] < start) start = p->dirtystarts[r];
+            if (p->dirtyends[r]   > end)   end   = p->dirtyends[r];
+            p->dirtyNo--;
+            p->dirtystarts[r] = p->dirtystarts[p->dirtyNo];
+            p->dirtyends[r]   = p->dirtyends[p->dirtyNo];
+        }
+        else
+            r++;
+    }
+
+    if (p->dirtyNo < LTFAT_MAXTREE_DIRTYNO)
+    {
+        p->dirtystarts[p->dirtyNo] = start;
+        p->dirtyends[p->dirtyNo]   = end;
+        p->dirtyNo++;
+        return 0;
+    }
+
+    /* The list is full, merge with the closest range. No other range can
+     * lie in the gap in between. */
+    ltfat_int rmin = 0, gapmin = 0;
+    for (ltfat_int r = 0; r < p->dirtyNo; r++)
+    {
+        ltfat_int gap = start > p->dirtyends[r] ?
+                        start - p->dirtyends[r] : p->dirtystarts[r] - end;
+        if ( r == 0 || gap < gapmin )
+        {
+            gapmin = gap;
+            rmin = r;
+        }
+    }
+
+    if (start < p->dirtystarts[rmin]) p->dirtystarts[rmin] = start;
+    if (end   > p->dirtyends[rmin])   p->dirtyends[rmin]   = end;
     return 0;
 }
 
@@ -174,22 +292,183 @@ LTFAT_NAME(maxtree_getdirty)(LTFAT_NAME(maxtree)* p, ltfat_int* start,
     return 0;
 }
 
+ltfat_int
+LTFAT_NAME(maxtree_getdirtyranges)(LTFAT_NAME(maxtree)* p,
+                                   const ltfat_int** starts,
+                                   const ltfat_int** ends)
+{
+    *starts = p->dirtystarts;
+    *ends   = p->dirtyends;
+    return p->dirtyNo;
+}
+
 int
 LTFAT_NAME(maxtree_updatedirty)(LTFAT_NAME(maxtree)* p)
 {
-    if ( p->dirtyend <= p->dirtystart )
-        return 1;
+    int ret = p->dirtyNo == 0;
 
-    int ret = LTFAT_NAME(maxtree_updaterange)(p, p->dirtystart, p->dirtyend);
+    for (ltfat_int r = 0; r < p->dirtyNo; r++)
+        ret |= LTFAT_NAME(maxtree_updaterange)(p, p->dirtystarts[r],
+                                              p->dirtyends[r]);
+
+    p->dirtyNo    = 0;
     p->dirtystart = p->Lstep;
     p->dirtyend   = 0;
     return ret;
 }
 
+/* Maximum of len values and the position of its first occurrence.
+ * len must be a multiple of LTFAT_VLEN. */
+static inline void
+LTFAT_NAME(maxtree_vecmax)(const LTFAT_REAL* vals, ltfat_int len,
+                           LTFAT_REAL* max, ltfat_int* pos)
+{
+    LTFAT_REAL lanes[LTFAT_VLEN];
+    ltfat_vreal vmax = LTFAT_VLOAD(vals);
+
+    for (ltfat_int l = LTFAT_VLEN; l < len; l += LTFAT_VLEN)
+        vmax = LTFAT_VMAX(vmax, LTFAT_VLOAD(vals + l));
+
+    LTFAT_VSTORE(lanes, vmax);
+    LTFAT_REAL m = lanes[0];
+    for (ltfat_int l = 1; l < LTFAT_VLEN; l++)
+        if (lanes[l] > m) m = lanes[l];
+
+    ltfat_int l = 0;
+    while (l < len - 1 && vals[l] != m) l++;
+
+    *max = m; *pos = l;
+}
+
+static inline void
+LTFAT_NAME(maxtree_arraymax)(const LTFAT_REAL* vals, ltfat_int len,
+                             LTFAT_REAL* max, ltfat_int* pos)
+{
+    LTFAT_REAL m = vals[0];
+    ltfat_int mpos = 0;
+
+    for (ltfat_int l = 1; l < len; l++)
+        if (vals[l] > m)
+        {
+            m = vals[l];
+            mpos = l;
+        }
+
+    *max = m; *pos = mpos;
+}
+
+/* Maximum of the leaf block b */
+static void
+LTFAT_NAME(maxtree_leafblockmax)(LTFAT_NAME(maxtree)* p, ltfat_int b,
+                                 LTFAT_REAL* max, ltfat_int* pos)
+{
+    ltfat_int start = b * LTFAT_MAXTREE_BLOCK;
+    ltfat_int len = ltfat_imin(LTFAT_MAXTREE_BLOCK, p->L - start);
+    const LTFAT_REAL* leaves = p->treePtrs[p->depth];
+
+    /* Blocks are never empty, this lets the compiler know that too */
+    if (len < 1) { *max = 0; *pos = start; return; }
+
+    if (!p->is_complexinput)
+    {
+        if (len == LTFAT_MAXTREE_BLOCK)
+            LTFAT_NAME(maxtree_vecmax)(leaves + start, len, max, pos);
+        else
+            LTFAT_NAME(maxtree_arraymax)(leaves + start, len, max, pos);
+    }
+    else
+    {
+        const LTFAT_REAL* cleaves = leaves + 2 * start;
+        LTFAT_REAL energy[LTFAT_MAXTREE_BLOCK];
+
+        if (p->callback)
+        {
+            for (ltfat_int l = 0; l < len; l++)
+                energy[l] = p->callback(p->userdata,
+                                        *((LTFAT_COMPLEX*)&cleaves[2 * l]),
+                                        start + l);
+        }
+#ifdef LTFAT_VSWAPPAIRS
+        else if (len == LTFAT_MAXTREE_BLOCK)
+        {
+            /* Both lanes of a coefficient hold its energy */
+            LTFAT_REAL energy2[2 * LTFAT_MAXTREE_BLOCK];
+            for (ltfat_int l = 0; l < 2 * LTFAT_MAXTREE_BLOCK; l += LTFAT_VLEN)
+            {
+                ltfat_vreal v = LTFAT_VLOAD(cleaves + l);
+                v = LTFAT_VMUL(v, v);
+                LTFAT_VSTORE(energy2 + l, LTFAT_VADD(v, LTFAT_VSWAPPAIRS(v)));
+            }
+            LTFAT_NAME(maxtree_vecmax)(energy2, 2 * LTFAT_MAXTREE_BLOCK,
+                                       max, pos);
+            *pos = start + *pos / 2;
+            return;
+        }
+#endif
+        else
+        {
+            for (ltfat_int l = 0; l < len; l++)
+                energy[l] = cleaves[2 * l] * cleaves[2 * l] +
+                            cleaves[2 * l + 1] * cleaves[2 * l + 1];
+        }
+
+        LTFAT_NAME(maxtree_arraymax)(energy, len, max, pos);
+    }
+
+    *pos += start;
+}
+
+static int
+LTFAT_NAME(maxtree_updaterange_blocked)(LTFAT_NAME(maxtree)* p,
+                                        ltfat_int start, ltfat_int end)
+{
+    if (end > p->Lstep)
+    {
+        ltfat_int over = end - p->Lstep;
+        LTFAT_NAME(maxtree_updaterange_blocked)( p, 0, over);
+    }
+
+    if (end > p->L) end = p->L;
+    if (start >= end) return 0;
+
+    ltfat_int b0 = start / LTFAT_MAXTREE_BLOCK;
+    ltfat_int b1 = ltfat_idivceil(end, LTFAT_MAXTREE_BLOCK);
+
+    LTFAT_REAL* treeValnext = p->treePtrs[p->depth - 1];
+    ltfat_int* treePosnext = p->treePosPtrs[p->depth - 1];
+
+    for (ltfat_int b = b0; b < b1; b++)
+        LTFAT_NAME(maxtree_leafblockmax)(p, b, &treeValnext[b], &treePosnext[b]);
+
+    for (ltfat_int d = p->depth - 1; d > 0; d--)
+    {
+        b0 = b0 / LTFAT_MAXTREE_BLOCK;
+        b1 = ltfat_idivceil(b1, LTFAT_MAXTREE_BLOCK);
+
+        const LTFAT_REAL* treeVal = p->treePtrs[d];
+        const ltfat_int* treePos  = p->treePosPtrs[d];
+        treeValnext = p->treePtrs[d - 1];
+        treePosnext = p->treePosPtrs[d - 1];
+
+        for (ltfat_int b = b0; b < b1; b++)
+        {
+            ltfat_int l;
+            LTFAT_NAME(maxtree_vecmax)(treeVal + b * LTFAT_MAXTREE_BLOCK,
+                                       LTFAT_MAXTREE_BLOCK, &treeValnext[b], &l);
+            treePosnext[b] = treePos[b * LTFAT_MAXTREE_BLOCK + l];
+        }
+    }
+
+    return 0;
+}
+
 int
 LTFAT_NAME(maxtree_updaterange)(LTFAT_NAME(maxtree)* p, ltfat_int start,
                                 ltfat_int end)
 {
+    if (p->is_blocked)
+        return LTFAT_NAME(maxtree_updaterange_blocked)(p, start, end);
+
     if (p->depth == 0) return 0;
 
     if (end > p->Lstep)
@@ -315,6 +594,13 @@ LTFAT_NAME(maxtree_findmax)(LTFAT_NAME(maxtree)* p, LTFAT_REAL* max,
 {
     LTFAT_NAME(maxtree_updatedirty)(p);
 
+    if (p->is_blocked)
+    {
+        *max    = p->treePtrs[0][0];
+        *maxPos = p->treePosPtrs[0][0];
+        return 0;
+    }
+
     if(  p->is_complexinput && p->depth == 0 )
     {
         LTFAT_COMPLEX* toplevel = (LTFAT_COMPLEX*)p->treePtrs[0];
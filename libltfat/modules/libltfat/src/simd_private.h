@@ -0,0 +1,105 @@
+#ifndef _ltfat_simd_private_h
+#define _ltfat_simd_private_h
+
+/* Minimal portable vector abstraction over LTFAT_REAL
+ *
+ * ltfat_vreal holds LTFAT_VLEN values of LTFAT_REAL. The widest
+ * instruction set enabled by the compiler flags is used, e.g. AVX with
+ * -mavx or -march=native. SSE2 is always available on x86_64. Without
+ * any of them, the vector degenerates to a single scalar.
+ *
+ * Loads and stores do not require alignment.
+ *
+ * LTFAT_VSWAPPAIRS swaps neighboring elements, i.e. real and imaginary
+ * parts of interleaved complex numbers. It is not defined for the scalar
+ * fallback.
+ */
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#  ifdef LTFAT_DOUBLE
+typedef __m256d ltfat_vreal;
+#    define LTFAT_VLEN 4
+#    define LTFAT_VLOAD(ptr)     _mm256_loadu_pd(ptr)
+#    define LTFAT_VSTORE(ptr, v) _mm256_storeu_pd((ptr), (v))
+#    define LTFAT_VSET1(x)       _mm256_set1_pd(x)
+#    define LTFAT_VADD(a, b)     _mm256_add_pd((a), (b))
+#    define LTFAT_VSUB(a, b)     _mm256_sub_pd((a), (b))
+#    define LTFAT_VMUL(a, b)     _mm256_mul_pd((a), (b))
+#    define LTFAT_VMAX(a, b)     _mm256_max_pd((a), (b))
+#    define LTFAT_VSWAPPAIRS(a)  _mm256_permute_pd((a), 0x5)
+#  else
+typedef __m256 ltfat_vreal;
+#    define LTFAT_VLEN 8
+#    define LTFAT_VLOAD(ptr)     _mm256_loadu_ps(ptr)
+#    define LTFAT_VSTORE(ptr, v) _mm256_storeu_ps((ptr), (v))
+#    define LTFAT_VSET1(x)       _mm256_set1_ps(x)
+#    define LTFAT_VADD(a, b)     _mm256_add_ps((a), (b))
+#    define LTFAT_VSUB(a, b)     _mm256_sub_ps((a), (b))
+#    define LTFAT_VMUL(a, b)     _mm256_mul_ps((a), (b))
+#    define LTFAT_VMAX(a, b)     _mm256_max_ps((a), (b))
+#    define LTFAT_VSWAPPAIRS(a)  _mm256_permute_ps((a), 0xB1)
+#  endif
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#  ifdef LTFAT_DOUBLE
+typedef __m128d ltfat_vreal;
+#    define LTFAT_VLEN 2
+#    define LTFAT_VLOAD(ptr)     _mm_loadu_pd(ptr)
+#    define LTFAT_VSTORE(ptr, v) _mm_storeu_pd((ptr), (v))
+#    define LTFAT_VSET1(x)       _mm_set1_pd(x)
+#    define LTFAT_VADD(a, b)     _mm_add_pd((a), (b))
+#    define LTFAT_VSUB(a, b)     _mm_sub_pd((a), (b))
+#    define LTFAT_VMUL(a, b)     _mm_mul_pd((a), (b))
+#    define LTFAT_VMAX(a, b)     _mm_max_pd((a), (b))
+#    define LTFAT_VSWAPPAIRS(a)  _mm_shuffle_pd((a), (a), 1)
+#  else
+typedef __m128 ltfat_vreal;
+#    define LTFAT_VLEN 4
+#    define LTFAT_VLOAD(ptr)     _mm_loadu_ps(ptr)
+#    define LTFAT_VSTORE(ptr, v) _mm_storeu_ps((ptr), (v))
+#    define LTFAT_VSET1(x)       _mm_set1_ps(x)
+#    define LTFAT_VADD(a, b)     _mm_add_ps((a), (b))
+#    define LTFAT_VSUB(a, b)     _mm_sub_ps((a), (b))
+#    define LTFAT_VMUL(a, b)     _mm_mul_ps((a), (b))
+#    define LTFAT_VMAX(a, b)     _mm_max_ps((a), (b))
+#    define LTFAT_VSWAPPAIRS(a)  _mm_shuffle_ps((a), (a), 0xB1)
+#  endif
+#elif defined(__ARM_NEON) && (defined(__aarch64__) || !defined(LTFAT_DOUBLE))
+#include <arm_neon.h>
+#  ifdef LTFAT_DOUBLE
+typedef float64x2_t ltfat_vreal;
+#    define LTFAT_VLEN 2
+#    define LTFAT_VLOAD(ptr)     vld1q_f64(ptr)
+#    define LTFAT_VSTORE(ptr, v) vst1q_f64((ptr), (v))
+#    define LTFAT_VSET1(x)       vdupq_n_f64(x)
+#    define LTFAT_VADD(a, b)     vaddq_f64((a), (b))
+#    define LTFAT_VSUB(a, b)     vsubq_f64((a), (b))
+#    define LTFAT_VMUL(a, b)     vmulq_f64((a), (b))
+#    define LTFAT_VMAX(a, b)     vmaxq_f64((a), (b))
+#    define LTFAT_VSWAPPAIRS(a)  vextq_f64((a), (a), 1)
+#  else
+typedef float32x4_t ltfat_vreal;
+#    define LTFAT_VLEN 4
+#    define LTFAT_VLOAD(ptr)     vld1q_f32(ptr)
+#    define LTFAT_VSTORE(ptr, v) vst1q_f32((ptr), (v))
+#    define LTFAT_VSET1(x)       vdupq_n_f32(x)
+#    define LTFAT_VADD(a, b)     vaddq_f32((a), (b))
+#    define LTFAT_VSUB(a, b)     vsubq_f32((a), (b))
+#    define LTFAT_VMUL(a, b)     vmulq_f32((a), (b))
+#    define LTFAT_VMAX(a, b)     vmaxq_f32((a), (b))
+#    define LTFAT_VSWAPPAIRS(a)  vrev64q_f32(a)
+#  endif
+#else
+typedef LTFAT_REAL ltfat_vreal;
+#  define LTFAT_VLEN 1
+#  define LTFAT_VLOAD(ptr)     (*(ptr))
+#  define LTFAT_VSTORE(ptr, v) (*(ptr) = (v))
+#  define LTFAT_VSET1(x)       (x)
+#  define LTFAT_VADD(a, b)     ((a) + (b))
+#  define LTFAT_VSUB(a, b)     ((a) - (b))
+#  define LTFAT_VMUL(a, b)     ((a) * (b))
+#  define LTFAT_VMAX(a, b)     ((a) > (b) ? (a) : (b))
+#endif
+
+#endif
@@ -2,14 +2,26 @@
 #include "ltfat/types.h"
 #include "ltfat/macros.h"
 #include "dgtrealmp_private.h"
+#include "circularbuf_private.h"
 #include "slicingbuf_private.h"
 #include "slidgtrealmp_private.h"
+#include "threads_private.h"
 
 LTFAT_API int
 LTFAT_NAME(slidgtrealmp_init)(
     LTFAT_NAME(dgtrealmp_parbuf)* pb, ltfat_int L,
     ltfat_int numChans, ltfat_int bufLenMax,
     LTFAT_NAME(slidgtrealmp_state)** pout)
+{
+    return LTFAT_NAME(slidgtrealmp_init_pipelined)(pb, L, numChans, bufLenMax,
+            1, pout);
+}
+
+LTFAT_API int
+LTFAT_NAME(slidgtrealmp_init_pipelined)(
+    LTFAT_NAME(dgtrealmp_parbuf)* pb, ltfat_int L,
+    ltfat_int numChans, ltfat_int bufLenMax, ltfat_int pipeLen,
+    LTFAT_NAME(slidgtrealmp_state)** pout)
 {
     int status = LTFATERR_FAILED;
     LTFAT_NAME(slidgtrealmp_state)* p = NULL;
@@ -17,6 +29,10 @@ LTFAT_NAME(slidgtrealmp_init)(
     LTFAT_NAME(slicing_processor_state)* slistate = NULL;
     ltfat_int taperLen = 0, zpadLen = 0;
 
+    CHECKNULL(pout);
+    CHECK(LTFATERR_NOTPOSARG, pipeLen > 0,
+          "pipeLen must be positive (passed %td)", pipeLen);
+
     CHECKSTATUS(
         LTFAT_NAME(dgtrealmp_init)(pb, L, &mpstate));
 
@@ -41,12 +57,43 @@ LTFAT_NAME(slidgtrealmp_init)(
 
     p->owning_mpstate = 1;
     p->owning_slistate = 1;
+    mpstate = NULL; slistate = NULL;
+
+    if (pipeLen > 1)
+    {
+        // Every slot needs its own state. The Gram kernels are cached, so
+        // this mostly costs the DGT plans.
+        p->pipeLen = pipeLen;
+        p->numChans = numChans;
+        CHECKMEM( p->pipeStates =
+                      LTFAT_NEWARRAY(LTFAT_NAME(dgtrealmp_state)*, pipeLen));
+        CHECKMEM( p->pipeCout = LTFAT_NEWARRAY(LTFAT_COMPLEX**, pipeLen));
+        CHECKMEM( p->pipeW = LTFAT_NEWARRAY(int, pipeLen));
+        CHECKMEM( p->pipeIn  = LTFAT_NAME_REAL(calloc)(pipeLen * numChans * L));
+        CHECKMEM( p->pipeOut = LTFAT_NAME_REAL(calloc)(pipeLen * numChans * L));
+
+        p->pipeStates[0] = p->mpstate;
+        p->pipeCout[0] = p->couttmp;
+
+        for (ltfat_int s = 1; s < pipeLen; s++)
+        {
+            CHECKSTATUS(
+                LTFAT_NAME(dgtrealmp_init)(pb, L, &p->pipeStates[s]));
+            CHECKMEM( p->pipeCout[s] = LTFAT_NEWARRAY(LTFAT_COMPLEX*, p->P));
+
+            for (ltfat_int pidx = 0; pidx < p->P; pidx++)
+                CHECKMEM( p->pipeCout[s][pidx] = LTFAT_NAME_COMPLEX(malloc)(
+                                                     p->mpstate->M2[pidx] * p->mpstate->N[pidx]));
+        }
+    }
+
     *pout = p;
     return LTFATERR_SUCCESS;
 error:
     if (mpstate) LTFAT_NAME(dgtrealmp_done)(&mpstate);
     if (slistate) LTFAT_NAME(slicing_processor_done)(&slistate);
     if (p) LTFAT_NAME(slidgtrealmp_done)(&p);
+    if (pout) *pout = NULL;
     return status;
 }
 
@@ -69,6 +116,15 @@ LTFAT_NAME(slidgtrealmp_init_fromstates)(
         CHECKMEM( p->couttmp[pidx] = LTFAT_NAME_COMPLEX(malloc)(
                                          mpstate->M2[pidx] * (mpstate->L / mpstate->a[pidx])));
 
+    // The processor callback takes the sizes as int
+    CHECKMEM( p->M2 = LTFAT_NEWARRAY(int, p->P));
+    CHECKMEM( p->N = LTFAT_NEWARRAY(int, p->P));
+    for (ltfat_int pidx = 0; pidx < p->P; pidx++)
+    {
+        p->M2[pidx] = (int) mpstate->M2[pidx];
+        p->N[pidx] = (int) mpstate->N[pidx];
+    }
+
     LTFAT_NAME(slicing_processor_setcallback)( slistate,
             &LTFAT_NAME(slidgtrealmp_execute_callback), p);
 
@@ -86,7 +142,8 @@ LTFAT_NAME(slidgtrealmp_getprocdelay)( LTFAT_NAME(slidgtrealmp_state)* p)
 {
     int status = LTFATERR_FAILED;
     CHECKNULL(p);
-    return LTFAT_NAME(slicing_processor_getprocdelay)(p->slistate);
+    return LTFAT_NAME(slicing_processor_getprocdelay)(p->slistate) +
+           LTFAT_NAME(slidgtrealmp_getpipedelay)(p);
 error:
     return status;
 }
@@ -134,6 +191,28 @@ LTFAT_NAME(slidgtrealmp_done)(LTFAT_NAME(slidgtrealmp_state)** p)
         ltfat_free(pp->couttmp);
     }
 
+    if (pp->pipeStates)
+    {
+        for (ltfat_int s = 1; s < pp->pipeLen; s++)
+            if (pp->pipeStates[s])
+                LTFAT_NAME(dgtrealmp_done)(&pp->pipeStates[s]);
+        ltfat_free(pp->pipeStates);
+    }
+
+    if (pp->pipeCout)
+    {
+        for (ltfat_int s = 1; s < pp->pipeLen; s++)
+        {
+            if (!pp->pipeCout[s]) continue;
+            for (ltfat_int k = 0; k < pp->P; k++)
+                ltfat_safefree(pp->pipeCout[s][k]);
+            ltfat_free(pp->pipeCout[s]);
+        }
+        ltfat_free(pp->pipeCout);
+    }
+
+    LTFAT_SAFEFREEALL(pp->pipeIn, pp->pipeOut, pp->pipeW, pp->M2, pp->N);
+
     if (pp->owning_mpstate && pp->mpstate)
         LTFAT_NAME(dgtrealmp_done)(&pp->mpstate);
 
@@ -149,7 +228,88 @@ error:
 
 LTFAT_API int
 LTFAT_NAME(slidgtrealmp_reset)(
-    LTFAT_NAME(slidgtrealmp_state)* p);
+    LTFAT_NAME(slidgtrealmp_state)* p)
+{
+    int status = LTFATERR_FAILED;
+    CHECKNULL(p);
+
+    CHECKSTATUS( LTFAT_NAME(slicing_processor_reset)(p->slistate));
+
+    if (p->pipeLen > 1)
+    {
+        ltfat_int pipeBufLen = p->pipeLen * p->numChans * p->mpstate->L;
+
+        p->pipeSlot = 0;
+        memset(p->pipeW, 0, p->pipeLen * sizeof * p->pipeW);
+        memset(p->pipeIn, 0, pipeBufLen * sizeof * p->pipeIn);
+        memset(p->pipeOut, 0, pipeBufLen * sizeof * p->pipeOut);
+    }
+
+    return LTFATERR_SUCCESS;
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(slidgtrealmp_flush)(
+    LTFAT_NAME(slidgtrealmp_state)* p, ltfat_int chanNo, LTFAT_REAL* out[])
+{
+    int status = LTFATERR_FAILED;
+    ltfat_int delay, chunkLen;
+    LTFAT_REAL* zeros = NULL;
+    const LTFAT_REAL** inptr = NULL;
+    LTFAT_REAL** outptr = NULL;
+    CHECKNULL(p); CHECKNULL(out);
+    CHECK(LTFATERR_BADSIZE, chanNo > 0,
+          "chanNo must be positive (passed %td)", chanNo);
+
+    delay = LTFAT_NAME(slidgtrealmp_getprocdelay)(p);
+    chunkLen = ltfat_imin(delay, p->slistate->block_processor->bufLenMax);
+
+    CHECKMEM( zeros = LTFAT_NAME_REAL(calloc)(chunkLen));
+    CHECKMEM( inptr = LTFAT_NEWARRAY(const LTFAT_REAL*, chanNo));
+    CHECKMEM( outptr = LTFAT_NEWARRAY(LTFAT_REAL*, chanNo));
+
+    for (ltfat_int w = 0; w < chanNo; w++)
+        inptr[w] = zeros;
+
+    // The block processor accepts at most bufLenMax samples per call
+    for (ltfat_int pos = 0; pos < delay; pos += chunkLen)
+    {
+        ltfat_int len = ltfat_imin(chunkLen, delay - pos);
+
+        for (ltfat_int w = 0; w < chanNo; w++)
+            outptr[w] = out[w] + pos;
+
+        CHECKSTATUS(
+            LTFAT_NAME(slicing_processor_execute)(p->slistate, inptr, len, chanNo,
+                    outptr));
+    }
+
+    status = LTFATERR_SUCCESS;
+error:
+    ltfat_safefree(zeros);
+    ltfat_safefree(inptr);
+    ltfat_safefree(outptr);
+    return status;
+}
+
+/* Decomposes one channel of a slice and passes the coefficients either to
+ * the user callback or to the synthesis */
+static void
+LTFAT_NAME(slidgtrealmp_processslice)(
+    LTFAT_NAME(slidgtrealmp_state)* p, LTFAT_NAME(dgtrealmp_state)* mpstate,
+    LTFAT_COMPLEX** cout, const LTFAT_REAL in[], LTFAT_REAL out[])
+{
+    LTFAT_NAME(dgtrealmp_execute_decompose)(mpstate, in, cout);
+
+    if (p->callback)
+        p->callback(p->userdata, mpstate, mpstate->iterstate->c, cout,
+                    (int) p->P, p->M2, p->N, (int) mpstate->L, out);
+    else
+        LTFAT_NAME(dgtrealmp_execute_synthesize)(
+            mpstate, (const LTFAT_COMPLEX**)cout, NULL, out);
+}
 
 int
 LTFAT_NAME(slidgtrealmp_execute_callback)(void* userdata,
@@ -160,25 +320,65 @@ LTFAT_NAME(slidgtrealmp_execute_callback)(void* userdata,
     LTFAT_NAME(slidgtrealmp_state)* p =
         (LTFAT_NAME(slidgtrealmp_state)*) userdata;
 
+    if (p->pipeLen > 1)
+        return LTFAT_NAME(slidgtrealmp_execute_pipelined)(p, in, winLen, W, out);
+
     for (ltfat_int w = 0; w < W; w++)
-    {
-        LTFAT_NAME(dgtrealmp_execute_decompose)(
-            p->mpstate, in + w * winLen, p->couttmp);
+        LTFAT_NAME(slidgtrealmp_processslice)(p, p->mpstate, p->couttmp,
+                                              in + w * winLen, out + w * winLen);
 
-        if(p->callback)
-        {
-            /* p->callback(p->userdata, p->mpstate, p->mpstate->iterstate->c, */
-            /*             p->couttmp, p->mpstate->P, p->mpstate->M2, p->mpstate->N, */
-            /*             p->mpstate->L, out + w * winLen); */
-        }
-        else
-        {
-            LTFAT_NAME(dgtrealmp_execute_synthesize)(
-                p->mpstate, (const LTFAT_COMPLEX**)p->couttmp, NULL, out + w * winLen);
-        }
+    return  0;
+}
+
+/* The slices are collected in slots and decomposed concurrently once all
+ * slots are filled. The output of a slice is returned together with the
+ * input of the slice pipeLen - 1 positions later, the taper overlap-add in
+ * the slicing processor then works exactly as in the serial mode. */
+int
+LTFAT_NAME(slidgtrealmp_execute_pipelined)(
+    LTFAT_NAME(slidgtrealmp_state)* p, const LTFAT_REAL in[], int winLen,
+    int W, LTFAT_REAL out[])
+{
+    ltfat_int slot = p->pipeSlot;
+    ltfat_int outSlot = (slot + 1) % p->pipeLen;
+    ltfat_int slotLen = p->numChans * winLen;
+    ltfat_int outW;
 
+    memcpy(p->pipeIn + slot * slotLen, in, W * winLen * sizeof * in);
+    p->pipeW[slot] = W;
+
+    if (slot == p->pipeLen - 1)
+    {
+#ifdef _OPENMP
+        int nthreads = ltfat_usablethreads((int) p->pipeLen);
+        #pragma omp parallel for num_threads(nthreads) schedule(dynamic, 1)
+#endif
+        for (ltfat_int s = 0; s < p->pipeLen; s++)
+            for (ltfat_int w = 0; w < p->pipeW[s]; w++)
+                LTFAT_NAME(slidgtrealmp_processslice)(
+                    p, p->pipeStates[s], p->pipeCout[s],
+                    p->pipeIn + s * slotLen + w * winLen,
+                    p->pipeOut + s * slotLen + w * winLen);
     }
-    return  0;
+
+    // Slots which were not decomposed yet hold zeros
+    outW = ltfat_imin(W, p->pipeW[outSlot]);
+    memcpy(out, p->pipeOut + outSlot * slotLen, outW * winLen * sizeof * out);
+    memset(out + outW * winLen, 0, (W - outW) * winLen * sizeof * out);
+
+    p->pipeSlot = outSlot;
+    return 0;
+}
+
+ltfat_int
+LTFAT_NAME(slidgtrealmp_getpipedelay)( LTFAT_NAME(slidgtrealmp_state)* p)
+{
+    const LTFAT_NAME(slicing_processor_state)* sli = p->slistate;
+
+    if (p->pipeLen <= 1) return 0;
+
+    return (p->pipeLen - 1) *
+           (sli->winLen - sli->zpadLen - sli->taperLen / 2);
 }
 
 LTFAT_API int
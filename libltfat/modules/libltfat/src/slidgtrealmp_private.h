@@ -14,6 +14,17 @@ struct LTFAT_NAME(slidgtrealmp_state)
     ltfat_int P;
     void* userdata;
     LTFAT_NAME(slidgtrealmp_processor_callback)* callback;
+    int* M2;               // Sizes passed to the callback
+    int* N;
+    // Pipelined mode. Slot 0 uses mpstate and couttmp.
+    ltfat_int pipeLen;     // Number of slices decomposed concurrently
+    ltfat_int pipeSlot;    // Slot of the next slice
+    ltfat_int numChans;
+    LTFAT_NAME(dgtrealmp_state)** pipeStates;
+    LTFAT_COMPLEX*** pipeCout;
+    LTFAT_REAL* pipeIn;    // pipeLen x numChans slices
+    LTFAT_REAL* pipeOut;
+    int* pipeW;            // Number of channels in each slot
 };
 
 
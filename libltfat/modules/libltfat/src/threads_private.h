@@ -0,0 +1,32 @@
+#ifndef _ltfat_threads_private_h
+#define _ltfat_threads_private_h
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/* Index of the calling thread in the enclosing parallel region */
+static inline int
+ltfat_threadid(void)
+{
+#ifdef _OPENMP
+    return omp_get_thread_num();
+#else
+    return 0;
+#endif
+}
+
+/* Number of threads which will actually run. Without OpenMP everything
+ * runs in the calling thread. */
+static inline int
+ltfat_usablethreads(int nthreads)
+{
+#ifdef _OPENMP
+    return nthreads > 0 ? nthreads : 1;
+#else
+    (void) nthreads;
+    return 1;
+#endif
+}
+
+#endif
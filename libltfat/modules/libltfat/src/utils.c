@@ -245,6 +245,48 @@ error:
 }
 
 
+LTFAT_API int
+LTFAT_NAME(complex2planar_array)(const LTFAT_COMPLEX* in, ltfat_int L,
+                                 LTFAT_REAL* re, LTFAT_REAL* im)
+{
+    const LTFAT_REAL (*inTmp)[2];
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(in); CHECKNULL(re); CHECKNULL(im);
+    CHECK(LTFATERR_BADSIZE, L > 0, "L must be positive");
+
+    inTmp = (const LTFAT_REAL(*)[2]) in;
+
+    for (ltfat_int ii = 0; ii < L; ii++)
+    {
+        re[ii] = inTmp[ii][0];
+        im[ii] = inTmp[ii][1];
+    }
+
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(planar2complex_array)(const LTFAT_REAL* re, const LTFAT_REAL* im,
+                                 ltfat_int L, LTFAT_COMPLEX* out)
+{
+    LTFAT_REAL (*outTmp)[2];
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(re); CHECKNULL(im); CHECKNULL(out);
+    CHECK(LTFATERR_BADSIZE, L > 0, "L must be positive");
+
+    outTmp = (LTFAT_REAL(*)[2]) out;
+
+    for (ltfat_int ii = 0; ii < L; ii++)
+    {
+        outTmp[ii][0] = re[ii];
+        outTmp[ii][1] = im[ii];
+    }
+
+error:
+    return status;
+}
+
 LTFAT_API int
 LTFAT_NAME_COMPLEX(dgtreal2dgt)(const LTFAT_COMPLEX* cdgtreal, ltfat_int M,
                                 ltfat_int N, LTFAT_COMPLEX* cdgt)
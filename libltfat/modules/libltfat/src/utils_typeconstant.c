@@ -0,0 +1,25 @@
+#if !defined(_WIN32) && !defined(__WIN32__)
+// clock_gettime is POSIX, but we compile with -std=c99
+#  ifndef _POSIX_C_SOURCE
+#    define _POSIX_C_SOURCE 199309L
+#  endif
+#  include <time.h>
+#else
+#  include <windows.h>
+#endif
+#include "ltfat.h"
+
+LTFAT_API long long
+ltfat_monotonic_ns(void)
+{
+#if defined(_WIN32) || defined(__WIN32__)
+    LARGE_INTEGER count, freq;
+    QueryPerformanceCounter(&count);
+    QueryPerformanceFrequency(&freq);
+    return (long long) ( ((double) count.QuadPart) * 1e9 / freq.QuadPart );
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((long long) ts.tv_sec) * 1000000000LL + (long long) ts.tv_nsec;
+#endif
+}
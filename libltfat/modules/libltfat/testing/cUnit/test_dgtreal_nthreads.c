@@ -0,0 +1,29 @@
+ltfat_int  L = 480, gl = 48, a = 12, M = 48;
+ltfat_int cl = (M / 2 + 1) * (L / a);
+ltfat_dgt_hint hint[] = { ltfat_dgt_long, ltfat_dgt_fb };
+
+ltfat_dgt_params* params = ltfat_dgt_params_allocdef();
+LTFAT_REAL* g = LTFAT_NAME_REAL(malloc)(gl);
+LTFAT_REAL* f = LTFAT_NAME_REAL(calloc)(L);
+LTFAT_COMPLEX* c = LTFAT_NAME_COMPLEX(malloc)(cl);
+LTFAT_NAME(firwin)(LTFAT_HANN, gl, g);
+ltfat_dgt_setpar_nthreads(params, 2);
+
+/* The planner setting of the caller must survive a threaded init */
+LTFAT_NAME_REAL(fft_plan_with_nthreads)(3);
+
+for (unsigned int hId = 0; hId < ARRAYLEN(hint); hId++)
+{
+    LTFAT_NAME(dgtreal_plan)* plan = NULL;
+    ltfat_dgt_setpar_hint(params, hint[hId]);
+
+    mu_assert( LTFAT_NAME(dgtreal_init)(g, gl, L, 1, a, M, f, c, params, &plan) ==
+               LTFATERR_SUCCESS, "NTHREADS init hint=%d", (int) hint[hId]);
+    mu_assert( LTFAT_NAME_REAL(fft_planner_nthreads)() == 3,
+               "NTHREADS planner restored hint=%d", (int) hint[hId]);
+    LTFAT_NAME(dgtreal_done)(&plan);
+}
+
+LTFAT_NAME_REAL(fft_plan_with_nthreads)(1);
+ltfat_dgt_params_free(params);
+LTFAT_SAFEFREEALL(g, f, c);
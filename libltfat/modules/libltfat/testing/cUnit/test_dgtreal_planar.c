@@ -0,0 +1,50 @@
+ltfat_int  L = 480, gl = 48, a = 12, M = 48;
+ltfat_int  W[] = { 1, 3 };
+ltfat_dgt_hint hint[] = { ltfat_dgt_fb, ltfat_dgt_long };
+
+for (unsigned int hId = 0; hId < ARRAYLEN(hint); hId++)
+{
+    for (unsigned int wId = 0; wId < ARRAYLEN(W); wId++)
+    {
+        ltfat_int cl = (M / 2 + 1) * (L / a) * W[wId];
+        LTFAT_NAME(dgtreal_plan)* plan = NULL;
+        ltfat_dgt_params* params = ltfat_dgt_params_allocdef();
+        LTFAT_REAL* g = LTFAT_NAME_REAL(malloc)(gl);
+        LTFAT_REAL* f = LTFAT_NAME_REAL(malloc)(L * W[wId]);
+        LTFAT_REAL* fout = LTFAT_NAME_REAL(malloc)(L * W[wId]);
+        LTFAT_REAL* fplanar = LTFAT_NAME_REAL(malloc)(L * W[wId]);
+        LTFAT_REAL* cr = LTFAT_NAME_REAL(malloc)(cl);
+        LTFAT_REAL* ci = LTFAT_NAME_REAL(malloc)(cl);
+        LTFAT_REAL* cr2 = LTFAT_NAME_REAL(malloc)(cl);
+        LTFAT_REAL* ci2 = LTFAT_NAME_REAL(malloc)(cl);
+        LTFAT_COMPLEX* c = LTFAT_NAME_COMPLEX(malloc)(cl);
+
+        ltfat_dgt_setpar_hint(params, hint[hId]);
+        LTFAT_NAME(firwin)(LTFAT_HANN, gl, g);
+
+        mu_assert( LTFAT_NAME(dgtreal_init)(g, gl, L, W[wId], a, M, f, c, params,
+                                            &plan) == LTFATERR_SUCCESS,
+                   "PLANAR init hint=%d W=%d", (int) hint[hId], (int) W[wId]);
+
+        TEST_NAME(fillRand)(f, L * W[wId]);
+
+        /* The planar layout must hold exactly the interleaved coefficients */
+        LTFAT_NAME(dgtreal_execute_ana_newarray)(plan, f, c);
+        LTFAT_NAME(complex2planar_array)(c, cl, cr, ci);
+        mu_assert( LTFAT_NAME(dgtreal_execute_ana_planar)(plan, f, cr2, ci2) ==
+                   LTFATERR_SUCCESS &&
+                   memcmp(cr, cr2, cl * sizeof * cr) == 0 &&
+                   memcmp(ci, ci2, cl * sizeof * ci) == 0,
+                   "PLANAR analysis");
+
+        LTFAT_NAME(dgtreal_execute_syn_newarray)(plan, c, fout);
+        mu_assert( LTFAT_NAME(dgtreal_execute_syn_planar)(plan, cr, ci, fplanar) ==
+                   LTFATERR_SUCCESS &&
+                   memcmp(fout, fplanar, L * W[wId] * sizeof * fout) == 0,
+                   "PLANAR synthesis");
+
+        LTFAT_NAME(dgtreal_done)(&plan);
+        ltfat_dgt_params_free(params);
+        LTFAT_SAFEFREEALL(g, f, fout, fplanar, cr, ci, cr2, ci2, c);
+    }
+}
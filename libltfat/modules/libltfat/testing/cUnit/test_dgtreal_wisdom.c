@@ -0,0 +1,62 @@
+ltfat_int  L = 480, gl = 48, a = 12, M = 48;
+ltfat_int cl = (M / 2 + 1) * (L / a);
+const char* fname = "test_dgtreal_wisdom.txt";
+const char* transform = sizeof(LTFAT_REAL) == sizeof(double) ? "dgtreal_d" : "dgtreal_s";
+double tol = sizeof(LTFAT_REAL) == sizeof(double) ? 1e-10 : 1e-4;
+char line[256];
+int stalefound = 0;
+
+LTFAT_NAME(dgtreal_plan)* plan = NULL;
+LTFAT_NAME(dgtreal_plan)* planlong = NULL;
+ltfat_dgt_params* params = ltfat_dgt_params_allocdef();
+LTFAT_REAL* g = LTFAT_NAME_REAL(malloc)(gl);
+LTFAT_REAL* f = LTFAT_NAME_REAL(malloc)(L);
+LTFAT_COMPLEX* c = LTFAT_NAME_COMPLEX(malloc)(cl);
+LTFAT_COMPLEX* clong = LTFAT_NAME_COMPLEX(malloc)(cl);
+FILE* fp = NULL;
+
+LTFAT_NAME(firwin)(LTFAT_HANN, gl, g);
+TEST_NAME(fillRand)(f, L);
+ltfat_dgt_setpar_phaseconv(params, LTFAT_FREQINV);
+ltfat_dgt_setpar_nthreads(params, 1);
+
+/* OLA cannot be used for the synthesis and the signal is too short for
+ * the OLA analysis */
+fp = fopen(fname, "w");
+mu_assert( fp != NULL, "WISDOM cannot write %s", fname);
+fprintf(fp, "%s %d %d %d %d %d %d %d %d ola ola\n", transform, (int) L, 1,
+        (int) a, (int) M, (int) gl, (int) gl, (int) LTFAT_FREQINV, 1);
+fclose(fp);
+
+ltfat_dgt_wisdom_forget();
+mu_assert( ltfat_dgt_wisdom_import(fname) == LTFATERR_SUCCESS, "WISDOM import");
+
+ltfat_dgt_setpar_hint(params, ltfat_dgt_autotune);
+mu_assert( LTFAT_NAME(dgtreal_init)(g, gl, L, 1, a, M, f, c, params, &plan) ==
+           LTFATERR_SUCCESS, "WISDOM init with a stale entry");
+
+ltfat_dgt_setpar_hint(params, ltfat_dgt_long);
+LTFAT_NAME(dgtreal_init)(g, gl, L, 1, a, M, f, clong, params, &planlong);
+
+LTFAT_NAME(dgtreal_execute_ana_newarray)(plan, f, c);
+LTFAT_NAME(dgtreal_execute_ana_newarray)(planlong, f, clong);
+LTFAT_REAL maxdiff = 0;
+for (ltfat_int ii = 0; ii < cl; ii++)
+    if (ltfat_abs(c[ii] - clong[ii]) > maxdiff) maxdiff = ltfat_abs(c[ii] - clong[ii]);
+mu_assert( maxdiff < tol, "WISDOM transform after a stale entry");
+
+/* The stale entry was replaced by the new timing */
+mu_assert( ltfat_dgt_wisdom_export(fname) == LTFATERR_SUCCESS, "WISDOM export");
+fp = fopen(fname, "r");
+mu_assert( fp != NULL, "WISDOM cannot read %s", fname);
+while (fgets(line, sizeof line, fp))
+    stalefound = stalefound || strstr(line, " ola ola") != NULL;
+fclose(fp);
+mu_assert( !stalefound, "WISDOM stale entry replaced");
+
+remove(fname);
+ltfat_dgt_wisdom_forget();
+LTFAT_NAME(dgtreal_done)(&plan);
+LTFAT_NAME(dgtreal_done)(&planlong);
+ltfat_dgt_params_free(params);
+LTFAT_SAFEFREEALL(g, f, c, clong);
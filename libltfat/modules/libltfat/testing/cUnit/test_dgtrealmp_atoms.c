@@ -0,0 +1,85 @@
+ltfat_int  gl[] = { 256, 64 };
+ltfat_int   a[] = {  64, 16 };
+ltfat_int   M[] = { 256, 64 };
+ltfat_dgtmp_alg alg[] = { ltfat_dgtmp_alg_mp, ltfat_dgtmp_alg_loccyclicmp };
+
+for (unsigned int algId = 0; algId < ARRAYLEN(alg); algId++)
+{
+    LTFAT_NAME(dgtrealmp_parbuf)* pb = NULL;
+    LTFAT_NAME(dgtrealmp_state)* plan = NULL;
+    LTFAT_NAME(dgtrealmp_parbuf_init)(&pb);
+    for (unsigned int k = 0; k < ARRAYLEN(gl); k++)
+        LTFAT_NAME(dgtrealmp_parbuf_add_firwin)(pb, LTFAT_BLACKMAN, gl[k], a[k], M[k]);
+
+    ltfat_int L = LTFAT_NAME(dgtrealmp_getparbuf_siglen)(pb, 4096);
+    size_t maxatoms = 300;
+    LTFAT_NAME(dgtrealmp_setparbuf_alg)(pb, alg[algId]);
+    LTFAT_NAME(dgtrealmp_setparbuf_maxatoms)(pb, maxatoms);
+    LTFAT_NAME(dgtrealmp_setparbuf_maxit)(pb, 4 * maxatoms);
+    LTFAT_NAME(dgtrealmp_setparbuf_errtoldb)(pb, -60);
+
+    LTFAT_REAL* f = LTFAT_NAME_REAL(malloc)(L);
+    LTFAT_REAL* fdense = LTFAT_NAME_REAL(malloc)(L);
+    LTFAT_REAL* fatoms = LTFAT_NAME_REAL(malloc)(L);
+    LTFAT_COMPLEX* c[ARRAYLEN(gl)];
+    LTFAT_NAME(dgtrealmp_atom)* atoms = malloc(2 * maxatoms * sizeof * atoms);
+    LTFAT_NAME(dgtrealmp_atom)* atoms2 = malloc(2 * maxatoms * sizeof * atoms);
+    size_t atomsNo = 0, atomsNo2 = 0, unpackedNo = 0;
+    TEST_NAME(fillRand)(f, L);
+
+    for (unsigned int k = 0; k < ARRAYLEN(gl); k++)
+        c[k] = LTFAT_NAME_COMPLEX(malloc)(LTFAT_NAME(dgtrealmp_getparbuf_coeflen)(pb, L, k));
+
+    LTFAT_NAME(dgtrealmp_init)(pb, L, &plan);
+
+    mu_assert( LTFAT_NAME(dgtrealmp_execute_decompose_atoms)(
+                   plan, f, atoms, 2 * maxatoms, &atomsNo) >= 0 &&
+               atomsNo > 0 && atomsNo <= maxatoms,
+               "ATOMS alg=%d decompose %d atoms", (int) alg[algId], (int) atomsNo);
+
+    /* The list must match the nonzero coefficients of a dense decomposition */
+    mu_assert( LTFAT_NAME(dgtrealmp_execute_decompose)(plan, f, c) >= 0,
+               "ATOMS dense decompose");
+    LTFAT_NAME(dgtrealmp_coefs2atoms)(plan, (const LTFAT_COMPLEX**) c,
+                                      atoms2, 2 * maxatoms, &atomsNo2);
+    int same = atomsNo == atomsNo2;
+    for (size_t ii = 0; same && ii < atomsNo; ii++)
+        same = atoms[ii].w == atoms2[ii].w && atoms[ii].m == atoms2[ii].m &&
+               atoms[ii].n == atoms2[ii].n && atoms[ii].c == atoms2[ii].c;
+    mu_assert( same, "ATOMS list equals dense coefficients");
+
+    mu_assert( LTFAT_NAME(dgtrealmp_execute_decompose_atoms)(
+                   plan, f, atoms2, atomsNo - 1, &atomsNo2) == LTFATERR_BADREQSIZE,
+               "ATOMS short output rejected");
+
+    /* pack -> unpack -> synthesize equals the dense synthesis exactly */
+    size_t bufLen = LTFAT_NAME(dgtrealmp_atoms_packedlen)(atomsNo);
+    unsigned char* buf = malloc(bufLen);
+    mu_assert( LTFAT_NAME(dgtrealmp_atoms_pack)(atoms, atomsNo, buf) ==
+               LTFATERR_SUCCESS, "ATOMS pack");
+    mu_assert( LTFAT_NAME(dgtrealmp_atoms_unpack)(buf, bufLen, atoms2, 2 * maxatoms,
+               &unpackedNo) == LTFATERR_SUCCESS && unpackedNo == atomsNo,
+               "ATOMS unpack");
+
+    LTFAT_NAME(dgtrealmp_execute_synthesize)(plan, (const LTFAT_COMPLEX**) c, NULL,
+            fdense);
+    mu_assert( LTFAT_NAME(dgtrealmp_execute_synthesize_atoms)(plan, atoms2,
+               unpackedNo, fatoms) == LTFATERR_SUCCESS &&
+               memcmp(fdense, fatoms, L * sizeof * fdense) == 0,
+               "ATOMS synthesis from unpacked atoms equals dense synthesis");
+
+    mu_assert( LTFAT_NAME(dgtrealmp_atoms_unpack)(buf, bufLen - 1, atoms2,
+               2 * maxatoms, &unpackedNo) == LTFATERR_BADSIZE,
+               "ATOMS truncated stream rejected");
+
+    free(buf);
+    free(atoms);
+    free(atoms2);
+    for (unsigned int k = 0; k < ARRAYLEN(gl); k++)
+        ltfat_free(c[k]);
+    ltfat_free(f);
+    ltfat_free(fdense);
+    ltfat_free(fatoms);
+    LTFAT_NAME(dgtrealmp_done)(&plan);
+    LTFAT_NAME(dgtrealmp_parbuf_done)(&pb);
+}
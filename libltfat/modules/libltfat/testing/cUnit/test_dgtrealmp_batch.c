@@ -0,0 +1,56 @@
+ltfat_int  gl[] = { 256, 64 };
+ltfat_int   a[] = {  64, 16 };
+ltfat_int   M[] = { 256, 64 };
+size_t  itnos[] = { 1, 2, 3, 5, 7, 8, 13 };
+
+LTFAT_NAME(dgtrealmp_parbuf)* pb = NULL;
+LTFAT_NAME(dgtrealmp_state)* plan = NULL;
+LTFAT_NAME(dgtrealmp_parbuf_init)(&pb);
+for (unsigned int k = 0; k < ARRAYLEN(gl); k++)
+    LTFAT_NAME(dgtrealmp_parbuf_add_firwin)(pb, LTFAT_BLACKMAN, gl[k], a[k], M[k]);
+
+ltfat_int L = LTFAT_NAME(dgtrealmp_getparbuf_siglen)(pb, 4096);
+LTFAT_NAME(dgtrealmp_setparbuf_batchatoms)(pb, 8);
+LTFAT_NAME(dgtrealmp_setparbuf_maxatoms)(pb, L);
+LTFAT_NAME(dgtrealmp_setparbuf_maxit)(pb, L);
+LTFAT_NAME(dgtrealmp_setparbuf_errtoldb)(pb, -200);
+
+LTFAT_REAL* f = LTFAT_NAME_REAL(malloc)(L);
+LTFAT_COMPLEX* c[ARRAYLEN(gl)];
+size_t iters = 0, itersprev = 0;
+TEST_NAME(fillRand)(f, L);
+
+for (unsigned int k = 0; k < ARRAYLEN(gl); k++)
+    c[k] = LTFAT_NAME_COMPLEX(calloc)(LTFAT_NAME(dgtrealmp_getparbuf_coeflen)(pb, L, k));
+
+mu_assert( LTFAT_NAME(dgtrealmp_init)(pb, L, &plan) == LTFATERR_SUCCESS,
+           "BATCH init");
+mu_assert( LTFAT_NAME(dgtrealmp_reset)(plan, f) == LTFATERR_SUCCESS,
+           "BATCH reset");
+
+/* A batch must not run past the requested number of iterations */
+for (unsigned int iId = 0; iId < ARRAYLEN(itnos); iId++)
+{
+    mu_assert( LTFAT_NAME(dgtrealmp_execute_niters)(plan, itnos[iId], c) ==
+               LTFAT_DGTREALMP_STATUS_CANCONTINUE, "BATCH itno=%d", (int) itnos[iId]);
+
+    LTFAT_NAME(dgtrealmp_get_numiters)(plan, &iters);
+    mu_assert( iters - itersprev == itnos[iId], "BATCH itno=%d ran %d iterations",
+               (int) itnos[iId], (int) (iters - itersprev));
+    itersprev = iters;
+}
+
+/* Nor past maxit */
+LTFAT_NAME(dgtrealmp_done)(&plan);
+LTFAT_NAME(dgtrealmp_setparbuf_maxit)(pb, 37);
+LTFAT_NAME(dgtrealmp_init)(pb, L, &plan);
+mu_assert( LTFAT_NAME(dgtrealmp_execute_decompose)(plan, f, c) ==
+           LTFAT_DGTREALMP_STATUS_MAXITER, "BATCH maxit reached");
+LTFAT_NAME(dgtrealmp_get_numiters)(plan, &iters);
+mu_assert( iters == 37, "BATCH maxit=37 ran %d iterations", (int) iters);
+
+LTFAT_NAME(dgtrealmp_done)(&plan);
+LTFAT_NAME(dgtrealmp_parbuf_done)(&pb);
+for (unsigned int k = 0; k < ARRAYLEN(gl); k++)
+    ltfat_free(c[k]);
+ltfat_free(f);
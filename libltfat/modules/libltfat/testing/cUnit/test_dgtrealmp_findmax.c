@@ -0,0 +1,74 @@
+/* Windows as long as the signal make every update reach all columns, i.e.
+ * the dirty range of the time maxtree spans N columns or more */
+ltfat_int  gl[] = { 512, 32 };
+ltfat_int   a[] = {  16,  8 };
+ltfat_int   M[] = {  64, 32 };
+ltfat_int itno = 100;
+
+LTFAT_NAME(dgtrealmp_parbuf)* pb = NULL;
+LTFAT_NAME(dgtrealmp_state)* plan = NULL;
+LTFAT_NAME(dgtrealmp_parbuf_init)(&pb);
+for (unsigned int k = 0; k < ARRAYLEN(gl); k++)
+    LTFAT_NAME(dgtrealmp_parbuf_add_firwin)(pb, LTFAT_BLACKMAN, gl[k], a[k], M[k]);
+
+ltfat_int L = LTFAT_NAME(dgtrealmp_getparbuf_siglen)(pb, 512);
+LTFAT_NAME(dgtrealmp_setparbuf_maxatoms)(pb, 10 * itno);
+LTFAT_NAME(dgtrealmp_setparbuf_maxit)(pb, 10 * itno);
+LTFAT_NAME(dgtrealmp_setparbuf_errtoldb)(pb, -200);
+
+LTFAT_REAL* f = LTFAT_NAME_REAL(malloc)(L);
+LTFAT_COMPLEX* c[ARRAYLEN(gl)];
+LTFAT_COMPLEX* cprev[ARRAYLEN(gl)];
+LTFAT_COMPLEX* cres = NULL;
+ptrdiff_t clen = 0;
+TEST_NAME(fillRand)(f, L);
+
+for (unsigned int k = 0; k < ARRAYLEN(gl); k++)
+{
+    ptrdiff_t ck = LTFAT_NAME(dgtrealmp_getparbuf_coeflen)(pb, L, k);
+    c[k] = LTFAT_NAME_COMPLEX(calloc)(ck);
+    cprev[k] = LTFAT_NAME_COMPLEX(calloc)(ck);
+    clen += ck;
+}
+cres = LTFAT_NAME_COMPLEX(malloc)(clen);
+
+mu_assert( LTFAT_NAME(dgtrealmp_init)(pb, L, &plan) == LTFATERR_SUCCESS,
+           "FINDMAX init");
+mu_assert( LTFAT_NAME(dgtrealmp_reset)(plan, f) == LTFATERR_SUCCESS,
+           "FINDMAX reset");
+
+/* Plain MP must pick the largest residual coefficient in every iteration */
+for (ltfat_int it = 0; it < itno; it++)
+{
+    LTFAT_REAL maxres = 0, selres = -1;
+
+    LTFAT_NAME(dgtrealmp_getresidualcoef_compact)(plan, cres);
+    for (ptrdiff_t ii = 0; ii < clen; ii++)
+        if (ltfat_abs(cres[ii]) > maxres) maxres = ltfat_abs(cres[ii]);
+
+    mu_assert( LTFAT_NAME(dgtrealmp_execute_niters)(plan, 1, c) ==
+               LTFAT_DGTREALMP_STATUS_CANCONTINUE, "FINDMAX iteration %d", (int) it);
+
+    for (unsigned int k = 0, accum = 0; k < ARRAYLEN(gl); k++)
+    {
+        ptrdiff_t ck = LTFAT_NAME(dgtrealmp_getparbuf_coeflen)(pb, L, k);
+        for (ptrdiff_t ii = 0; ii < ck; ii++)
+            if (c[k][ii] != cprev[k][ii])
+                selres = ltfat_abs(cres[accum + ii]);
+        memcpy(cprev[k], c[k], ck * sizeof * c[k]);
+        accum += ck;
+    }
+
+    mu_assert( selres == maxres, "FINDMAX iteration %d selected %.3e, max is %.3e",
+               (int) it, (double) selres, (double) maxres);
+}
+
+LTFAT_NAME(dgtrealmp_done)(&plan);
+LTFAT_NAME(dgtrealmp_parbuf_done)(&pb);
+for (unsigned int k = 0; k < ARRAYLEN(gl); k++)
+{
+    ltfat_free(c[k]);
+    ltfat_free(cprev[k]);
+}
+ltfat_free(cres);
+ltfat_free(f);
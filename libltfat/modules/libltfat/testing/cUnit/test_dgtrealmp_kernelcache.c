@@ -0,0 +1,118 @@
+ltfat_int L = 4096;
+const char* fname = "test_dgtrealmp_kernelcache.bin";
+const char* fname2 = "test_dgtrealmp_kernelcache2.bin";
+/* kNo, kSkip, Mstep and astep of the first entry */
+ltfat_int damaged[] = { 12, 13, 14, 15 };
+ltfat_int damagedval[] = { 1 << 30, 0, -1, 1 << 30 };
+size_t hdrlen = 32;
+
+LTFAT_NAME(dgtrealmp_parbuf)* pb = NULL;
+LTFAT_NAME(dgtrealmp_state)* plan = NULL;
+LTFAT_REAL* f = LTFAT_NAME_REAL(malloc)(L);
+LTFAT_REAL* fout = LTFAT_NAME_REAL(malloc)(L);
+TEST_NAME(fillRand)(f, L);
+
+LTFAT_NAME(dgtrealmp_parbuf_init)(&pb);
+LTFAT_NAME(dgtrealmp_parbuf_add_firwin)(pb, LTFAT_BLACKMAN, 256, 64, 256);
+LTFAT_NAME(dgtrealmp_parbuf_add_firwin)(pb, LTFAT_BLACKMAN, 64, 16, 64);
+LTFAT_NAME(dgtrealmp_setparbuf_maxatoms)(pb, 400);
+LTFAT_NAME(dgtrealmp_setparbuf_kernrelthr)(pb, 1e-4);
+
+ptrdiff_t clen = 0;
+for (ltfat_int k = 0; k < LTFAT_NAME(dgtrealmp_getparbuf_dictno)(pb); k++)
+    clen += LTFAT_NAME(dgtrealmp_getparbuf_coeflen)(pb, L, k);
+LTFAT_COMPLEX* c1 = LTFAT_NAME_COMPLEX(calloc)(clen);
+LTFAT_COMPLEX* c2 = LTFAT_NAME_COMPLEX(calloc)(clen);
+
+/* Decomposition with freshly computed kernels */
+LTFAT_NAME(dgtrealmp_kernel_cache_clear)();
+mu_assert( LTFAT_NAME(dgtrealmp_init)(pb, L, &plan) == LTFATERR_SUCCESS,
+           "KERNELCACHE init");
+mu_assert( LTFAT_NAME(dgtrealmp_execute_compact)(plan, f, c1, fout) >= 0,
+           "KERNELCACHE decompose");
+LTFAT_NAME(dgtrealmp_done)(&plan);
+
+mu_assert( LTFAT_NAME(dgtrealmp_kernel_cache_export)(fname) == LTFATERR_SUCCESS,
+           "KERNELCACHE export");
+
+/* The same decomposition with the kernels read back from the file */
+LTFAT_NAME(dgtrealmp_kernel_cache_clear)();
+mu_assert( LTFAT_NAME(dgtrealmp_kernel_cache_import)(fname) == LTFATERR_SUCCESS,
+           "KERNELCACHE import");
+mu_assert( LTFAT_NAME(dgtrealmp_kernel_cache_export)(fname2) == LTFATERR_SUCCESS,
+           "KERNELCACHE export imported");
+mu_assert( LTFAT_NAME(dgtrealmp_init)(pb, L, &plan) == LTFATERR_SUCCESS,
+           "KERNELCACHE init from imported");
+mu_assert( LTFAT_NAME(dgtrealmp_execute_compact)(plan, f, c2, fout) >= 0,
+           "KERNELCACHE decompose from imported");
+LTFAT_NAME(dgtrealmp_done)(&plan);
+
+mu_assert( memcmp(c1, c2, clen * sizeof * c1) == 0,
+           "KERNELCACHE decomposition bit-identical after export and import");
+
+FILE* fp = fopen(fname, "rb");
+fseek(fp, 0, SEEK_END);
+long flen = ftell(fp);
+rewind(fp);
+unsigned char* buf = malloc(flen);
+unsigned char* buf2 = malloc(flen);
+size_t readlen = fread(buf, 1, flen, fp);
+fclose(fp);
+
+fp = fopen(fname2, "rb");
+readlen += fread(buf2, 1, flen, fp);
+mu_assert( readlen == 2 * (size_t) flen && fgetc(fp) == EOF &&
+           memcmp(buf, buf2, flen) == 0,
+           "KERNELCACHE re-exported file identical");
+fclose(fp);
+
+/* Damaged lattice fields must be rejected before they are used */
+for (unsigned int dId = 0; dId < ARRAYLEN(damaged); dId++)
+{
+    memcpy(buf2, buf, flen);
+    memcpy(buf2 + hdrlen + damaged[dId] * sizeof(ltfat_int), &damagedval[dId],
+           sizeof(ltfat_int));
+    fp = fopen(fname2, "wb");
+    fwrite(buf2, 1, flen, fp);
+    fclose(fp);
+
+    mu_assert( LTFAT_NAME(dgtrealmp_kernel_cache_import)(fname2) == LTFATERR_BADARG,
+               "KERNELCACHE damaged dims[%d]=%d rejected", (int) damaged[dId],
+               (int) damagedval[dId]);
+}
+
+/* Column range of the first entry reaching past the kernel height */
+{
+    ltfat_int dims[18];
+    memcpy(dims, buf + hdrlen, sizeof dims);
+    size_t rangeoff = hdrlen + sizeof dims + 2 * sizeof(LTFAT_REAL) + 2 * sizeof(double) +
+                      (dims[0] + dims[1]) * sizeof(LTFAT_REAL) +
+                      dims[8] * dims[9] * sizeof(LTFAT_COMPLEX);
+
+    memcpy(buf2, buf, flen);
+    memcpy(buf2 + rangeoff, &dims[8], sizeof(ltfat_int));
+    fp = fopen(fname2, "wb");
+    fwrite(buf2, 1, flen, fp);
+    fclose(fp);
+
+    mu_assert( LTFAT_NAME(dgtrealmp_kernel_cache_import)(fname2) == LTFATERR_BADARG,
+               "KERNELCACHE damaged range rejected");
+}
+
+/* Truncated file */
+fp = fopen(fname2, "wb");
+fwrite(buf, 1, flen / 2, fp);
+fclose(fp);
+mu_assert( LTFAT_NAME(dgtrealmp_kernel_cache_import)(fname2) == LTFATERR_BADARG,
+           "KERNELCACHE truncated file rejected");
+
+remove(fname);
+remove(fname2);
+free(buf);
+free(buf2);
+LTFAT_NAME(dgtrealmp_kernel_cache_clear)();
+LTFAT_NAME(dgtrealmp_parbuf_done)(&pb);
+ltfat_safefree(c1);
+ltfat_safefree(c2);
+ltfat_free(f);
+ltfat_free(fout);
@@ -0,0 +1,121 @@
+ltfat_int   gl[] = { 256, 64 };
+ltfat_int    a[] = {  64, 16 };
+ltfat_int    M[] = { 256, 64 };
+/* Edits at the start, in the middle, at the end and one reaching all columns */
+ltfat_int start[] = { 0, 1500, 3996, 1000 };
+ltfat_int   len[] = { 100, 300,  100, 2500 };
+ltfat_phaseconvention ptype[] = { LTFAT_TIMEINV, LTFAT_FREQINV };
+/* Relative to the largest coefficient of the signal */
+double tol = sizeof(LTFAT_REAL) == sizeof(double) ? 1e-6 : 1e-3;
+
+for (unsigned int pId = 0; pId < ARRAYLEN(ptype); pId++)
+{
+    LTFAT_NAME(dgtrealmp_parbuf)* pb = NULL;
+    LTFAT_NAME(dgtrealmp_state)* plan = NULL;
+    LTFAT_NAME(dgtrealmp_parbuf_init)(&pb);
+    for (unsigned int k = 0; k < ARRAYLEN(gl); k++)
+        LTFAT_NAME(dgtrealmp_parbuf_add_firwin)(pb, LTFAT_BLACKMAN, gl[k], a[k], M[k]);
+
+    ltfat_int L = LTFAT_NAME(dgtrealmp_getparbuf_siglen)(pb, 4096);
+    LTFAT_NAME(dgtrealmp_setparbuf_phaseconv)(pb, ptype[pId]);
+    LTFAT_NAME(dgtrealmp_setparbuf_kernrelthr)(pb, 1e-8);
+    LTFAT_NAME(dgtrealmp_setparbuf_errtoldb)(pb, -30);
+    LTFAT_NAME(dgtrealmp_setparbuf_maxatoms)(pb, L);
+    LTFAT_NAME(dgtrealmp_setparbuf_maxit)(pb, 2 * L);
+
+    LTFAT_REAL* f = LTFAT_NAME_REAL(malloc)(L);
+    LTFAT_REAL* fout = LTFAT_NAME_REAL(malloc)(L);
+    LTFAT_COMPLEX* c[ARRAYLEN(gl)];
+    LTFAT_COMPLEX* cres[ARRAYLEN(gl)];
+    LTFAT_COMPLEX* cdgt = NULL;
+    ptrdiff_t clen = 0;
+    TEST_NAME(fillRand)(f, L);
+
+    for (unsigned int k = 0; k < ARRAYLEN(gl); k++)
+    {
+        ptrdiff_t ck = LTFAT_NAME(dgtrealmp_getparbuf_coeflen)(pb, L, k);
+        c[k] = LTFAT_NAME_COMPLEX(calloc)(ck);
+        cres[k] = LTFAT_NAME_COMPLEX(malloc)(ck);
+        clen += ck;
+    }
+    cdgt = LTFAT_NAME_COMPLEX(malloc)(clen);
+
+    /* Not enabled */
+    LTFAT_NAME(dgtrealmp_init)(pb, L, &plan);
+    LTFAT_NAME(dgtrealmp_execute_decompose)(plan, f, c);
+    mu_assert( LTFAT_NAME(dgtrealmp_execute_redecompose)(plan, f, 0, 10, c) ==
+               LTFATERR_BADARG, "REDECOMPOSE not enabled rejected");
+    LTFAT_NAME(dgtrealmp_done)(&plan);
+
+    LTFAT_NAME(dgtrealmp_setparbuf_redecompose)(pb, 1);
+    LTFAT_NAME(dgtrealmp_init)(pb, L, &plan);
+    for (unsigned int k = 0; k < ARRAYLEN(gl); k++)
+        memset(c[k], 0, LTFAT_NAME(dgtrealmp_getparbuf_coeflen)(pb, L, k) * sizeof * c[k]);
+
+    mu_assert( LTFAT_NAME(dgtrealmp_execute_decompose)(plan, f, c) >= 0,
+               "REDECOMPOSE decompose");
+
+    LTFAT_REAL maxcf = 0;
+    for (unsigned int k = 0; k < ARRAYLEN(gl); k++)
+    {
+        ptrdiff_t ck = LTFAT_NAME(dgtrealmp_getparbuf_coeflen)(pb, L, k);
+        LTFAT_NAME(dgtreal_execute_ana_newarray)(
+            LTFAT_NAME(dgtrealmp_getdgtrealplan)(plan)[k], f, cres[k]);
+        for (ptrdiff_t ii = 0; ii < ck; ii++)
+            if (ltfat_abs(cres[k][ii]) > maxcf) maxcf = ltfat_abs(cres[k][ii]);
+    }
+
+    for (unsigned int eId = 0; eId < ARRAYLEN(start); eId++)
+    {
+        LTFAT_REAL maxdiff = 0;
+        double errdb = 0;
+
+        TEST_NAME(fillRand)(f + start[eId], len[eId]);
+
+        mu_assert( LTFAT_NAME(dgtrealmp_execute_redecompose)(
+                       plan, f + start[eId], start[eId], len[eId], c) >= 0,
+                   "REDECOMPOSE ptype=%d start=%d len=%d", (int) ptype[pId],
+                   (int) start[eId], (int) len[eId]);
+
+        /* The residual coefficients must match a DGT of the actual residual */
+        LTFAT_NAME(dgtrealmp_execute_synthesize)(plan, (const LTFAT_COMPLEX**) c,
+                NULL, fout);
+        for (ltfat_int l = 0; l < L; l++)
+            fout[l] = f[l] - fout[l];
+
+        for (unsigned int k = 0; k < ARRAYLEN(gl); k++)
+            LTFAT_NAME(dgtreal_execute_ana_newarray)(
+                LTFAT_NAME(dgtrealmp_getdgtrealplan)(plan)[k], fout, cres[k]);
+
+        LTFAT_NAME(dgtrealmp_getresidualcoef_compact)(plan, cdgt);
+
+        for (unsigned int k = 0, accum = 0; k < ARRAYLEN(gl); k++)
+        {
+            ptrdiff_t ck = LTFAT_NAME(dgtrealmp_getparbuf_coeflen)(pb, L, k);
+            for (ptrdiff_t ii = 0; ii < ck; ii++)
+            {
+                LTFAT_REAL d = ltfat_abs(cres[k][ii] - cdgt[accum + ii]);
+                if (d > maxdiff) maxdiff = d;
+            }
+            accum += ck;
+        }
+
+        LTFAT_NAME(dgtrealmp_get_errdb)(plan, &errdb);
+
+        mu_assert( maxdiff <= tol * maxcf && errdb <= -30,
+                   "REDECOMPOSE residual ptype=%d start=%d len=%d maxdiff=%.3e err=%.2f dB",
+                   (int) ptype[pId], (int) start[eId], (int) len[eId],
+                   (double) maxdiff, errdb);
+    }
+
+    LTFAT_NAME(dgtrealmp_done)(&plan);
+    LTFAT_NAME(dgtrealmp_parbuf_done)(&pb);
+    for (unsigned int k = 0; k < ARRAYLEN(gl); k++)
+    {
+        ltfat_free(c[k]);
+        ltfat_free(cres[k]);
+    }
+    ltfat_free(cdgt);
+    ltfat_free(f);
+    ltfat_free(fout);
+}
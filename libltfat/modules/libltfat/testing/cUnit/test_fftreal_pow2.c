@@ -0,0 +1,68 @@
+ltfat_int L[] = { 16, 32, 64, 128, 256, 2048, 8192 };
+double tol = sizeof(LTFAT_REAL) == sizeof(double) ? 1e-10 : 1e-3;
+
+/* The native power-of-two transform must agree with the complex FFT of the
+ * backend. The real-to-complex one is not a reference since it dispatches
+ * the power-of-two lengths to the native transform in the KISS build. */
+for (unsigned int lId = 0; lId < ARRAYLEN(L); lId++)
+{
+    ltfat_int M2 = L[lId] / 2 + 1;
+    LTFAT_NAME(fftreal_pow2_plan)* plan = NULL;
+    LTFAT_REAL* f = LTFAT_NAME_REAL(malloc)(L[lId]);
+    LTFAT_REAL* fpow2 = LTFAT_NAME_REAL(malloc)(L[lId]);
+    LTFAT_COMPLEX* c = LTFAT_NAME_COMPLEX(malloc)(M2);
+    LTFAT_COMPLEX* cpow2 = LTFAT_NAME_COMPLEX(malloc)(M2);
+    LTFAT_COMPLEX* fc = LTFAT_NAME_COMPLEX(malloc)(L[lId]);
+    LTFAT_COMPLEX* cc = LTFAT_NAME_COMPLEX(malloc)(L[lId]);
+    LTFAT_REAL maxdiff = 0, maxabs = 0;
+
+    TEST_NAME(fillRand)(f, L[lId]);
+    TEST_NAME_COMPLEX(fillRand)(c, M2);
+    // The DC and Nyquist bins of a real signal spectrum are real
+    c[0] = ltfat_real(c[0]);
+    c[M2 - 1] = ltfat_real(c[M2 - 1]);
+
+    mu_assert( LTFAT_NAME(fftreal_pow2_init)(L[lId], &plan) == LTFATERR_SUCCESS,
+               "POW2 init L=%d", (int) L[lId]);
+
+    for (ltfat_int l = 0; l < L[lId]; l++)
+        fc[l] = f[l];
+    LTFAT_NAME(fft)(fc, L[lId], 1, cc);
+    LTFAT_NAME(fftreal_pow2_execute)(plan, f, cpow2);
+
+    for (ltfat_int m = 0; m < M2; m++)
+    {
+        if (ltfat_abs(cc[m] - cpow2[m]) > maxdiff) maxdiff = ltfat_abs(cc[m] - cpow2[m]);
+        if (ltfat_abs(cc[m]) > maxabs) maxabs = ltfat_abs(cc[m]);
+    }
+    mu_assert( maxdiff <= tol * maxabs, "POW2 fftreal L=%d, diff %.3e",
+               (int) L[lId], (double) (maxdiff / maxabs));
+
+    maxdiff = 0; maxabs = 0;
+    for (ltfat_int m = 0; m < M2; m++)
+        cc[m] = c[m];
+    for (ltfat_int m = M2; m < L[lId]; m++)
+        cc[m] = conj(c[L[lId] - m]);
+    LTFAT_NAME(ifft)(cc, L[lId], 1, fc);
+    LTFAT_NAME(ifftreal_pow2_execute)(plan, c, fpow2);
+
+    for (ltfat_int l = 0; l < L[lId]; l++)
+    {
+        if (ltfat_abs(ltfat_real(fc[l]) - fpow2[l]) > maxdiff)
+            maxdiff = ltfat_abs(ltfat_real(fc[l]) - fpow2[l]);
+        if (ltfat_abs(fc[l]) > maxabs) maxabs = ltfat_abs(fc[l]);
+    }
+    mu_assert( maxdiff <= tol * maxabs, "POW2 ifftreal L=%d, diff %.3e",
+               (int) L[lId], (double) (maxdiff / maxabs));
+
+    LTFAT_NAME(fftreal_pow2_done)(&plan);
+    LTFAT_SAFEFREEALL(f, fpow2, c, cpow2, fc, cc);
+}
+
+/* Lengths the native transform does not handle */
+{
+    LTFAT_NAME(fftreal_pow2_plan)* plan = NULL;
+    mu_assert( LTFAT_NAME(fftreal_pow2_init)(96, &plan) == LTFATERR_BADARG &&
+               LTFAT_NAME(fftreal_pow2_init)(LTFAT_FFTREAL_POW2_MINL / 2, &plan) ==
+               LTFATERR_BADARG, "POW2 init rejects unsupported lengths");
+}
@@ -0,0 +1,106 @@
+ltfat_int Mmax = 40;
+/* Growing systems, edits of the last and of an inner row, shrinking and
+ * growing past the allocated size */
+ltfat_int  Msz[] = {  1,  2,  3,  5,  8, 12, 12, 12,  8, 13, 40, 40 };
+ltfat_int edit[] = { -1, -1, -1, -1, -1, -1, 11,  3, -1, -1, -1, 39 };
+double tol = sizeof(LTFAT_REAL) == sizeof(double) ? 1e-10 : 1e-4;
+
+LTFAT_COMPLEX* Afull = LTFAT_NAME_COMPLEX(malloc)(Mmax * Mmax);
+LTFAT_COMPLEX* A = LTFAT_NAME_COMPLEX(malloc)(Mmax * Mmax);
+LTFAT_COMPLEX* Awork = LTFAT_NAME_COMPLEX(malloc)(Mmax * Mmax);
+LTFAT_COMPLEX* b = LTFAT_NAME_COMPLEX(malloc)(Mmax);
+LTFAT_COMPLEX* x = LTFAT_NAME_COMPLEX(malloc)(Mmax);
+LTFAT_COMPLEX* xfresh = LTFAT_NAME_COMPLEX(malloc)(Mmax);
+LTFAT_NAME_COMPLEX(hermsystemsolver_plan)* plan = NULL;
+LTFAT_NAME_COMPLEX(hermsystemsolver_plan)* planfresh = NULL;
+
+/* Hermitian and strictly diagonally dominant, so every leading submatrix is
+ * positive definite and remains so after the edits below */
+TEST_NAME_COMPLEX(fillRand)(Afull, Mmax * Mmax);
+for (ltfat_int i = 0; i < Mmax; i++)
+{
+    Afull[i * Mmax + i] = 2 * Mmax;
+    for (ltfat_int j = 0; j < i; j++)
+        Afull[i * Mmax + j] = conj(Afull[j * Mmax + i]);
+}
+
+mu_assert( LTFAT_NAME_COMPLEX(hermsystemsolver_init)(Mmax, &plan) ==
+           LTFATERR_SUCCESS, "HERMSYSTEMSOLVER init");
+
+for (unsigned int sId = 0; sId < ARRAYLEN(Msz); sId++)
+{
+    ltfat_int M = Msz[sId];
+    LTFAT_REAL maxres = 0, maxb = 0;
+
+    if (edit[sId] >= 0)
+    {
+        ltfat_int r = edit[sId];
+        for (ltfat_int j = 0; j < Mmax; j++)
+        {
+            if (j == r) continue;
+            Afull[j * Mmax + r] = ((LTFAT_REAL) rand()) / RAND_MAX +
+                                  I * ((LTFAT_REAL) rand()) / RAND_MAX;
+            Afull[r * Mmax + j] = conj(Afull[j * Mmax + r]);
+        }
+    }
+
+    for (ltfat_int j = 0; j < M; j++)
+        for (ltfat_int i = 0; i < M; i++)
+            A[j * M + i] = Afull[j * Mmax + i];
+
+    for (ltfat_int i = 0; i < M; i++)
+        b[i] = ((LTFAT_REAL) rand()) / RAND_MAX - I * ((LTFAT_REAL) rand()) / RAND_MAX;
+
+    /* The solver can overwrite A */
+    memcpy(Awork, A, M * M * sizeof * A);
+    memcpy(x, b, M * sizeof * b);
+    mu_assert( LTFAT_NAME_COMPLEX(hermsystemsolver_execute)(plan, Awork, M, x) == 0,
+               "HERMSYSTEMSOLVER M=%d edit=%d", (int) M, (int) edit[sId]);
+
+    for (ltfat_int i = 0; i < M; i++)
+    {
+        LTFAT_COMPLEX res = -b[i];
+        for (ltfat_int j = 0; j < M; j++)
+            res += A[j * M + i] * x[j];
+        if (ltfat_abs(res) > maxres) maxres = ltfat_abs(res);
+        if (ltfat_abs(b[i]) > maxb) maxb = ltfat_abs(b[i]);
+    }
+    mu_assert( maxres <= tol * maxb, "HERMSYSTEMSOLVER residual %.3e",
+               (double) maxres);
+
+    /* Reusing the factorization must give the same result as a new plan */
+    memcpy(Awork, A, M * M * sizeof * A);
+    memcpy(xfresh, b, M * sizeof * b);
+    LTFAT_NAME_COMPLEX(hermsystemsolver_init)(Mmax, &planfresh);
+    LTFAT_NAME_COMPLEX(hermsystemsolver_execute)(planfresh, Awork, M, xfresh);
+    LTFAT_NAME_COMPLEX(hermsystemsolver_done)(&planfresh);
+    mu_assert( memcmp(x, xfresh, M * sizeof * x) == 0,
+               "HERMSYSTEMSOLVER same as without reuse");
+}
+
+/* Linearly dependent atoms give a singular Gram matrix */
+for (ltfat_int i = 0; i < 9; i++) Awork[i] = 1;
+for (ltfat_int i = 0; i < 3; i++) x[i] = 1;
+mu_assert( LTFAT_NAME_COMPLEX(hermsystemsolver_execute)(plan, Awork, 3, x) > 0,
+           "HERMSYSTEMSOLVER singular matrix detected");
+
+/* The plan is still usable after the breakdown */
+memcpy(Awork, A, Mmax * Mmax * sizeof * A);
+memcpy(x, b, Mmax * sizeof * b);
+memcpy(xfresh, b, Mmax * sizeof * b);
+mu_assert( LTFAT_NAME_COMPLEX(hermsystemsolver_execute)(plan, Awork, Mmax, x) == 0,
+           "HERMSYSTEMSOLVER after breakdown");
+memcpy(Awork, A, Mmax * Mmax * sizeof * A);
+LTFAT_NAME_COMPLEX(hermsystemsolver_init)(Mmax, &planfresh);
+LTFAT_NAME_COMPLEX(hermsystemsolver_execute)(planfresh, Awork, Mmax, xfresh);
+mu_assert( memcmp(x, xfresh, Mmax * sizeof * x) == 0,
+           "HERMSYSTEMSOLVER after breakdown same as without reuse");
+
+LTFAT_NAME_COMPLEX(hermsystemsolver_done)(&planfresh);
+LTFAT_NAME_COMPLEX(hermsystemsolver_done)(&plan);
+ltfat_free(Afull);
+ltfat_free(A);
+ltfat_free(Awork);
+ltfat_free(b);
+ltfat_free(x);
+ltfat_free(xfresh);
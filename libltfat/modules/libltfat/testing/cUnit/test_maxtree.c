@@ -15,14 +15,14 @@ for (unsigned int lId = 0; lId < ARRAYLEN(L); lId++)
         LTFAT_REAL max2;
         /* fin[L[lId]-1] = 100; */
         LTFAT_NAME(findmaxinarray)(fin, L[lId], &max, &maxPos);
-        printf("max=%.2f, maxPos=%td\n", max, maxPos);
+        printf("max=%.2f, maxPos=%d\n", max, (int) maxPos);
 
         LTFAT_NAME(maxtree)* p = NULL;
         LTFAT_NAME(maxtree_initwitharray)(L[lId], depth[dId], fin, &p);
         LTFAT_NAME(maxtree_findmax)(p, &max2, &maxPos2);
-        printf("max=%.2f, maxPos=%td\n", max2, maxPos2);
+        printf("max=%.2f, maxPos=%d\n", max2, (int) maxPos2);
 
-        for (unsigned int idx = 0; idx < L[lId]; idx++)
+        for (ltfat_int idx = 0; idx < L[lId]; idx++)
         {
             for (unsigned int rIdx = 0; rIdx < ARRAYLEN(rLen); rIdx++)
             {
@@ -31,7 +31,7 @@ for (unsigned int lId = 0; lId < ARRAYLEN(L); lId++)
                 TEST_NAME(fillRand)(fin, L[lId]);
                 LTFAT_NAME(maxtree_reset)(p, fin);
 
-                for (unsigned int ii = 0; ii < rLen[rIdx]; ii++)
+                for (ltfat_int ii = 0; ii < rLen[rIdx]; ii++)
                 {
                     ltfat_int pos = idx + ii;
                     if (pos >= L[lId])
@@ -48,8 +48,8 @@ for (unsigned int lId = 0; lId < ARRAYLEN(L); lId++)
 
                 /* printf("max=%.2f, maxPos=%td\n",max2,maxPos2);  */
                 mu_assert( max == max2 && maxPos == maxPos2 ,
-                           "TREEMAX L=%td, d=%td, idx=%d, r=%td",
-                           L[lId], depth[dId], idx, rLen[rIdx] );
+                           "TREEMAX L=%d, d=%d, idx=%d, r=%d", (int) L[lId],
+                           (int) depth[dId], (int) idx, (int) rLen[rIdx] );
             }
         }
 
@@ -59,3 +59,47 @@ for (unsigned int lId = 0; lId < ARRAYLEN(L); lId++)
 
     ltfat_free(fin);
 }
+
+ltfat_int Lblk[] = { 9, 16, 17, 100, 257, 300 };
+
+for (unsigned int lId = 0; lId < ARRAYLEN(Lblk); lId++)
+{
+    LTFAT_REAL* fin = LTFAT_NAME_REAL(malloc)(Lblk[lId]);
+    TEST_NAME(fillRand)(fin, Lblk[lId]);
+
+    LTFAT_NAME(maxtree)* p = NULL;
+    LTFAT_NAME(maxtree_initblocked)(Lblk[lId], Lblk[lId], &p);
+
+    for (ltfat_int idx = 0; idx < Lblk[lId]; idx++)
+    {
+        for (unsigned int rIdx = 0; rIdx < ARRAYLEN(rLen); rIdx++)
+        {
+            ltfat_int maxPos, maxPos2;
+            LTFAT_REAL max, max2;
+            ltfat_int idx2 = idx + Lblk[lId] / 2;
+
+            TEST_NAME(fillRand)(fin, Lblk[lId]);
+            LTFAT_NAME(maxtree_reset)(p, fin);
+
+            /* Two separate dirty ranges */
+            for (ltfat_int ii = 0; ii < rLen[rIdx]; ii++)
+            {
+                fin[(idx + ii) % Lblk[lId]] = 100 + ii;
+                fin[(idx2 + ii) % Lblk[lId]] = 50.5 + ii;
+            }
+
+            LTFAT_NAME(findmaxinarray)(fin, Lblk[lId], &max, &maxPos);
+
+            LTFAT_NAME(maxtree_setdirty)(p, idx, idx + rLen[rIdx]);
+            LTFAT_NAME(maxtree_setdirty)(p, idx2, idx2 + rLen[rIdx]);
+            LTFAT_NAME(maxtree_findmax)(p, &max2, &maxPos2);
+
+            mu_assert( max == max2 && maxPos == maxPos2 ,
+                       "TREEMAX BLOCKED L=%d, idx=%d, r=%d",
+                       (int) Lblk[lId], (int) idx, (int) rLen[rIdx] );
+        }
+    }
+
+    LTFAT_NAME(maxtree_done)(&p);
+    ltfat_free(fin);
+}
@@ -0,0 +1,103 @@
+ltfat_int pipeLen[] = { 1, 2, 4 };
+ltfat_int W = 2, Ls = 8192, bufLen = 256;
+double tol = sizeof(LTFAT_REAL) == sizeof(double) ? 1e-10 : 1e-4;
+
+LTFAT_NAME(dgtrealmp_parbuf)* pb = NULL;
+LTFAT_NAME(slidgtrealmp_state)* plan = NULL;
+LTFAT_NAME(dgtrealmp_parbuf_init)(&pb);
+LTFAT_NAME(dgtrealmp_parbuf_add_firwin)(pb, LTFAT_BLACKMAN, 256, 64, 256);
+LTFAT_NAME(dgtrealmp_parbuf_add_firwin)(pb, LTFAT_BLACKMAN, 64, 16, 64);
+LTFAT_NAME(dgtrealmp_setparbuf_maxatoms)(pb, 200);
+LTFAT_NAME(dgtrealmp_setparbuf_errtoldb)(pb, -40);
+
+ltfat_int L = LTFAT_NAME(dgtrealmp_getparbuf_siglen)(pb, 1024);
+LTFAT_REAL* f[2];
+LTFAT_REAL* fser[2];
+LTFAT_REAL* fpipe[2];
+ltfat_int delayser = 0;
+
+/* Serial output of the whole stream including the flushed tail */
+mu_assert( LTFAT_NAME(slidgtrealmp_init)(pb, L, W, bufLen, &plan) ==
+           LTFATERR_SUCCESS, "PIPELINED serial init");
+delayser = LTFAT_NAME(slidgtrealmp_getprocdelay)(plan);
+
+for (ltfat_int w = 0; w < W; w++)
+{
+    f[w] = LTFAT_NAME_REAL(malloc)(Ls);
+    fser[w] = LTFAT_NAME_REAL(malloc)(Ls + delayser);
+    TEST_NAME(fillRand)(f[w], Ls);
+}
+
+for (ltfat_int pos = 0; pos < Ls; pos += bufLen)
+{
+    const LTFAT_REAL* in[] = { f[0] + pos, f[1] + pos };
+    LTFAT_REAL* out[] = { fser[0] + pos, fser[1] + pos };
+    LTFAT_NAME(slidgtrealmp_execute)(plan, in, bufLen, W, out);
+}
+{
+    LTFAT_REAL* out[] = { fser[0] + Ls, fser[1] + Ls };
+    mu_assert( LTFAT_NAME(slidgtrealmp_flush)(plan, W, out) == LTFATERR_SUCCESS,
+               "PIPELINED serial flush");
+}
+LTFAT_NAME(slidgtrealmp_done)(&plan);
+
+for (unsigned int pId = 0; pId < ARRAYLEN(pipeLen); pId++)
+{
+    ltfat_int delay, pipedelay;
+    LTFAT_REAL maxdiff = 0;
+
+    mu_assert( LTFAT_NAME(slidgtrealmp_init_pipelined)(pb, L, W, bufLen,
+               pipeLen[pId], &plan) == LTFATERR_SUCCESS,
+               "PIPELINED init pipeLen=%d", (int) pipeLen[pId]);
+
+    delay = LTFAT_NAME(slidgtrealmp_getprocdelay)(plan);
+    pipedelay = delay - delayser;
+    mu_assert( pipedelay >= 0, "PIPELINED delay pipeLen=%d", (int) pipeLen[pId]);
+
+    for (ltfat_int w = 0; w < W; w++)
+        fpipe[w] = LTFAT_NAME_REAL(malloc)(Ls + delay);
+
+    /* Twice to check that reset discards the pending slices */
+    for (int run = 0; run < 2; run++)
+    {
+        LTFAT_NAME(slidgtrealmp_reset)(plan);
+
+        for (ltfat_int pos = 0; pos < Ls; pos += bufLen)
+        {
+            const LTFAT_REAL* in[] = { f[0] + pos, f[1] + pos };
+            LTFAT_REAL* out[] = { fpipe[0] + pos, fpipe[1] + pos };
+            LTFAT_NAME(slidgtrealmp_execute)(plan, in, bufLen, W, out);
+        }
+
+        {
+            LTFAT_REAL* out[] = { fpipe[0] + Ls, fpipe[1] + Ls };
+            mu_assert( LTFAT_NAME(slidgtrealmp_flush)(plan, W, out) == LTFATERR_SUCCESS,
+                       "PIPELINED flush pipeLen=%d", (int) pipeLen[pId]);
+        }
+
+        /* The pipelined output is the serial one delayed by pipedelay */
+        for (ltfat_int w = 0; w < W; w++)
+        {
+            for (ltfat_int l = 0; l < pipedelay; l++)
+                if (ltfat_abs(fpipe[w][l]) > maxdiff) maxdiff = ltfat_abs(fpipe[w][l]);
+
+            for (ltfat_int l = 0; l < Ls + delayser; l++)
+                if (ltfat_abs(fpipe[w][l + pipedelay] - fser[w][l]) > maxdiff)
+                    maxdiff = ltfat_abs(fpipe[w][l + pipedelay] - fser[w][l]);
+        }
+
+        mu_assert( maxdiff < tol, "PIPELINED pipeLen=%d run %d equals serial, diff %.3e",
+                   (int) pipeLen[pId], run, (double) maxdiff);
+    }
+
+    LTFAT_NAME(slidgtrealmp_done)(&plan);
+    for (ltfat_int w = 0; w < W; w++)
+        ltfat_free(fpipe[w]);
+}
+
+LTFAT_NAME(dgtrealmp_parbuf_done)(&pb);
+for (ltfat_int w = 0; w < W; w++)
+{
+    ltfat_free(f[w]);
+    ltfat_free(fser[w]);
+}
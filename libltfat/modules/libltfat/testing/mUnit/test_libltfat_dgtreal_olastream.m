@@ -0,0 +1,97 @@
+function test_failed = test_libltfat_dgtreal_olastream(varargin)
+test_failed = 0;
+
+fprintf(' ===============  %s ================ \n',upper(mfilename));
+
+definput.flags.complexity={'double','single'};
+[flags]=ltfatarghelper({},definput,varargin);
+dataPtr = [flags.complexity, 'Ptr'];
+
+[~,~,enuminfo]=libltfatprotofile;
+phaseconv = enuminfo.ltfat_phaseconvention;
+FFTW_ESTIMATE = 64;
+
+Larr  = [3000 3001  999  777];
+glarr = [  64   64   48   50];
+aarr  = [  16   16   16   10];
+Marr  = [  64   64   32   20];
+blarr = [ 256  256   64   40];
+Warr  = [   1    2    3    1];
+chunkarr = [100 1000  37    5];
+Ncaparr  = [  7   50   3 1000];
+
+for idx = 1:numel(Larr)
+    L = Larr(idx);
+    gl = glarr(idx);
+    W = Warr(idx);
+    a = aarr(idx);
+    M = Marr(idx);
+    bl = blarr(idx);
+    Ncap = Ncaparr(idx);
+    M2 = floor(M/2) + 1;
+    N = ceil(L/a);
+
+    g = randn(gl,1,flags.complexity);
+    f = randn(L,W,flags.complexity);
+    gPtr = libpointer(dataPtr,g);
+
+    % Non-periodic reference: zero-pad beyond the window overlap
+    Lbig = dgtlength(L + 2*gl,a,M);
+
+    for pconv = {'freqinv','timeinv'}
+        truec = dgtreal(postpad(f,Lbig),fir2long(g,Lbig),a,M,pconv{1});
+        truec = truec(:,1:N,:);
+
+        plan = libpointer();
+        funname = makelibraryname('dgtreal_olastream_init',flags.complexity,0);
+        statusInit = calllib('libltfat',funname,gPtr,gl,W,a,M,bl,...
+                             phaseconv.(['LTFAT_',upper(pconv{1})]),FFTW_ESTIMATE,plan);
+
+        cstream = zeros(M2,0,W,flags.complexity);
+        coutPtr = libpointer(dataPtr,zeros(2*M2*Ncap*W,1,flags.complexity));
+        LusedPtr = libpointer('int64Ptr',0);
+        NoutPtr = libpointer('int64Ptr',0);
+        status = 0;
+
+        pos = 0;
+        while pos < L
+            Lchunk = min(randi(chunkarr(idx)),L-pos);
+            fchunk = f(pos+1:pos+Lchunk,:);
+            funname = makelibraryname('dgtreal_olastream_push',flags.complexity,0);
+            status = status + calllib('libltfat',funname,plan,fchunk,Lchunk,LusedPtr);
+            pos = pos + double(LusedPtr.Value);
+
+            funname = makelibraryname('dgtreal_olastream_pull',flags.complexity,0);
+            status = status + calllib('libltfat',funname,plan,coutPtr,Ncap,NoutPtr);
+            cstream = appendcols(cstream,coutPtr.Value,M2,Ncap,W,NoutPtr.Value);
+        end
+
+        funname = makelibraryname('dgtreal_olastream_flush',flags.complexity,0);
+        status = status + calllib('libltfat',funname,plan);
+        NoutPtr.Value = 1;
+        while NoutPtr.Value > 0
+            funname = makelibraryname('dgtreal_olastream_pull',flags.complexity,0);
+            status = status + calllib('libltfat',funname,plan,coutPtr,Ncap,NoutPtr);
+            cstream = appendcols(cstream,coutPtr.Value,M2,Ncap,W,NoutPtr.Value);
+        end
+
+        funname = makelibraryname('dgtreal_olastream_done',flags.complexity,0);
+        statusDone = calllib('libltfat',funname,plan);
+
+        if size(cstream,2) ~= N
+            res = 1;
+        else
+            res = norm(reshape(truec - cstream,M2,N*W),'fro');
+        end
+        [test_failed,fail]=ltfatdiditfail(res+statusInit+status+statusDone,test_failed);
+        fprintf(['DGTREAL OLASTREAM %s L:%4i, W:%3i, a:%3i, M:%3i, gl:%3i, bl:%3i %s %s %s\n'],...
+                upper(pconv{1}),L,W,a,M,gl,bl,flags.complexity,ltfatstatusstring(status),fail);
+    end
+end
+
+function c = appendcols(c,cinterleaved,M2,Ncap,W,Nout)
+if Nout == 0
+    return;
+end
+cnew = reshape(interleaved2complex(cinterleaved),M2,Ncap,W);
+c = cat(2,c,cnew(:,1:Nout,:));
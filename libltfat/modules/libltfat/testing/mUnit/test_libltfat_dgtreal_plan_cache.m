@@ -0,0 +1,65 @@
+function test_failed = test_libltfat_dgtreal_plan_cache(varargin)
+test_failed = 0;
+
+fprintf(' ===============  %s ================ \n',upper(mfilename));
+
+definput.flags.complexity={'double','single'};
+[flags]=ltfatarghelper({},definput,varargin);
+dataPtr = [flags.complexity, 'Ptr'];
+
+Larr  = [350 360   9];
+glarr = [ 20  10   9];
+aarr  = [ 10  10   3];
+Marr  = [ 35  36   3];
+Warr  = [  1   3   3];
+
+% Budget 0 destroys the plans on release
+for budget = [64*1024*1024, 0]
+funname = makelibraryname('dgtreal_plan_cache_set_budget',flags.complexity,0);
+statusBudget = calllib('libltfat',funname,budget);
+
+for idx = 1:numel(Larr)
+    L = Larr(idx);
+    W = Warr(idx);
+    a = aarr(idx);
+    M = Marr(idx);
+    M2 = floor(M/2) + 1;
+    gl = glarr(idx);
+    N = L/a;
+
+    g = randn(gl,1,flags.complexity);
+    gPtr = libpointer(dataPtr,g);
+
+    % The second round gets the plan released in the first one
+    for round = 1:2
+        f = randn(L,W,flags.complexity);
+        fPtr = libpointer(dataPtr,f);
+        coutPtr = libpointer(dataPtr,zeros(2*M2*N*W,1,flags.complexity));
+
+        plan = libpointer();
+        funname = makelibraryname('dgtreal_plan_cache_get',flags.complexity,0);
+        statusGet = calllib('libltfat',funname,gPtr,gl,L,W,a,M,...
+                            libpointer(),libpointer(),libpointer(),plan);
+
+        funname = makelibraryname('dgtreal_execute_ana_newarray',flags.complexity,0);
+        statusExecute = calllib('libltfat',funname,plan,fPtr,coutPtr);
+
+        truec = dgtreal(f,g,a,M);
+        res = norm(reshape(truec,M2,N*W) - interleaved2complex(coutPtr.Value),'fro');
+
+        funname = makelibraryname('dgtreal_plan_cache_release',flags.complexity,0);
+        statusRelease = calllib('libltfat',funname,plan);
+
+        [test_failed,fail]=ltfatdiditfail(res+statusGet+statusExecute+statusRelease+statusBudget,test_failed);
+        fprintf(['DGTREAL PLAN CACHE round %i budget %9i L:%3i, W:%3i, a:%3i, M:%3i %s %s %s\n'],...
+                round,budget,L,W,a,M,flags.complexity,ltfatstatusstring(statusExecute),fail);
+    end
+end
+end
+
+funname = makelibraryname('dgtreal_plan_cache_clear',flags.complexity,0);
+statusClear = calllib('libltfat',funname);
+funname = makelibraryname('dgtreal_plan_cache_set_budget',flags.complexity,0);
+statusBudget = calllib('libltfat',funname,64*1024*1024);
+[test_failed,fail]=ltfatdiditfail(statusClear+statusBudget,test_failed);
+fprintf('DGTREAL PLAN CACHE clear %s %s\n',flags.complexity,fail);
@@ -0,0 +1,122 @@
+function test_failed = test_libltfat_dgtreal_shear(varargin)
+test_failed = 0;
+
+fprintf(' ===============  %s ================ \n',upper(mfilename));
+
+definput.flags.complexity={'double','single'};
+[flags]=ltfatarghelper({},definput,varargin);
+dataPtr = [flags.complexity, 'Ptr'];
+
+Larr  = [ 48  60 192  48  48];
+aarr  = [  4   6   4   4   4];
+Marr  = [  8   5   8   8   8];
+Warr  = [  1   3   2   3   1];
+ltarr = [1 2; 1 2; 1 2; 0 1; 1 3];
+
+for idx = 1:numel(Larr)
+    L = Larr(idx);
+    W = Warr(idx);
+    a = aarr(idx);
+    M = Marr(idx);
+    lt = ltarr(idx,:);
+    M2 = floor(M/2) + 1;
+    N = L/a;
+
+    [s0,s1,br] = shearfind(L,a,M,lt);
+
+    g = cast(pgauss(L,a*M/L),flags.complexity);
+    gd = cast(gabdual(g,a,M,'lt',lt),flags.complexity);
+    f = randn(L,W,flags.complexity);
+
+    fPtr = libpointer(dataPtr,f);
+    gPtr = libpointer(dataPtr,g);
+    gdPtr = libpointer(dataPtr,gd);
+    coutPtr = libpointer(dataPtr,zeros(2*M2*N*W,1,flags.complexity));
+    frecPtr = libpointer(dataPtr,zeros(L,W,flags.complexity));
+
+    funname = makelibraryname('dgtreal_shear',flags.complexity,0);
+    status = calllib('libltfat',funname,fPtr,gPtr,L,W,a,M,s0,s1,br,coutPtr);
+
+    % Only the rectangular and the quincunx lattice are conjugate symmetric
+    if lt(2) > 2
+        [test_failed,fail]=ltfatdiditfail(status ~= -14,test_failed);
+        fprintf(['DGTREAL SHEAR REJECT  L:%3i, W:%3i, a:%3i, M:%3i, lt:[%i %i] %s %s %s\n'],...
+                L,W,a,M,lt(1),lt(2),flags.complexity,ltfatstatusstring(status),fail);
+        continue;
+    end
+
+    truec = dgt(f,g,a,M,'lt',lt);
+    truec = truec(1:M2,:,:);
+    res = norm(reshape(truec,M2,N*W) - interleaved2complex(coutPtr.Value),'fro');
+    [test_failed,fail]=ltfatdiditfail(res+status,test_failed);
+    fprintf(['DGTREAL SHEAR         L:%3i, W:%3i, a:%3i, M:%3i, lt:[%i %i] %s %s %s\n'],...
+            L,W,a,M,lt(1),lt(2),flags.complexity,ltfatstatusstring(status),fail);
+
+    funname = makelibraryname('idgtreal_shear',flags.complexity,0);
+    status = calllib('libltfat',funname,coutPtr,gdPtr,L,W,a,M,s0,s1,br,frecPtr);
+
+    res = norm(f - frecPtr.Value,'fro');
+    [test_failed,fail]=ltfatdiditfail(res+status,test_failed);
+    fprintf(['IDGTREAL SHEAR        L:%3i, W:%3i, a:%3i, M:%3i, lt:[%i %i] %s %s %s\n'],...
+            L,W,a,M,lt(1),lt(2),flags.complexity,ltfatstatusstring(status),fail);
+
+    % Overlap-add with blocks of 3*2*M samples and window of length 2*M
+    gl = 2*M;
+    bl = 6*M;
+    if mod(L,bl) == 0 && mod(gl,2*a) == 0
+        [s0e,s1e,bre] = shearfind(bl+gl,a,M,lt);
+        gfir = cast(pgauss(bl+gl,a*M/(bl+gl)),flags.complexity);
+        gfir = long2fir(gfir,gl);
+        gfirPtr = libpointer(dataPtr,gfir);
+        coutPtr = libpointer(dataPtr,zeros(2*M2*N*W,1,flags.complexity));
+
+        funname = makelibraryname('dgtreal_shearola',flags.complexity,0);
+        status = calllib('libltfat',funname,fPtr,gfirPtr,L,gl,W,a,M,s0e,s1e,bre,bl,coutPtr);
+
+        truec = dgt(f,fir2long(gfir,L),a,M,'lt',lt);
+        truec = truec(1:M2,:,:);
+        res = norm(reshape(truec,M2,N*W) - interleaved2complex(coutPtr.Value),'fro');
+        [test_failed,fail]=ltfatdiditfail(res+status,test_failed);
+        fprintf(['DGTREAL SHEAROLA      L:%3i, W:%3i, a:%3i, M:%3i, lt:[%i %i] %s %s %s\n'],...
+                L,W,a,M,lt(1),lt(2),flags.complexity,ltfatstatusstring(status),fail);
+    end
+end
+
+% Shear parameters which do not describe a lattice of the given a and M
+Lrej  = [ 48  48  48 144];
+arej  = [  4   4   4   6];
+Mrej  = [  8   8   8  18];
+s0rej = [  1   1   5   1];
+s1rej = [  5  11   1   7];
+brrej = [  4   4   4   6];
+
+for idx = 1:numel(Lrej)
+    L = Lrej(idx);
+    a = arej(idx);
+    M = Mrej(idx);
+    M2 = floor(M/2) + 1;
+    N = L/a;
+    W = 1;
+
+    g = cast(pgauss(L,a*M/L),flags.complexity);
+    f = randn(L,W,flags.complexity);
+
+    fPtr = libpointer(dataPtr,f);
+    gPtr = libpointer(dataPtr,g);
+    coutPtr = libpointer(dataPtr,zeros(2*M2*N*W,1,flags.complexity));
+    frecPtr = libpointer(dataPtr,zeros(L,W,flags.complexity));
+
+    funname = makelibraryname('dgtreal_shear',flags.complexity,0);
+    status = calllib('libltfat',funname,fPtr,gPtr,L,W,a,M,...
+                     s0rej(idx),s1rej(idx),brrej(idx),coutPtr);
+    [test_failed,fail]=ltfatdiditfail(status ~= -6,test_failed);
+    fprintf(['DGTREAL SHEAR REJECT  L:%3i, a:%3i, M:%3i, s0:%i, s1:%i, br:%i %s %s %s\n'],...
+            L,a,M,s0rej(idx),s1rej(idx),brrej(idx),flags.complexity,ltfatstatusstring(status),fail);
+
+    funname = makelibraryname('idgtreal_shear',flags.complexity,0);
+    status = calllib('libltfat',funname,coutPtr,gPtr,L,W,a,M,...
+                     s0rej(idx),s1rej(idx),brrej(idx),frecPtr);
+    [test_failed,fail]=ltfatdiditfail(status ~= -6,test_failed);
+    fprintf(['IDGTREAL SHEAR REJECT L:%3i, a:%3i, M:%3i, s0:%i, s1:%i, br:%i %s %s %s\n'],...
+            L,a,M,s0rej(idx),s1rej(idx),brrej(idx),flags.complexity,ltfatstatusstring(status),fail);
+end
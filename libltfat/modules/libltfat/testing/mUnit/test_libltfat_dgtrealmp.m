@@ -153,6 +153,7 @@ calllib('libltfat','ltfat_dgtmp_setpar_alg',params,algmpstruct.ltfat_dgtmp_alg_l
 %calllib('libltfat','ltfat_dgtmp_setpar_alg',params,algmpstruct.ltfat_dgtmp_alg_LocOMP);
 calllib('libltfat','ltfat_dgtmp_setpar_iterstep',params,1e6);
 calllib('libltfat','ltfat_dgtmp_setpar_cycles',params,1);
+calllib('libltfat','ltfat_dgtmp_setpar_nthreads',params,2);
 
 
 plan = libpointer();
@@ -285,6 +286,50 @@ statusDone = calllib('libltfat',funname,plan);
 
   atomsArr(end + 1) = atoms;
   [test_failed,fail]=ltfatdiditfail(abs(errdb - errtoldb)>0.1 ,test_failed);
+
+%% Plain MP selecting several atoms per iteration
+batchatoms = 8;
+nthreadsArr = [1, 3];
+coutBatch = cell(numel(nthreadsArr),1);
+for tIdx = 1:numel(nthreadsArr)
+    params = calllib('libltfat','ltfat_dgtmp_params_allocdef');
+    calllib('libltfat','ltfat_dgtmp_setpar_maxatoms',params,sizeaccum);
+    calllib('libltfat','ltfat_dgtmp_setpar_maxit',params,sizeaccum);
+    calllib('libltfat','ltfat_dgtmp_setpar_errtoldb',params,errtoldb);
+    calllib('libltfat','ltfat_dgtmp_setpar_kernrelthr',params,1e-4);
+    calllib('libltfat','ltfat_dgtmp_setpar_phaseconv',params,cphaseconv);
+    calllib('libltfat','ltfat_dgtmp_setpar_alg',params,algmpstruct.ltfat_dgtmp_alg_mp);
+    calllib('libltfat','ltfat_dgtmp_setpar_batchatoms',params,batchatoms);
+    calllib('libltfat','ltfat_dgtmp_setpar_nthreads',params,nthreadsArr(tIdx));
+
+    plan = libpointer();
+    funname = makelibraryname('dgtrealmp_init_gen_compact',flags.complexity,0);
+    statusInit = calllib('libltfat',funname,gPtr,glPtr,...
+        L,Psize,aPtr,MPtr,params,plan);
+    calllib('libltfat','ltfat_dgtmp_params_free',params);
+
+    coutPtr = libpointer(dataPtr,complex2interleaved(...
+        cast(zeros(sizeaccum,1),flags.complexity)));
+    funname = makelibraryname('dgtrealmp_execute_compact',flags.complexity,0);
+    statusExecute = calllib('libltfat',funname,plan,fPtr,coutPtr,foutPtr);
+
+    errdbPtr = libpointer('doublePtr',[1]);
+    funname = makelibraryname('dgtrealmp_get_errdb',flags.complexity,0);
+    calllib('libltfat',funname,plan,errdbPtr);
+
+    funname = makelibraryname('dgtrealmp_done',flags.complexity,0);
+    calllib('libltfat',funname,plan);
+
+    coutBatch{tIdx} = coutPtr.value;
+    [test_failed,fail]=ltfatdiditfail(statusInit ~= 0 || statusExecute < 0 || ...
+                                      errdbPtr.value > errtoldb + 0.1, test_failed);
+    fprintf('DGTREALMP batchatoms=%d nthreads=%d err %.2f dB %s %s\n',...
+        batchatoms,nthreadsArr(tIdx),errdbPtr.value,flags.complexity,fail);
+end
+
+[test_failed,fail]=ltfatdiditfail(any(coutBatch{1} ~= coutBatch{2}),test_failed);
+fprintf('DGTREALMP batchatoms=%d same result for all nthreads %s %s\n',...
+    batchatoms,flags.complexity,fail);
     %[test_failed,fail]=ltfatdiditfail(res+statusInit,test_failed);
     %fprintf(['DGTREAL FREQINV WP auto %s L:%3i, W:%3i, a:%3i, M:%3i %s %s %s\n'],dirstr,L,W,a,M,flags.complexity,ltfatstatusstring(statusExecute),fail);
  %drawnow  
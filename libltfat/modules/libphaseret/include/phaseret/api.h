@@ -1,10 +1,12 @@
 //#include "dgtrealwrapper.h"
 #include "gla.h"
+#include "decolbfgs.h"
 #include "legla.h"
 #include "pghi.h"
 #include "spsi.h"
 #include "rtpghi.h"
 #include "rtisila.h"
+#include "lertisila.h"
 #include "gsrtisila.h"
 #include "gsrtisilapghi.h"
 #include "utils.h"
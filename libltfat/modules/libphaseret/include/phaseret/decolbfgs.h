@@ -0,0 +1,285 @@
+#ifndef LTFAT_NOSYSTEMHEADERS
+#include "ltfat.h"
+#include "ltfat/types.h"
+#endif
+
+#include "phaseret/types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct PHASERET_NAME(decolbfgs_plan) PHASERET_NAME(decolbfgs_plan);
+
+/** \addtogroup decolbfgs
+ * @{
+ *
+ */
+
+/** Function prototype for status callback
+ *
+ *  The callback is executed at the end of each iteration.
+ *
+ *  \param[in]         p   DGTREAL plan with the analysis window used both
+ *                         for analysis and synthesis
+ *  \param[in]  userdata   User defined data
+ *  \param[in]         f   Signal at the end of iteration, size L x W
+ *  \param[in]         L   Signal length
+ *  \param[in]         W   Number of signal channels
+ *  \param[in]         a   Time hop factor
+ *  \param[in]         M   Number of frequency channels
+ *  \param[in]    objval   Value of the objective function
+ *  \param[in]      iter   Current iteration
+ *
+ * #### Versions #
+ * <tt>
+ * phaseret_decolbfgs_callback_status_d(ltfat_dgtreal_plan_d* p,
+ *                                      void* userdata, const double f[],
+ *                                      ltfat_int L, ltfat_int W, ltfat_int a,
+ *                                      ltfat_int M, double objval, ltfat_int iter);
+ *
+ * phaseret_decolbfgs_callback_status_s(ltfat_dgtreal_plan_s* p,
+ *                                      void* userdata, const float f[],
+ *                                      ltfat_int L, ltfat_int W, ltfat_int a,
+ *                                      ltfat_int M, double objval, ltfat_int iter);
+ * </tt>
+ *  \returns
+ *  Status code | Meaning
+ *  ------------|---------------------------------------------------------------------------------------
+ *   0          | Signalizes that callback exited without error
+ *  >0          | Signalizes that callback exited without error but terminate the algorithm prematurely
+ *  <0          | Callback exited with error
+ */
+typedef int
+PHASERET_NAME(decolbfgs_callback_status)(LTFAT_NAME(dgtreal_plan)* p,
+        void* userdata, const LTFAT_REAL f[],
+        ltfat_int L, ltfat_int W, ltfat_int a, ltfat_int M,
+        double objval, ltfat_int iter);
+
+/** Phase retrieval by direct minimization of the spectrogram error
+ *
+ *  Minimizes sum( (|c(f)|^p - |cinit|^p)^2 ) over the time-domain signal f
+ *  using the L-BFGS algorithm, p=2/3. The phase of \a cinit is used
+ *  for the initial estimate of f.
+ *
+ *  M2 = M/2 + 1, N = L/a
+ *
+ *  \param[in]  cinit   Initial set of coefficients, size M2 x N x W
+ *  \param[in]      g   Analysis window, size gl x 1
+ *  \param[in]      L   Signal length
+ *  \param[in]     gl   Window length
+ *  \param[in]      W   Number of signal channels
+ *  \param[in]      a   Time hop factor
+ *  \param[in]      M   Number of frequency channels
+ *  \param[in]   iter   Maximum number of iterations
+ *  \param[out]     c   Coefficients with reconstructed phase, size M2 x N x W
+ *
+ * #### Versions #
+ * <tt>
+ * phaseret_decolbfgs_d(const ltfat_complex_d cinit[], const double g[],
+ *                      ltfat_int L, ltfat_int gl, ltfat_int W, ltfat_int a, ltfat_int M,
+ *                      ltfat_int iter, ltfat_complex_d c[]);
+ *
+ * phaseret_decolbfgs_s(const ltfat_complex_s cinit[], const float g[],
+ *                      ltfat_int L, ltfat_int gl, ltfat_int W, ltfat_int a, ltfat_int M,
+ *                      ltfat_int iter, ltfat_complex_s c[]);
+ * </tt>
+ *  \returns
+ *  Status code           | Description
+ *  ----------------------|-----------------------
+ *  LTFATERR_SUCCESS      | No error occurred
+ *  LTFATERR_NULLPOINTER  | \a cinit or \a g or \a c was NULL
+ *  LTFATERR_BADSIZE      | Signal length L is less or equal to 0.
+ *  LTFATERR_NOTPOSARG    | At least one of \f W, \f a, \f M, \f gl, \a iter was less or equal to zero.
+ *  LTFATERR_BADTRALEN    | \a L is not divisible by both \a a and \a M.
+ *  LTFATERR_INITFAILED   | The FFTW plan creation failed
+ *  LTFATERR_NOMEM        | Memory allocation error occurred
+ */
+PHASERET_API int
+PHASERET_NAME(decolbfgs)(const LTFAT_COMPLEX cinit[], const LTFAT_REAL g[],
+                         ltfat_int L, ltfat_int gl, ltfat_int W,
+                         ltfat_int a, ltfat_int M, ltfat_int iter, LTFAT_COMPLEX c[]);
+
+/** Initialize decolbfgs plan
+ *
+ *  M2 = M/2 + 1, N = L/a
+ *
+ *  The memory requirements are approximately (2*histlen + 5) x L x W
+ *  real numbers on top of the DGTREAL plan.
+ *
+ *  \note In-place mode i.e. \a cinit == \a c is allowed.
+ *
+ *  \param[in]  cinit   Initial set of coefficients, size M2 x N x W or NULL
+ *  \param[in]      g   Analysis window, size gl x 1
+ *  \param[in]      L   Signal length
+ *  \param[in]     gl   Window length
+ *  \param[in]      W   Number of signal channels
+ *  \param[in]      a   Time hop factor
+ *  \param[in]      M   Number of frequency channels
+ *  \param[in]   pexp   Exponent applied to the magnitude in the objective function, 2/3 is recommended
+ *  \param[in] histlen  Number of correction pairs stored by L-BFGS
+ *  \param[in]      c   Array for holding coefficients with reconstructed phase, size M2 x N x W
+ *  \param[in] params   DGT parameters or NULL
+ *  \param[out]     p   decolbfgs plan
+ *
+ * #### Versions #
+ * <tt>
+ * phaseret_decolbfgs_init_d(const ltfat_complex_d cinit[], const double g[],
+ *                           ltfat_int L, ltfat_int gl, ltfat_int W, ltfat_int a,
+ *                           ltfat_int M, double pexp, ltfat_int histlen,
+ *                           ltfat_complex_d c[], ltfat_dgt_params* params,
+ *                           phaseret_decolbfgs_plan_d** p);
+ *
+ * phaseret_decolbfgs_init_s(const ltfat_complex_s cinit[], const float g[],
+ *                           ltfat_int L, ltfat_int gl, ltfat_int W, ltfat_int a,
+ *                           ltfat_int M, double pexp, ltfat_int histlen,
+ *                           ltfat_complex_s c[], ltfat_dgt_params* params,
+ *                           phaseret_decolbfgs_plan_s** p);
+ * </tt>
+ *  \returns
+ *  Status code           | Description
+ *  ----------------------|-----------------------
+ *  LTFATERR_SUCCESS      | No error occurred
+ *  LTFATERR_NULLPOINTER  | \a g or \a p was NULL
+ *  LTFATERR_BADSIZE      | Signal length L is less or equal to 0.
+ *  LTFATERR_NOTPOSARG    | At least one of \f W, \f a, \f M, \f gl, \a pexp, \a histlen was less or equal to zero.
+ *  LTFATERR_BADTRALEN    | \a L is not divisible by both \a a and \a M.
+ *  LTFATERR_INITFAILED   | The FFTW plan creation failed
+ *  LTFATERR_CANNOTHAPPEN | \a params contain invalid values
+ *  LTFATERR_NOMEM        | Memory allocation error occurred
+ */
+PHASERET_API int
+PHASERET_NAME(decolbfgs_init)(const LTFAT_COMPLEX cinit[], const LTFAT_REAL g[],
+                              ltfat_int L, ltfat_int gl, ltfat_int W, ltfat_int a,
+                              ltfat_int M, double pexp, ltfat_int histlen,
+                              LTFAT_COMPLEX c[], ltfat_dgt_params* params,
+                              PHASERET_NAME(decolbfgs_plan)** p);
+
+/** Execute decolbfgs plan
+ *
+ *  \param[in]      p   decolbfgs plan
+ *  \param[in]   iter   Maximum number of iterations
+ *
+ * #### Versions #
+ * <tt>
+ * phaseret_decolbfgs_execute_d(phaseret_decolbfgs_plan_d* p, ltfat_int iter);
+ *
+ * phaseret_decolbfgs_execute_s(phaseret_decolbfgs_plan_s* p, ltfat_int iter);
+ * </tt>
+ *  \returns
+ *  Status code           | Description
+ *  ----------------------|-----------------------
+ *  LTFATERR_SUCCESS      | No error occurred
+ *  LTFATERR_NULLPOINTER  | \a p was NULL or the plan was created with \a cinit or \a c being NULL
+ *  LTFATERR_NOTPOSARG    | \a iter was not positive
+ *  any                   | Error code from the status callback
+ */
+PHASERET_API int
+PHASERET_NAME(decolbfgs_execute)(PHASERET_NAME(decolbfgs_plan)* p, ltfat_int iter);
+
+/** Execute decolbfgs plan on a new array
+ *
+ *  M2 = M/2 + 1, N = L/a
+ *
+ *  \param[in]      p   decolbfgs plan
+ *  \param[in]  cinit   Initial set of coefficients, size M2 x N x W
+ *  \param[in]   iter   Maximum number of iterations
+ *  \param[out]     c   Coefficients with reconstructed phase, size M2 x N x W
+ *
+ * #### Versions #
+ * <tt>
+ * phaseret_decolbfgs_execute_newarray_d(phaseret_decolbfgs_plan_d* p,
+ *                                       const ltfat_complex_d cinit[],
+ *                                       ltfat_int iter, ltfat_complex_d c[]);
+ *
+ * phaseret_decolbfgs_execute_newarray_s(phaseret_decolbfgs_plan_s* p,
+ *                                       const ltfat_complex_s cinit[],
+ *                                       ltfat_int iter, ltfat_complex_s c[]);
+ * </tt>
+ *  \returns
+ *  Status code           | Description
+ *  ----------------------|-----------------------
+ *  LTFATERR_SUCCESS      | No error occurred
+ *  LTFATERR_NULLPOINTER  | \a p or \a cinit or \a c was NULL
+ *  LTFATERR_NOTPOSARG    | \a iter was not positive
+ *  any                   | Error code from the status callback
+ */
+PHASERET_API int
+PHASERET_NAME(decolbfgs_execute_newarray)(PHASERET_NAME(decolbfgs_plan)* p,
+        const LTFAT_COMPLEX cinit[], ltfat_int iter, LTFAT_COMPLEX c[]);
+
+/** Destroy decolbfgs plan
+ *
+ *  \param[in]      p   decolbfgs plan
+ *
+ * #### Versions #
+ * <tt>
+ * phaseret_decolbfgs_done_d(phaseret_decolbfgs_plan_d** p);
+ *
+ * phaseret_decolbfgs_done_s(phaseret_decolbfgs_plan_s** p);
+ * </tt>
+ *  \returns
+ *  Status code           | Description
+ *  ----------------------|-----------------------
+ *  LTFATERR_SUCCESS      | No error occurred
+ *  LTFATERR_NULLPOINTER  | \a p or \a *p was NULL
+ */
+PHASERET_API int
+PHASERET_NAME(decolbfgs_done)(PHASERET_NAME(decolbfgs_plan)** p);
+
+/** Set stopping tolerance
+ *
+ *  The iterations stop when the relative decrease of the objective
+ *  function in one iteration is less than \a tol. The default is 1e-6.
+ *
+ *  \param[in]      p   decolbfgs plan
+ *  \param[in]    tol   Tolerance
+ *
+ * #### Versions #
+ * <tt>
+ * phaseret_decolbfgs_set_tol_d(phaseret_decolbfgs_plan_d* p, double tol);
+ *
+ * phaseret_decolbfgs_set_tol_s(phaseret_decolbfgs_plan_s* p, double tol);
+ * </tt>
+ *  \returns
+ *  Status code           | Description
+ *  ----------------------|-----------------------
+ *  LTFATERR_SUCCESS      | No error occurred
+ *  LTFATERR_NULLPOINTER  | \a p was NULL
+ *  LTFATERR_BADARG       | \a tol was negative
+ */
+PHASERET_API int
+PHASERET_NAME(decolbfgs_set_tol)(PHASERET_NAME(decolbfgs_plan)* p, double tol);
+
+/** Register status callback
+ *
+ *  \param[in]         p   decolbfgs plan
+ *  \param[in]  callback   Callback function
+ *  \param[in]  userdata   User defined data
+ *
+ * #### Versions #
+ * <tt>
+ * phaseret_decolbfgs_set_status_callback_d(phaseret_decolbfgs_plan_d* p,
+ *                                          phaseret_decolbfgs_callback_status_d* callback,
+ *                                          void* userdata);
+ *
+ * phaseret_decolbfgs_set_status_callback_s(phaseret_decolbfgs_plan_s* p,
+ *                                          phaseret_decolbfgs_callback_status_s* callback,
+ *                                          void* userdata);
+ * </tt>
+ *  \returns
+ *  Status code           | Description
+ *  ----------------------|-----------------------
+ *  LTFATERR_SUCCESS      | No error occurred
+ *  LTFATERR_NULLPOINTER  | \a p or \a callback was NULL
+ */
+PHASERET_API int
+PHASERET_NAME(decolbfgs_set_status_callback)(PHASERET_NAME(decolbfgs_plan)* p,
+        PHASERET_NAME(decolbfgs_callback_status)* callback,
+        void* userdata);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
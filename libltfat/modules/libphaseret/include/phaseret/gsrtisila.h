@@ -34,6 +34,13 @@ PHASERET_NAME(gsrtisilaupdate_execute)(PHASERET_NAME(gsrtisilaupdate_plan)* p,
                                        LTFAT_REAL* frames2, LTFAT_COMPLEX* cframes2,
                                        LTFAT_COMPLEX* c);
 
+PHASERET_API int
+PHASERET_NAME(gsrtisilaupdate_set_timebudget)(PHASERET_NAME(gsrtisilaupdate_plan)* p,
+                                              long long timebudget);
+
+PHASERET_API ltfat_int
+PHASERET_NAME(gsrtisilaupdate_get_itdone)(PHASERET_NAME(gsrtisilaupdate_plan)* p);
+
 PHASERET_API int
 PHASERET_NAME(gsrtisila_init_win)(LTFAT_FIRWIN win, ltfat_int gl, ltfat_int W,
                                   ltfat_int a, ltfat_int M, ltfat_int lookahead, ltfat_int maxit,
@@ -64,6 +71,19 @@ PHASERET_API int
 PHASERET_NAME(gsrtisila_set_itno)(PHASERET_NAME(gsrtisila_state)* p,
                                   ltfat_int it);
 
+/** Set per-frame time budget in nanoseconds (0 disables it)
+ *
+ * Works the same way as rtisila_set_timebudget.
+ */
+PHASERET_API int
+PHASERET_NAME(gsrtisila_set_timebudget)(PHASERET_NAME(gsrtisila_state)* p,
+                                        long long timebudget);
+
+/** Get number of iterations achieved in the last frame
+ */
+PHASERET_API ltfat_int
+PHASERET_NAME(gsrtisila_get_lastitno)(PHASERET_NAME(gsrtisila_state)* p);
+
 PHASERET_API int
 PHASERET_NAME(gsrtisila_set_skipinitialization)(PHASERET_NAME(gsrtisila_state)* p,
         int do_skipinitialization);
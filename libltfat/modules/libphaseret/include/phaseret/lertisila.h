@@ -0,0 +1,279 @@
+#ifndef LTFAT_NOSYSTEMHEADERS
+#include "ltfat.h"
+#include "ltfat/types.h"
+#endif
+
+#ifndef _phaseret_lertisila_h
+#define _phaseret_lertisila_h
+// place for non-templated structs, enums, functions etc.
+#endif /* _phaseret_lertisila_h */
+
+#include "phaseret/types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct PHASERET_NAME(lertisila_state) PHASERET_NAME(lertisila_state);
+
+/** \addtogroup lertisila
+ *  @{
+ *
+ */
+
+/** Create a LeRTISILA state.
+ *
+ * The phase update is done directly in the coefficient domain using truncated
+ * projection kernels of size (2*lookback+1) x (2*lookback+1), where
+ * lookback = max(lookahead, ceil(gl/a)-1).
+ *
+ * \param[in]     g            Analysis window
+ * \param[in]     gl           Window length
+ * \param[in]     W            Number of signal channels
+ * \param[in]     a            Hop size
+ * \param[in]     M            Number of frequency channels (FFT length)
+ * \param[in]     lookahead    (Maximum) number of lookahead frames
+ * \param[in]     maxit        Number of iterations. The number of per-frame
+ *                             iterations is (lookahead+1) * maxit.
+ * \param[out]    p            LeRTISILA state
+ *
+ * #### Versions #
+ * <tt>
+ * phaseret_lertisila_init_d(const double g[], ltfat_int gl, ltfat_int W,
+ *                           ltfat_int a, ltfat_int M, ltfat_int lookahead,
+ *                           ltfat_int maxit, phaseret_lertisila_state_d** p);
+ *
+ * phaseret_lertisila_init_s(const float g[], ltfat_int gl, ltfat_int W,
+ *                           ltfat_int a, ltfat_int M, ltfat_int lookahead,
+ *                           ltfat_int maxit, phaseret_lertisila_state_s** p);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p or \a g was NULL
+ * LTFATERR_BADARG          | \a lookahead was a negative number
+ * LTFATERR_BADSIZE         | \a gl was not positive or the kernel is taller than M/2+1
+ * LTFATERR_NOTPOSARG       | One of the following was not positive: \a W, \a a, \a M, \a maxit
+ * LTFATERR_NOTAFRAME       | System is not a frame.
+ * LTFATERR_NOTPAINLESS     | System is not painless.
+ * LTFATERR_INITFAILED      | FFTW plan creation failed
+ * LTFATERR_NOMEM           | Indentifies that heap allocation failed
+ */
+PHASERET_API int
+PHASERET_NAME(lertisila_init)(const LTFAT_REAL g[], ltfat_int gl, ltfat_int W,
+                              ltfat_int a, ltfat_int M, ltfat_int lookahead, ltfat_int maxit,
+                              PHASERET_NAME(lertisila_state)** p);
+
+/** Create a LeRTISILA state from a window.
+ * \param[in]     win          Analysis window
+ * \param[in]     gl           Window length
+ * \param[in]     W            Number of signal channels
+ * \param[in]     a            Hop size
+ * \param[in]     M            Number of frequency channels (FFT length)
+ * \param[in]     lookahead    (Maximum) number of lookahead frames
+ * \param[in]     maxit        Number of iterations. The number of per-frame
+ *                             iterations is (lookahead+1) * maxit.
+ * \param[out]    p            LeRTISILA state
+ *
+ * #### Versions #
+ * <tt>
+ * phaseret_lertisila_init_win_d(LTFAT_FIRWIN win, ltfat_int gl, ltfat_int W,
+ *                               ltfat_int a, ltfat_int M, ltfat_int lookahead,
+ *                               ltfat_int maxit, phaseret_lertisila_state_d** p);
+ *
+ * phaseret_lertisila_init_win_s(LTFAT_FIRWIN win, ltfat_int gl, ltfat_int W,
+ *                               ltfat_int a, ltfat_int M, ltfat_int lookahead,
+ *                               ltfat_int maxit, phaseret_lertisila_state_s** p);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_CANNOTHAPPEN    | \a win is not a valid value from the \a LTFAT_FIRWIN enum
+ * LTFATERR_NULLPOINTER     | \a p was NULL
+ * LTFATERR_BADARG          | \a lookahead was a negative number
+ * LTFATERR_BADSIZE         | \a gl was not positive or the kernel is taller than M/2+1
+ * LTFATERR_NOTPOSARG       | One of the following was not positive: \a W, \a a, \a M, \a maxit
+ * LTFATERR_NOTAFRAME       | System is not a frame.
+ * LTFATERR_NOTPAINLESS     | System is not painless.
+ * LTFATERR_INITFAILED      | FFTW plan creation failed
+ * LTFATERR_NOMEM           | Indentifies that heap allocation failed
+ */
+PHASERET_API int
+PHASERET_NAME(lertisila_init_win)(LTFAT_FIRWIN win, ltfat_int gl, ltfat_int W,
+                                  ltfat_int a, ltfat_int M, ltfat_int lookahead,
+                                  ltfat_int maxit, PHASERET_NAME(lertisila_state)** p);
+
+/** Change number of lookahead frames
+ *
+ * The number of frames can only be less or equal to the number of lookahead frames
+ * specified in the init function.
+ *
+ * \note This is not thread safe.
+ *
+ * \param[in] p          LeRTISILA state
+ * \param[in] lookahead  Number of lookahead frame
+ *
+ * #### Versions #
+ * <tt>
+ * phaseret_lertisila_set_lookahead_d(phaseret_lertisila_state_d* p, ltfat_int lookahead);
+ *
+ * phaseret_lertisila_set_lookahead_s(phaseret_lertisila_state_s* p, ltfat_int lookahead);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p was NULL
+ * LTFATERR_BADARG          | \a lookahead was a negative number or greater than max lookahead
+ */
+PHASERET_API int
+PHASERET_NAME(lertisila_set_lookahead)(PHASERET_NAME(lertisila_state)* p, ltfat_int lookahead);
+
+/** Change number of iterations
+ *
+ * \param[in] p          LeRTISILA state
+ * \param[in] it         Number of iterations
+ *
+ * #### Versions #
+ * <tt>
+ * phaseret_lertisila_set_itno_d(phaseret_lertisila_state_d* p, ltfat_int it);
+ *
+ * phaseret_lertisila_set_itno_s(phaseret_lertisila_state_s* p, ltfat_int it);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p was NULL
+ * LTFATERR_BADARG          | \a it was not positive
+ */
+PHASERET_API int
+PHASERET_NAME(lertisila_set_itno)(PHASERET_NAME(lertisila_state)* p, ltfat_int it);
+
+/** Execute LeRTISILA for a single time frame
+ *
+ *  The function is intended to be called for consecutive stream of frames
+ *  as it reuses some data from the previous frames stored in the state.
+ *  No FFTs are computed, the frames are updated in the coefficient domain.
+ *
+ *  \a c is lagging behind \a s by \a lookahead frames.
+ *
+ *  M2=M/2+1
+ *
+ * \param[in]       p   LeRTISILA state
+ * \param[in]       s   Target magnitude, size M2 x W
+ * \param[out]      c   Reconstructed coefficients, size M2 x W
+ *
+ * #### Versions #
+ * <tt>
+ * phaseret_lertisila_execute_d(phaseret_lertisila_state_d* p, const double s[],
+ *                              ltfat_complex_d c[]);
+ *
+ * phaseret_lertisila_execute_s(phaseret_lertisila_state_s* p, const float s[],
+ *                              ltfat_complex_s c[]);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the following was NULL: \a p, \a s, \a c
+ */
+PHASERET_API int
+PHASERET_NAME(lertisila_execute)(PHASERET_NAME(lertisila_state)* p,
+                                 const LTFAT_REAL s[], LTFAT_COMPLEX c[]);
+
+/** Reset buffers of LeRTISILA state
+ *
+ * \param[in] p      LeRTISILA state
+ * \param[in] sinit  Array of W pointers to the initial lookahead frames
+ *                   (M2 x lookahead each) or NULL
+ *
+ * #### Versions #
+ * <tt>
+ * phaseret_lertisila_reset_d(phaseret_lertisila_state_d* p, const double** sinit);
+ *
+ * phaseret_lertisila_reset_s(phaseret_lertisila_state_s* p, const float** sinit);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p was NULL
+ */
+PHASERET_API int
+PHASERET_NAME(lertisila_reset)(PHASERET_NAME(lertisila_state)* p, const LTFAT_REAL** sinit);
+
+/** Destroy LeRTISILA state
+ * \param[in]  p  LeRTISILA state
+ *
+ * #### Versions #
+ * <tt>
+ * phaseret_lertisila_done_d(phaseret_lertisila_state_d** p);
+ *
+ * phaseret_lertisila_done_s(phaseret_lertisila_state_s** p);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p or \a *p was NULL
+ */
+PHASERET_API int
+PHASERET_NAME(lertisila_done)(PHASERET_NAME(lertisila_state)** p);
+
+/** Do LeRTISILA for a complete magnitude spectrogram and compensate delay
+ *
+ * This function just creates a state object, executes it for each
+ * frame in \a s and destroys it.
+ *
+ * M2=M/2+1
+ * N=L/a
+ *
+ * \param[in]     s          Magnitude of coefficients, size M2 x N x W
+ * \param[in]     g          Analysis window
+ * \param[in]     L          Transform length
+ * \param[in]     gl         Window length
+ * \param[in]     W          Number of signal channels
+ * \param[in]     a          Hop size
+ * \param[in]     M          FFT length, also length of all the windows
+ * \param[in]     lookahead  Number of lookahead frames
+ * \param[in]     maxit      Number of iterations
+ * \param[out]    c          Reconstructed coefficients, size M2 x N x W
+ *
+ * #### Versions #
+ * <tt>
+ * phaseret_lertisilaoffline_d(const double s[], const double g[],
+ *                             ltfat_int L, ltfat_int gl, ltfat_int W,
+ *                             ltfat_int a, ltfat_int M, ltfat_int lookahead,
+ *                             ltfat_int maxit, ltfat_complex_d c[]);
+ *
+ * phaseret_lertisilaoffline_s(const float s[], const float g[],
+ *                             ltfat_int L, ltfat_int gl, ltfat_int W,
+ *                             ltfat_int a, ltfat_int M, ltfat_int lookahead,
+ *                             ltfat_int maxit, ltfat_complex_s c[]);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the following was NULL: \a c, \a g, \a s
+ * LTFATERR_BADARG          | \a lookahead was a negative number
+ * LTFATERR_BADSIZE         | \a gl was not positive or the kernel is taller than M/2+1
+ * LTFATERR_NOTPOSARG       | One of the following was not positive: \a W, \a a, \a M, \a maxit
+ * LTFATERR_NOTAFRAME       | System is not a frame.
+ * LTFATERR_NOTPAINLESS     | System is not painless.
+ * LTFATERR_INITFAILED      | FFTW plan creation failed
+ * LTFATERR_NOMEM           | Indentifies that heap allocation failed
+ */
+PHASERET_API int
+PHASERET_NAME(lertisilaoffline)(const LTFAT_REAL s[], const LTFAT_REAL g[],
+                                ltfat_int L, ltfat_int gl, ltfat_int W, ltfat_int a, ltfat_int M,
+                                ltfat_int lookahead, ltfat_int maxit, LTFAT_COMPLEX c[]);
+
+/** @}*/
+
+#ifdef __cplusplus
+}
+#endif
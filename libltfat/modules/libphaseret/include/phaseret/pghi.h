@@ -157,6 +157,41 @@ PHASERET_NAME(pghi_init)(ltfat_int L, ltfat_int W, ltfat_int a, ltfat_int M,
 PHASERET_API int
 PHASERET_NAME(pghi_execute)(PHASERET_NAME(pghi_plan)* p, const LTFAT_REAL s[], LTFAT_COMPLEX c[]);
 
+/** Execute PGHI plan with planar output
+ *
+ * As phaseret_pghi_execute(), but the real and imaginary parts of the
+ * output are stored in separate arrays. The phase is reconstructed
+ * directly in \a ci and combined with the magnitude without any
+ * interleaving.
+ *
+ * M2 = M/2 + 1, N = L/a
+ *
+ * \param[in]      p  PGHI plan
+ * \param[in]      s  Target magnitude of coefficients, size M2 x N X W
+ * \param[out]    cr  Real parts of the output coefficients, size M2 x N X W
+ * \param[out]    ci  Imaginary parts of the output coefficients, size M2 x N X W
+ *
+ * \note \a cr can be equal to \a s.
+ *
+ * #### Versions #
+ * <tt>
+ * phaseret_pghi_execute_planar_d(phaseret_pghi_plan_d* p,
+ *                                const double s[], double cr[], double ci[]);
+ *
+ * phaseret_pghi_execute_planar_s(phaseret_pghi_plan_s* p,
+ *                                const float s[], float cr[], float ci[]);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | Indicates that at least one of the following was NULL: \a p, \a s, \a cr, \a ci
+ * LTFATERR_BADARG          | \a ci was equal to \a s
+ */
+PHASERET_API int
+PHASERET_NAME(pghi_execute_planar)(PHASERET_NAME(pghi_plan)* p, const LTFAT_REAL s[],
+                                   LTFAT_REAL cr[], LTFAT_REAL ci[]);
+
 /** Execute PGHI plan with respect to mask
  *
  * M2 = M/2 + 1, N = L/a
@@ -218,6 +253,10 @@ void
 PHASERET_NAME(pghimagphase)(const LTFAT_REAL s[], const LTFAT_REAL phase[],
                             ltfat_int L, LTFAT_COMPLEX c[]);
 
+void
+PHASERET_NAME(pghimagphase_planar)(const LTFAT_REAL s[], const LTFAT_REAL phase[],
+                                   ltfat_int L, LTFAT_REAL cr[], LTFAT_REAL ci[]);
+
 void
 PHASERET_NAME(pghilog)(const LTFAT_REAL in[], ltfat_int L, LTFAT_REAL out[]);
 
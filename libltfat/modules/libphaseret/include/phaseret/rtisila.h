@@ -91,6 +91,24 @@ PHASERET_NAME(rtisilaupdate_execute)(PHASERET_NAME(rtisilaupdate_plan)* p, const
                                      const LTFAT_REAL* s, ltfat_int lookahead, ltfat_int maxit, LTFAT_REAL* frames2,
                                      LTFAT_COMPLEX* c);
 
+/** Set time budget of a single rtisilaupdate_execute call
+ *
+ * With nonzero \a timebudget, rtisilaupdate_execute stops before
+ * doing \a maxit iterations if the next iteration is not expected to finish
+ * in time. At least one iteration is always done.
+ *
+ * \param[in] p           RTISILA Update Plan
+ * \param[in] timebudget  Time budget in nanoseconds, 0 disables the budget
+ */
+PHASERET_API int
+PHASERET_NAME(rtisilaupdate_set_timebudget)(PHASERET_NAME(rtisilaupdate_plan)* p,
+                                            long long timebudget);
+
+/** Number of iterations done in the last rtisilaupdate_execute call
+ */
+PHASERET_API ltfat_int
+PHASERET_NAME(rtisilaupdate_get_itdone)(PHASERET_NAME(rtisilaupdate_plan)* p);
+
 /** Do maxit iterations of RTISI-LA for a single frame
  *
  * This function just creates a plan, executes it and destroys it.
@@ -243,6 +261,55 @@ PHASERET_NAME(rtisila_set_lookahead)(PHASERET_NAME(rtisila_state)* p, ltfat_int
 PHASERET_API int
 PHASERET_NAME(rtisila_set_itno)(PHASERET_NAME(rtisila_state)* p, ltfat_int it);
 
+/** Set per-frame time budget
+ *
+ * Enables the adaptive mode, in which the number of iterations is not fixed,
+ * but it is limited by the time spent in rtisila_execute. The iterations
+ * are stopped when the next one is not expected to fit in the budget.
+ * The number of iterations set in rtisila_init or rtisila_set_itno is then
+ * the upper limit. At least one iteration is always done. The budget is
+ * shared by all \a W channels. The time is measured using a monotonic clock.
+ *
+ * \note This is not thread safe.
+ *
+ * \param[in] p           RTISILA Plan
+ * \param[in] timebudget  Time budget in nanoseconds, 0 disables the adaptive mode
+ *
+ * #### Versions #
+ * <tt>
+ * phaseret_rtisila_set_timebudget_d(phaseret_rtisila_state_d* p, long long timebudget);
+ *
+ * phaseret_rtisila_set_timebudget_s(phaseret_rtisila_state_s* p, long long timebudget);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p was NULL
+ * LTFATERR_BADARG          | \a timebudget was a negative number
+ *
+ * \see rtisila_get_lastitno
+ */
+PHASERET_API int
+PHASERET_NAME(rtisila_set_timebudget)(PHASERET_NAME(rtisila_state)* p, long long timebudget);
+
+/** Get number of iterations achieved in the last frame
+ *
+ * When the state processes more channels, it is the minimum over the channels.
+ *
+ * \param[in] p   RTISILA Plan
+ *
+ * #### Versions #
+ * <tt>
+ * phaseret_rtisila_get_lastitno_d(phaseret_rtisila_state_d* p);
+ *
+ * phaseret_rtisila_get_lastitno_s(phaseret_rtisila_state_s* p);
+ * </tt>
+ * \returns Number of iterations or LTFATERR_NULLPOINTER if \a p was NULL
+ */
+PHASERET_API ltfat_int
+PHASERET_NAME(rtisila_get_lastitno)(PHASERET_NAME(rtisila_state)* p);
+
 /** Execute RTISILA plan for a single time frame
  *
  *  The function is intedned to be called for consecutive stream of frames
@@ -92,6 +92,108 @@ PHASERET_NAME(spsi_withmask)(const LTFAT_COMPLEX cin[], const int mask[], ltfat_
                              LTFAT_REAL initphase[], LTFAT_COMPLEX c[]);
 
 
+/** Real-time SPSI state
+ *
+ * Serves for storing the phase of the previous frame between calls to
+ * rtspsi_execute.
+ */
+typedef struct PHASERET_NAME(rtspsi_state) PHASERET_NAME(rtspsi_state);
+
+/** Create a real-time SPSI state
+ *
+ * SPSI needs only the phase of the previous frame, therefore the
+ * reconstruction has no lookahead and no delay. No memory is allocated
+ * in rtspsi_execute.
+ *
+ * \param[in]     W            Number of channels
+ * \param[in]     a            Hop size
+ * \param[in]     M            Number of frequency channels (FFT length)
+ * \param[out]    p            RTSPSI state
+ *
+ * #### Versions #
+ * <tt>
+ * phaseret_rtspsi_init_d(ltfat_int W, ltfat_int a, ltfat_int M,
+ *                        phaseret_rtspsi_state_d** p);
+ *
+ * phaseret_rtspsi_init_s(ltfat_int W, ltfat_int a, ltfat_int M,
+ *                        phaseret_rtspsi_state_s** p);
+ * </tt>
+ *  \returns
+ *  Status code          |  Description
+ *  ---------------------|---------------------
+ *  LTFATERR_SUCCESS     | No error occurred
+ *  LTFATERR_NULLPOINTER | \a p was NULL
+ *  LTFATERR_NOTPOSARG   | At least one of the following was not positive: \a W, \a a, \a M
+ *  LTFATERR_NOMEM       | Heap allocation failed
+ */
+PHASERET_API int
+PHASERET_NAME(rtspsi_init)(ltfat_int W, ltfat_int a, ltfat_int M,
+                           PHASERET_NAME(rtspsi_state)** p);
+
+/** Reset RTSPSI state
+ *
+ * Sets phase of the previous frame to zero or to the provided values.
+ *
+ * \param[in] p          RTSPSI state
+ * \param[in] phaseinit  Array of W pointers to phase of the -1 frame, each
+ *                       of length M2. Both the array and the individual
+ *                       pointers can be NULL meaning zero phase.
+ *
+ * #### Versions #
+ * <tt>
+ * phaseret_rtspsi_reset_d(phaseret_rtspsi_state_d* p, const double** phaseinit);
+ *
+ * phaseret_rtspsi_reset_s(phaseret_rtspsi_state_s* p, const float** phaseinit);
+ * </tt>
+ * \returns Status code
+ */
+PHASERET_API int
+PHASERET_NAME(rtspsi_reset)(PHASERET_NAME(rtspsi_state)* p,
+                            const LTFAT_REAL** phaseinit);
+
+/** Execute RTSPSI for a single frame
+ *
+ *  The function is intended to be called for consecutive stream of frames
+ *  as it uses the phase of the previous frame stored in the state.
+ *  The output is not delayed.
+ *
+ * \param[in]       p   RTSPSI state
+ * \param[in]       s   Target magnitude, size M2 x W
+ * \param[out]      c   Reconstructed coefficients, size M2 x W.
+ *                      Can be equal to \a s (in-place), provided it has
+ *                      room for M2 x W complex numbers.
+ *
+ * #### Versions #
+ * <tt>
+ * phaseret_rtspsi_execute_d(phaseret_rtspsi_state_d* p, const double s[],
+ *                           ltfat_complex_d c[]);
+ *
+ * phaseret_rtspsi_execute_s(phaseret_rtspsi_state_s* p, const float s[],
+ *                           ltfat_complex_s c[]);
+ * </tt>
+ *  \returns
+ *  Status code          |  Description
+ *  ---------------------|---------------------
+ *  LTFATERR_SUCCESS     | No error occurred
+ *  LTFATERR_NULLPOINTER | \a p, \a s or \a c was NULL
+ */
+PHASERET_API int
+PHASERET_NAME(rtspsi_execute)(PHASERET_NAME(rtspsi_state)* p,
+                              const LTFAT_REAL s[], LTFAT_COMPLEX c[]);
+
+/** Destroy a RTSPSI state
+ * \param[in] p  RTSPSI state
+ *
+ * #### Versions #
+ * <tt>
+ * phaseret_rtspsi_done_d(phaseret_rtspsi_state_d** p);
+ *
+ * phaseret_rtspsi_done_s(phaseret_rtspsi_state_s** p);
+ * </tt>
+ */
+PHASERET_API int
+PHASERET_NAME(rtspsi_done)(PHASERET_NAME(rtspsi_state)** p);
+
 /** \} */
 void
 PHASERET_NAME(spsiupdate)(const LTFAT_REAL* scol, ltfat_int stride, ltfat_int a, ltfat_int M, LTFAT_REAL* tmpphase);
@@ -0,0 +1,277 @@
+#include "phaseret/decolbfgs.h"
+#include "phaseret/utils.h"
+#include "ltfat/macros.h"
+#include "lbfgs_private.h"
+
+struct PHASERET_NAME(decolbfgs_plan)
+{
+    LTFAT_NAME(dgtreal_plan)* p; //!< Analysis and adjoint synthesis (both with g)
+    PHASERET_NAME(lbfgs_plan)* lbfgs;
+    PHASERET_NAME(decolbfgs_callback_status)* status_callback;
+    void* status_callback_userdata;
+    double pexp;
+    LTFAT_REAL* sp;        //!< Target magnitude to the power of pexp
+    LTFAT_REAL* f;         //!< Current signal estimate
+    LTFAT_COMPLEX* cbuf;   //!< Coefficient buffer used by the objective function
+// Storing cinit
+    const LTFAT_COMPLEX* cinit;
+    LTFAT_COMPLEX* c;
+};
+
+/* Interior frequency channels appear twice in the full spectrum */
+static inline LTFAT_REAL
+PHASERET_NAME(decolbfgs_chanweight)(ltfat_int m, ltfat_int M)
+{
+    return (m == 0 || 2 * m == M) ? 1.0 : 2.0;
+}
+
+/* Objective sum(w.*(|c|^p - s^p).^2) and its gradient with respect to f,
+ * which is the adjoint synthesis of 2p*w.*(|c|^p - s^p).*|c|^(p-2).*c
+ * (the factor w is implicit in the real synthesis). */
+static int
+PHASERET_NAME(decolbfgs_objfun)(void* userdata, const LTFAT_REAL f[],
+                                double* fval, LTFAT_REAL grad[])
+{
+    PHASERET_NAME(decolbfgs_plan)* p = (PHASERET_NAME(decolbfgs_plan)*) userdata;
+    int status = LTFATERR_SUCCESS;
+    ltfat_int M = LTFAT_NAME(dgtreal_get_M)(p->p);
+    ltfat_int L = LTFAT_NAME(dgtreal_get_L)(p->p);
+    ltfat_int W = LTFAT_NAME(dgtreal_get_W)(p->p);
+    ltfat_int a = LTFAT_NAME(dgtreal_get_a)(p->p);
+    ltfat_int M2 = M / 2 + 1;
+    ltfat_int NW = L / a * W;
+    LTFAT_REAL pexp = (LTFAT_REAL) p->pexp;
+    double acc = 0.0;
+
+    CHECKSTATUS(
+        LTFAT_NAME(dgtreal_execute_ana_newarray)(p->p, f, p->cbuf));
+
+    for (ltfat_int n = 0; n < NW; n++)
+    {
+        LTFAT_COMPLEX* cCol = p->cbuf + n * M2;
+        const LTFAT_REAL* spCol = p->sp + n * M2;
+
+        for (ltfat_int m = 0; m < M2; m++)
+        {
+            LTFAT_REAL absc = ltfat_abs(cCol[m]);
+            LTFAT_REAL absp = pow(absc, pexp);
+            LTFAT_REAL inner = absp - spCol[m];
+
+            acc += PHASERET_NAME(decolbfgs_chanweight)(m, M) * inner * inner;
+
+            if (absc > 0)
+                cCol[m] *= 2 * pexp * inner * absp / (absc * absc);
+            else
+                cCol[m] = LTFAT_COMPLEX(0, 0);
+        }
+    }
+
+    CHECKSTATUS(
+        LTFAT_NAME(dgtreal_execute_syn_newarray)(p->p, p->cbuf, grad));
+
+    *fval = acc;
+error:
+    return status;
+}
+
+PHASERET_API int
+PHASERET_NAME(decolbfgs)(const LTFAT_COMPLEX cinit[], const LTFAT_REAL g[],
+                         ltfat_int L, ltfat_int gl, ltfat_int W,
+                         ltfat_int a, ltfat_int M, ltfat_int iter, LTFAT_COMPLEX c[])
+{
+    PHASERET_NAME(decolbfgs_plan)* p = NULL;
+    int status = LTFATERR_SUCCESS;
+
+    CHECKSTATUS(
+        PHASERET_NAME(decolbfgs_init)(cinit, g, L, gl, W, a, M, 2.0 / 3.0, 10,
+                                      c, NULL, &p));
+
+    CHECKSTATUS( PHASERET_NAME(decolbfgs_execute)(p, iter));
+
+error:
+    if (p) PHASERET_NAME(decolbfgs_done)(&p);
+    return status;
+}
+
+PHASERET_API int
+PHASERET_NAME(decolbfgs_init)(const LTFAT_COMPLEX cinit[], const LTFAT_REAL g[],
+                              ltfat_int L, ltfat_int gl, ltfat_int W, ltfat_int a,
+                              ltfat_int M, double pexp, ltfat_int histlen,
+                              LTFAT_COMPLEX c[], ltfat_dgt_params* params,
+                              PHASERET_NAME(decolbfgs_plan)** pout)
+{
+    int status = LTFATERR_SUCCESS;
+    PHASERET_NAME(decolbfgs_plan)* p = NULL;
+    ltfat_int N, M2;
+
+    CHECKNULL(g); CHECKNULL(pout);
+    CHECK(LTFATERR_BADSIZE, L > 0, "L must be positive (passed %d)", L);
+    CHECK(LTFATERR_NOTPOSARG, a > 0, "a must be positive (passed %d)", a);
+    CHECK(LTFATERR_NOTPOSARG, M > 0, "M must be positive (passed %d)", M);
+    CHECK(LTFATERR_NOTPOSARG, W > 0, "W must be positive (passed %d)", W);
+    CHECK(LTFATERR_NOTPOSARG, pexp > 0.0, "pexp must be positive");
+    CHECK(LTFATERR_NOTPOSARG, histlen > 0,
+          "histlen must be positive (passed %d)", histlen);
+
+    N = L / a;
+    M2 = M / 2 + 1;
+
+    CHECKMEM( p = (PHASERET_NAME(decolbfgs_plan)*) ltfat_calloc(1, sizeof * p));
+    CHECKMEM( p->sp = LTFAT_NAME_REAL(malloc)(M2 * N * W));
+    CHECKMEM( p->f = LTFAT_NAME_REAL(malloc)(L * W));
+    CHECKMEM( p->cbuf = LTFAT_NAME_COMPLEX(malloc)(M2 * N * W));
+    p->pexp = pexp;
+
+    CHECKSTATUS(
+        LTFAT_NAME(dgtreal_init_gen)(g, gl, g, gl, L, W, a, M, p->f, p->cbuf,
+                                     params, &p->p));
+
+    CHECKSTATUS(
+        PHASERET_NAME(lbfgs_init)(L * W, histlen,
+                                  PHASERET_NAME(decolbfgs_objfun), p, &p->lbfgs));
+
+    p->cinit = cinit; p->c = c;
+
+    *pout = p;
+    return status;
+error:
+    if (p) PHASERET_NAME(decolbfgs_done)(&p);
+    return status;
+}
+
+PHASERET_API int
+PHASERET_NAME(decolbfgs_done)(PHASERET_NAME(decolbfgs_plan)** p)
+{
+    PHASERET_NAME(decolbfgs_plan)* pp = NULL;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(*p);
+    pp = *p;
+
+    if (pp->p)
+        CHECKSTATUS(
+            LTFAT_NAME(dgtreal_done)(&pp->p));
+
+    if (pp->lbfgs)
+        PHASERET_NAME(lbfgs_done)(&pp->lbfgs);
+
+    ltfat_safefree(pp->sp);
+    ltfat_safefree(pp->f);
+    ltfat_safefree(pp->cbuf);
+    ltfat_free(pp);
+    *p = NULL;
+error:
+    return status;
+}
+
+PHASERET_API int
+PHASERET_NAME(decolbfgs_execute_newarray)(PHASERET_NAME(decolbfgs_plan)* p,
+        const LTFAT_COMPLEX cinit[], ltfat_int iter, LTFAT_COMPLEX cout[])
+{
+    int status = LTFATERR_SUCCESS;
+    ltfat_int M, L, W, a, M2, N;
+    double num = 0.0, den = 0.0;
+    LTFAT_REAL pexp;
+    CHECKNULL(p); CHECKNULL(cinit); CHECKNULL(cout);
+    CHECK(LTFATERR_NOTPOSARG, iter > 0,
+          "At least one iteration is requred. Passed %d.", iter);
+
+    M = LTFAT_NAME(dgtreal_get_M)(p->p);
+    L = LTFAT_NAME(dgtreal_get_L)(p->p);
+    W = LTFAT_NAME(dgtreal_get_W)(p->p);
+    a = LTFAT_NAME(dgtreal_get_a)(p->p);
+    M2 = M / 2 + 1;
+    N = L / a;
+    pexp = (LTFAT_REAL) p->pexp;
+
+    // Store the magnitude raised to pexp
+    for (ltfat_int ii = 0; ii < N * M2 * W; ii++)
+        p->sp[ii] = pow(ltfat_abs(cinit[ii]), pexp);
+
+    // Initial signal by the adjoint synthesis. Synthesis might overwrite
+    // the input, so work on a copy.
+    memcpy(p->cbuf, cinit, (N * M2 * W) * sizeof * p->cbuf);
+    CHECKSTATUS( LTFAT_NAME(dgtreal_execute_syn_newarray)(p->p, p->cbuf, p->f));
+
+    // Scale it such that it minimizes the objective function along f
+    CHECKSTATUS( LTFAT_NAME(dgtreal_execute_ana_newarray)(p->p, p->f, p->cbuf));
+    for (ltfat_int n = 0; n < N * W; n++)
+        for (ltfat_int m = 0; m < M2; m++)
+        {
+            double cp = pow(ltfat_abs(p->cbuf[n * M2 + m]), pexp);
+            double wm = PHASERET_NAME(decolbfgs_chanweight)(m, M);
+            num += wm * cp * p->sp[n * M2 + m];
+            den += wm * cp * cp;
+        }
+
+    if (den > 0.0 && num > 0.0)
+    {
+        LTFAT_REAL scal = (LTFAT_REAL) pow(num / den, 1.0 / p->pexp);
+        for (ltfat_int l = 0; l < L * W; l++)
+            p->f[l] *= scal;
+    }
+
+    CHECKSTATUS( PHASERET_NAME(lbfgs_reset)(p->lbfgs, p->f));
+
+    for (ltfat_int ii = 0; ii < iter; ii++)
+    {
+        int stepstatus = PHASERET_NAME(lbfgs_step)(p->lbfgs, p->f);
+        CHECKSTATUS( stepstatus < 0 ? stepstatus : 0 );
+
+        // Status callback, optional premature exit
+        if (p->status_callback)
+        {
+            int retstatus = p->status_callback(p->p, p->status_callback_userdata,
+                                               p->f, L, W, a, M,
+                                               p->lbfgs->fval, ii);
+            if (retstatus > 0)
+                break;
+            else
+                CHECKSTATUS(retstatus);
+        }
+
+        if (stepstatus > 0)
+            break;
+    }
+
+    CHECKSTATUS( LTFAT_NAME(dgtreal_execute_ana_newarray)(p->p, p->f, cout));
+
+error:
+    return status;
+}
+
+PHASERET_API int
+PHASERET_NAME(decolbfgs_execute)(PHASERET_NAME(decolbfgs_plan)* p, ltfat_int iter)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+    CHECKSTATUS(
+        PHASERET_NAME(decolbfgs_execute_newarray)(p, p->cinit, iter, p->c));
+error:
+    return status;
+}
+
+PHASERET_API int
+PHASERET_NAME(decolbfgs_set_tol)(PHASERET_NAME(decolbfgs_plan)* p, double tol)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+    CHECK(LTFATERR_BADARG, tol >= 0.0, "tol cannot be negative");
+
+    p->lbfgs->tol = tol;
+error:
+    return status;
+}
+
+PHASERET_API int
+PHASERET_NAME(decolbfgs_set_status_callback)(PHASERET_NAME(decolbfgs_plan)* p,
+        PHASERET_NAME(decolbfgs_callback_status)* callback,
+        void* userdata)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(callback);
+
+    p->status_callback = callback;
+    p->status_callback_userdata = userdata;
+error:
+    return status;
+}
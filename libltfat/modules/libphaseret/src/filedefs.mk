@@ -1,9 +1,9 @@
-files += gla.c legla.c gsrtisila.c gsrtisilapghi.c pghi.c rtisila.c rtpghi.c spsi.c utils.c
+files += decolbfgs.c gla.c lbfgs.c legla.c lertisila.c gsrtisila.c gsrtisilapghi.c pghi.c rtisila.c rtpghi.c spsi.c utils.c
 files_notypechange += pghi_typeconstant.c legla_typeconstant.c
 
 DSLFLAGS = -lltfat
 DLFLAGS = -lltfatd
 SLFLAGS = -lltfatf
-CFLAGS+=-Imodules/libltfat/include
+CFLAGS+=-Imodules/libltfat/include -Imodules/libltfat/src
 extradepincludes:=\#include \"ltfat.h\"\n
 
@@ -56,6 +56,9 @@ PHASERET_NAME(gsrtisilaupdate_execute)(PHASERET_NAME(gsrtisilaupdate_plan)* p,
     ltfat_int M = p->M;
     ltfat_int gl = p->gl;
     ltfat_int M2 = M / 2 + 1;
+    int do_timed = p->timebudget > 0;
+    long long tstart = do_timed ? ltfat_monotonic_ns() : 0;
+    ltfat_int it;
 
     // If we are not working inplace ...
     if (frames != frames2)
@@ -69,8 +72,16 @@ PHASERET_NAME(gsrtisilaupdate_execute)(PHASERET_NAME(gsrtisilaupdate_plan)* p,
                                              cframes2 + (lookback + lookahead)*M2,
                                              frames2 + (lookback + lookahead)*gl);
 
-    for (ltfat_int it = 0; it < maxit; it++)
+    for (it = 0; it < maxit; it++)
     {
+        if (do_timed && it > 0)
+        {
+            // Stop if the next iteration is not expected to fit in the budget
+            long long elapsed = ltfat_monotonic_ns() - tstart;
+            if (elapsed + elapsed / it > p->timebudget)
+                break;
+        }
+
         for (ltfat_int nback = lookahead; nback >= 0; nback--)
         {
             ltfat_int indx = lookback + nback;
@@ -85,9 +96,31 @@ PHASERET_NAME(gsrtisilaupdate_execute)(PHASERET_NAME(gsrtisilaupdate_plan)* p,
         }
     }
 
+    p->itdone = it;
+
     if (c) memcpy(c, cframes2 + lookback * M2, M2 * sizeof * c);
 }
 
+PHASERET_API int
+PHASERET_NAME(gsrtisilaupdate_set_timebudget)(PHASERET_NAME(gsrtisilaupdate_plan)* p,
+                                              long long timebudget)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+    CHECK(LTFATERR_BADARG, timebudget >= 0, "timebudget cannot be negative.");
+
+    p->timebudget = timebudget;
+error:
+    return status;
+}
+
+PHASERET_API ltfat_int
+PHASERET_NAME(gsrtisilaupdate_get_itdone)(PHASERET_NAME(gsrtisilaupdate_plan)* p)
+{
+    if (p) return p->itdone;
+    else return LTFATERR_NULLPOINTER;
+}
+
 PHASERET_API int
 PHASERET_NAME(gsrtisila_init_win)(LTFAT_FIRWIN win, ltfat_int gl, ltfat_int W,
                                   ltfat_int a, ltfat_int M, ltfat_int lookahead, ltfat_int maxit,
@@ -177,11 +210,13 @@ PHASERET_NAME(gsrtisila_init)(const LTFAT_REAL* g, ltfat_int gl, ltfat_int W,
     ltfat_free(gcopy); gcopy = NULL;
     ltfat_free(wins); wins = NULL;
 
-    CHECKMEM( p->frames =
-                  LTFAT_NAME_REAL(calloc)(gl * (lookback + 1 + maxLookahead) * W));
+    // The window of lookback + 1 + lookahead frames slides along a buffer
+    // twice as long and it is moved back to the beginning only when it
+    // reaches the end.
+    p->bufN = 2 * (lookback + 1 + maxLookahead);
+    CHECKMEM( p->frames = LTFAT_NAME_REAL(calloc)(gl * p->bufN * W));
     CHECKMEM( p->s = LTFAT_NAME_REAL(calloc)( M2 * (1 + maxLookahead) * W));
-    CHECKMEM( p->cframes =
-                  LTFAT_NAME_COMPLEX(calloc)( M2 * (lookback + 1 + maxLookahead) * W));
+    CHECKMEM( p->cframes = LTFAT_NAME_COMPLEX(calloc)( M2 * p->bufN * W));
 
     CHECKSTATUS(
         PHASERET_NAME(gsrtisilaupdate_init)(gana, gd, gl, a, M, lookahead + 1, 1,
@@ -197,6 +232,7 @@ PHASERET_NAME(gsrtisila_init)(const LTFAT_REAL* g, ltfat_int gl, ltfat_int W,
     p->lookahead = lookahead;
     p->maxLookahead = maxLookahead;
     p->maxit = maxit;
+    p->lastitno = maxit;
     p->W = W;
 
     *pout = p;
@@ -210,11 +246,20 @@ error:
     return status;
 }
 
+LTFAT_COMPLEX*
+PHASERET_NAME(gsrtisila_cframes)(PHASERET_NAME(gsrtisila_state)* p, ltfat_int w)
+{
+    ltfat_int M2 = p->uplan->M / 2 + 1;
+    return p->cframes + (w * p->bufN + p->start) * M2;
+}
+
 PHASERET_API int
 PHASERET_NAME(gsrtisila_execute)(PHASERET_NAME(gsrtisila_state)* p,
                                  const LTFAT_REAL s[], LTFAT_COMPLEX c[])
 {
-    ltfat_int M, gl, M2, noFrames, N;
+    ltfat_int M, gl, M2, noFrames, bufN;
+    long long tstart = 0;
+    int do_rewind;
     int status = LTFATERR_SUCCESS;
     CHECKNULL(p); CHECKNULL(s); CHECKNULL(c);
 
@@ -222,25 +267,63 @@ PHASERET_NAME(gsrtisila_execute)(PHASERET_NAME(gsrtisila_state)* p,
     gl = p->uplan->gl;
     M2 = M / 2 + 1;
     noFrames = p->lookback + 1 + p->lookahead;
-    N = p->lookback + 1 + p->maxLookahead;
+    bufN = p->bufN;
+
+    // Advancing the window is just incrementing start unless the window
+    // would run over the end of the buffer.
+    do_rewind = p->start + 1 + noFrames > bufN;
+
+    if (p->timebudget > 0)
+        tstart = ltfat_monotonic_ns();
+
+    p->lastitno = p->maxit;
 
     for (ltfat_int w = 0; w < p->W; w++)
     {
+        if (p->timebudget > 0)
+        {
+            // Split what is left from the budget evenly among the remaining channels
+            long long timeleft =
+                p->timebudget - (ltfat_monotonic_ns() - tstart);
+            p->uplan->timebudget = timeleft > 0 ? timeleft / (p->W - w) : 1;
+        }
+
         const LTFAT_REAL* schan = s + w * M2;
         LTFAT_COMPLEX* cchan = c + w * M2;
-        LTFAT_REAL* frameschan = p->frames + w * N * gl;
-        LTFAT_COMPLEX* cframeschan = p->cframes + w * N * M2;
+        LTFAT_REAL* frameschan = p->frames + w * bufN * gl;
+        LTFAT_COMPLEX* cframeschan = p->cframes + w * bufN * M2;
         LTFAT_REAL* sframeschan = p->s + w * (1 + p->maxLookahead) * M2;
 
-        PHASERET_NAME(shiftcolsleft)(frameschan, gl, noFrames, NULL);
-        PHASERET_NAME_COMPLEX(shiftcolsleft)(cframeschan, M2, noFrames, cchan);
+        if (do_rewind)
+        {
+            // Move the frames which are kept to the beginning of the buffer
+            memmove(frameschan, frameschan + (p->start + 1) * gl,
+                    (noFrames - 1) * gl * sizeof * frameschan);
+            memmove(cframeschan, cframeschan + (p->start + 1) * M2,
+                    (noFrames - 1) * M2 * sizeof * cframeschan);
+        }
+        else
+        {
+            frameschan += (p->start + 1) * gl;
+            cframeschan += (p->start + 1) * M2;
+        }
+
+        // Initialize the newest frame
+        memset(frameschan + (noFrames - 1) * gl, 0, gl * sizeof * frameschan);
+        memcpy(cframeschan + (noFrames - 1) * M2, cchan, M2 * sizeof * cchan);
+
         PHASERET_NAME(shiftcolsleft)(sframeschan, M2, p->lookahead + 1, schan);
 
         PHASERET_NAME(gsrtisilaupdate_execute)(p->uplan, frameschan, cframeschan,
                                                noFrames, sframeschan, p->lookahead, p->maxit,
                                                frameschan, cframeschan, cchan);
+
+        if (p->uplan->itdone < p->lastitno)
+            p->lastitno = p->uplan->itdone;
     }
 
+    p->start = do_rewind ? 0 : p->start + 1;
+
 error:
     return status;
 }
@@ -279,18 +362,18 @@ PHASERET_API int
 PHASERET_NAME(gsrtisila_reset)(PHASERET_NAME(gsrtisila_state)* p,
                                const LTFAT_REAL** sinit)
 {
-    ltfat_int N, W, gl, M2;
+    ltfat_int W, gl, M2;
     int status = LTFATERR_SUCCESS;
     CHECKNULL(p);
 
-    N = p->lookback + 1 + p->maxLookahead;
     W = p->W;
     M2 = p->uplan->M / 2 + 1;
     gl = p->uplan->gl;
 
     memset(p->s, 0, M2 * (1 + p->maxLookahead) * W * sizeof * p->s);
-    memset(p->frames, 0, gl * N * W * sizeof * p->frames);
-    memset(p->cframes, 0, M2 * N * W * sizeof * p->cframes);
+    memset(p->frames, 0, gl * p->bufN * W * sizeof * p->frames);
+    memset(p->cframes, 0, M2 * p->bufN * W * sizeof * p->cframes);
+    p->start = 0;
 
     if (sinit)
         for (ltfat_int w = 0; w < W; w++)
@@ -344,6 +427,28 @@ error:
 
 }
 
+PHASERET_API int
+PHASERET_NAME(gsrtisila_set_timebudget)(PHASERET_NAME(gsrtisila_state)* p,
+                                        long long timebudget)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+    CHECK(LTFATERR_BADARG, timebudget >= 0, "timebudget cannot be negative.");
+
+    p->timebudget = timebudget;
+    // The per-channel budget of the update plan is set in gsrtisila_execute
+    p->uplan->timebudget = 0;
+error:
+    return status;
+}
+
+PHASERET_API ltfat_int
+PHASERET_NAME(gsrtisila_get_lastitno)(PHASERET_NAME(gsrtisila_state)* p)
+{
+    if (p) return p->lastitno;
+    else return LTFATERR_NULLPOINTER;
+}
+
 PHASERET_API int
 PHASERET_NAME(gsrtisilaoffline)(const LTFAT_REAL s[], const LTFAT_REAL g[],
                                 ltfat_int L, ltfat_int gl, ltfat_int W, ltfat_int a, ltfat_int M,
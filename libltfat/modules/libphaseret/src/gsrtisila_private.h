@@ -12,6 +12,8 @@ struct PHASERET_NAME(gsrtisilaupdate_plan)
     ltfat_int a;
     ltfat_int gNo;
     int do_skipinitialization;
+    long long timebudget; //!< Time budget for one execute call in ns, 0 means none
+    ltfat_int itdone;     //!< Number of iterations done in the last execute call
 };
 
 struct PHASERET_NAME(gsrtisila_state)
@@ -22,6 +24,10 @@ struct PHASERET_NAME(gsrtisila_state)
     ltfat_int lookback;
     ltfat_int maxit;
     ltfat_int W;
+    long long timebudget; //!< Per-frame time budget in ns, 0 means fixed maxit
+    ltfat_int lastitno;   //!< Iterations achieved in the last frame
+    ltfat_int bufN;     //!< Capacity of frames and cframes in frames (per channel)
+    ltfat_int start;    //!< Index of the oldest frame of the current window
     LTFAT_REAL* frames; //!< Buffer for time-domain frames
     LTFAT_COMPLEX* cframes; //!< Buffer for frequency-domain frames
     LTFAT_REAL* s; //!< Buffer for target magnitude
@@ -29,5 +35,10 @@ struct PHASERET_NAME(gsrtisila_state)
     ltfat_int garbageBinSize;
 };
 
+/* Frequency-domain frames of the current window (lookback + 1 + lookahead
+ * frames) of channel w. The window slides along the buffer, the pointer is
+ * valid until the next gsrtisila_execute or gsrtisila_reset call. */
+LTFAT_COMPLEX*
+PHASERET_NAME(gsrtisila_cframes)(PHASERET_NAME(gsrtisila_state)* p, ltfat_int w);
 
 #endif
@@ -94,7 +94,7 @@ PHASERET_NAME(gsrtisilapghi_execute)(PHASERET_NAME(gsrtisilapghi_state)* p,
     LTFAT_REAL* lastphase = NULL;
     CHECKNULL(p); CHECKNULL(s); CHECKNULL(c);
 
-    lastc = p->gsstate->cframes +
+    lastc = PHASERET_NAME(gsrtisila_cframes)(p->gsstate, 0) +
             (p->gsstate->lookback + p->gsstate->lookahead) * M2;
     lastphase = p->pghistate->phase;
 
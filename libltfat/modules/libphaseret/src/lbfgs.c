@@ -0,0 +1,279 @@
+#include "phaseret/utils.h"
+#include "ltfat/macros.h"
+#include "lbfgs_private.h"
+#include "simd_private.h"
+
+/* Wolfe conditions constants */
+#define LBFGS_C1 1e-4
+#define LBFGS_C2 0.9
+
+/* Number of elements summed in vector registers before the partial sums
+ * are added to the double accumulator */
+#define LBFGS_DOTBLOCK 1024
+
+static double
+PHASERET_NAME(lbfgs_dot)(const LTFAT_REAL a[], const LTFAT_REAL b[], ltfat_int n)
+{
+    double acc = 0.0;
+    LTFAT_REAL lanes[LTFAT_VLEN];
+    ltfat_int ii = 0;
+
+    while (n - ii >= LTFAT_VLEN)
+    {
+        ltfat_int blockend = ii + ltfat_imin(n - ii, LBFGS_DOTBLOCK) / LTFAT_VLEN * LTFAT_VLEN;
+        ltfat_vreal vacc = LTFAT_VSET1(0);
+
+        for (; ii < blockend; ii += LTFAT_VLEN)
+            vacc = LTFAT_VADD(vacc, LTFAT_VMUL(LTFAT_VLOAD(a + ii), LTFAT_VLOAD(b + ii)));
+
+        LTFAT_VSTORE(lanes, vacc);
+        for (ltfat_int l = 0; l < LTFAT_VLEN; l++)
+            acc += lanes[l];
+    }
+
+    for (; ii < n; ii++)
+        acc += a[ii] * b[ii];
+    return acc;
+}
+
+/* out = alpha*x + y, out may alias y */
+static void
+PHASERET_NAME(lbfgs_axpy)(LTFAT_REAL alpha, const LTFAT_REAL x[],
+                          const LTFAT_REAL y[], ltfat_int n, LTFAT_REAL out[])
+{
+    ltfat_vreal valpha = LTFAT_VSET1(alpha);
+    ltfat_int ii = 0;
+
+    for (; ii + LTFAT_VLEN <= n; ii += LTFAT_VLEN)
+        LTFAT_VSTORE(out + ii, LTFAT_VADD(LTFAT_VMUL(valpha, LTFAT_VLOAD(x + ii)),
+                                          LTFAT_VLOAD(y + ii)));
+
+    for (; ii < n; ii++)
+        out[ii] = alpha * x[ii] + y[ii];
+}
+
+static void
+PHASERET_NAME(lbfgs_scale)(LTFAT_REAL alpha, LTFAT_REAL x[], ltfat_int n)
+{
+    ltfat_vreal valpha = LTFAT_VSET1(alpha);
+    ltfat_int ii = 0;
+
+    for (; ii + LTFAT_VLEN <= n; ii += LTFAT_VLEN)
+        LTFAT_VSTORE(x + ii, LTFAT_VMUL(valpha, LTFAT_VLOAD(x + ii)));
+
+    for (; ii < n; ii++)
+        x[ii] *= alpha;
+}
+
+/* Search direction d = -H*grad using the two-loop recursion */
+static void
+PHASERET_NAME(lbfgs_direction)(PHASERET_NAME(lbfgs_plan)* p)
+{
+    ltfat_int n = p->n;
+    LTFAT_REAL* q = p->d;
+
+    memcpy(q, p->grad, n * sizeof * q);
+
+    // From the newest to the oldest pair
+    for (ltfat_int k = 0; k < p->histno; k++)
+    {
+        ltfat_int idx = (p->head - 1 - k + p->histlen) % p->histlen;
+        const LTFAT_REAL* s = p->S + idx * n;
+        const LTFAT_REAL* y = p->Y + idx * n;
+        double alpha = p->rho[idx] * PHASERET_NAME(lbfgs_dot)(s, q, n);
+
+        PHASERET_NAME(lbfgs_axpy)((LTFAT_REAL)( -alpha ), y, q, n, q);
+
+        p->alpha[idx] = alpha;
+    }
+
+    // Initial Hessian is gamma*I, gamma = s'*y/y'*y of the newest pair
+    if (p->histno > 0)
+    {
+        ltfat_int idx = (p->head - 1 + p->histlen) % p->histlen;
+        const LTFAT_REAL* y = p->Y + idx * n;
+        double gamma = 1.0 / (p->rho[idx] * PHASERET_NAME(lbfgs_dot)(y, y, n));
+
+        PHASERET_NAME(lbfgs_scale)((LTFAT_REAL) gamma, q, n);
+    }
+
+    // From the oldest to the newest pair
+    for (ltfat_int k = p->histno - 1; k >= 0; k--)
+    {
+        ltfat_int idx = (p->head - 1 - k + p->histlen) % p->histlen;
+        const LTFAT_REAL* s = p->S + idx * n;
+        const LTFAT_REAL* y = p->Y + idx * n;
+        double beta = p->rho[idx] * PHASERET_NAME(lbfgs_dot)(y, q, n);
+
+        PHASERET_NAME(lbfgs_axpy)((LTFAT_REAL)( p->alpha[idx] - beta ), s, q, n, q);
+    }
+
+    PHASERET_NAME(lbfgs_scale)(-1, q, n);
+}
+
+int
+PHASERET_NAME(lbfgs_init)(ltfat_int n, ltfat_int histlen,
+                          PHASERET_NAME(lbfgs_objfun)* objfun, void* userdata,
+                          PHASERET_NAME(lbfgs_plan)** pout)
+{
+    int status = LTFATERR_SUCCESS;
+    PHASERET_NAME(lbfgs_plan)* p = NULL;
+
+    CHECKNULL(objfun); CHECKNULL(pout);
+    CHECK(LTFATERR_NOTPOSARG, n > 0, "n must be positive (passed %d)", n);
+    CHECK(LTFATERR_NOTPOSARG, histlen > 0,
+          "histlen must be positive (passed %d)", histlen);
+
+    CHECKMEM( p = (PHASERET_NAME(lbfgs_plan)*) ltfat_calloc(1, sizeof * p));
+    p->objfun = objfun;
+    p->userdata = userdata;
+    p->n = n;
+    p->histlen = histlen;
+    p->tol = 1e-6;
+    p->maxls = 25;
+
+    CHECKMEM( p->S = LTFAT_NAME_REAL(malloc)(n * histlen));
+    CHECKMEM( p->Y = LTFAT_NAME_REAL(malloc)(n * histlen));
+    CHECKMEM( p->rho = (double*) ltfat_malloc(histlen * sizeof * p->rho));
+    CHECKMEM( p->alpha = (double*) ltfat_malloc(histlen * sizeof * p->alpha));
+    CHECKMEM( p->grad = LTFAT_NAME_REAL(malloc)(n));
+    CHECKMEM( p->gradnew = LTFAT_NAME_REAL(malloc)(n));
+    CHECKMEM( p->d = LTFAT_NAME_REAL(malloc)(n));
+    CHECKMEM( p->xnew = LTFAT_NAME_REAL(malloc)(n));
+
+    *pout = p;
+    return status;
+error:
+    if (p) PHASERET_NAME(lbfgs_done)(&p);
+    return status;
+}
+
+int
+PHASERET_NAME(lbfgs_reset)(PHASERET_NAME(lbfgs_plan)* p, const LTFAT_REAL x[])
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(x);
+
+    p->histno = 0;
+    p->head = 0;
+
+    CHECKSTATUS( p->objfun(p->userdata, x, &p->fval, p->grad));
+error:
+    return status;
+}
+
+int
+PHASERET_NAME(lbfgs_step)(PHASERET_NAME(lbfgs_plan)* p, LTFAT_REAL x[])
+{
+    int status = LTFATERR_SUCCESS;
+    ltfat_int n;
+    double gtd, t, tlo, thi, fnew = 0.0, fold;
+    int accepted = 0;
+    LTFAT_REAL* tmp;
+    CHECKNULL(p); CHECKNULL(x);
+    n = p->n;
+
+    PHASERET_NAME(lbfgs_direction)(p);
+    gtd = PHASERET_NAME(lbfgs_dot)(p->grad, p->d, n);
+
+    if (!(gtd < 0.0))
+    {
+        // Not a descent direction, restart from steepest descent
+        p->histno = 0;
+        PHASERET_NAME(lbfgs_direction)(p);
+        gtd = PHASERET_NAME(lbfgs_dot)(p->grad, p->d, n);
+
+        if (!(gtd < 0.0))
+            return 1;
+    }
+
+    // Without history the direction is not scaled, start with a short step
+    if (p->histno > 0)
+        t = 1.0;
+    else
+    {
+        double gnorm1 = 0.0;
+        for (ltfat_int ii = 0; ii < n; ii++)
+            gnorm1 += fabs(p->grad[ii]);
+
+        t = gnorm1 > 1.0 ? 1.0 / gnorm1 : 1.0;
+    }
+
+    // Bisection line search for the weak Wolfe conditions
+    tlo = 0.0; thi = -1.0;
+    for (ltfat_int ls = 0; ls < p->maxls; ls++)
+    {
+        PHASERET_NAME(lbfgs_axpy)((LTFAT_REAL) t, p->d, x, n, p->xnew);
+
+        CHECKSTATUS( p->objfun(p->userdata, p->xnew, &fnew, p->gradnew));
+
+        if (!(fnew <= p->fval + LBFGS_C1 * t * gtd))
+            thi = t;
+        else if (PHASERET_NAME(lbfgs_dot)(p->gradnew, p->d, n) < LBFGS_C2 * gtd)
+            tlo = t;
+        else
+        {
+            accepted = 1;
+            break;
+        }
+
+        t = thi > 0.0 ? 0.5 * (tlo + thi) : 2.0 * t;
+    }
+
+    // Accept the last trial point if it at least decreased the objective
+    if (!accepted && !(fnew < p->fval))
+        return 1;
+
+    // Store the correction pair
+    {
+        LTFAT_REAL* s = p->S + p->head * n;
+        LTFAT_REAL* y = p->Y + p->head * n;
+        double sy;
+
+        PHASERET_NAME(lbfgs_axpy)(-1, x, p->xnew, n, s);
+        PHASERET_NAME(lbfgs_axpy)(-1, p->grad, p->gradnew, n, y);
+
+        sy = PHASERET_NAME(lbfgs_dot)(s, y, n);
+
+        // Skip the pair if it would make the Hessian approximation indefinite
+        if (sy > 1e-10 * PHASERET_NAME(lbfgs_dot)(y, y, n))
+        {
+            p->rho[p->head] = 1.0 / sy;
+            p->head = (p->head + 1) % p->histlen;
+            if (p->histno < p->histlen) p->histno++;
+        }
+    }
+
+    memcpy(x, p->xnew, n * sizeof * x);
+    tmp = p->grad; p->grad = p->gradnew; p->gradnew = tmp;
+    fold = p->fval;
+    p->fval = fnew;
+
+    if (fold - fnew <= p->tol * fold)
+        return 1;
+
+error:
+    return status;
+}
+
+int
+PHASERET_NAME(lbfgs_done)(PHASERET_NAME(lbfgs_plan)** p)
+{
+    int status = LTFATERR_SUCCESS;
+    PHASERET_NAME(lbfgs_plan)* pp;
+    CHECKNULL(p); CHECKNULL(*p);
+    pp = *p;
+
+    ltfat_safefree(pp->S);
+    ltfat_safefree(pp->Y);
+    ltfat_safefree(pp->rho);
+    ltfat_safefree(pp->alpha);
+    ltfat_safefree(pp->grad);
+    ltfat_safefree(pp->gradnew);
+    ltfat_safefree(pp->d);
+    ltfat_safefree(pp->xnew);
+    ltfat_free(pp);
+    *p = NULL;
+error:
+    return status;
+}
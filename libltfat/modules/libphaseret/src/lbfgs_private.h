@@ -0,0 +1,89 @@
+#ifndef _PHASERET_LBFGS_PRIVATE_H
+#define _PHASERET_LBFGS_PRIVATE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Objective function for the L-BFGS engine
+ *
+ * \param[in]  userdata  User defined data
+ * \param[in]  x         Point, size n
+ * \param[out] fval      Value of the objective function at \a x
+ * \param[out] grad      Gradient at \a x, size n
+ *
+ * \returns Zero on success, error code otherwise
+ */
+typedef int
+PHASERET_NAME(lbfgs_objfun)(void* userdata, const LTFAT_REAL x[],
+                            double* fval, LTFAT_REAL grad[]);
+
+typedef struct PHASERET_NAME(lbfgs_plan) PHASERET_NAME(lbfgs_plan);
+
+struct PHASERET_NAME(lbfgs_plan)
+{
+    PHASERET_NAME(lbfgs_objfun)* objfun;
+    void* userdata;
+    ltfat_int n;
+    ltfat_int histlen;  //!< Capacity of the history ring
+    ltfat_int histno;   //!< Number of valid pairs in the ring
+    ltfat_int head;     //!< Ring index where the next pair is written
+    LTFAT_REAL* S;      //!< Ring of position differences, size n x histlen
+    LTFAT_REAL* Y;      //!< Ring of gradient differences, size n x histlen
+    double* rho;        //!< 1/(y'*s) for each pair
+    double* alpha;      //!< Scratch for the two-loop recursion
+    LTFAT_REAL* grad;   //!< Gradient at the current point
+    LTFAT_REAL* gradnew;//!< Gradient at the line search trial point
+    LTFAT_REAL* d;      //!< Search direction
+    LTFAT_REAL* xnew;   //!< Line search trial point
+    double fval;        //!< Objective at the current point
+    double tol;         //!< Tolerance of the relative decrease of the objective
+    ltfat_int maxls;    //!< Maximum number of objective evaluations per step
+};
+
+/** Create L-BFGS engine
+ *
+ * \param[in]  n         Number of variables
+ * \param[in]  histlen   Number of stored correction pairs
+ * \param[in]  objfun    Objective function
+ * \param[in]  userdata  Data passed to \a objfun
+ * \param[out] p         L-BFGS plan
+ */
+int
+PHASERET_NAME(lbfgs_init)(ltfat_int n, ltfat_int histlen,
+                          PHASERET_NAME(lbfgs_objfun)* objfun, void* userdata,
+                          PHASERET_NAME(lbfgs_plan)** p);
+
+/** Set the starting point
+ *
+ * Clears the history and evaluates the objective at \a x.
+ */
+int
+PHASERET_NAME(lbfgs_reset)(PHASERET_NAME(lbfgs_plan)* p, const LTFAT_REAL x[]);
+
+/** Do one L-BFGS iteration
+ *
+ * The search direction is computed by the two-loop recursion over the
+ * history ring and the step length is found by a bisection line search
+ * satisfying the weak Wolfe conditions.
+ *
+ * \param[in]     p  L-BFGS plan
+ * \param[in,out] x  Current point, it is replaced by the new one
+ *
+ * \returns 0 if the iteration was done, 1 if the algorithm has
+ *          converged (\a x then holds the last accepted point, whose
+ *          relative decrease of the objective was below the tolerance)
+ *          or cannot make progress (\a x is then unchanged),
+ *          error code from \a objfun otherwise
+ */
+int
+PHASERET_NAME(lbfgs_step)(PHASERET_NAME(lbfgs_plan)* p, LTFAT_REAL x[]);
+
+int
+PHASERET_NAME(lbfgs_done)(PHASERET_NAME(lbfgs_plan)** p);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _PHASERET_LBFGS_PRIVATE_H */
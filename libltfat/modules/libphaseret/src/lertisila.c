@@ -0,0 +1,435 @@
+#include "phaseret/lertisila.h"
+#include "phaseret/legla.h"
+#include "phaseret/utils.h"
+#include "ltfat/macros.h"
+
+struct PHASERET_NAME(lertisila_state)
+{
+    PHASERET_NAME(leglaupdate_plan_col)* uplan; //!< Single column update plan
+    LTFAT_COMPLEX** k;      //!< kNo modulated projection kernels
+    LTFAT_COMPLEX** kspec1; //!< Kernels for the first iteration of the newest frame
+    LTFAT_COMPLEX** kspec2; //!< Kernels for other iterations of the newest frame
+    ltfat_int kNo;          //!< Number of distinct kernel modulations
+    ltfat_int nmod;         //!< Index of the submit frame modulo kNo
+    ltfat_int maxLookahead;
+    ltfat_int lookahead;
+    ltfat_int lookback;
+    ltfat_int maxit;
+    ltfat_int W;
+    ltfat_int a;
+    ltfat_int M;
+    ltfat_int kernh2;
+    ltfat_int M2buf;     //!< Height of a column in cbuf
+    ltfat_int Nbuf;      //!< Number of columns of cbuf per channel
+    LTFAT_COMPLEX* cbuf; //!< Coefficients with extended borders, FREQINV
+    LTFAT_COMPLEX* cout; //!< Output of a single column update
+    LTFAT_REAL* s;       //!< Buffer for target magnitude
+};
+
+/* Conjugate-symmetric extension of a single column of cbuf.
+ * It is the same as extendborders with EXT_UPDOWN, but for one column only
+ * so that a column update does not require copying the whole buffer. */
+static void
+PHASERET_NAME(lertisila_extendcol)(LTFAT_COMPLEX* bufcol, ltfat_int M,
+                                   ltfat_int kernh2)
+{
+    ltfat_int M2 = M / 2 + 1;
+    LTFAT_COMPLEX* topsource = bufcol + kernh2;
+    LTFAT_COMPLEX* toptarget = topsource - 2;
+    LTFAT_COMPLEX* bottomtarget = bufcol + kernh2 - 1 + M2;
+    LTFAT_COMPLEX* bottomsource = bottomtarget - 2 + M % 2;
+
+    for (ltfat_int m = 0; m < kernh2 - 1; m++)
+        toptarget[-m] = conj(topsource[m]);
+
+    for (ltfat_int m = 0; m < kernh2 - 1; m++)
+        bottomtarget[m] = conj(bottomsource[-m]);
+}
+
+/* Compute the projection kernel as a response to impulses in frames
+ * nfirst,...,nlast (all at frequency zero), truncate it to ksize and
+ * precompute all kNo modulations. */
+static int
+PHASERET_NAME(lertisila_kernels)(LTFAT_NAME(dgtreal_plan)* dgtplan,
+                                 ltfat_int nfirst, ltfat_int nlast,
+                                 phaseret_size ksize, ltfat_int kNo,
+                                 LTFAT_COMPLEX* cbig, LTFAT_REAL* fbuf,
+                                 LTFAT_COMPLEX* ksmall, LTFAT_COMPLEX** kmod)
+{
+    int status = LTFATERR_SUCCESS;
+    ltfat_int M = LTFAT_NAME(dgtreal_get_M)(dgtplan);
+    ltfat_int a = LTFAT_NAME(dgtreal_get_a)(dgtplan);
+    ltfat_int L = LTFAT_NAME(dgtreal_get_L)(dgtplan);
+    ltfat_int M2 = M / 2 + 1;
+    ltfat_int kernh2 = ksize.height / 2 + 1;
+    phaseret_size bigsize;
+    bigsize.width = L / a; bigsize.height = M;
+
+    memset(cbig, 0, M2 * bigsize.width * sizeof * cbig);
+    for (ltfat_int n = nfirst; n <= nlast; n++)
+        cbig[n * M2] = LTFAT_COMPLEX(1.0, 0.0);
+
+    CHECKSTATUS( LTFAT_NAME(dgtreal_execute_proj)(dgtplan, cbig, fbuf, cbig));
+
+    PHASERET_NAME(legla_big2small_kernel)(cbig, bigsize, ksize, ksmall);
+
+    for (ltfat_int n = 0; n < kNo; n++)
+    {
+        CHECKMEM( kmod[n] = LTFAT_NAME_COMPLEX(calloc)( ksize.width * kernh2));
+        PHASERET_NAME(kernphasefi)(ksmall, ksize, n, a, M, kmod[n]);
+    }
+error:
+    return status;
+}
+
+PHASERET_API int
+PHASERET_NAME(lertisila_set_lookahead)(
+    PHASERET_NAME(lertisila_state) * p, ltfat_int lookahead)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+    CHECK(LTFATERR_BADARG, lookahead >= 0 && lookahead <= p->maxLookahead,
+          "lookahead can only be in range [0-%d] (passed %d).", p->maxLookahead,
+          lookahead);
+
+    p->lookahead = lookahead;
+error:
+    return status;
+}
+
+PHASERET_API int
+PHASERET_NAME(lertisila_set_itno)(PHASERET_NAME(lertisila_state)* p,
+                                  ltfat_int it)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+    CHECK(LTFATERR_BADARG, it > 0, "it must be greater than 0.");
+
+    p->maxit = it;
+error:
+    return status;
+}
+
+PHASERET_API int
+PHASERET_NAME(lertisila_reset)(PHASERET_NAME(lertisila_state) * p,
+                               const LTFAT_REAL** sinit)
+{
+    ltfat_int W, M2;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+
+    W = p->W;
+    M2 = p->M / 2 + 1;
+
+    memset(p->s, 0, M2 * (1 + p->maxLookahead) * W * sizeof * p->s);
+    memset(p->cbuf, 0, p->M2buf * p->Nbuf * W * sizeof * p->cbuf);
+    p->nmod = 0;
+
+    if (sinit)
+        for (ltfat_int w = 0; w < W; w++)
+            if (sinit[w])
+            {
+                LTFAT_COMPLEX* cbufchan = p->cbuf + w * p->Nbuf * p->M2buf;
+
+                memcpy(p->s + M2 + w * (1 + p->maxLookahead)*M2, sinit[w],
+                       M2 * p->lookahead * sizeof * p->s );
+
+                // Initial lookahead frames start with zero phase
+                for (ltfat_int n = 0; n < p->lookahead; n++)
+                {
+                    LTFAT_COMPLEX* bufcol =
+                        cbufchan + (p->lookback + 1 + n) * p->M2buf;
+                    const LTFAT_REAL* scol = sinit[w] + n * M2;
+
+                    for (ltfat_int m = 0; m < M2; m++)
+                        bufcol[p->kernh2 - 1 + m] = scol[m];
+
+                    PHASERET_NAME(lertisila_extendcol)(bufcol, p->M, p->kernh2);
+                }
+            }
+
+error:
+    return status;
+}
+
+PHASERET_API int
+PHASERET_NAME(lertisila_init)(const LTFAT_REAL* g, ltfat_int gl,
+                              ltfat_int W, ltfat_int a, ltfat_int M, ltfat_int lookahead, ltfat_int maxit,
+                              PHASERET_NAME(lertisila_state) * *pout)
+{
+    int status = LTFATERR_SUCCESS;
+
+    PHASERET_NAME(lertisila_state)* p = NULL;
+    LTFAT_NAME(dgtreal_plan)* baseplan = NULL;
+    LTFAT_NAME(dgtreal_plan)* specplan = NULL;
+    ltfat_dgt_params* dparams = NULL;
+    LTFAT_REAL* gd = NULL;
+    LTFAT_REAL* fbuf = NULL;
+    LTFAT_COMPLEX* cbig = NULL;
+    LTFAT_COMPLEX* ksmall = NULL;
+
+    ltfat_int M2, lookback, kernw, Lk;
+    phaseret_size ksize;
+    CHECKNULL(g);
+    CHECKNULL(pout);
+    CHECK(LTFATERR_BADSIZE, gl > 0, "gl must be positive (passed %d)", gl);
+    CHECK(LTFATERR_NOTPOSARG, W > 0, "W must be positive (passed %d)", W);
+    CHECK(LTFATERR_NOTPOSARG, a > 0, "a must be positive (passed %d)", a);
+    CHECK(LTFATERR_NOTPOSARG, M > 0, "M must be positive (passed %d)", M);
+    CHECK(LTFATERR_BADARG, lookahead >= 0, "lookahead >=0 failed (passed %d)",
+          lookahead);
+    CHECK(LTFATERR_NOTPOSARG, maxit > 0, "maxit must be positive (passed %d)",
+          maxit);
+
+    M2 = M / 2 + 1;
+    lookback = (ltfat_int)( ceil(((LTFAT_REAL)gl) / a) - 1 );
+    lookback = lookahead > lookback ? lookahead : lookback;
+    kernw = 2 * lookback + 1;
+    ksize.width = kernw; ksize.height = kernw;
+
+    CHECK(LTFATERR_BADSIZE, lookback < M2,
+          "Kernel height %d is too big for M=%d", ksize.height, M);
+
+    CHECKMEM(p = (PHASERET_NAME(lertisila_state)*)ltfat_calloc(1, sizeof * p));
+
+    p->lookback = lookback;
+    p->lookahead = lookahead;
+    p->maxLookahead = lookahead;
+    p->maxit = maxit;
+    p->W = W;
+    p->a = a;
+    p->M = M;
+    p->kNo = ltfat_lcm(M, a) / a;
+    p->kernh2 = ksize.height / 2 + 1;
+    p->M2buf = M2 + ksize.height - 1;
+    p->Nbuf = 2 * lookback + lookahead + 1;
+
+    CHECKSTATUS(
+        PHASERET_NAME(leglaupdate_col_init)(M, ksize, EXT_UPDOWN | MOD_FRAMEWISE,
+                                            &p->uplan));
+
+    CHECKMEM(p->cbuf = LTFAT_NAME_COMPLEX(calloc)(p->M2buf * p->Nbuf * W));
+    CHECKMEM(p->cout = LTFAT_NAME_COMPLEX(malloc)(M2));
+    CHECKMEM(p->s = LTFAT_NAME_REAL(calloc)(M2 * (1 + lookahead) * W));
+
+    CHECKMEM(p->k = (LTFAT_COMPLEX**) ltfat_calloc(p->kNo, sizeof * p->k));
+    CHECKMEM(p->kspec1 = (LTFAT_COMPLEX**) ltfat_calloc(p->kNo, sizeof * p->k));
+    CHECKMEM(p->kspec2 = (LTFAT_COMPLEX**) ltfat_calloc(p->kNo, sizeof * p->k));
+
+    // The kernels are computed from a system long enough not to wrap around
+    Lk = ltfat_dgtlength( (4 * lookback + 2) * a > 2 * gl ?
+                          (4 * lookback + 2) * a : 2 * gl, a, M);
+
+    CHECKMEM(gd = LTFAT_NAME_REAL(malloc)(gl));
+    CHECKMEM(fbuf = LTFAT_NAME_REAL(malloc)(Lk));
+    CHECKMEM(cbig = LTFAT_NAME_COMPLEX(malloc)(M2 * (Lk / a)));
+    CHECKMEM(ksmall = LTFAT_NAME_COMPLEX(malloc)(kernw * p->kernh2));
+
+    CHECKSTATUS(LTFAT_NAME(gabdual_painless)(g, gl, a, M, gd));
+
+    CHECKMEM(dparams = ltfat_dgt_params_allocdef());
+    ltfat_dgt_setpar_phaseconv(dparams, LTFAT_FREQINV);
+
+    CHECKSTATUS(
+        LTFAT_NAME(dgtreal_init_gen)(g, gl, gd, gl, Lk, 1, a, M, NULL, NULL,
+                                     dparams, &baseplan));
+    CHECKSTATUS(
+        LTFAT_NAME(dgtreal_init_gen)(gd, gl, gd, gl, Lk, 1, a, M, NULL, NULL,
+                                     dparams, &specplan));
+
+    // Regular kernel
+    CHECKSTATUS(
+        PHASERET_NAME(lertisila_kernels)(baseplan, 0, 0, ksize, p->kNo,
+                                         cbig, fbuf, ksmall, p->k));
+
+    // Kernel for the first iteration of the newest frame. The newest frame
+    // itself is zero at that point.
+    CHECKSTATUS(
+        PHASERET_NAME(lertisila_kernels)(specplan, 1, kernw, ksize, p->kNo,
+                                         cbig, fbuf, ksmall, p->kspec1));
+
+    // Kernel for the other iterations of the newest frame
+    CHECKSTATUS(
+        PHASERET_NAME(lertisila_kernels)(specplan, 0, kernw, ksize, p->kNo,
+                                         cbig, fbuf, ksmall, p->kspec2));
+
+    LTFAT_NAME(dgtreal_done)(&baseplan);
+    LTFAT_NAME(dgtreal_done)(&specplan);
+    ltfat_dgt_params_free(dparams);
+    ltfat_free(gd);
+    ltfat_free(fbuf);
+    ltfat_free(cbig);
+    ltfat_free(ksmall);
+
+    *pout = p;
+    return status;
+error:
+    if (baseplan) LTFAT_NAME(dgtreal_done)(&baseplan);
+    if (specplan) LTFAT_NAME(dgtreal_done)(&specplan);
+    if (dparams) ltfat_dgt_params_free(dparams);
+    ltfat_safefree(gd);
+    ltfat_safefree(fbuf);
+    ltfat_safefree(cbig);
+    ltfat_safefree(ksmall);
+    if (p) PHASERET_NAME(lertisila_done)(&p);
+    if (pout) *pout = NULL;
+    return status;
+}
+
+PHASERET_API int
+PHASERET_NAME(lertisila_init_win)(LTFAT_FIRWIN win, ltfat_int gl,
+                                  ltfat_int W, ltfat_int a, ltfat_int M, ltfat_int lookahead, ltfat_int maxit,
+                                  PHASERET_NAME(lertisila_state) * *pout)
+{
+    LTFAT_REAL* g = NULL;
+    int status = LTFATERR_SUCCESS;
+    int initstatus;
+    CHECKMEM(g = LTFAT_NAME_REAL(malloc)(gl));
+
+    // Analysis window
+    CHECKSTATUS(LTFAT_NAME(firwin)(win, gl, g));
+
+    initstatus = PHASERET_NAME(lertisila_init)(g, gl, W, a, M, lookahead, maxit,
+                 pout);
+
+    ltfat_free(g);
+    return initstatus;
+error:
+    if (g)
+        ltfat_free(g);
+    return status;
+}
+
+PHASERET_API int
+PHASERET_NAME(lertisila_done)(PHASERET_NAME(lertisila_state) * *p)
+{
+    int status = LTFATERR_SUCCESS;
+    PHASERET_NAME(lertisila_state) * pp;
+    CHECKNULL(p);
+    CHECKNULL(*p);
+    pp = *p;
+
+    if (pp->uplan)
+        PHASERET_NAME(leglaupdate_col_done)(&pp->uplan);
+
+    for (ltfat_int n = 0; n < pp->kNo; n++)
+    {
+        if (pp->k) ltfat_safefree(pp->k[n]);
+        if (pp->kspec1) ltfat_safefree(pp->kspec1[n]);
+        if (pp->kspec2) ltfat_safefree(pp->kspec2[n]);
+    }
+
+    ltfat_safefree(pp->k);
+    ltfat_safefree(pp->kspec1);
+    ltfat_safefree(pp->kspec2);
+    ltfat_safefree(pp->cbuf);
+    ltfat_safefree(pp->cout);
+    ltfat_safefree(pp->s);
+
+    ltfat_free(pp);
+    *p = NULL;
+error:
+    return status;
+}
+
+PHASERET_API int
+PHASERET_NAME(lertisila_execute)( PHASERET_NAME(lertisila_state) * p,
+                                  const LTFAT_REAL* s, LTFAT_COMPLEX* c)
+{
+    ltfat_int M, M2, M2buf, kernh2;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+    CHECKNULL(s);
+    CHECKNULL(c);
+
+    M = p->M;
+    M2 = M / 2 + 1;
+    M2buf = p->M2buf;
+    kernh2 = p->kernh2;
+
+    for (ltfat_int w = 0; w < p->W; w++)
+    {
+        const LTFAT_REAL* schan = s + w * M2;
+        LTFAT_COMPLEX* cchan = c + w * M2;
+        LTFAT_COMPLEX* cbufchan = p->cbuf + w * p->Nbuf * M2buf;
+        LTFAT_REAL* sframeschan = p->s + w * (1 + p->maxLookahead) * M2;
+
+        // Shift coefficient buffer, the newest frame starts as zero
+        PHASERET_NAME_COMPLEX(shiftcolsleft)(cbufchan, M2buf, p->Nbuf, NULL);
+
+        // Shift scols buffer
+        PHASERET_NAME(shiftcolsleft)(sframeschan, M2, p->lookahead + 1, schan);
+
+        for (ltfat_int it = 0; it < p->maxit; it++)
+        {
+            for (ltfat_int nback = p->lookahead; nback >= 0; nback--)
+            {
+                ltfat_int kidx = (p->nmod + nback) % p->kNo;
+                const LTFAT_COMPLEX* kern = p->k[kidx];
+
+                if (nback == p->lookahead)
+                    kern = it == 0 ? p->kspec1[kidx] : p->kspec2[kidx];
+
+                // The kernel is centered at column lookback + nback
+                PHASERET_NAME(leglaupdate_col_execute)(p->uplan,
+                                                       sframeschan + nback * M2, kern,
+                                                       cbufchan + nback * M2buf, p->cout);
+
+                PHASERET_NAME(lertisila_extendcol)(
+                    cbufchan + (p->lookback + nback) * M2buf, M, kernh2);
+            }
+        }
+
+        // Submit the frame, convert FREQINV to TIMEINV
+        LTFAT_NAME_COMPLEX(fftrealcircshift)(
+            cbufchan + p->lookback * M2buf + kernh2 - 1, M,
+            (double)(-p->nmod * p->a), cchan);
+    }
+
+    p->nmod = (p->nmod + 1) % p->kNo;
+
+error:
+    return status;
+}
+
+PHASERET_API int
+PHASERET_NAME(lertisilaoffline)(const LTFAT_REAL s[], const LTFAT_REAL g[],
+                                ltfat_int L, ltfat_int gl, ltfat_int W, ltfat_int a, ltfat_int M,
+                                ltfat_int lookahead, ltfat_int maxit, LTFAT_COMPLEX c[])
+{
+    int status = LTFATERR_SUCCESS;
+    PHASERET_NAME(lertisila_state)* p = NULL;
+    ltfat_int N = L / a;
+    ltfat_int M2 = M / 2 + 1;
+
+    CHECKNULL(s);
+    CHECKNULL(g);
+    CHECKNULL(c);
+    // Just limit lookahead to something sensible
+    lookahead = lookahead > N ? N : lookahead;
+
+    CHECKSTATUS(PHASERET_NAME(lertisila_init)(g, gl, 1, a, M, lookahead, maxit, &p));
+
+    for (ltfat_int w = 0; w < W; w++)
+    {
+        const LTFAT_REAL* schan = s + w * N * M2;
+        PHASERET_NAME(lertisila_reset)(p, &schan);
+
+        for (ltfat_int n = 0, nahead = lookahead; nahead < N; ++n, ++nahead)
+        {
+            const LTFAT_REAL* sncol = schan + nahead * M2;
+            LTFAT_COMPLEX* cncol = c + n * M2 + w * N * M2;
+            PHASERET_NAME(lertisila_execute)(p, sncol, cncol);
+        }
+
+        for (ltfat_int n = N - lookahead, nahead = 0; n < N; ++n, ++nahead)
+        {
+            const LTFAT_REAL* sncol = schan + nahead * M2;
+            LTFAT_COMPLEX* cncol = c + n * M2 + w * N * M2;
+            PHASERET_NAME(lertisila_execute)(p, sncol, cncol);
+        }
+    }
+error:
+    if (p) PHASERET_NAME(lertisila_done)(&p);
+    return status;
+}
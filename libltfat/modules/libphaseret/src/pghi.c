@@ -101,6 +101,38 @@ error:
     return status;
 }
 
+/* Phase of one channel. scratch must not overlap with schan. */
+static void
+PHASERET_NAME(pghi_phase)(PHASERET_NAME(pghi_plan)* p, const LTFAT_REAL schan[],
+                          LTFAT_REAL scratch[])
+{
+    ltfat_int M2 = p->M / 2 + 1;
+    ltfat_int N = p->L / p->a;
+
+    PHASERET_NAME(pghilog)(schan, M2 * N, scratch);
+    PHASERET_NAME(pghitgrad)(scratch, p->gamma, p->a, p->M, N, p->tgrad );
+    PHASERET_NAME(pghifgrad)(scratch, p->gamma, p->a, p->M, N, p->fgrad );
+
+    memset(scratch, 0, M2 * N * sizeof * scratch);
+
+    // Start of without mask
+    LTFAT_NAME(heapinttask_resetmax)(p->hit, schan, (LTFAT_REAL) p->tol1);
+    LTFAT_NAME(heapint_execute)(p->hit, schan, p->tgrad, p->fgrad, scratch);
+    int* donemask = LTFAT_NAME(heapinttask_get_mask)(p->hit);
+
+    if (!isnan(p->tol2) && p->tol2 < p->tol1)
+    {
+        // Reuse the just computed mask
+        LTFAT_NAME(heapinttask_resetmask)(p->hit, donemask, schan, (LTFAT_REAL) p->tol2, 0);
+        LTFAT_NAME(heapint_execute)(p->hit, schan, p->tgrad, p->fgrad, scratch);
+    }
+
+    // Assign random phase to unused coefficients
+    for (ltfat_int ii = 0; ii < M2 * N; ii++)
+        if (donemask[ii] <= LTFAT_MASK_UNKNOWN)
+            scratch[ii] = (LTFAT_REAL) ( 2.0 * M_PI * ((double)rand()) / RAND_MAX);
+}
+
 PHASERET_API int
 PHASERET_NAME(pghi_execute)(PHASERET_NAME(pghi_plan)* p, const LTFAT_REAL s[],
                             LTFAT_COMPLEX c[])
@@ -117,33 +149,10 @@ PHASERET_NAME(pghi_execute)(PHASERET_NAME(pghi_plan)* p, const LTFAT_REAL s[],
     {
         const LTFAT_REAL* schan = s + w * M2 * N;
         LTFAT_COMPLEX* cchan = c + w * M2 * N;
-        const LTFAT_REAL* tgradwchan = p->tgrad + w * M2 * N;
-        const LTFAT_REAL* fgradwchan = p->fgrad + w * M2 * N;
         LTFAT_REAL* scratch = ((LTFAT_REAL*)cchan) + M2 *
                               N; // Second half of the output
 
-        PHASERET_NAME(pghilog)(schan, M2 * N, scratch);
-        PHASERET_NAME(pghitgrad)(scratch, p->gamma, p->a, p->M, N, p->tgrad );
-        PHASERET_NAME(pghifgrad)(scratch, p->gamma, p->a, p->M, N, p->fgrad );
-
-        memset(scratch, 0, M2 * N * sizeof * scratch);
-
-        // Start of without mask
-        LTFAT_NAME(heapinttask_resetmax)(p->hit, schan, (LTFAT_REAL) p->tol1);
-        LTFAT_NAME(heapint_execute)(p->hit, schan, tgradwchan, fgradwchan, scratch);
-        int* donemask = LTFAT_NAME(heapinttask_get_mask)(p->hit);
-
-        if (!isnan(p->tol2) && p->tol2 < p->tol1)
-        {
-            // Reuse the just computed mask
-            LTFAT_NAME(heapinttask_resetmask)(p->hit, donemask, schan, (LTFAT_REAL) p->tol2, 0);
-            LTFAT_NAME(heapint_execute)(p->hit, schan, tgradwchan, fgradwchan, scratch);
-        }
-
-        // Assign random phase to unused coefficients
-        for (ltfat_int ii = 0; ii < M2 * N; ii++)
-            if (donemask[ii] <= LTFAT_MASK_UNKNOWN)
-                scratch[ii] = (LTFAT_REAL) ( 2.0 * M_PI * ((double)rand()) / RAND_MAX);
+        PHASERET_NAME(pghi_phase)(p, schan, scratch);
 
         // Combine phase and magnitude
         if (schan != (LTFAT_REAL*) cchan)
@@ -161,6 +170,29 @@ error:
     return status;
 }
 
+PHASERET_API int
+PHASERET_NAME(pghi_execute_planar)(PHASERET_NAME(pghi_plan)* p, const LTFAT_REAL s[],
+                                   LTFAT_REAL cr[], LTFAT_REAL ci[])
+{
+    int status = LTFATERR_SUCCESS;
+    ltfat_int M2, N;
+    CHECKNULL(s); CHECKNULL(cr); CHECKNULL(ci); CHECKNULL(p);
+    CHECK(LTFATERR_BADARG, s != ci, "s and ci cannot be the same array");
+
+    M2 = p->M / 2 + 1;
+    N = p->L / p->a;
+
+    for (ltfat_int w = 0; w < p->W; w++)
+    {
+        // The phase is computed directly in the imaginary part
+        PHASERET_NAME(pghi_phase)(p, s + w * M2 * N, ci + w * M2 * N);
+        PHASERET_NAME(pghimagphase_planar)(s + w * M2 * N, ci + w * M2 * N,
+                                           M2 * N, cr + w * M2 * N, ci + w * M2 * N);
+    }
+error:
+    return status;
+}
+
 PHASERET_API int
 PHASERET_NAME(pghi_execute_withmask)(PHASERET_NAME(pghi_plan)* p,
                                      const LTFAT_COMPLEX cin[],
@@ -262,6 +294,18 @@ PHASERET_NAME(pghimagphase)(const LTFAT_REAL s[], const LTFAT_REAL phase[],
         c[l] = s[l] * exp(I * phase[l]);
 }
 
+void
+PHASERET_NAME(pghimagphase_planar)(const LTFAT_REAL s[], const LTFAT_REAL phase[],
+                                   ltfat_int L, LTFAT_REAL cr[], LTFAT_REAL ci[])
+{
+    for (ltfat_int l = 0; l < L; l++)
+    {
+        LTFAT_REAL sval = s[l], phaseval = phase[l];
+        cr[l] = sval * cos(phaseval);
+        ci[l] = sval * sin(phaseval);
+    }
+}
+
 void
 PHASERET_NAME(pghilog)(const LTFAT_REAL* in, ltfat_int L, LTFAT_REAL* out)
 {
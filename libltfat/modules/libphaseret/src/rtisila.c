@@ -16,6 +16,8 @@ struct PHASERET_NAME(rtisilaupdate_plan)
     ltfat_int gl;
     ltfat_int M;
     ltfat_int a;
+    long long timebudget; //!< Time budget for one execute call in ns, 0 means none
+    ltfat_int itdone;     //!< Number of iterations done in the last execute call
 };
 
 struct PHASERET_NAME(rtisila_state)
@@ -26,6 +28,8 @@ struct PHASERET_NAME(rtisila_state)
     ltfat_int lookback;
     ltfat_int maxit;
     ltfat_int W;
+    long long timebudget; //!< Per-frame time budget in ns, 0 means fixed maxit
+    ltfat_int lastitno;   //!< Iterations achieved in the last frame
     LTFAT_REAL* frames; //!< Buffer for time-domain frames
     LTFAT_REAL* s;      //!< Buffer for target magnitude
     void** garbageBin;
@@ -264,13 +268,25 @@ PHASERET_NAME(rtisilaupdate_execute)(
     ltfat_int M = p->M;
     ltfat_int gl = p->gl;
     ltfat_int M2 = M / 2 + 1;
+    int do_timed = p->timebudget > 0;
+    long long tstart = do_timed ? ltfat_monotonic_ns() : 0;
+    ltfat_int it;
 
     // If we are not working inplace ...
     if (frames != frames2)
         memcpy(frames2, frames, gl * N * sizeof * frames);
 
-    for (ltfat_int it = 0; it < maxit; it++)
+    for (it = 0; it < maxit; it++)
     {
+        if (do_timed && it > 0)
+        {
+            // Stop if the next iteration is not expected to fit in the budget.
+            // The first iteration is always done such that c is valid.
+            long long elapsed = ltfat_monotonic_ns() - tstart;
+            if (elapsed + elapsed / it > p->timebudget)
+                break;
+        }
+
         for (ltfat_int nback = lookahead; nback >= 0; nback--)
         {
             ltfat_int indx = lookback + nback;
@@ -284,13 +300,36 @@ PHASERET_NAME(rtisilaupdate_execute)(
             else
                 PHASERET_NAME(rtisilaoverlaynthframe)(p, frames2, p->g, indx, N);
 
-            if (nback == 0 && it == (maxit - 1))
+            // In the timed mode, any iteration can be the last one
+            if (nback == 0 && (it == (maxit - 1) || do_timed))
                 PHASERET_NAME(rtisilaphaseupdate)(p, s + nback * M2, frames2 +  indx * gl, c);
             else
                 PHASERET_NAME(rtisilaphaseupdate)(p, s + nback * M2, frames2 +  indx * gl,
                                                   NULL);
         }
     }
+
+    p->itdone = it;
+}
+
+PHASERET_API int
+PHASERET_NAME(rtisilaupdate_set_timebudget)(PHASERET_NAME(rtisilaupdate_plan)* p,
+                                            long long timebudget)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+    CHECK(LTFATERR_BADARG, timebudget >= 0, "timebudget cannot be negative.");
+
+    p->timebudget = timebudget;
+error:
+    return status;
+}
+
+PHASERET_API ltfat_int
+PHASERET_NAME(rtisilaupdate_get_itdone)(PHASERET_NAME(rtisilaupdate_plan)* p)
+{
+    if (p) return p->itdone;
+    else return LTFATERR_NULLPOINTER;
 }
 
 void
@@ -419,6 +458,7 @@ PHASERET_NAME(rtisila_init)(const LTFAT_REAL* g, ltfat_int gl,
     p->lookahead = lookahead;
     p->maxLookahead = maxLookahead;
     p->maxit = maxit;
+    p->lastitno = maxit;
     p->W = W;
 
     *pout = p;
@@ -508,6 +548,7 @@ PHASERET_NAME(rtisila_execute)( PHASERET_NAME(rtisila_state) * p,
                                 const LTFAT_REAL* s, LTFAT_COMPLEX* c)
 {
     ltfat_int M, gl, M2, noFrames, N;
+    long long tstart = 0;
     int status = LTFATERR_SUCCESS;
     CHECKNULL(p);
     CHECKNULL(s);
@@ -519,8 +560,21 @@ PHASERET_NAME(rtisila_execute)( PHASERET_NAME(rtisila_state) * p,
     noFrames = p->lookback + 1 + p->lookahead;
     N = p->lookback + 1 + p->maxLookahead;
 
+    if (p->timebudget > 0)
+        tstart = ltfat_monotonic_ns();
+
+    p->lastitno = p->maxit;
+
     for (ltfat_int w = 0; w < p->W; w++)
     {
+        if (p->timebudget > 0)
+        {
+            // Split what is left from the budget evenly among the remaining channels
+            long long timeleft =
+                p->timebudget - (ltfat_monotonic_ns() - tstart);
+            p->uplan->timebudget = timeleft > 0 ? timeleft / (p->W - w) : 1;
+        }
+
         const LTFAT_REAL* schan = s + w * M2;
         LTFAT_COMPLEX* cchan = c + w * M2;
         LTFAT_REAL* frameschan = p->frames + w * N * gl;
@@ -533,6 +587,9 @@ PHASERET_NAME(rtisila_execute)( PHASERET_NAME(rtisila_state) * p,
 
         PHASERET_NAME(rtisilaupdate_execute)(p->uplan, frameschan, noFrames,
                                              sframeschan, p->lookahead, p->maxit, frameschan, cchan);
+
+        if (p->uplan->itdone < p->lastitno)
+            p->lastitno = p->uplan->itdone;
     }
 
 error:
@@ -594,3 +651,25 @@ error:
     return status;
 
 }
+
+PHASERET_API int
+PHASERET_NAME(rtisila_set_timebudget)(PHASERET_NAME(rtisila_state)* p,
+                                      long long timebudget)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+    CHECK(LTFATERR_BADARG, timebudget >= 0, "timebudget cannot be negative.");
+
+    p->timebudget = timebudget;
+    // The per-channel budget of the update plan is set in rtisila_execute
+    p->uplan->timebudget = 0;
+error:
+    return status;
+}
+
+PHASERET_API ltfat_int
+PHASERET_NAME(rtisila_get_lastitno)(PHASERET_NAME(rtisila_state)* p)
+{
+    if (p) return p->lastitno;
+    else return LTFATERR_NULLPOINTER;
+}
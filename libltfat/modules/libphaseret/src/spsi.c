@@ -3,6 +3,112 @@
 #include "ltfat/macros.h"
 #include "float.h"
 
+/* Per-channel scratch of the column update */
+typedef struct
+{
+    ltfat_int* peaks;   //!< Indices of the local maxima, length M2
+    LTFAT_REAL* p;      //!< Interpolated peak offsets, length M2
+    LTFAT_REAL* s;      //!< Contiguous magnitude column, length M2
+} PHASERET_NAME(spsi_scratch);
+
+/* Same as spsiupdate, but works with a contiguous column and splits the work
+ * into passes over bins which do not depend on each other:
+ * 1) branch-free local maxima detection and compaction of the peak indices,
+ * 2) quadratic interpolation of the log-magnitude at the peaks,
+ * 3) sequential assignment of the peak phase to the regions of influence. */
+static void
+PHASERET_NAME(spsiupdate_col)(const LTFAT_REAL* scol, ltfat_int a, ltfat_int M,
+                              ltfat_int* peaks, LTFAT_REAL* pbuf,
+                              LTFAT_REAL* tmpphase)
+{
+    ltfat_int M2 = M / 2 + 1;
+    ltfat_int pNo = 0;
+
+    for (ltfat_int m = 1; m < M2 - 1; m++)
+    {
+        peaks[pNo] = m;
+        pNo += (scol[m] > scol[m - 1]) & (scol[m] > scol[m + 1]);
+    }
+
+#ifdef _OPENMP
+    #pragma omp simd
+#endif
+    for (ltfat_int k = 0; k < pNo; k++)
+    {
+        ltfat_int m = peaks[k];
+        LTFAT_REAL alpha = log(scol[m - 1] + LTFAT_REAL_MIN);
+        LTFAT_REAL beta = log(scol[m] + LTFAT_REAL_MIN);
+        LTFAT_REAL gamma = log(scol[m + 1] + LTFAT_REAL_MIN);
+        LTFAT_REAL denom = alpha - (LTFAT_REAL)(2.0) * beta + gamma;
+        LTFAT_REAL safedenom = denom != 0.0 ? denom : (LTFAT_REAL) 1.0;
+        pbuf[k] = denom != 0.0 ? (LTFAT_REAL)(0.5) * (alpha - gamma) / safedenom : 0;
+    }
+
+    for (ltfat_int k = 0; k < pNo; k++)
+    {
+        ltfat_int m = peaks[k];
+        LTFAT_REAL p = pbuf[k];
+        ltfat_int binup = m, bindown = m;
+        LTFAT_REAL instf = m + p;
+        LTFAT_REAL peakPhase = tmpphase[m] + (LTFAT_REAL)( 2.0 * M_PI * a * instf) / M;
+        tmpphase[m] = peakPhase;
+
+        if (p > 0)
+        {
+            tmpphase[m + 1] = peakPhase;
+            binup = m + 2;
+            bindown = m - 1;
+        }
+
+        if (p < 0)
+        {
+            tmpphase[m - 1] = peakPhase;
+            binup = m + 1;
+            bindown = m - 2;
+        }
+
+        // Go towards low frequency bins
+        ltfat_int bin = bindown;
+
+        while (bin > 0 && scol[bin] < scol[bin + 1])
+        {
+            tmpphase[bin] = peakPhase;
+            bin--;
+        }
+
+        // Go towards high frequency bins
+        bin = binup;
+
+        while (bin < M2 - 1 && scol[bin] < scol[bin - 1])
+        {
+            tmpphase[bin] = peakPhase;
+            bin++;
+        }
+    }
+}
+
+static int
+PHASERET_NAME(spsi_scratch_init)(ltfat_int M2, ltfat_int W, int withs,
+                                 PHASERET_NAME(spsi_scratch)* sc)
+{
+    int status = LTFATERR_SUCCESS;
+    memset(sc, 0, sizeof * sc);
+    CHECKMEM( sc->peaks = (ltfat_int*) ltfat_malloc(M2 * W * sizeof * sc->peaks));
+    CHECKMEM( sc->p = LTFAT_NAME_REAL(malloc)(M2 * W));
+    if (withs)
+        CHECKMEM( sc->s = LTFAT_NAME_REAL(malloc)(M2 * W));
+error:
+    return status;
+}
+
+static void
+PHASERET_NAME(spsi_scratch_done)(PHASERET_NAME(spsi_scratch)* sc)
+{
+    ltfat_safefree(sc->peaks);
+    ltfat_safefree(sc->p);
+    ltfat_safefree(sc->s);
+}
+
 PHASERET_API int
 PHASERET_NAME(spsi)(const LTFAT_REAL* s, ltfat_int L, ltfat_int W, ltfat_int a, ltfat_int M,
                     LTFAT_REAL* initphase, LTFAT_COMPLEX* c)
@@ -10,6 +116,9 @@ PHASERET_NAME(spsi)(const LTFAT_REAL* s, ltfat_int L, ltfat_int W, ltfat_int a,
     ltfat_int M2 = M / 2 + 1;
     ltfat_int N = L / a;
     LTFAT_REAL* tmpphase = initphase;
+    int inplace = s == (const LTFAT_REAL*)c;
+    PHASERET_NAME(spsi_scratch) sc;
+    memset(&sc, 0, sizeof sc);
 
     int status = LTFATERR_SUCCESS;
     CHECKNULL(s); CHECKNULL(c);
@@ -21,7 +130,9 @@ PHASERET_NAME(spsi)(const LTFAT_REAL* s, ltfat_int L, ltfat_int W, ltfat_int a,
     if (!initphase)
         CHECKMEM(tmpphase = LTFAT_NAME_REAL(calloc)(M2 * W));
 
-    if (s == (LTFAT_REAL*)c)
+    CHECKSTATUS( PHASERET_NAME(spsi_scratch_init)(M2, W, 0, &sc));
+
+    if (inplace)
     {
         // Inplace, move the abs. values to the second half of the array
         LTFAT_REAL* chalf = ((LTFAT_REAL*)c) + W * M2 * N;
@@ -29,6 +140,11 @@ PHASERET_NAME(spsi)(const LTFAT_REAL* s, ltfat_int L, ltfat_int W, ltfat_int a,
         s = chalf;
     }
 
+    // Channels are independent, but inplace the output of channel w
+    // overwrites the magnitudes of channels >= W/2, so it is done serially
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(static) if(!inplace)
+#endif
     for (ltfat_int w = 0; w < W; w++)
     {
         LTFAT_REAL* tmpphasecol = tmpphase + w * M2;
@@ -37,7 +153,8 @@ PHASERET_NAME(spsi)(const LTFAT_REAL* s, ltfat_int L, ltfat_int W, ltfat_int a,
             const LTFAT_REAL* scol = s + n * M2 + w * M2 * N;
             LTFAT_COMPLEX* ccol = c + n * M2 + w * M2 * N;
 
-            PHASERET_NAME(spsiupdate)(scol, 1, a, M, tmpphasecol);
+            PHASERET_NAME(spsiupdate_col)(scol, a, M, sc.peaks + w * M2,
+                                          sc.p + w * M2, tmpphasecol);
 
             for (ltfat_int m = 0; m < M2; m++)
                 ccol[m] = scol[m] * exp(I * tmpphasecol[m]);
@@ -45,8 +162,9 @@ PHASERET_NAME(spsi)(const LTFAT_REAL* s, ltfat_int L, ltfat_int W, ltfat_int a,
     }
 
 error:
+    PHASERET_NAME(spsi_scratch_done)(&sc);
     if (!initphase)
-        ltfat_free(tmpphase);
+        ltfat_safefree(tmpphase);
     return status;
 }
 
@@ -57,6 +175,8 @@ PHASERET_NAME(spsi_withmask)(const LTFAT_COMPLEX* cinit, const int* mask, ltfat_
     ltfat_int M2 = M / 2 + 1;
     ltfat_int N = L / a;
     LTFAT_REAL* tmpphase = initphase;
+    PHASERET_NAME(spsi_scratch) sc;
+    memset(&sc, 0, sizeof sc);
 
     int status = LTFATERR_SUCCESS;
     CHECKNULL(cinit);
@@ -70,34 +190,144 @@ PHASERET_NAME(spsi_withmask)(const LTFAT_COMPLEX* cinit, const int* mask, ltfat_
     if (!initphase)
         CHECKMEM(tmpphase = LTFAT_NAME_REAL(calloc)(M2 * W));
 
+    CHECKSTATUS( PHASERET_NAME(spsi_scratch_init)(M2, W, 1, &sc));
+
+    // Channels are independent
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(static)
+#endif
     for (ltfat_int w = 0; w < W; w++)
     {
         LTFAT_REAL* tmpphasecol = tmpphase + w * M2;
+        LTFAT_REAL* scol = sc.s + w * M2;
         for (ltfat_int n = 0; n < N; n++)
         {
             LTFAT_COMPLEX* ccol = c + n * M2 + w * M2 * N;
             const LTFAT_COMPLEX* cinitcol = cinit + n * M2 + w * M2 * N;
             const int* maskcol = mask + n * M2 + w * M2 * N;
 
-            PHASERET_NAME(realimag2absangle)(cinitcol, M2, ccol);
-            LTFAT_REAL* absptr = (LTFAT_REAL*)ccol;
-            LTFAT_REAL* angleptr = ((LTFAT_REAL*)ccol) + 1;
+            // Contiguous magnitude, the phase is only needed where known
+            for (ltfat_int m = 0; m < M2; m++)
+                scol[m] = ltfat_abs(cinitcol[m]);
 
-            PHASERET_NAME(spsiupdate)(absptr, 2, a, M, tmpphasecol);
+            PHASERET_NAME(spsiupdate_col)(scol, a, M, sc.peaks + w * M2,
+                                          sc.p + w * M2, tmpphasecol);
 
             /* Overwrite with known phase */
             for (ltfat_int m = 0; m < M2; m++)
                 if (maskcol[m])
-                    tmpphasecol[m] = angleptr[2 * m];
+                    tmpphasecol[m] = ltfat_arg(cinitcol[m]);
 
             for (ltfat_int m = 0; m < M2; m++)
-                ccol[m] = absptr[2 * m] * exp(I * tmpphasecol[m]);
+                ccol[m] = scol[m] * exp(I * tmpphasecol[m]);
         }
     }
 
+error:
+    PHASERET_NAME(spsi_scratch_done)(&sc);
     if (!initphase)
-        ltfat_free(tmpphase);
+        ltfat_safefree(tmpphase);
+    return status;
+}
+
+struct PHASERET_NAME(rtspsi_state)
+{
+    ltfat_int W;
+    ltfat_int a;
+    ltfat_int M;
+    LTFAT_REAL* phase;  //!< Phase of the previous frame, M2 x W
+    ltfat_int* peaks;   //!< Scratch for spsiupdate_col, M2
+    LTFAT_REAL* pbuf;   //!< Scratch for spsiupdate_col, M2
+};
+
+PHASERET_API int
+PHASERET_NAME(rtspsi_init)(ltfat_int W, ltfat_int a, ltfat_int M,
+                           PHASERET_NAME(rtspsi_state)** pout)
+{
+    int status = LTFATERR_SUCCESS;
+    ltfat_int M2 = M / 2 + 1;
+    PHASERET_NAME(rtspsi_state)* p = NULL;
+
+    CHECKNULL(pout);
+    CHECK(LTFATERR_NOTPOSARG, W > 0, "W must be positive");
+    CHECK(LTFATERR_NOTPOSARG, a > 0, "a must be positive (passed %d)", a);
+    CHECK(LTFATERR_NOTPOSARG, M > 0, "M must be positive");
+
+    CHECKMEM( p = (PHASERET_NAME(rtspsi_state)*) ltfat_calloc(1, sizeof * p));
+    CHECKMEM( p->phase = LTFAT_NAME_REAL(calloc)(M2 * W));
+    CHECKMEM( p->peaks = (ltfat_int*) ltfat_malloc(M2 * sizeof * p->peaks));
+    CHECKMEM( p->pbuf = LTFAT_NAME_REAL(malloc)(M2));
+
+    p->W = W;
+    p->a = a;
+    p->M = M;
+
+    *pout = p;
+    return status;
+error:
+    if (p) PHASERET_NAME(rtspsi_done)(&p);
+    return status;
+}
+
+PHASERET_API int
+PHASERET_NAME(rtspsi_reset)(PHASERET_NAME(rtspsi_state)* p,
+                            const LTFAT_REAL** phaseinit)
+{
+    int status = LTFATERR_SUCCESS;
+    ltfat_int M2;
+    CHECKNULL(p);
+    M2 = p->M / 2 + 1;
 
+    memset(p->phase, 0, M2 * p->W * sizeof * p->phase);
+
+    if (phaseinit)
+        for (ltfat_int w = 0; w < p->W; w++)
+            if (phaseinit[w])
+                memcpy(p->phase + w * M2, phaseinit[w], M2 * sizeof * p->phase);
+
+error:
+    return status;
+}
+
+PHASERET_API int
+PHASERET_NAME(rtspsi_execute)(PHASERET_NAME(rtspsi_state)* p,
+                              const LTFAT_REAL s[], LTFAT_COMPLEX c[])
+{
+    int status = LTFATERR_SUCCESS;
+    ltfat_int M2;
+    CHECKNULL(p); CHECKNULL(s); CHECKNULL(c);
+    M2 = p->M / 2 + 1;
+
+    // Going backwards allows s == c
+    for (ltfat_int w = p->W - 1; w >= 0; w--)
+    {
+        const LTFAT_REAL* sCol = s + w * M2;
+        LTFAT_COMPLEX* cCol = c + w * M2;
+        LTFAT_REAL* phaseCol = p->phase + w * M2;
+
+        PHASERET_NAME(spsiupdate_col)(sCol, p->a, p->M, p->peaks, p->pbuf,
+                                      phaseCol);
+
+        for (ltfat_int m = M2 - 1; m >= 0; m--)
+            cCol[m] = sCol[m] * exp(I * phaseCol[m]);
+    }
+
+error:
+    return status;
+}
+
+PHASERET_API int
+PHASERET_NAME(rtspsi_done)(PHASERET_NAME(rtspsi_state)** p)
+{
+    int status = LTFATERR_SUCCESS;
+    PHASERET_NAME(rtspsi_state)* pp;
+    CHECKNULL(p); CHECKNULL(*p);
+    pp = *p;
+    ltfat_safefree(pp->phase);
+    ltfat_safefree(pp->peaks);
+    ltfat_safefree(pp->pbuf);
+    ltfat_free(pp);
+    *p = NULL;
 error:
     return status;
 }
@@ -5,6 +5,7 @@ definput.flags.phase={'load','reload','recompile'};
 definput.flags.comptarget={'fulloptim','release','debug'};
 definput.flags.verbosity={'quiet','verbose'};
 definput.flags.corcpp={'c','cpp'};
+definput.flags.openmp={'noopenmp','openmp'};
 definput.keyvals.compiler = [];
 
 [flags,kv,lib]=ltfatarghelper({'lib'},definput,varargin);
@@ -28,6 +29,10 @@ if ~iscompiled || flags.do_recompile
     if flags.do_cpp
         makecmd = [makecmd, ' USECPP=1'];
     end
+
+    if flags.do_openmp
+        makecmd = [makecmd, ' USEOPENMP=1'];
+    end
     
     if kv.compiler
         makecmd = [makecmd, sprintf(' CC=%s',kv.compiler)];
@@ -0,0 +1,36 @@
+f = greasy;
+a = 128;
+M = 1024;
+M2 = floor(M/2) + 1; 
+gl = M;
+L = dgtlength(numel(f),a,M);
+g = firwin('blackman',gl);
+N = L/a;
+maxit = 100;
+
+corig = dgtreal(f,{'blackman',gl},a,M);
+s = abs(corig) + 1i*zeros(size(corig));
+
+cinPtr = libpointer('doublePtr',complex2interleaved(s));
+cout = zeros(2*M2,N);
+coutPtr = libpointer('doublePtr',cout);
+
+tic;
+calllib('libphaseret','phaseret_decolbfgs_d',cinPtr,g,L,gl,1,a,M,maxit,coutPtr);
+tlib = toc;
+
+cout2 = interleaved2complex(coutPtr.Value);
+
+frec = idgtreal(cout2,{'dual',{'blackman',gl}},a,M);
+
+s2 = dgtreal(frec,{'blackman',gl},a,M);
+magnitudeerrdb(s,s2)
+
+tic;
+c = decolbfgs(abs(s),{'blackman',gl},a,M,'maxit',maxit,'freqinv');
+tmat = toc;
+frec = idgtreal(c,{'dual',{'blackman',gl}},a,M);
+magnitudeerrdb(s,dgtreal(frec,{'blackman',gl},a,M))
+
+fprintf('libphaseret: %.2f s, MATLAB: %.2f s\n',tlib,tmat);
+
@@ -28,3 +28,17 @@ magnitudeerrdb(s,s2)
 
 
 
+
+% Planar output
+plan = libpointer();
+calllib('libphaseret','phaseret_pghi_init_d',L,1,a,M,1e-1,1e-10,gamma,plan);
+crPtr = libpointer('doublePtr',zeros(M2,N));
+ciPtr = libpointer('doublePtr',zeros(M2,N));
+calllib('libphaseret','phaseret_pghi_execute_planar_d',plan,s,crPtr,ciPtr);
+calllib('libphaseret','phaseret_pghi_done_d',plan);
+
+cout3 = crPtr.Value + 1i*ciPtr.Value;
+frec3 = idgtreal(cout3,{'dual',{'hann',gl}},a,M,'timeinv');
+
+s3 = dgtreal(frec3,{'hann',gl},a,M,'timeinv');
+magnitudeerrdb(s,s3)
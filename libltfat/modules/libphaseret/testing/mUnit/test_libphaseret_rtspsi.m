@@ -0,0 +1,41 @@
+clear all;
+f = gspi;
+a = 256;
+M = 1024;
+M2 = floor(M/2) + 1; 
+gl = 1024;
+L = dgtlength(numel(f),a,M);
+N = L/a;
+
+
+corig = dgtreal(f,{'hann',gl},a,M,'timeinv');
+s = abs(corig);
+
+% Offline SPSI as reference
+cref = zeros(2*M2,N);
+crefPtr = libpointer('doublePtr',cref);
+calllib('libphaseret','phaseret_spsi_d',s,L,1,a,M,libpointer(),crefPtr);
+
+% Frame-by-frame
+statePtr = libpointer();
+calllib('libphaseret','phaseret_rtspsi_init_d',1,a,M,statePtr);
+
+cout = zeros(2*M2,N);
+ccol = zeros(2*M2,1);
+ccolPtr = libpointer('doublePtr',ccol);
+tic
+for n=1:N
+    calllib('libphaseret','phaseret_rtspsi_execute_d',statePtr,s(:,n),ccolPtr);
+    cout(:,n) = ccolPtr.Value;
+end
+t = toc;
+t/N*1000
+
+calllib('libphaseret','phaseret_rtspsi_done_d',statePtr);
+
+fprintf('RTSPSI vs. SPSI max difference: %d\n',max(abs(cout(:) - crefPtr.Value(:))));
+
+cout2 = interleaved2complex(cout);
+frec = idgtreal(cout2,{'dual',{'hann',gl}},a,M,'timeinv');
+s2 = dgtreal(frec,{'hann',gl},a,M,'timeinv');
+magnitudeerrdb(s,s2)
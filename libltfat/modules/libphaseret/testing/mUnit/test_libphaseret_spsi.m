@@ -25,6 +25,18 @@ frec = idgtreal(cout2,{'dual',{'hann',gl}},a,M,'timeinv');
 s2 = dgtreal(frec,{'hann',gl},a,M,'timeinv');
 magnitudeerrdb(s,s2)
 
+%% Multichannel inplace must equal out of place
+% Only meaningful with the library built by loadlibphaseret('recompile','openmp')
+W = 8;
+s = abs(dgtreal(randn(L,W),{'hann',gl},a,M,'timeinv'));
+cout = zeros(2*M2,N,W);
+coutPtr = libpointer('doublePtr',cout);
+calllib('libphaseret','phaseret_spsi_d',s,L,W,a,M,libpointer(),coutPtr);
 
+cinplace = zeros(2*M2,N,W);
+cinplace(1:numel(s)) = s(:);
+cinplacePtr = libpointer('doublePtr',cinplace);
+calllib('libphaseret','phaseret_spsi_d',cinplacePtr,L,W,a,M,libpointer(),cinplacePtr);
 
-
+fprintf('SPSI inplace vs. out of place W=%d max difference: %d\n',W,...
+        max(abs(cinplacePtr.Value(:) - coutPtr.Value(:))));